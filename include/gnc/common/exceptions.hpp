@@ -30,4 +30,9 @@ public:
     using GncException::GncException;
 };
 
+class AllocationError : public GncException {
+public:
+    using GncException::GncException;
+};
+
 } // namespace gnc
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <string>
 #include <optional>
 #include <any>
+#include <functional>
 
 namespace gnc::states {
 
@@ -100,6 +101,7 @@ enum class StateAccessType {
  * - access: 访问权限
  * - source: 输入状态的数据来源
  * - required: 是否为必需状态
+ * - compute: 派生输出的计算函数（仅派生输出），读取时按需求值
  * 
  * 状态规格用于：
  * 1. 组件接口定义
@@ -113,6 +115,7 @@ struct StateSpec {
     std::optional<StateId> source;  ///< 数据来源（仅输入状态）
     bool required{false};    ///< 是否必需
     std::any default_value; ///< 默认值
+    std::function<std::any()> compute;  ///< 派生输出的计算函数（为空表示普通输出）
 };
 
 } // namespace gnc::states
@@ -0,0 +1,363 @@
+/**
+ * @file multi_fidelity_dynamics.hpp
+ * @brief 多保真度动力学组件（3-DOF 质点 / 6-DOF 刚体自动切换）
+ *
+ * @details 设计思路：
+ * 1. 同一组件内同时持有 3-DOF 质点模型和 6-DOF 刚体模型，组件名仍为 "Dynamics"，
+ *    输出状态与 RigidBodyDynamics6DoF 保持一致，可直接在 core.yaml 中替换。
+ * 2. 保真度切换只发生在组件内部，组件的依赖声明不变，因此不需要重新做拓扑排序。
+ * 3. 升级条件（任一满足即升级到 6-DOF）：
+ *    - 距离：与兴趣点或指定飞行器的距离小于 promote_distance_m。其他飞行器的位置按上一帧
+ *      读取（previousFrameState），与执行顺序无关，飞行器之间可以相互引用而不形成依赖环
+ *    - 阶段：指定阶段状态（如 "GuidanceWithPhase.current_phase"）处于配置的阶段列表中
+ *    - 记录：promote_when_logged 开启且本组件的输出被 DataLogger 选中记录
+ *    - 强制：飞行器在 full_fidelity_vehicles 列表中
+ * 4. 降级使用滞回（demote_distance_m）和最短驻留步数（min_dwell_steps），避免来回抖动。
+ * 5. 状态映射：
+ *    - 3→6：位置、速度原样保留；姿态取速度对齐姿态（零滚转），角速度清零
+ *    - 6→3：位置、速度原样保留，姿态和角速度丢弃
+ * 6. 统计每个飞行器以及本次运行全部飞行器在各保真度下的步数占比，在 finalize() 时输出；
+ *    全部飞行器的汇总保存在 StateManager 的运行计数器中，同一进程中的多次运行互不影响。
+ *
+ * 配置示例（dynamics.json）：
+ * @code
+ * "multi_fidelity": {
+ *     "initial_level": "3dof",
+ *     "promote_distance_m": 5000.0,
+ *     "demote_distance_m": 6000.0,
+ *     "points_of_interest": [[10000, 0, 0]],
+ *     "proximity_vehicles": [2],
+ *     "phase_state": "GuidanceWithPhase.current_phase",
+ *     "full_fidelity_phases": ["main"],
+ *     "promote_when_logged": false,
+ *     "full_fidelity_vehicles": [],
+ *     "min_dwell_steps": 10
+ * }
+ * @endcode
+ */
+#pragma once
+#include "gnc/core/component_base.hpp"
+#include "gnc/core/component_registrar.hpp"
+#include "../utility/config_manager.hpp"
+#include "../utility/simple_logger.hpp"
+#include "math/math.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace gnc::components {
+
+/**
+ * @brief 动力学保真度等级
+ */
+enum class FidelityLevel {
+    PointMass3DoF = 3,   ///< 3-DOF 质点模型
+    RigidBody6DoF = 6    ///< 6-DOF 刚体模型
+};
+
+/**
+ * @brief 保真度步数统计
+ */
+struct FidelityStatistics {
+    uint64_t steps_3dof{0};   ///< 以 3-DOF 运行的飞行器步数
+    uint64_t steps_6dof{0};   ///< 以 6-DOF 运行的飞行器步数
+    uint64_t promotions{0};   ///< 3→6 切换次数
+    uint64_t demotions{0};    ///< 6→3 切换次数
+
+    uint64_t totalSteps() const { return steps_3dof + steps_6dof; }
+    double fraction3DoF() const { return totalSteps() ? static_cast<double>(steps_3dof) / totalSteps() : 0.0; }
+    double fraction6DoF() const { return totalSteps() ? static_cast<double>(steps_6dof) / totalSteps() : 0.0; }
+};
+
+/**
+ * @brief 多保真度动力学组件
+ */
+class MultiFidelityDynamics : public states::ComponentBase {
+public:
+    MultiFidelityDynamics(states::VehicleId id, const std::string& instanceName = "")
+        : states::ComponentBase(id, "Dynamics", instanceName) {
+        // 组件级依赖与保真度无关，切换保真度不改变执行计划。两种模型都不使用气动力，
+        // 因此不依赖 Aerodynamics（后者按上一帧读取 Dynamics 的速度）
+        declareInput<void>(ComponentId{globalId, "TimingManager"});
+        declareInput<void>(ComponentId{globalId, "CoordinationInitializer"});
+
+        declareOutput<Vector3d>("position_truth_m", Vector3d(0.0, 0.0, 0.0));
+        declareOutput<Vector3d>("velocity_truth_mps", Vector3d(0.0, 0.0, 0.0));
+        declareOutput<Quaterniond>("attitude_truth_quat", Quaterniond(1.0, 0.0, 0.0, 0.0));
+        declareOutput<Vector3d>("velocity_body_mps", Vector3d(0.0, 0.0, 0.0));
+        declareOutput<Vector3d>("angular_rate_body_radps", Vector3d(0.0, 0.0, 0.0));
+        declareOutput<int>("fidelity_level", static_cast<int>(FidelityLevel::PointMass3DoF));
+    }
+
+    std::string getComponentType() const override {
+        return "MultiFidelityDynamics";
+    }
+
+    void initialize() override {
+        loadConfiguration();
+        run_steps_3dof_ = &runCounter("MultiFidelityDynamics.steps_3dof");
+        run_steps_6dof_ = &runCounter("MultiFidelityDynamics.steps_6dof");
+        run_instances_ = &runCounter("MultiFidelityDynamics.instances");
+        ++*run_instances_;
+        publishState();
+        LOG_COMPONENT_INFO("Multi-fidelity dynamics initialized at {}-DOF", static_cast<int>(level_));
+    }
+
+    void finalize() override {
+        LOG_COMPONENT_INFO("Vehicle {} fidelity: 3-DOF {:.1f}%, 6-DOF {:.1f}% of {} steps ({} promotions, {} demotions)",
+                           getVehicleId(), stats_.fraction3DoF() * 100.0, stats_.fraction6DoF() * 100.0,
+                           stats_.totalSteps(), stats_.promotions, stats_.demotions);
+
+        // 本次运行中最后一个终结的实例负责输出全部飞行器的汇总
+        if (run_instances_ && --*run_instances_ == 0) {
+            FidelityStatistics total = getRunStatistics();
+            LOG_INFO("[MultiFidelityDynamics] All vehicles: 3-DOF {:.1f}%, 6-DOF {:.1f}% of {} vehicle-steps",
+                     total.fraction3DoF() * 100.0, total.fraction6DoF() * 100.0, total.totalSteps());
+        }
+    }
+
+    /**
+     * @brief 当前保真度
+     */
+    FidelityLevel getFidelityLevel() const { return level_; }
+
+    /**
+     * @brief 本飞行器的保真度统计
+     */
+    const FidelityStatistics& getStatistics() const { return stats_; }
+
+    /**
+     * @brief 本次运行所有 MultiFidelityDynamics 实例累计的保真度统计（按飞行器步数计，不含切换次数）
+     */
+    FidelityStatistics getRunStatistics() const {
+        FidelityStatistics total;
+        total.steps_3dof = run_steps_3dof_ ? static_cast<uint64_t>(*run_steps_3dof_) : 0;
+        total.steps_6dof = run_steps_6dof_ ? static_cast<uint64_t>(*run_steps_6dof_) : 0;
+        return total;
+    }
+
+protected:
+    void updateImpl() override {
+        double dt = getState<double>({{globalId, "TimingManager"}, "timing_delta_s"});
+
+        // 记录组件在自身 initialize() 中选择状态，因此在第一次更新时检查是否被记录
+        if (promote_when_logged_ && !logged_checked_) {
+            logged_checked_ = true;
+            if (isLogged()) {
+                LOG_COMPONENT_INFO("Dynamics outputs are logged, running at 6-DOF");
+                pinned_full_fidelity_ = true;
+            }
+        }
+
+        // 1. 评估期望保真度并在需要时切换（带状态映射）
+        ++steps_in_level_;
+        FidelityLevel desired = evaluateDesiredLevel();
+        if (desired != level_ && (desired == FidelityLevel::RigidBody6DoF || steps_in_level_ >= min_dwell_steps_)) {
+            switchTo(desired);
+        }
+
+        // 2. 推进当前模型
+        if (level_ == FidelityLevel::RigidBody6DoF) {
+            stepRigidBody(dt);
+            ++stats_.steps_6dof;
+            ++*run_steps_6dof_;
+        } else {
+            stepPointMass(dt);
+            ++stats_.steps_3dof;
+            ++*run_steps_3dof_;
+        }
+
+        publishState();
+        LOG_COMPONENT_TRACE("{}-DOF step, position X: {}", static_cast<int>(level_), position_[0]);
+    }
+
+private:
+    /**
+     * @brief 从 dynamics 配置中读取切换条件和初始状态
+     */
+    void loadConfiguration() {
+        using namespace gnc::components::utility;
+        auto config = ConfigManager::getInstance().getComponentConfig(ConfigFileType::DYNAMICS, "multi_fidelity");
+        if (config.empty()) {
+            LOG_COMPONENT_WARN("Config 'dynamics.multi_fidelity' not found. Using defaults.");
+        }
+
+        level_ = config.value("initial_level", std::string("3dof")) == "6dof"
+               ? FidelityLevel::RigidBody6DoF : FidelityLevel::PointMass3DoF;
+        promote_distance_m_ = config.value("promote_distance_m", 0.0);
+        demote_distance_m_ = std::max(config.value("demote_distance_m", promote_distance_m_), promote_distance_m_);
+        min_dwell_steps_ = config.value("min_dwell_steps", 10);
+        phase_state_ = config.value("phase_state", std::string());
+
+        if (config.contains("initial_position")) position_ = toVector(config["initial_position"]);
+        if (config.contains("initial_velocity")) velocity_ = toVector(config["initial_velocity"]);
+        if (config.contains("initial_angular_velocity")) angular_rate_ = toVector(config["initial_angular_velocity"]);
+
+        for (const auto& point : config.value("points_of_interest", nlohmann::json::array())) {
+            points_of_interest_.push_back(toVector(point));
+        }
+        for (const auto& vehicle : config.value("proximity_vehicles", nlohmann::json::array())) {
+            auto other = vehicle.get<states::VehicleId>();
+            if (other == getVehicleId()) {
+                continue;
+            }
+            try {
+                proximity_positions_.push_back(
+                    &previousFrameState<Vector3d>(StateId{{other, "Dynamics"}, "position_truth_m"}));
+            } catch (const std::exception& e) {
+                LOG_COMPONENT_WARN("Proximity source vehicle {} unavailable, ignoring: {}", other, e.what());
+            }
+        }
+        for (const auto& phase : config.value("full_fidelity_phases", nlohmann::json::array())) {
+            full_fidelity_phases_.push_back(phase.get<std::string>());
+        }
+        promote_when_logged_ = config.value("promote_when_logged", false);
+        for (const auto& vehicle : config.value("full_fidelity_vehicles", nlohmann::json::array())) {
+            if (vehicle.get<states::VehicleId>() == getVehicleId()) {
+                pinned_full_fidelity_ = true;
+            }
+        }
+
+        attitude_ = velocityAlignedAttitude(velocity_, attitude_);
+        if (pinned_full_fidelity_) {
+            level_ = FidelityLevel::RigidBody6DoF;
+        }
+    }
+
+    /**
+     * @brief 根据切换条件计算期望的保真度
+     * @details 升级阈值使用 promote_distance_m，降级阈值使用 demote_distance_m（滞回）
+     */
+    FidelityLevel evaluateDesiredLevel() {
+        if (pinned_full_fidelity_) {
+            return FidelityLevel::RigidBody6DoF;
+        }
+
+        if (!phase_state_.empty() && !full_fidelity_phases_.empty()) {
+            try {
+                const auto& phase = get<std::string>(phase_state_);
+                if (std::find(full_fidelity_phases_.begin(), full_fidelity_phases_.end(), phase) != full_fidelity_phases_.end()) {
+                    return FidelityLevel::RigidBody6DoF;
+                }
+            } catch (const std::exception& e) {
+                LOG_COMPONENT_WARN("Phase state '{}' unavailable, phase condition disabled: {}", phase_state_, e.what());
+                phase_state_.clear();
+            }
+        }
+
+        if (promote_distance_m_ > 0.0) {
+            double threshold = level_ == FidelityLevel::RigidBody6DoF ? demote_distance_m_ : promote_distance_m_;
+            double threshold_sq = threshold * threshold;
+            for (const auto& point : points_of_interest_) {
+                if ((position_ - point).squaredNorm() < threshold_sq) {
+                    return FidelityLevel::RigidBody6DoF;
+                }
+            }
+            for (const Vector3d* other : proximity_positions_) {
+                if ((position_ - *other).squaredNorm() < threshold_sq) {
+                    return FidelityLevel::RigidBody6DoF;
+                }
+            }
+        }
+
+        return FidelityLevel::PointMass3DoF;
+    }
+
+    /**
+     * @brief 切换保真度并映射状态
+     */
+    void switchTo(FidelityLevel target) {
+        if (target == FidelityLevel::RigidBody6DoF) {
+            // 3→6：由速度方向恢复姿态，角速度从零开始
+            attitude_ = velocityAlignedAttitude(velocity_, attitude_);
+            angular_rate_.setZero();
+            ++stats_.promotions;
+        } else {
+            // 6→3：仅保留平动状态
+            angular_rate_.setZero();
+            ++stats_.demotions;
+        }
+        LOG_COMPONENT_DEBUG("Fidelity switched {}-DOF -> {}-DOF after {} steps",
+                            static_cast<int>(level_), static_cast<int>(target), steps_in_level_);
+        level_ = target;
+        steps_in_level_ = 0;
+    }
+
+    /**
+     * @brief 3-DOF 质点模型：仅积分平动
+     */
+    void stepPointMass(double dt) {
+        // 伪实现：无外力的匀速运动，姿态始终与速度对齐
+        position_ += velocity_ * dt;
+        attitude_ = velocityAlignedAttitude(velocity_, attitude_);
+    }
+
+    /**
+     * @brief 6-DOF 刚体模型：积分平动和转动
+     */
+    void stepRigidBody(double dt) {
+        position_ += velocity_ * dt;
+
+        // 四元数运动学积分 q_{k+1} = q_k ⊗ exp(ω·dt/2)
+        double angle = angular_rate_.norm() * dt;
+        if (angle > EPSILON) {
+            attitude_ = (attitude_ * Quaterniond(Eigen::AngleAxisd(angle, angular_rate_.normalized()))).normalized();
+        }
+    }
+
+    void publishState() {
+        setState("position_truth_m", position_);
+        setState("velocity_truth_mps", velocity_);
+        setState("attitude_truth_quat", attitude_);
+        // 直接用自身姿态计算载体系速度，两种保真度下保持一致
+        setState("velocity_body_mps", Vector3d(attitude_.conjugate() * velocity_));
+        setState("angular_rate_body_radps", angular_rate_);
+        setState("fidelity_level", static_cast<int>(level_));
+    }
+
+    /**
+     * @brief 计算机体 X 轴与速度方向对齐的姿态（零滚转）
+     * @param velocity 惯性系速度
+     * @param fallback 速度过小时沿用的姿态
+     */
+    static Quaterniond velocityAlignedAttitude(const Vector3d& velocity, const Quaterniond& fallback) {
+        if (velocity.squaredNorm() < EPSILON) {
+            return fallback;
+        }
+        return Quaterniond::FromTwoVectors(Vector3d::UnitX(), velocity.normalized());
+    }
+
+    static Vector3d toVector(const nlohmann::json& value) {
+        return Vector3d(value.at(0).get<double>(), value.at(1).get<double>(), value.at(2).get<double>());
+    }
+
+    // 切换配置
+    double promote_distance_m_ = 0.0;
+    double demote_distance_m_ = 0.0;
+    int min_dwell_steps_ = 10;
+    std::string phase_state_;
+    std::vector<std::string> full_fidelity_phases_;
+    std::vector<Vector3d> points_of_interest_;
+    std::vector<const Vector3d*> proximity_positions_;  ///< 其他飞行器上一帧的位置
+    bool promote_when_logged_ = false;
+    bool logged_checked_ = false;
+    bool pinned_full_fidelity_ = false;
+
+    // 运行时状态
+    FidelityLevel level_ = FidelityLevel::PointMass3DoF;
+    int steps_in_level_ = 0;
+    FidelityStatistics stats_;
+    int64_t* run_steps_3dof_ = nullptr;   ///< 本次运行全部实例的汇总（StateManager 运行计数器）
+    int64_t* run_steps_6dof_ = nullptr;
+    int64_t* run_instances_ = nullptr;
+
+    Vector3d position_{0.0, 0.0, 0.0};
+    Vector3d velocity_{100.0, 0.0, 0.0};
+    Quaterniond attitude_{1.0, 0.0, 0.0, 0.0};
+    Vector3d angular_rate_{0.0, 0.0, 0.0};
+};
+
+static gnc::ComponentRegistrar<MultiFidelityDynamics> multi_fidelity_dynamics_registrar("MultiFidelityDynamics");
+
+}
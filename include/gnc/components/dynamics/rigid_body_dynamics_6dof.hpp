@@ -24,8 +24,10 @@ public:
         declareOutput<Vector3d>("velocity_truth_mps", Vector3d(0.0, 0.0, 0.0));
         declareOutput<Quaterniond>("attitude_truth_quat", Quaterniond(1.0, 0.0, 0.0, 0.0)); // w,x,y,z
         
-        // 新增：输出载体系速度
-        declareOutput<Vector3d>("velocity_body_mps", Vector3d(0.0, 0.0, 0.0));
+        // 载体系速度为派生输出：只有被读取时才做坐标转换
+        declareDerivedOutput<Vector3d>("velocity_body_mps", [this]() {
+            return SAFE_TRANSFORM_VEC(velocity_, "INERTIAL", "BODY");
+        });
     }
 
     std::string getComponentType() const override {
@@ -46,15 +48,7 @@ protected:
         setState("velocity_truth_mps", velocity_);
         setState("attitude_truth_quat", attitude_);
         
-        // 使用超简化接口计算载体系速度 - 只需一行代码！
-        Vector3d velocity_body_mps = SAFE_TRANSFORM_VEC(velocity_, "INERTIAL", "BODY");
-        setState("velocity_body_mps", velocity_body_mps);
-        
         LOG_COMPONENT_DEBUG("Updated truth state. Position X: {}", position_[0]);
-        LOG_COMPONENT_DEBUG("Velocity in body frame: {}, {}, {}", 
-            getState<Vector3d>("velocity_body_mps")[0],
-            getState<Vector3d>("velocity_body_mps")[1],
-            getState<Vector3d>("velocity_body_mps")[2]);
         LOG_COMPONENT_DEBUG("Attitude in body frame: {}, {}, {}, {}", 
             getState<Quaterniond>("attitude_truth_quat").w(),
             getState<Quaterniond>("attitude_truth_quat").x(),
@@ -0,0 +1,167 @@
+/**
+ * @file static_pipeline_dynamics.hpp
+ * @brief 基于编译期静态流水线的固定构型动力学组件
+ *
+ * @details 将 大气 → 二次阻力 → 质点动力学 三个阶段组成 StaticPipeline，
+ * 执行顺序在编译期由依赖关系确定（模板参数的声明顺序无关紧要），
+ * 阶段之间通过生成的状态结构体直接传递数据，不经过 StateManager。
+ * 整条流水线注册为一个组件（组件名 "Dynamics"），提供与 RigidBodyDynamics6DoF 相同的输出：
+ * position_truth_m、velocity_truth_mps、attitude_truth_quat 和派生输出 velocity_body_mps；
+ * 另外在 Dynamics 名下发布 air_density_kg_m3 和 aero_force_truth_N 便于记录。
+ *
+ * 适用于不需要运行时替换子模型、也不需要控制/拉偏输入的固定构型飞行器，
+ * 可在 core.yaml 中用 StaticPipelineDynamics 替换 Atmosphere、Aerodynamics、Dynamics 三个组件。
+ * 替换后 Atmosphere.* 和 Aerodynamics.* 路径不再存在，只读取 Dynamics 输出的组件不受影响。
+ * 各阶段是独立的简化模型，不是对应动态组件的等价实现：阻力沿速度反方向且不含 Disturbance
+ * 的 drag_factor，因此数值与 SimpleAerodynamics + RigidBodyDynamics6DoF 的组合不同。
+ *
+ * 配置示例（dynamics.json）：
+ * @code
+ * "static_pipeline": {
+ *     "mass_kg": 1000.0,
+ *     "cda_m2": 0.1,
+ *     "initial_position": [0, 0, 0],
+ *     "initial_velocity": [100, 0, 0]
+ * }
+ * @endcode
+ */
+#pragma once
+#include "gnc/core/component_registrar.hpp"
+#include "gnc/core/static_pipeline.hpp"
+#include "../utility/config_manager.hpp"
+#include "../utility/simple_logger.hpp"
+#include "math/math.hpp"
+
+namespace gnc::components {
+
+namespace static_stages {
+
+/**
+ * @brief 大气阶段：海平面标准大气密度
+ */
+struct AtmosphereStage {
+    struct Outputs {
+        double air_density_kg_m3 = 1.225;
+    };
+
+    template <typename State>
+    void step(State& state, const pipeline::StepContext&) {
+        state.air_density_kg_m3 = 1.225;
+    }
+};
+
+/**
+ * @brief 二次阻力阶段：F = -0.5·ρ·|v|·CdA·v，方向与速度相反
+ * @details 读取上一步的速度。与 SimpleAerodynamics 不同，不乘拉偏系数，阻力也不固定沿 X 轴
+ */
+struct QuadraticDragStage {
+    using Depends = pipeline::Depends<AtmosphereStage>;
+
+    struct Outputs {
+        Vector3d aero_force_truth_N = Vector3d::Zero();
+    };
+
+    template <typename State>
+    void step(State& state, const pipeline::StepContext&) {
+        const Vector3d& v = state.velocity_truth_mps;
+        double speed = v.norm();
+        // 阻力方向与速度相反
+        state.aero_force_truth_N = -0.5 * state.air_density_kg_m3 * speed * cda_m2 * v;
+    }
+
+    double cda_m2 = 0.1;  ///< 阻力系数与参考面积之积
+};
+
+/**
+ * @brief 质点动力学阶段：半隐式欧拉积分，姿态取速度对齐姿态
+ */
+struct PointMassDynamicsStage {
+    using Depends = pipeline::Depends<QuadraticDragStage>;
+
+    struct Outputs {
+        Vector3d position_truth_m = Vector3d::Zero();
+        Vector3d velocity_truth_mps = Vector3d::Zero();
+        Quaterniond attitude_truth_quat = Quaterniond::Identity();
+    };
+
+    template <typename State>
+    void step(State& state, const pipeline::StepContext& ctx) {
+        state.velocity_truth_mps += state.aero_force_truth_N / mass_kg * ctx.dt_s;
+        state.position_truth_m += state.velocity_truth_mps * ctx.dt_s;
+        if (state.velocity_truth_mps.squaredNorm() > 0.0) {
+            state.attitude_truth_quat = Quaterniond::FromTwoVectors(Vector3d::UnitX(), state.velocity_truth_mps);
+        }
+    }
+
+    double mass_kg = 1000.0;
+};
+
+} // namespace static_stages
+
+/**
+ * @brief 大气 + 二次阻力 + 质点动力学 的静态流水线
+ * @details 故意按与执行顺序相反的顺序列出阶段，执行顺序由编译期依赖解析确定
+ */
+using PointMassPipeline = pipeline::StaticPipeline<
+    static_stages::PointMassDynamicsStage,
+    static_stages::QuadraticDragStage,
+    static_stages::AtmosphereStage>;
+
+class StaticPipelineDynamics : public pipeline::StaticPipelineComponent<PointMassPipeline> {
+public:
+    StaticPipelineDynamics(states::VehicleId id, const std::string& instanceName = "")
+        : StaticPipelineComponent(id, "Dynamics", instanceName) {
+        declareOutput<Vector3d>("position_truth_m", Vector3d(0.0, 0.0, 0.0));
+        declareOutput<Vector3d>("velocity_truth_mps", Vector3d(0.0, 0.0, 0.0));
+        declareOutput<Quaterniond>("attitude_truth_quat", Quaterniond(1.0, 0.0, 0.0, 0.0));
+        declareOutput<double>("air_density_kg_m3", 1.225);
+        declareOutput<Vector3d>("aero_force_truth_N", Vector3d(0.0, 0.0, 0.0));
+
+        // 载体系速度为派生输出：只有被读取时才做坐标转换
+        declareDerivedOutput<Vector3d>("velocity_body_mps", [this]() {
+            const auto& state = pipeline_.state();
+            return Vector3d(state.attitude_truth_quat.conjugate() * state.velocity_truth_mps);
+        });
+    }
+
+    std::string getComponentType() const override {
+        return "StaticPipelineDynamics";
+    }
+
+    void initialize() override {
+        using namespace gnc::components::utility;
+        auto config = ConfigManager::getInstance().getComponentConfig(ConfigFileType::DYNAMICS, "static_pipeline");
+        if (config.empty()) {
+            LOG_COMPONENT_WARN("Config 'dynamics.static_pipeline' not found. Using defaults.");
+        }
+
+        pipeline_.stage<static_stages::PointMassDynamicsStage>().mass_kg = config.value("mass_kg", 1000.0);
+        pipeline_.stage<static_stages::QuadraticDragStage>().cda_m2 = config.value("cda_m2", 0.1);
+        auto& state = pipeline_.state();
+        if (config.contains("initial_position")) state.position_truth_m = toVector(config["initial_position"]);
+        if (config.contains("initial_velocity")) state.velocity_truth_mps = toVector(config["initial_velocity"]);
+
+        publish(state);
+        LOG_COMPONENT_INFO("Static pipeline dynamics initialized, mass {} kg",
+                           pipeline_.stage<static_stages::PointMassDynamicsStage>().mass_kg);
+    }
+
+protected:
+    void publish(const PointMassPipeline::State& state) override {
+        setState("position_truth_m", state.position_truth_m);
+        setState("velocity_truth_mps", state.velocity_truth_mps);
+        setState("attitude_truth_quat", state.attitude_truth_quat);
+        setState("air_density_kg_m3", state.air_density_kg_m3);
+        setState("aero_force_truth_N", state.aero_force_truth_N);
+        LOG_COMPONENT_TRACE("Static pipeline step, position X: {}", state.position_truth_m[0]);
+    }
+
+private:
+    static Vector3d toVector(const nlohmann::json& value) {
+        return Vector3d(value.at(0).get<double>(), value.at(1).get<double>(), value.at(2).get<double>());
+    }
+};
+
+static gnc::ComponentRegistrar<StaticPipelineDynamics> static_pipeline_dynamics_registrar("StaticPipelineDynamics");
+
+}
@@ -1,7 +1,8 @@
 #pragma once
 #include "../../core/component_base.hpp"
 #include "../../core/component_registrar.hpp"
-#include <vector> // 仅作类型示例
+#include <memory_resource>
+#include <span>
 #include "../utility/simple_logger.hpp"
 
 namespace gnc::components {
@@ -22,22 +23,65 @@ public:
     std::string getComponentType() const override {
         return "SimpleAerodynamics";
     }
+
+    void initialize() override {
+        // 输入每帧都读，初始化时绑定一次句柄
+        density_ = getStateHandle<double>({ {getVehicleId(), "Atmosphere"}, "air_density_kg_m3" });
+        drag_factor_ = getStateHandle<double>("Disturbance.drag_factor");
+        // Dynamics 依赖本组件的气动力，速度只能按上一帧读取，不声明依赖
+        velocity_ = &previousFrameState<Vector3d>({ {getVehicleId(), "Dynamics"}, "velocity_truth_mps" });
+    }
+
+    /**
+     * @brief 批量更新多个飞行器的气动力
+     * @details 先经各实例初始化时绑定的句柄集中读取输入，再在无虚调用、无状态查找的紧凑循环中
+     * 计算阻力，最后统一写回；结果与逐个调用 updateImpl() 一致。中间数组使用本帧临时内存
+     */
+    static void updateBatch(std::span<SimpleAerodynamics*> batch) {
+        const size_t n = batch.size();
+        std::pmr::memory_resource* memory = FrameMemory::resource();
+        std::pmr::vector<double> density(n, memory), speed_sq(n, memory), drag_factor(n, memory), drag(n, memory);
+        for (size_t i = 0; i < n; ++i) {
+            const auto* self = batch[i];
+            density[i] = self->density_.get();
+            const Vector3d& velocity = *self->velocity_;
+            speed_sq[i] = velocity[0]*velocity[0] + velocity[1]*velocity[1] + velocity[2]*velocity[2];
+            drag_factor[i] = self->drag_factor_.get();
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            drag[i] = -0.5 * density[i] * speed_sq[i] * CDA * drag_factor[i];
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            batch[i]->setState("aero_force_truth_N", Vector3d(drag[i], 0.0, 0.0));
+        }
+        LOG_DEBUG("[Aerodynamics] Batch-updated aero force for {} vehicles", n);
+    }
+
 protected:
     void updateImpl() override {
-        auto density = getState<double>({ {getVehicleId(), "Atmosphere"}, "air_density_kg_m3" });
-        auto velocity = getState<Vector3d>({ {getVehicleId(), "Dynamics"}, "velocity_truth_mps" });
+        double density = density_.get();
+        const Vector3d& velocity = *velocity_;
         
         // 伪实现：简单阻力模型
         double speed_sq = velocity[0]*velocity[0] + velocity[1]*velocity[1] + velocity[2]*velocity[2];
-        double drag = -0.5 * density * speed_sq * 0.1 /*CdA*/;
-        LOG_COMPONENT_TRACE("Drag: {}, Drag factor: {}", drag, get<double>("Disturbance.drag_factor"));
-        drag *= get<double>("Disturbance.drag_factor");
+        double drag = -0.5 * density * speed_sq * CDA;
+        LOG_COMPONENT_TRACE("Drag: {}, Drag factor: {}", drag, drag_factor_.get());
+        drag *= drag_factor_.get();
         LOG_COMPONENT_TRACE("Drag after factor: {}", drag);
-        std::vector<double> force = {drag, 0.0, 0.0}; // 假设沿X轴负方向
+        Vector3d force(drag, 0.0, 0.0); // 假设沿X轴负方向
         
         setState("aero_force_truth_N", force);
         LOG_COMPONENT_DEBUG("Calculated aero force (truth): {}", force[0]);
     }
+
+private:
+    static constexpr double CDA = 0.1;  ///< 阻力系数与参考面积之积
+
+    StateHandle<double> density_;
+    const Vector3d* velocity_ = nullptr;  ///< Dynamics 速度的上一帧快照
+    StateHandle<double> drag_factor_;
 };
 
 static gnc::ComponentRegistrar<SimpleAerodynamics> simple_aerodynamics_registrar("SimpleAerodynamics");
@@ -11,6 +11,8 @@ public:
     SimpleAtmosphere(states::VehicleId id, const std::string& instanceName = "") 
         : states::ComponentBase(id, "Atmosphere", instanceName) {
         declareOutput<double>("air_density_kg_m3");
+        // 输出为常量，执行一次后即可跳过
+        setSkipIfInputsUnchanged(true);
     }
 
     std::string getComponentType() const override {
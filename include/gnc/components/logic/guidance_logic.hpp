@@ -15,6 +15,8 @@ public:
         // 简化的组件级依赖声明
         declareInput<void>(ComponentId{id, "Navigation"});
         declareOutput<double>("desired_throttle_level"); // 输出一个油门指令
+        // 输出只取决于导航输入，导航未变化时跳过
+        setSkipIfInputsUnchanged(true);
     }
 
     std::string getComponentType() const override {
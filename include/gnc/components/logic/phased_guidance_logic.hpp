@@ -47,7 +47,7 @@ public:
         declareOutput<int>("phase_id");                     // 当前制导阶段ID
         declareOutput<bool>("phase_changed");               // 制导阶段是否变化
         declareOutput<double>("time_in_phase");             // 在当前阶段的时间
-        declareOutput<std::vector<double>>("guidance_command"); // 导引量输出
+        declareOutput<Vector3d>("guidance_command"); // 导引量输出
         declareOutput<double>("desired_throttle_level");    // 油门指令
         
         // 注意：不在构造函数中初始化FlowController，而是在initialize()中进行
@@ -122,7 +122,7 @@ protected:
         double time_in_phase = flow_controller_->getTimeInState();
         
         // 根据当前阶段计算制导律
-        std::vector<double> guidance_command = calculateGuidanceCommand(current_phase);
+        Vector3d guidance_command = calculateGuidanceCommand(current_phase);
         double throttle_command = calculateThrottleCommand(current_phase);
         
         // 更新输出状态
@@ -190,10 +190,10 @@ private:
      * @brief 计算制导指令
      * 
      * @param phase 当前制导阶段
-     * @return std::vector<double> 制导指令 [x, y, z]
+     * @return Vector3d 制导指令 [x, y, z]
      */
-    std::vector<double> calculateGuidanceCommand(const std::string& phase) {
-        std::vector<double> command(3, 0.0);
+    Vector3d calculateGuidanceCommand(const std::string& phase) {
+        Vector3d command = Vector3d::Zero();
         
         if (phase == "initial") {
             // 初始制导阶段：使用保守的制导参数
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../../core/coroutine_behavior.hpp"
+#include "../../core/component_registrar.hpp"
+#include "../utility/config_manager.hpp"
+#include "../utility/simple_logger.hpp"
+#include "math/math.hpp"
+#include <algorithm>
+#include <string>
+
+namespace gnc::components {
+
+/**
+ * @brief 协程实现的分离/展开时序逻辑
+ *
+ * @details 时序：等待 arm_delay_s 秒 → 解锁 → 等待航程超过 deploy_range_m →
+ * 展开 → 等待 deploy_duration_s 秒 → 完成。
+ * 与 FlowController 状态图或周期计数器相比，逻辑按顺序书写；等待期间协程挂起，
+ * 只有到期时才被恢复。
+ *
+ * 配置示例（logic.yaml）：
+ * @code
+ * sequenced_deployment:
+ *   arm_delay_s: 2.0
+ *   deploy_range_m: 500.0
+ *   deploy_duration_s: 1.0
+ * @endcode
+ */
+class SequencedDeploymentLogic : public coroutine::SequencedComponent {
+public:
+    SequencedDeploymentLogic(states::VehicleId id, const std::string& instanceName = "")
+        : coroutine::SequencedComponent(id, "Deployment", instanceName) {
+        declareInput<void>(ComponentId{id, "Dynamics"});
+
+        declareOutput<std::string>("sequence_step", std::string("idle"));
+        declareOutput<bool>("armed", false);
+        declareOutput<bool>("deployed", false);
+        declareOutput<double>("deploy_fraction", 0.0);
+    }
+
+    std::string getComponentType() const override {
+        return "SequencedDeploymentLogic";
+    }
+
+    void initialize() override {
+        using namespace gnc::components::utility;
+        auto config = ConfigManager::getInstance().getComponentConfig(ConfigFileType::LOGIC, "sequenced_deployment");
+        if (config.empty()) {
+            LOG_COMPONENT_WARN("Config 'logic.sequenced_deployment' not found. Using defaults.");
+        }
+        arm_delay_s_ = config.value("arm_delay_s", 2.0);
+        deploy_range_m_ = config.value("deploy_range_m", 500.0);
+        deploy_duration_s_ = config.value("deploy_duration_s", 1.0);
+    }
+
+protected:
+    coroutine::Task behavior() override {
+        setState("sequence_step", std::string("waiting_to_arm"));
+        co_await sleep(arm_delay_s_);
+
+        setState("armed", true);
+        setState("sequence_step", std::string("armed"));
+        LOG_COMPONENT_INFO("Armed at t = {:.2f}s", now());
+
+        co_await until([this]() { return range() > deploy_range_m_; });
+
+        deploy_start_s_ = now();
+        setState("deployed", true);
+        setState("sequence_step", std::string("deploying"));
+        LOG_COMPONENT_INFO("Deploying at t = {:.2f}s, range {:.1f} m", now(), range());
+
+        co_await sleep(deploy_duration_s_);
+
+        setState("sequence_step", std::string("complete"));
+        LOG_COMPONENT_INFO("Deployment complete at t = {:.2f}s", now());
+    }
+
+    void onUpdate() override {
+        // 展开过程中输出连续的展开比例
+        if (deploy_start_s_ < 0.0) {
+            return;
+        }
+        double fraction = deploy_duration_s_ > 0.0 ? (now() - deploy_start_s_) / deploy_duration_s_ : 1.0;
+        setState("deploy_fraction", std::clamp(fraction, 0.0, 1.0));
+    }
+
+private:
+    double range() {
+        return getState<Vector3d>({{getVehicleId(), "Dynamics"}, "position_truth_m"}).norm();
+    }
+
+    double arm_delay_s_ = 2.0;
+    double deploy_range_m_ = 500.0;
+    double deploy_duration_s_ = 1.0;
+    double deploy_start_s_ = -1.0;
+};
+
+static gnc::ComponentRegistrar<SequencedDeploymentLogic> sequenced_deployment_logic_registrar("SequencedDeploymentLogic");
+
+}
@@ -30,8 +30,8 @@ public:
         declareInput<void>(ComponentId{id, "TargetTracker"});
         
         // 声明输出
-        declareOutput<std::vector<double>>("guidance_command_inertial");
-        declareOutput<std::vector<double>>("guidance_command_body");
+        declareOutput<Vector3d>("guidance_command_inertial");
+        declareOutput<Vector3d>("guidance_command_body");
         declareOutput<double>("range_to_target");
     }
 
@@ -54,7 +54,7 @@ protected:
         auto vel_body = TRANSFORM_VEC(vel_inertial, "INERTIAL", "BODY");
         
         // 2. 在载体系中进行制导计算
-        std::vector<double> cmd_body = computeBodyGuidanceCommand(pos_body, vel_body);
+        Vector3d cmd_body = computeBodyGuidanceCommand(pos_body, vel_body);
         
         // 3. 一行代码转回惯性系
         auto cmd_inertial = TRANSFORM_VEC(cmd_body, "BODY", "INERTIAL");
@@ -95,8 +95,8 @@ private:
     /**
      * @brief 在载体系中计算制导指令
      */
-    std::vector<double> computeBodyGuidanceCommand(const Vector3d& pos_body,
-                                                   const Vector3d& vel_body) {
+    Vector3d computeBodyGuidanceCommand(const Vector3d& pos_body,
+                                        const Vector3d& vel_body) {
         // 简单的比例导引示例
         // 在载体系中，目标通常在前方（正X方向）
         Vector3d desired_vel_body = {100.0, 0.0, 0.0}; // 期望速度
@@ -110,7 +110,7 @@ private:
         
         // 简单的P控制
         const double kp = 0.5;
-        std::vector<double> cmd_body = {
+        Vector3d cmd_body = {
             kp * vel_error[0],
             kp * vel_error[1],
             kp * vel_error[2]
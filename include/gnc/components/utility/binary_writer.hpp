@@ -0,0 +1,69 @@
+/**
+ * @file binary_writer.hpp
+ * @brief Binary file writer implementation for DataLogger
+ */
+
+#pragma once
+
+#include "data_logger.hpp"
+#include <cstdint>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+/**
+ * @brief Binary file writer implementation
+ *
+ * @details Fixed-width rows of native doubles behind a JSON header, so that a
+ * recording can be loaded (or a single row located) without parsing text:
+ *
+ *   magic "GNCLOG1\n" | uint64 header size | header JSON | rows
+ *
+ * The header holds one entry per column (vehicle, component, flattened name,
+ * original state, type and element index, see ColumnInfo) plus the metadata.
+ * Each row is the time followed by one double per column. The header JSON is
+ * padded with spaces so that the rows start 8-byte aligned.
+ */
+class BinaryWriter : public FileWriter {
+public:
+    static constexpr char MAGIC[8] = {'G', 'N', 'C', 'L', 'O', 'G', '1', '\n'};
+    static constexpr const char* EXTENSION = ".gnclog";
+
+    BinaryWriter() = default;
+    ~BinaryWriter() override = default;
+
+    void describeColumns(const std::vector<ColumnInfo>& columns) override;
+
+    void initialize(const std::string& file_path,
+                    const std::vector<gnc::states::StateId>& states,
+                    bool include_metadata,
+                    const nlohmann::json& metadata_json = nlohmann::json()) override;
+
+    /**
+     * @brief Append one row; non-numeric values are stored as NaN
+     */
+    void writeDataPoint(double time, const std::vector<std::any>& values) override;
+
+    void finalize() override;
+
+    /**
+     * @brief Path of the file actually written (with timestamp suffix)
+     */
+    const std::string& filePath() const { return file_path_; }
+
+private:
+    std::ofstream file_stream_;
+    std::string file_path_;
+    std::vector<ColumnInfo> columns_;
+    size_t column_count_ = 0;
+    std::vector<double> row_;
+    uint64_t rows_written_ = 0;
+    bool initialized_ = false;
+};
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
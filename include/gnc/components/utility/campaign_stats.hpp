@@ -0,0 +1,194 @@
+/**
+ * @file campaign_stats.hpp
+ * @brief Campaign-level aggregation of per-run summary records
+ *
+ * A Monte Carlo campaign produces one summary record per run (DataLogger
+ * "summary" format, see summary_writer.hpp). CampaignAggregator folds these in
+ * as runs finish, so that the campaign statistics are current after every run
+ * without re-reading earlier ones. For every state and every reduction of the
+ * record (min, max, final, rms, time_above, ...) it keeps
+ *
+ *   - RunningStats: count, mean and variance (Welford), min and max
+ *   - TDigest: a mergeable quantile sketch of bounded size
+ *
+ * and writes count/mean/std/min/max, the configured quantiles and a histogram
+ * estimated from the sketch. Both structures merge exactly (RunningStats) or
+ * within sketch accuracy (TDigest), so partial campaigns written by separate
+ * collectors can be combined, and a collector can resume from its own output.
+ *
+ * addRun() is thread-safe for in-process campaigns that run simulations on
+ * several threads; forked campaigns use the gnc_campaign collector, which
+ * watches the run output directory.
+ */
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+/**
+ * @brief Count, mean, variance, min and max in one pass
+ */
+class RunningStats {
+public:
+    void add(double value);
+
+    /**
+     * @brief Combine with the statistics of another sample (Chan et al.)
+     */
+    void merge(const RunningStats& other);
+
+    uint64_t count() const { return count_; }
+    double mean() const { return count_ > 0 ? mean_ : std::numeric_limits<double>::quiet_NaN(); }
+    double variance() const;    ///< Sample variance (n - 1)
+    double stddev() const;
+    double min() const { return count_ > 0 ? min_ : std::numeric_limits<double>::quiet_NaN(); }
+    double max() const { return count_ > 0 ? max_ : std::numeric_limits<double>::quiet_NaN(); }
+
+    nlohmann::json toJson() const;
+    static RunningStats fromJson(const nlohmann::json& json);
+
+private:
+    uint64_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief Merging t-digest quantile sketch
+ *
+ * @details Keeps at most about `compression` centroids whatever the number of
+ * samples, with the k1 scale function so that tails are resolved more finely
+ * than the median. Extreme quantiles are bounded by the exact min and max.
+ */
+class TDigest {
+public:
+    struct Centroid {
+        double mean = 0.0;
+        double weight = 0.0;
+    };
+
+    explicit TDigest(double compression = 100.0) : compression_(compression) {}
+
+    void add(double value, double weight = 1.0);
+    void merge(const TDigest& other);
+
+    /**
+     * @brief Estimated value at quantile q in [0, 1] (NaN when empty)
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief Estimated fraction of samples <= value
+     */
+    double cdf(double value) const;
+
+    double totalWeight() const;
+    double compression() const { return compression_; }
+    const std::vector<Centroid>& centroids() const;
+
+    nlohmann::json toJson() const;
+    static TDigest fromJson(const nlohmann::json& json);
+
+private:
+    void compress() const;
+
+    double compression_;
+    mutable std::vector<Centroid> centroids_;   ///< Sorted by mean once compressed
+    mutable std::vector<Centroid> buffer_;      ///< Unmerged samples
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+};
+
+struct CampaignOptions {
+    std::vector<double> quantiles = {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99};
+    size_t histogram_bins = 20;
+    double compression = 100.0;
+    bool include_sketches = true;   ///< Store the t-digest centroids so the file can be merged or resumed
+
+    static CampaignOptions fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @brief Thread-safe aggregator of per-run summary records
+ */
+class CampaignAggregator {
+public:
+    explicit CampaignAggregator(CampaignOptions options = {}) : options_(std::move(options)) {}
+
+    CampaignAggregator(const CampaignAggregator&) = delete;
+    CampaignAggregator& operator=(const CampaignAggregator&) = delete;
+
+    /**
+     * @brief Fold in one run summary
+     * @param summary Record written by SummaryWriter
+     * @param source Run identifier (e.g. the summary file name); a run already seen is ignored
+     * @return false if the run was already aggregated
+     * @throws std::runtime_error if the record is not a run summary
+     */
+    bool addRun(const nlohmann::json& summary, const std::string& source);
+
+    /**
+     * @brief Combine with another aggregator, e.g. a partial campaign from another collector
+     * @details Aggregated statistics cannot be split per run, so the two
+     * aggregators must cover disjoint runs; nothing is merged otherwise.
+     * @throws std::runtime_error if a run was aggregated by both
+     */
+    void merge(const CampaignAggregator& other);
+
+    bool contains(const std::string& source) const;
+    size_t runs() const;
+
+    /**
+     * @brief Campaign statistics record
+     */
+    nlohmann::json toJson() const;
+
+    /**
+     * @brief Fold in a campaign record written with include_sketches
+     * @details Used to resume a collector from its own output or to combine
+     * partial campaigns. The record must cover runs not yet aggregated here;
+     * nothing is loaded otherwise.
+     * @throws std::runtime_error if the record has no sketches or shares a run
+     */
+    void load(const nlohmann::json& record);
+
+    /**
+     * @brief Write toJson() to a file, atomically replacing the previous version
+     */
+    void write(const std::string& path) const;
+
+    /**
+     * @brief Whether a JSON record is a run summary written by SummaryWriter
+     */
+    static bool isRunSummary(const nlohmann::json& json);
+
+private:
+    struct Field {
+        RunningStats stats;
+        TDigest digest;
+    };
+
+    Field& field(const std::string& state, const std::string& reduction);
+
+    CampaignOptions options_;
+    mutable std::mutex mutex_;
+    std::map<std::string, std::map<std::string, Field>> states_;   ///< state key -> reduction name -> statistics
+    std::set<std::string> sources_;
+};
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
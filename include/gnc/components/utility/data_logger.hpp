@@ -6,7 +6,8 @@
  * 
  * 1. Core Functionality
  *    - State Discovery: Automatically discover and select states based on regex patterns
- *    - Data Recording: Record selected states to HDF5 or CSV files
+ *    - Data Recording: Record selected states to HDF5, CSV or binary files
+ *    - Streaming Reductions: Or keep only per-state statistics ("summary" format)
  *    - Metadata Integration: Include Git hash, configuration snapshots, and timestamps
  *    - Flexible Configuration: Configure through YAML files
  * 
@@ -33,6 +34,7 @@
 #include "../../core/component_base.hpp"
 #include "../../common/types.hpp"
 #include "gnc/core/component_registrar.hpp"
+#include "gnc/core/metrics.hpp"
 #include <string>
 #include <vector>
 #include <memory>
@@ -44,11 +46,24 @@ namespace gnc {
 namespace components {
 namespace utility {
 
+/**
+ * @brief Origin of one recorded column
+ *
+ * @details Vector and quaternion states are flattened into one column per element;
+ * this records which state and element a column came from so that readers can
+ * rebuild the original values (see log_reader.hpp).
+ */
+struct ColumnInfo {
+    gnc::states::StateId source;          ///< Original state (empty name for non-state columns)
+    std::string type_name;                ///< RTTI name of the original state type
+    int component_index = 0;              ///< Element index within the original state
+};
+
 /**
  * @brief Abstract interface for file writers
  * 
  * @details FileWriter provides a common interface for different output formats.
- * This allows the DataLogger to support multiple file formats (HDF5, CSV) 
+ * This allows the DataLogger to support multiple file formats (HDF5, CSV, binary) 
  * through a unified interface using the Strategy pattern.
  */
 class FileWriter {
@@ -86,11 +101,23 @@ public:
      * @throws std::runtime_error if finalization fails
      */
     virtual void finalize() = 0;
+
+    /**
+     * @brief Describe where each column comes from, called before initialize()
+     * @details Optional; formats that cannot store the information ignore it.
+     */
+    virtual void describeColumns(const std::vector<ColumnInfo>& columns) { (void)columns; }
+
+    /**
+     * @brief Apply format-specific options, called before initialize()
+     * @param options The DataLogger configuration section named after the format (may be null)
+     */
+    virtual void configure(const nlohmann::json& options) { (void)options; }
 };
 
 /**
  * @brief Factory function to create appropriate file writer based on format
- * @param format Output format ("hdf5" or "csv")
+ * @param format Output format ("hdf5", "csv", "binary" or "summary")
  * @return Unique pointer to the created file writer
  * @throws std::invalid_argument if format is not supported
  */
@@ -143,9 +170,12 @@ public:
         , file_path_("logs/datalogger_output.h5")
         , log_frequency_hz_(0.0)
         , log_metadata_(true)
+        , log_vehicle_activity_(true)
         , last_log_time_(0.0)
         , initialized_(false)
     {
+        // Opening the output file and collecting git metadata only touch this component
+        setIndependentInitialization(true);
         LOG_COMPONENT_DEBUG("DataLogger created with instance name: {}", instanceName);
     }
     /**
@@ -207,10 +237,12 @@ protected:
 
 private:
     // Configuration parameters (loaded from utility.yaml)
-    std::string output_format_;        ///< Output format: "hdf5" or "csv"
+    std::string output_format_;        ///< Output format: "hdf5", "csv", "binary" or "summary"
+    nlohmann::json writer_options_;    ///< Configuration section named after the format
     std::string file_path_;           ///< Output file path
     double log_frequency_hz_;         ///< Logging frequency in Hz (0 = every step)
     bool log_metadata_;               ///< Whether to include metadata
+    bool log_vehicle_activity_;       ///< Whether to record a per-vehicle "active" column
 
     // Configuration selectors
     std::vector<StateSelector> selectors_;  ///< State selection rules from configuration
@@ -221,6 +253,11 @@ private:
     double last_log_time_;            ///< Last time data was logged
     bool initialized_;                ///< Whether component has been initialized
 
+    // Writer throughput metrics, registered once the file writer exists
+    gnc::MetricsCounter* rows_written_ = nullptr;
+    gnc::MetricsCounter* values_written_ = nullptr;
+    gnc::MetricsHistogram* write_time_ = nullptr;
+
     /**
      * @brief Structure to hold flattened state information
      */
@@ -229,10 +266,26 @@ private:
         std::string flattened_name;              ///< Flattened name (e.g., "position_x", "attitude_w")
         std::string type_name;                   ///< Type name from RTTI
         int component_index;                     ///< Index within the original state (0 for scalars)
+        size_t vehicle_slot = NO_VEHICLE_SLOT;   ///< Index into logged_vehicles_ (NO_VEHICLE_SLOT for the global vehicle)
     };
 
+    static constexpr size_t NO_VEHICLE_SLOT = static_cast<size_t>(-1);
+
     std::vector<FlattenedState> flattened_states_;     ///< List of flattened states for logging
 
+    /**
+     * @brief Vehicles owning logged states, excluding the global vehicle
+     * @details Sleeping vehicles are logged as NaN plus an "active" flag column
+     * instead of repeating their frozen values.
+     */
+    std::vector<gnc::states::VehicleId> logged_vehicles_;
+    std::vector<char> vehicle_active_;                 ///< Per-frame activity buffer, indexed like logged_vehicles_
+
+    /**
+     * @brief Collect the vehicles owning logged states and assign vehicle slots
+     */
+    void assignVehicleSlots();
+
     /**
      * @brief Load configuration from utility.yaml
      * @throws std::runtime_error if configuration is invalid
@@ -36,6 +36,7 @@
 #include "gnc/common/types.hpp"
 #include "config_manager.hpp"
 #include "gnc/core/component_registrar.hpp"
+#include "math/math.hpp"
 #include <map>
 #include <vector>
 #include <fstream>
@@ -167,6 +168,9 @@ private:
     
     // 动态参数的上次更新值（用于检测变化）
     std::map<std::string, std::any> last_dynamic_values_;
+
+    // Dynamics 位置的上一帧快照，高度取其 Z 分量；Dynamics 经 Aerodynamics 依赖本组件，不能声明依赖
+    const Vector3d* position_{nullptr};
 };
 
 // 注册组件到工厂
@@ -308,6 +308,22 @@ public:
         return *this;
     }
 
+    /**
+     * @brief 将状态与飞行器活动状态绑定
+     * 
+     * @param state 状态名称
+     * @param active 进入该状态时飞行器是否活动（false表示进入后整机休眠）
+     * @return FlowController& 流程控制器引用（链式调用）
+     * 
+     * @details 例如将 "landed" 绑定为 false，进入着陆阶段后该飞行器的全部组件
+     * 都会被调度器跳过；未绑定的状态不改变飞行器的活动状态。
+     * 注意：休眠后本控制器也不再更新，需要通过唤醒条件重新激活飞行器。
+     */
+    FlowController& bindVehicleActivity(const StateType& state, bool active) {
+        activity_bindings_[state] = active;
+        return *this;
+    }
+
     /**
      * @brief 强制切换到指定状态
      * 
@@ -343,6 +359,7 @@ public:
         if (states_[current_state_].entry_action) {
             states_[current_state_].entry_action();
         }
+        applyVehicleActivity();
         
         LOG_COMPONENT_INFO("Forced state transition: {} -> {}", previous_state_.c_str(), current_state_.c_str());
         return true;
@@ -389,6 +406,7 @@ public:
                 if (states_[current_state_].entry_action) {
                     states_[current_state_].entry_action();
                 }
+                applyVehicleActivity();
                 
                 LOG_COMPONENT_INFO("Event triggered state transition: {} -> {} (Event: {})", 
                           previous_state_.c_str(), current_state_.c_str(), event_name.c_str());
@@ -482,6 +500,7 @@ public:
             states_[initial_state_].entry_action) {
             states_[initial_state_].entry_action();
         }
+        applyVehicleActivity();
         
         LOG_COMPONENT_INFO("Flow controller reset to initial state: {}", initial_state_.c_str());
     }
@@ -625,6 +644,7 @@ protected:
         if (states_[initial_state_].entry_action) {
             states_[initial_state_].entry_action();
         }
+        applyVehicleActivity();
         
         LOG_COMPONENT_INFO("Flow controller initialized with state: {}", initial_state_.c_str());
         
@@ -679,11 +699,23 @@ private:
         if (states_.find(current_state_) != states_.end() && states_[current_state_].entry_action) {
             states_[current_state_].entry_action();
         }
+        applyVehicleActivity();
         
         LOG_COMPONENT_INFO("State transition: {} -> {} ({})", 
                   previous_state_.c_str(), current_state_.c_str(), desc.c_str());
     }
     
+    /**
+     * @brief 按当前状态的绑定设置飞行器活动状态
+     */
+    void applyVehicleActivity() {
+        auto it = activity_bindings_.find(current_state_);
+        states::IStateAccess* access = stateAccess_ ? stateAccess_ : getStateAccess();
+        if (it != activity_bindings_.end() && access) {
+            access->setVehicleActive(getVehicleId(), it->second);
+        }
+    }
+
     /**
      * @brief 验证状态和转换的有效性
      */
@@ -743,6 +775,9 @@ private:
     // 最后的转换原因
     std::string last_transition_reason_;
     
+    // 状态与飞行器活动状态的绑定：state -> active
+    std::unordered_map<StateType, bool> activity_bindings_;
+    
     states::IStateAccess* stateAccess_{nullptr};  ///< 状态访问接口（从父组件传入）
 };
 
@@ -0,0 +1,154 @@
+/**
+ * @file log_analysis.hpp
+ * @brief Parallel post-processing of many DataLogger recordings
+ *
+ * A RunSet opens the recordings of a campaign (binary logs memory-mapped and
+ * read in place, CSV and HDF5 logs loaded) and evaluates column expressions
+ * over them:
+ *
+ *   - reduce(): one scalar per run and reduction, e.g. the miss distance
+ *     `min:norm(Dynamics.position_truth_m_x, Dynamics.position_truth_m_y)`
+ *   - series(): an expression on a common time grid, one row per run, from
+ *     which percentileBands() computes envelopes and percentile bands
+ *
+ * Expressions use + - * / ^, parentheses, numbers, `t` (time) and the
+ * functions abs sqrt exp log sin cos tan asin acos atan atan2 hypot min max
+ * norm (Euclidean norm of its arguments) deg rad. Columns are referred to by
+ * flattened name, with or without the "<vehicle>." prefix when that is
+ * unambiguous; names that are not identifiers go in brackets, e.g.
+ * `[2.Dynamics.position_truth_m_x]`. Named expressions added with define()
+ * can be used in later expressions.
+ *
+ * Work is split into (run, row chunk) tasks on a TaskPool. Each task gathers
+ * its columns into contiguous chunk buffers and evaluates the expression one
+ * operation at a time over the chunk, so the inner loops are simple array
+ * loops the compiler vectorizes. Results are contiguous row-major matrices.
+ */
+
+#pragma once
+
+#include "log_reader.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+/**
+ * @brief Dense row-major matrix of doubles
+ */
+struct Matrix {
+    size_t rows = 0;
+    size_t cols = 0;
+    std::vector<double> data;
+
+    Matrix() = default;
+    Matrix(size_t row_count, size_t col_count, double fill = 0.0)
+        : rows(row_count), cols(col_count), data(row_count * col_count, fill) {}
+
+    double& operator()(size_t row, size_t col) { return data[row * cols + col]; }
+    double operator()(size_t row, size_t col) const { return data[row * cols + col]; }
+    const double* row(size_t index) const { return data.data() + index * cols; }
+};
+
+enum class ReductionOp { Min, Max, Mean, Rms, Std, First, Final, TimeOfMin, TimeOfMax };
+
+/**
+ * @brief Per-run scalar: a reduction over time of an expression
+ */
+struct ReductionSpec {
+    std::string name;
+    ReductionOp op = ReductionOp::Final;
+    std::string expression;
+
+    /**
+     * @brief Parse "NAME=OP:EXPR", e.g. "miss=min:norm(dx, dy, dz)"
+     * @throws std::invalid_argument on malformed specs or unknown operations
+     */
+    static ReductionSpec parse(const std::string& text);
+};
+
+struct AnalysisOptions {
+    size_t threads = 0;                 ///< 0: hardware concurrency
+    size_t chunk_rows = 1 << 15;        ///< Rows per evaluation chunk (and at least per task)
+};
+
+/**
+ * @brief Expression values of every run on a common time grid
+ */
+struct SeriesResult {
+    std::vector<double> times;          ///< Grid: the time column of the first run
+    Matrix values;                      ///< runs x times; NaN outside a run's time span
+};
+
+/**
+ * @brief Statistics of the last reduce() or series() call
+ */
+struct AnalysisStats {
+    uint64_t rows = 0;
+    uint64_t bytes = 0;                 ///< Column data read
+    double elapsed_s = 0.0;
+};
+
+class Expression;
+
+class RunSet {
+public:
+    /**
+     * @brief Open recordings in parallel
+     * @throws std::runtime_error if a file cannot be read
+     */
+    static RunSet open(const std::vector<std::string>& paths, size_t threads = 0);
+
+    RunSet();
+    ~RunSet();
+    RunSet(RunSet&&) noexcept;
+    RunSet& operator=(RunSet&&) noexcept;
+
+    size_t size() const { return runs_.size(); }
+    const std::string& path(size_t run) const { return paths_[run]; }
+    const LogView& run(size_t index) const { return *runs_[index]; }
+
+    /**
+     * @brief Name an expression for use in later expressions
+     * @throws std::invalid_argument if the expression does not parse
+     */
+    void define(const std::string& name, const std::string& expression);
+
+    /**
+     * @brief One row per run, one column per spec
+     * @throws std::invalid_argument on parse errors, std::runtime_error if a run lacks a column
+     */
+    Matrix reduce(const std::vector<ReductionSpec>& specs, const AnalysisOptions& options = {});
+
+    /**
+     * @brief Evaluate an expression for every run on the time grid of the first run
+     * @details Runs recorded on other grids are linearly interpolated.
+     */
+    SeriesResult series(const std::string& expression, const AnalysisOptions& options = {});
+
+    const AnalysisStats& lastStats() const { return stats_; }
+
+private:
+    std::shared_ptr<const Expression> parse(const std::string& expression) const;
+
+    std::vector<std::string> paths_;
+    std::vector<std::unique_ptr<LogView>> runs_;
+    std::map<std::string, std::shared_ptr<const Expression>> definitions_;
+    AnalysisStats stats_;
+};
+
+/**
+ * @brief Percentiles across runs at every grid time, ignoring NaN
+ * @param percentiles In [0, 100]; 0 and 100 give the envelope
+ * @return percentiles x times
+ */
+Matrix percentileBands(const SeriesResult& series, const std::vector<double>& percentiles, size_t threads = 0);
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
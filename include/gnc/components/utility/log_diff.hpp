@@ -0,0 +1,104 @@
+/**
+ * @file log_diff.hpp
+ * @brief Run-to-run comparison of DataLogger recordings
+ *
+ * Columns of the two logs are matched by flattened name (prefixed with the
+ * vehicle id when both logs record it) and rows by time. Two values match when
+ *
+ *   |a - b| <= abs + rel * max(|a|, |b|)
+ *
+ * with per-column tolerances (the first override whose regex matches the column
+ * name, otherwise the defaults). Non-finite values are compared exactly: inf
+ * matches only the same-signed inf and NaN matches only NaN.
+ *
+ * Binary logs are memory-mapped and scanned row by row in a single pass, split
+ * across threads; when both logs have the same column layout the inner loop is
+ * a contiguous, branch-free scan the compiler vectorizes. Per-row bookkeeping
+ * (mismatch counts, first divergence) only runs for rows that contain a
+ * mismatch. CSV and HDF5 logs are loaded through RecordedLog.
+ */
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+/**
+ * @brief Tolerance for the columns whose name matches a regex
+ */
+struct DiffTolerance {
+    std::string pattern;    ///< ECMAScript regex searched in the column name
+    double abs = 0.0;
+    double rel = 0.0;
+};
+
+struct DiffOptions {
+    double abs_tolerance = 1e-9;
+    double rel_tolerance = 0.0;
+    std::vector<DiffTolerance> overrides;
+    double time_tolerance = 1e-9;       ///< Rows are aligned when their times differ by at most this
+    std::string include;                ///< Only compare columns matching this regex (empty: all)
+    bool allow_missing = false;         ///< Columns or rows present in only one log do not fail the diff
+    size_t threads = 0;                 ///< 0: hardware concurrency
+
+    static DiffOptions fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @brief Comparison result for one column
+ */
+struct ColumnDiff {
+    std::string name;
+    double abs_tolerance = 0.0;
+    double rel_tolerance = 0.0;
+    uint64_t mismatches = 0;
+    double max_abs_error = 0.0;
+    uint64_t first_divergence_row = std::numeric_limits<uint64_t>::max();  ///< Row in the first log
+    double first_divergence_time = 0.0;
+
+    bool diverged() const { return mismatches > 0; }
+    nlohmann::json toJson() const;
+};
+
+struct DiffResult {
+    uint64_t rows_a = 0;
+    uint64_t rows_b = 0;
+    uint64_t compared_rows = 0;
+    uint64_t rows_only_a = 0;           ///< Rows whose time has no counterpart in the second log
+    uint64_t rows_only_b = 0;
+    std::vector<ColumnDiff> columns;    ///< Compared columns, in the order of the first log
+    std::vector<std::string> only_in_a;
+    std::vector<std::string> only_in_b;
+    bool allow_missing = false;
+    double elapsed_s = 0.0;
+    uint64_t bytes_scanned = 0;
+
+    bool structurallyEqual() const {
+        return only_in_a.empty() && only_in_b.empty() && rows_only_a == 0 && rows_only_b == 0;
+    }
+    bool passed() const;
+
+    /**
+     * @brief Column that diverged earliest, or nullptr
+     */
+    const ColumnDiff* firstDivergence() const;
+
+    nlohmann::json toJson() const;
+};
+
+/**
+ * @brief Compare two recordings
+ * @throws std::runtime_error if a log cannot be read or an option regex is invalid
+ */
+DiffResult diffLogs(const std::string& path_a, const std::string& path_b, const DiffOptions& options = {});
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
@@ -0,0 +1,148 @@
+/**
+ * @file log_reader.hpp
+ * @brief Readers for files written by DataLogger
+ */
+
+#pragma once
+
+#include "../../common/types.hpp"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+/**
+ * @brief One recorded column and the state element it came from
+ */
+struct LogColumn {
+    std::optional<gnc::states::VehicleId> vehicle;  ///< Unknown for HDF5 files and older CSV files
+    std::string component;
+    std::string name;                     ///< Flattened column name as written by DataLogger
+    std::string state;                    ///< Original state name; empty for non-state columns
+    std::string type_name;                ///< RTTI name of the original state type
+    int index = 0;                        ///< Element index within the original state
+};
+
+/**
+ * @brief A binary log (.gnclog) mapped into memory; rows are read in place
+ *
+ * @details Row r starts at row(r): the time followed by one value per column.
+ * Used where loading and transposing a whole recording would dominate, such as
+ * diffing multi-GB logs. Falls back to reading the file into memory where
+ * mapping is unavailable or the data section is not 8-byte aligned (logs
+ * written before BinaryWriter padded its header).
+ */
+class MappedBinaryLog {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be opened or is not a binary log
+     */
+    explicit MappedBinaryLog(const std::string& path);
+    ~MappedBinaryLog();
+
+    MappedBinaryLog(const MappedBinaryLog&) = delete;
+    MappedBinaryLog& operator=(const MappedBinaryLog&) = delete;
+
+    size_t rows() const { return rows_; }
+    size_t width() const { return columns_.size() + 1; }
+    const double* row(size_t index) const { return data_ + index * width(); }
+    const std::vector<LogColumn>& columns() const { return columns_; }
+    const nlohmann::json& metadata() const { return metadata_; }
+
+private:
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    std::vector<double> buffer_;
+    const double* data_ = nullptr;
+    size_t rows_ = 0;
+    std::vector<LogColumn> columns_;
+    nlohmann::json metadata_;
+};
+
+/**
+ * @brief A DataLogger recording loaded into memory (column-major)
+ *
+ * @details Binary logs (.gnclog) describe every column exactly. CSV and HDF5 logs
+ * only carry the flattened names (CSV files also list the vehicle of each column
+ * in a "# vehicles:" comment), so the original state and type are inferred
+ * from DataLogger's naming convention: "<state>_x/_y/_z" is a Vector3d,
+ * "<state>_w/_x/_y/_z" a Quaterniond and anything else a double.
+ */
+class RecordedLog {
+public:
+    /**
+     * @brief Load a log, choosing the reader from the file extension
+     * @throws std::runtime_error if the file cannot be read or the format is unsupported
+     */
+    static RecordedLog load(const std::string& path);
+
+    static RecordedLog loadBinary(const std::string& path);
+    static RecordedLog loadCsv(const std::string& path);
+    static RecordedLog loadHdf5(const std::string& path);
+
+    size_t rows() const { return times_.size(); }
+    const std::vector<double>& times() const { return times_; }
+    const std::vector<LogColumn>& columns() const { return columns_; }
+    const std::vector<double>& column(size_t index) const { return values_.at(index); }
+    double value(size_t row, size_t column) const { return values_[column][row]; }
+    const nlohmann::json& metadata() const { return metadata_; }
+
+    /**
+     * @brief Indices of the columns recorded for a state, ordered by element index
+     * @param vehicle Matches columns of this vehicle, or columns without vehicle information
+     */
+    std::vector<size_t> findState(gnc::states::VehicleId vehicle, const std::string& component,
+                                  const std::string& state) const;
+
+    /**
+     * @brief Names of the states recorded for a component, in column order
+     */
+    std::vector<std::string> statesOf(gnc::states::VehicleId vehicle, const std::string& component) const;
+
+private:
+    void addColumn(LogColumn column, const std::string& flattened_name);
+    void inferTypes();
+
+    std::vector<double> times_;
+    std::vector<LogColumn> columns_;
+    std::vector<std::vector<double>> values_;
+    nlohmann::json metadata_;
+};
+
+/**
+ * @brief Column pointers into a log, without copying binary logs
+ *
+ * @details Element r of column j is columns[j][r * stride]. Binary logs are
+ * memory-mapped and read in place (row-major, stride = row width); CSV and HDF5
+ * logs are loaded through RecordedLog (column-major, stride 1). Names are the
+ * flattened column names, prefixed with "<vehicle>." when every column records
+ * its vehicle.
+ */
+struct LogView {
+    std::unique_ptr<MappedBinaryLog> mapped;
+    std::unique_ptr<RecordedLog> loaded;
+    size_t rows = 0;
+    size_t stride = 1;
+    const double* times = nullptr;
+    std::vector<const double*> columns;
+    std::vector<std::string> names;
+    bool row_major = false;
+    bool vehicles = false;              ///< Names are prefixed with the vehicle id
+
+    double time(uint64_t row) const { return times[row * stride]; }
+
+    /**
+     * @brief Open a log, choosing the reader from the file extension
+     * @throws std::runtime_error if the file cannot be read or the format is unsupported
+     */
+    static LogView open(const std::string& path);
+};
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
@@ -43,6 +43,7 @@
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/async.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include "../../common/types.hpp"
@@ -131,6 +132,12 @@ public:
      */
     void flush();
 
+    /**
+     * @brief 异步日志队列中等待写出的消息数，未启用异步日志时为 0
+     * @details 可在任意线程调用
+     */
+    size_t queueDepth() const;
+
     /**
      * @brief 关闭日志系统
      */
@@ -159,6 +166,7 @@ private:
 private:
     std::shared_ptr<spdlog::logger> main_logger_;           ///< 主日志器
     std::unordered_map<std::string, std::shared_ptr<spdlog::logger>> component_loggers_; ///< 组件日志器映射
+    std::mutex component_loggers_mutex_;                    ///< 保护 component_loggers_
     std::vector<spdlog::sink_ptr> sinks_;                   ///< 日志输出目标
     LogLevel current_level_ = LogLevel::INFO;               ///< 当前日志级别
     bool initialized_ = false;                              ///< 是否已初始化
@@ -0,0 +1,120 @@
+/**
+ * @file summary_writer.hpp
+ * @brief Streaming reduction writer for DataLogger
+ */
+
+#pragma once
+
+#include "data_logger.hpp"
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+/**
+ * @brief Threshold for the columns whose key matches a regex
+ */
+struct SummaryThreshold {
+    std::string pattern;    ///< ECMAScript regex searched in the column key ("vehicle.flattened_name")
+    double above = 0.0;
+};
+
+/**
+ * @brief Writer that keeps per-column statistics instead of the time series
+ *
+ * @details Selected with `format: "summary"`. Every data point updates, per
+ * flattened column, the minimum and maximum (with their times), the final
+ * value, mean, RMS and, when a threshold applies, the time spent above it
+ * (sample-and-hold between data points). Nothing is written until finalize(),
+ * which emits a single JSON record (see campaign_stats.hpp for aggregating them):
+ *
+ *   { "kind": "run_summary", "version": 1, "rows": N, "start_time": t0, "end_time": t1,
+ *     "metadata": {...},
+ *     "states": { "1.Dynamics.position_x": { "min": ..., "max": ..., ... } } }
+ *
+ * NaN samples (e.g. sleeping vehicles) are skipped and interrupt the time
+ * above threshold. Options come from the `summary` section of the DataLogger
+ * configuration:
+ *
+ *   summary:
+ *     thresholds:
+ *       - pattern: "altitude"
+ *         above: 1000.0
+ */
+class SummaryWriter : public FileWriter {
+public:
+    static constexpr const char* EXTENSION = ".json";
+
+    SummaryWriter() = default;
+    ~SummaryWriter() override = default;
+
+    /**
+     * @brief Online reductions of one column
+     */
+    struct Reduction {
+        double min = std::numeric_limits<double>::infinity();
+        double time_of_min = std::numeric_limits<double>::quiet_NaN();
+        double max = -std::numeric_limits<double>::infinity();
+        double time_of_max = std::numeric_limits<double>::quiet_NaN();
+        double final = std::numeric_limits<double>::quiet_NaN();
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        uint64_t samples = 0;
+        double threshold = std::numeric_limits<double>::quiet_NaN();   ///< NaN: no threshold
+        double time_above = 0.0;
+        double last_time = 0.0;
+        bool above = false;
+
+        void add(double time, double value);
+        nlohmann::json toJson() const;
+    };
+
+    /**
+     * @brief Read the thresholds
+     * @throws std::runtime_error if a threshold pattern is not a valid regex
+     */
+    void configure(const nlohmann::json& options) override;
+
+    void initialize(const std::string& file_path,
+                    const std::vector<gnc::states::StateId>& states,
+                    bool include_metadata,
+                    const nlohmann::json& metadata_json = nlohmann::json()) override;
+
+    /**
+     * @brief Fold one row into the reductions; non-numeric values count as NaN
+     */
+    void writeDataPoint(double time, const std::vector<std::any>& values) override;
+
+    /**
+     * @brief Write the summary record
+     */
+    void finalize() override;
+
+    /**
+     * @brief Summary record as written by finalize()
+     */
+    nlohmann::json summary() const;
+
+    /**
+     * @brief Path of the file actually written (with timestamp suffix)
+     */
+    const std::string& filePath() const { return file_path_; }
+
+private:
+    std::vector<SummaryThreshold> thresholds_;
+    std::vector<std::string> keys_;
+    std::vector<Reduction> reductions_;
+    std::string file_path_;
+    nlohmann::json metadata_;
+    uint64_t rows_ = 0;
+    double start_time_ = std::numeric_limits<double>::quiet_NaN();
+    double end_time_ = std::numeric_limits<double>::quiet_NaN();
+    bool initialized_ = false;
+};
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
@@ -33,6 +33,7 @@
 #include "frame_identifier.hpp"
 #include "itransform_provider.hpp"
 #include "../../math/math.hpp"
+#include "../core/metrics.hpp"
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -246,8 +247,14 @@ public:
         auto cache_key = std::make_pair(from_frame, to_frame);
         auto it = transform_cache_.find(cache_key);
         if (it != transform_cache_.end()) {
+            if (MetricsRegistry::enabled()) [[unlikely]] {
+                cache_hits_.add();
+            }
             return it->second;
         }
+        if (MetricsRegistry::enabled()) [[unlikely]] {
+            cache_misses_.add();
+        }
 
         // 使用图论算法查找路径
         auto path = findTransformPath(from_frame, to_frame);
@@ -582,6 +589,12 @@ private:
                               PairHash> transform_cache_;
     mutable std::mutex cache_mutex_;
 
+    /// 缓存命中统计（所有注册表共用，命中率 = hits / (hits + misses)），仅在导出指标时计数
+    MetricsCounter& cache_hits_ = MetricsRegistry::getInstance().counter(
+        "gnc_transform_cache_hits_total", "Coordinate transform cache hits");
+    MetricsCounter& cache_misses_ = MetricsRegistry::getInstance().counter(
+        "gnc_transform_cache_misses_total", "Coordinate transform cache misses");
+
     /**
      * @brief 添加边到图中
      * 
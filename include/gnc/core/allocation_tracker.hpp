@@ -0,0 +1,100 @@
+/**
+ * @file allocation_tracker.hpp
+ * @brief 调试用全局堆分配计数与归属
+ *
+ * 以 -DGNC_TRACK_ALLOCATIONS=ON 构建时替换全局 operator new/delete，按线程统计
+ * 分配次数和字节数。StateManager 在组件更新期间通过 Scope 把分配记到当前组件名下，
+ * 据此报告稳定运行阶段（预热帧之后）每个组件仍在调用全局 new 的情况，并可在任一帧
+ * 发生分配时抛出 AllocationError，使测试失败。未开启时计数恒为 0，没有任何开销。
+ *
+ * 只统计 C++ 的 operator new；第三方库直接调用 malloc 的分配不在统计范围内。
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gnc {
+
+/**
+ * @brief 一个归属对象（组件或框架本身）的分配计数
+ * @details 第一次分配时可记录一份调用栈样本（原始地址，报告时再符号化，记录时不分配内存）
+ */
+struct AllocationCounters {
+    static constexpr int MAX_STACK_DEPTH = 24;
+
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    void* sample_stack[MAX_STACK_DEPTH] = {};
+    int sample_depth = 0;
+    std::size_t sample_size = 0;
+};
+
+/**
+ * @brief 稳定运行阶段的分配检查配置（core.yaml 中的 core.allocation_check）
+ */
+struct AllocationCheckConfig {
+    uint64_t warmup_frames = 3;        ///< 预热帧数，之后的帧视为稳定运行
+    bool sample_stacks = true;         ///< 为每个组件记录第一次分配的调用栈
+    bool fail_on_allocation = false;   ///< 稳定运行阶段任一帧发生分配时抛出 AllocationError
+};
+
+class AllocationTracker {
+public:
+    static constexpr bool enabled() {
+#ifdef GNC_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 当前线程累计的全局 operator new 调用次数
+     */
+    static uint64_t allocationCount();
+
+    /**
+     * @brief 当前线程累计通过全局 operator new 申请的字节数
+     */
+    static uint64_t allocatedBytes();
+
+    /**
+     * @brief 是否为归属对象记录调用栈样本（全局开关）
+     */
+    static void setStackSampling(bool enable);
+
+    /**
+     * @brief 将调用栈样本符号化（会分配内存，只应在报告时调用）
+     */
+    static std::vector<std::string> symbolize(const AllocationCounters& counters);
+
+    /**
+     * @brief 作用域内当前线程的分配记到 counters 名下，可嵌套
+     */
+    class Scope {
+    public:
+        explicit Scope(AllocationCounters* counters) {
+            if constexpr (enabled()) {
+                previous_ = exchangeCurrent(counters);
+            }
+        }
+        ~Scope() {
+            if constexpr (enabled()) {
+                exchangeCurrent(previous_);
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        AllocationCounters* previous_ = nullptr;
+    };
+
+private:
+    static AllocationCounters* exchangeCurrent(AllocationCounters* counters);
+};
+
+} // namespace gnc
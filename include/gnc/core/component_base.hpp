@@ -43,6 +43,9 @@
 #include "state_interface.hpp"
 #include "state_access.hpp"
 #include "../common/exceptions.hpp"
+#include "frame_memory.hpp"
+#include "random_streams.hpp"
+#include "external_inputs.hpp"
 #include "gnc/components/utility/simple_logger.hpp"
 #include <memory>
 #include <string>
@@ -185,6 +188,20 @@ public:
         return stateAccess_;
     }
 
+    /**
+     * @brief 是否启用了"输入未变化时跳过更新"策略
+     */
+    bool isSkipIfInputsUnchanged() const {
+        return skip_if_inputs_unchanged_;
+    }
+
+    /**
+     * @brief initialize() 是否可与其他组件并行执行
+     */
+    bool isIndependentInitialization() const {
+        return independent_initialization_;
+    }
+
 protected:
     /**
      * @brief 组件更新实现 (纯虚函数)
@@ -231,6 +248,37 @@ protected:
             .source = StateId{componentId, ""},  // 只记录组件ID，状态名为空
             .required = required,
             .default_value = std::any(),
+            .compute = nullptr,
+        };
+        stateSpecs_.push_back(spec);
+    }
+
+    /**
+     * @brief 声明输入状态 (状态级版本)
+     * 
+     * @tparam T 状态的数据类型
+     * @param stateId 依赖的具体状态
+     * @param required 是否为必需依赖（必需依赖参与执行顺序排序）
+     * 
+     * @details 与组件级声明相比，状态级声明只关注单个状态：
+     * 启用 setSkipIfInputsUnchanged() 时只比较该状态的版本，
+     * 而不是被依赖组件的全部输出。
+     * 
+     * 使用示例：
+     * @code
+     * declareInput<double>(StateId{{id, "Dynamics"}, "altitude"}, false);  // 可选依赖
+     * @endcode
+     */
+    template<typename T>
+    void declareInput(const StateId& stateId, bool required = true) {
+        StateSpec spec{
+            .name = stateId.component.name + "." + stateId.name,
+            .type = typeid(T).name(),
+            .access = StateAccessType::Input,
+            .source = stateId,
+            .required = required,
+            .default_value = std::any(),
+            .compute = nullptr,
         };
         stateSpecs_.push_back(spec);
     }
@@ -260,6 +308,43 @@ protected:
             .source = std::nullopt,
             .required = true,
             .default_value = default_value.has_value() ? std::any(default_value.value()) : std::any(),
+            .compute = nullptr,
+        };
+        stateSpecs_.push_back(spec);
+    }
+
+    /**
+     * @brief 声明派生输出状态
+     * 
+     * @tparam T 状态的数据类型
+     * @param name 状态名称
+     * @param compute 计算函数
+     * 
+     * @details 派生输出不需要在 updateImpl() 中 setState：
+     * 1. 每帧第一次被读取时（包括 DataLogger 的读取）才调用 compute 求值
+     * 2. 求值结果在本帧内缓存，直到下一帧或本组件再次更新
+     * 3. 没有读者时不产生任何计算开销
+     * 4. compute 中读取的其他状态会被记录为依赖，依赖被改写时缓存失效
+     * 
+     * 派生输出是只读的，对其 setState 会抛出异常。
+     * 
+     * 使用示例：
+     * @code
+     * declareDerivedOutput<Vector3d>("velocity_body_mps", [this]() {
+     *     return SAFE_TRANSFORM_VEC(velocity_, "INERTIAL", "BODY");
+     * });
+     * @endcode
+     */
+    template<typename T>
+    void declareDerivedOutput(const std::string& name, std::function<T()> compute) {
+        StateSpec spec{
+            .name = name,
+            .type = typeid(T).name(),
+            .access = StateAccessType::Output,
+            .source = std::nullopt,
+            .required = true,
+            .default_value = std::any(),
+            .compute = [compute = std::move(compute)]() { return std::any(compute()); },
         };
         stateSpecs_.push_back(spec);
     }
@@ -381,6 +466,24 @@ protected:
         return stateAccess_->getState<T>(id);
     }
 
+    /**
+     * @brief 绑定状态句柄，路径格式同 get()
+     * @details 在 initialize() 中绑定一次，之后每帧经句柄读取，省去路径解析和哈希查找
+     * @throws StateAccessError 状态不存在、为派生状态或类型不匹配时抛出
+     */
+    template<typename T>
+    StateHandle<T> getStateHandle(const std::string& path) const {
+        return getStateHandle<T>(parsePath(path));
+    }
+
+    template<typename T>
+    StateHandle<T> getStateHandle(const StateId& stateId) const {
+        if (!stateAccess_) {
+            throw std::runtime_error("Component not registered or StateManager no longer exists");
+        }
+        return stateAccess_->getStateHandle<T>(stateId);
+    }
+
     /**
      * @brief 便捷的状态设置方法
      * 
@@ -401,6 +504,176 @@ protected:
         setState(state_name, value);
     }
 
+    // --- 飞行器活动状态 ---
+
+    /**
+     * @brief 设置本组件所属飞行器的活动状态
+     * 
+     * @param active false 表示休眠，立即生效：本帧内尚未执行的同飞行器组件也会被跳过
+     * @throws std::runtime_error 当组件未注册时抛出
+     * 
+     * 使用示例：
+     * @code
+     * if (altitude < 0.0) {
+     *     setVehicleActive(false);  // 落地后整机休眠
+     * }
+     * @endcode
+     */
+    void setVehicleActive(bool active) {
+        if (!stateAccess_) {
+            throw std::runtime_error("Component not registered or StateManager no longer exists");
+        }
+        stateAccess_->setVehicleActive(vehicleId_, active);
+    }
+
+    /**
+     * @brief 查询本组件所属飞行器是否处于活动状态
+     */
+    bool isVehicleActive() const {
+        return stateAccess_ ? stateAccess_->isVehicleActive(vehicleId_) : true;
+    }
+
+    /**
+     * @brief 设置本组件所属飞行器的唤醒条件
+     * @details 条件仅在飞行器休眠期间每帧求值一次，应只读取少量状态
+     */
+    void setWakeCondition(std::function<bool()> condition) {
+        if (!stateAccess_) {
+            throw std::runtime_error("Component not registered or StateManager no longer exists");
+        }
+        stateAccess_->setWakeCondition(vehicleId_, std::move(condition));
+    }
+
+    /**
+     * @brief 登记下一次需要被调度的仿真时刻
+     * @details 混合离散事件调度模式下，所有飞行器都休眠时仿真时钟会跳到最早登记的时刻，
+     * 而不是逐步推进；组件若在某时刻需要动作（如定时唤醒），应在此登记
+     */
+    void scheduleWakeAt(double time_s) {
+        if (!stateAccess_) {
+            throw std::runtime_error("Component not registered or StateManager no longer exists");
+        }
+        stateAccess_->scheduleWakeAt(time_s);
+    }
+
+    /**
+     * @brief 本次运行中名为 name 的随机数流，种子由主种子和名称派生
+     * @details 只能在注册后（如 initialize() 中）调用，引用在 StateManager 生命周期内有效
+     * @throws std::runtime_error 当组件未注册或状态管理器不提供随机数流时抛出
+     */
+    core::RandomStream& randomStream(const std::string& name) {
+        core::RandomStreams* streams = stateAccess_ ? stateAccess_->randomStreams() : nullptr;
+        if (!streams) {
+            throw std::runtime_error("Component not registered or StateManager provides no random streams");
+        }
+        return streams->stream(name);
+    }
+
+    /**
+     * @brief 本次运行中按名称共享的计数器，同类组件的各实例据此汇总统计
+     * @throws std::runtime_error 当组件未注册或状态管理器不提供计数器时抛出
+     */
+    int64_t& runCounter(const std::string& name) {
+        int64_t* counter = stateAccess_ ? stateAccess_->runCounter(name) : nullptr;
+        if (!counter) {
+            throw std::runtime_error("Component not registered or StateManager provides no run counters");
+        }
+        return *counter;
+    }
+
+    /**
+     * @brief 按上一帧读取另一组件的输出：返回每帧开始前更新的快照
+     * @details 不声明依赖，读到的值与执行顺序无关，可用于相互读取的组件（如飞行器间距离）。
+     * 只能在注册后（如 initialize() 中）调用，引用在 StateManager 生命周期内有效
+     * @throws std::runtime_error 当组件未注册、状态不存在或类型不符时抛出
+     */
+    template<typename T>
+    const T& previousFrameState(const StateId& stateId) {
+        const std::any* snapshot = stateAccess_
+            ? stateAccess_->previousFrameState(stateId, typeid(T), [](std::any& destination, const std::any& source) {
+                  *std::any_cast<T>(&destination) = *std::any_cast<const T>(&source);
+              })
+            : nullptr;
+        if (!snapshot) {
+            throw std::runtime_error("Component not registered or StateManager provides no previous-frame states");
+        }
+        return *std::any_cast<const T>(snapshot);
+    }
+
+    /**
+     * @brief 本组件是否有输出被数据记录组件选中记录
+     * @details 记录组件在自身 initialize() 中选择状态，因此应在第一次 update 时或之后查询
+     */
+    bool isLogged() const {
+        if (!stateAccess_) {
+            return false;
+        }
+        for (const auto& spec : stateSpecs_) {
+            if (spec.access == StateAccessType::Output && stateAccess_->isStateLogged({getComponentId(), spec.name})) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 订阅本次运行的外部事件通道，处理函数在帧开始前于仿真线程上调用
+     * @details 订阅随组件析构解除；只能在注册后（如 initialize() 中）调用
+     * @throws std::runtime_error 当组件未注册或状态管理器不提供外部输入队列时抛出
+     */
+    void subscribeEvent(const std::string& channel, core::ExternalInputs::EventHandler handler) {
+        core::ExternalInputs* inputs = stateAccess_ ? stateAccess_->externalInputs() : nullptr;
+        if (!inputs) {
+            throw std::runtime_error("Component not registered or StateManager provides no external inputs");
+        }
+        eventSubscriptions_.push_back(inputs->subscribe(channel, std::move(handler)));
+    }
+
+    /**
+     * @brief 本帧临时内存，在下一帧开始时整体回收
+     * @details 用于 update 中的临时容器，避免每帧调用全局 new；
+     * 其中的对象不能跨帧保存
+     */
+    std::pmr::memory_resource* frameMemory() const {
+        return FrameMemory::resource();
+    }
+
+    /**
+     * @brief 创建使用本帧临时内存的 vector
+     */
+    template<typename T>
+    std::pmr::vector<T> frameVector(std::size_t size = 0) const {
+        return std::pmr::vector<T>(size, frameMemory());
+    }
+
+    /**
+     * @brief 设置"输入未变化时跳过更新"策略
+     * 
+     * @param enable 是否启用
+     * 
+     * @details 启用后，StateManager 在每帧执行前比较本组件声明的全部输入
+     * （包括可选输入）的版本号，自上次执行以来均未变化时跳过本次更新。
+     * 版本号只在状态值实际变化时递增，因此被跳过组件的输出也不会变化，
+     * 下游同样启用此策略的组件会被连带跳过。
+     * 
+     * 仅适用于输出是输入的纯函数的组件；没有输入的组件只会执行一次。
+     * 需要在构造函数或 initialize() 中设置。
+     */
+    void setSkipIfInputsUnchanged(bool enable) {
+        skip_if_inputs_unchanged_ = enable;
+    }
+
+    /**
+     * @brief 声明 initialize() 与其他组件无关，可在初始化线程池上并行执行
+     *
+     * @details 适用于加载参数表、打开文件等耗时且只触及本组件数据的初始化。
+     * 仍保证在所依赖组件的 initialize() 完成后才开始。此类 initialize() 只能
+     * 读取状态管理器（不得 setState），需要在构造函数中设置。
+     */
+    void setIndependentInitialization(bool enable) {
+        independent_initialization_ = enable;
+    }
+
     friend class gnc::StateManager;  // 允许 StateManager 访问 protected 成员
 
 protected:
@@ -483,6 +756,9 @@ private:
     std::string name_;
     IStateAccess* stateAccess_{nullptr};
     std::vector<StateSpec> stateSpecs_;
+    bool skip_if_inputs_unchanged_{false};
+    bool independent_initialization_{false};
+    std::vector<core::EventSubscription> eventSubscriptions_;
     
     // 新增：路径缓存，用于性能优化
     mutable std::unordered_map<std::string, StateId> path_cache_;
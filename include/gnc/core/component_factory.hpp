@@ -7,12 +7,29 @@
 #include <unordered_map>
 #include <functional>
 #include <memory>
+#include <span>
+#include <typeindex>
+#include <vector>
 
 namespace gnc {
 
 // 创建者函数的类型定义：接受VehicleId和组件名称，返回一个ComponentBase指针
 using ComponentCreator = std::function<states::ComponentBase*(states::VehicleId, const std::string&)>;
 
+// 批量更新函数的类型定义：一次更新同一类型的多个组件实例
+using BatchUpdater = void (*)(std::span<states::ComponentBase* const>);
+
+/**
+ * @brief 支持批量更新的组件类型
+ * @details 组件可提供静态函数 `static void updateBatch(std::span<T*> batch)`，
+ * 调度器会把同一类型、相互独立的实例（通常来自不同飞行器）合并为一次调用。
+ * 批量函数必须与逐个调用 updateImpl() 的结果一致。
+ */
+template <typename T>
+concept BatchUpdatable = requires(std::span<T*> batch) {
+    T::updateBatch(batch);
+};
+
 class ComponentFactory {
 public:
     static ComponentFactory& getInstance() {
@@ -38,6 +55,33 @@ public:
         LOG_DEBUG("[Factory] Registered component type: {}", type.c_str());
     }
 
+    /**
+     * @brief 移除组件类型的创建者，类型不存在时不做任何事
+     */
+    void unregisterCreator(const std::string& type) {
+        creators_.erase(type);
+    }
+
+    /**
+     * @brief 注册组件类型的批量更新函数（类型未实现 updateBatch 时无操作）
+     */
+    template <typename T>
+    void registerBatchUpdater() {
+        if constexpr (BatchUpdatable<T>) {
+            batchUpdaters_[std::type_index(typeid(T))] = &batchTrampoline<T>;
+            LOG_DEBUG("[Factory] Registered batch updater for type: {}", typeid(T).name());
+        }
+    }
+
+    /**
+     * @brief 获取组件动态类型的批量更新函数
+     * @return 未注册时返回 nullptr，调度器回退为逐个更新
+     */
+    BatchUpdater getBatchUpdater(const std::type_index& type) const {
+        auto it = batchUpdaters_.find(type);
+        return it == batchUpdaters_.end() ? nullptr : it->second;
+    }
+
     /**
      * @brief 根据类型字符串创建组件实例
      * @param type 要创建的组件类型
@@ -58,7 +102,22 @@ private:
     ComponentFactory() = default;
     ~ComponentFactory() = default;
 
+    /**
+     * @brief 将基类指针转换为具体类型后调用 T::updateBatch
+     * @details 调度器保证同一批次中的组件动态类型均为 T
+     */
+    template <typename T>
+    static void batchTrampoline(std::span<states::ComponentBase* const> components) {
+        thread_local std::vector<T*> typed;
+        typed.clear();
+        for (auto* component : components) {
+            typed.push_back(static_cast<T*>(component));
+        }
+        T::updateBatch(std::span<T*>(typed));
+    }
+
     std::unordered_map<std::string, ComponentCreator> creators_;
+    std::unordered_map<std::type_index, BatchUpdater> batchUpdaters_;
 };
 
 }
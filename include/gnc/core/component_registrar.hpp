@@ -20,6 +20,8 @@ public:
                 return new T(id, instanceName);
             }
         );
+        // 若组件提供静态 updateBatch，则一并注册批量更新函数
+        ComponentFactory::getInstance().registerBatchUpdater<T>();
     }
 };
 
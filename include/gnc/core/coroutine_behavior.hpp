@@ -0,0 +1,476 @@
+/**
+ * @file coroutine_behavior.hpp
+ * @brief 基于 C++20 协程的时序行为组件
+ *
+ * 时序行为（如"等待 2 s → 解锁 → 等待距离超过 X → 展开"）以前只能写成 FlowController
+ * 状态图，或者像 PhasedGuidanceLogic 那样手写周期计数器。本文件提供协程支持，
+ * 组件逻辑可以直接写成顺序代码：
+ *
+ * @code
+ * Task behavior() override {
+ *     co_await sleep(2.0);
+ *     arm();
+ *     co_await until([this] { return range() > 500.0; });
+ *     deploy();
+ * }
+ * @endcode
+ *
+ * 设计要点：
+ * - 协程只在 updateImpl() 中恢复，且只在其唤醒条件到期时恢复：
+ *   sleep 使用时间轮（TimerWheel），每帧开销为 O(1)；until 的条件每帧轮询一次
+ * - 在组件更新期间创建的协程帧从组件自有的 FrameArena 分配（按大小分级的空闲链表），
+ *   挂起中的行为除帧内存外没有任何开销，反复创建的子任务复用同一块内存
+ * - Task 可以嵌套：co_await 子任务会在子任务结束后恢复父任务，异常沿调用链传播
+ */
+#pragma once
+
+#include "component_base.hpp"
+#include "../common/exceptions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gnc::coroutine {
+
+/**
+ * @brief 协程帧内存池
+ * @details 从固定大小的内存块中顺序分配，释放的帧按大小分级放入空闲链表复用，
+ * 内存块在内存池销毁时统一释放
+ */
+class FrameArena {
+public:
+    explicit FrameArena(std::size_t chunk_size = 4096) : chunk_size_(chunk_size) {}
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(std::size_t size) {
+        size = roundUp(size);
+        bytes_in_use_ += size;
+        auto it = free_lists_.find(size);
+        if (it != free_lists_.end() && it->second) {
+            FreeNode* node = it->second;
+            it->second = node->next;
+            return node;
+        }
+        if (size > remaining_) {
+            std::size_t chunk = std::max(chunk_size_, size);
+            chunks_.push_back(std::make_unique<std::byte[]>(chunk));
+            cursor_ = chunks_.back().get();
+            remaining_ = chunk;
+            bytes_reserved_ += chunk;
+        }
+        void* result = cursor_;
+        cursor_ += size;
+        remaining_ -= size;
+        return result;
+    }
+
+    void deallocate(void* ptr, std::size_t size) {
+        size = roundUp(size);
+        bytes_in_use_ -= size;
+        auto* node = static_cast<FreeNode*>(ptr);
+        node->next = free_lists_[size];
+        free_lists_[size] = node;
+    }
+
+    std::size_t bytesInUse() const { return bytes_in_use_; }
+    std::size_t bytesReserved() const { return bytes_reserved_; }
+
+    /**
+     * @brief 当前线程上用于分配协程帧的内存池
+     */
+    static FrameArena* current() { return currentSlot(); }
+
+    /**
+     * @brief 在作用域内把协程帧分配重定向到指定内存池
+     */
+    class Scope {
+    public:
+        explicit Scope(FrameArena& arena) : previous_(std::exchange(currentSlot(), &arena)) {}
+        ~Scope() { currentSlot() = previous_; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameArena* previous_;
+    };
+
+private:
+    static FrameArena*& currentSlot() {
+        thread_local FrameArena* arena = nullptr;
+        return arena;
+    }
+
+    static constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static std::size_t roundUp(std::size_t size) {
+        return (std::max(size, sizeof(FreeNode)) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    std::size_t chunk_size_;
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    std::byte* cursor_ = nullptr;
+    std::size_t remaining_ = 0;
+    std::unordered_map<std::size_t, FreeNode*> free_lists_;
+    std::size_t bytes_in_use_ = 0;
+    std::size_t bytes_reserved_ = 0;
+};
+
+/**
+ * @brief 协程任务
+ * @details 创建后处于挂起状态，由调度器或父任务（co_await）启动
+ */
+class Task {
+public:
+    struct promise_type {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                auto continuation = handle.promise().continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        /**
+         * @brief 协程帧从当前作用域的 FrameArena 分配，没有时使用全局堆
+         */
+        static void* operator new(std::size_t size) {
+            return allocateFrame(FrameArena::current(), size);
+        }
+
+        static void operator delete(void* ptr, std::size_t size) {
+            auto* header = static_cast<std::byte*>(ptr) - HEADER_SIZE;
+            FrameArena* arena = *reinterpret_cast<FrameArena**>(header);
+            if (arena) {
+                arena->deallocate(header, size + HEADER_SIZE);
+            } else {
+                ::operator delete(header);
+            }
+        }
+
+    private:
+        // 帧前保存所属内存池指针，释放时无需额外参数
+        static constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+        static void* allocateFrame(FrameArena* arena, std::size_t size) {
+            void* header = arena ? arena->allocate(size + HEADER_SIZE) : ::operator new(size + HEADER_SIZE);
+            *static_cast<FrameArena**>(header) = arena;
+            return static_cast<std::byte*>(header) + HEADER_SIZE;
+        }
+    };
+
+    Task() = default;
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { reset(); }
+
+    bool valid() const { return static_cast<bool>(handle_); }
+    bool done() const { return !handle_ || handle_.done(); }
+
+    /**
+     * @brief 启动或恢复根任务，任务内未捕获的异常在此重新抛出
+     */
+    void resume() {
+        if (!done()) {
+            handle_.resume();
+        }
+        rethrowIfFailed();
+    }
+
+    void rethrowIfFailed() {
+        if (handle_ && handle_.done() && handle_.promise().exception) {
+            std::rethrow_exception(std::exchange(handle_.promise().exception, nullptr));
+        }
+    }
+
+    /**
+     * @brief 在另一个任务中 co_await 子任务
+     */
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> child;
+            bool await_ready() noexcept { return !child || child.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent) noexcept {
+                child.promise().continuation = parent;
+                return child;
+            }
+            void await_resume() {
+                if (child && child.promise().exception) {
+                    std::rethrow_exception(child.promise().exception);
+                }
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    void reset() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief 哈希时间轮
+ * @details 时间按 tick_s 离散为刻度，到期刻度映射到 slot_count 个槽位之一。
+ * 推进时只访问经过的槽位；一次推进超过一整圈时最多扫描所有槽位一次。
+ * 定时器在刻度到达 ceil(due / tick) 时到期，不会早于 due 触发。
+ */
+class TimerWheel {
+public:
+    explicit TimerWheel(double tick_s = 0.01, std::size_t slot_count = 256)
+        : tick_s_(tick_s), slots_(slot_count) {}
+
+    /**
+     * @brief 设置刻度长度，仅在没有待触发定时器时有效
+     */
+    void setResolution(double tick_s) {
+        if (pending_ == 0 && tick_s > 0.0) {
+            tick_s_ = tick_s;
+        }
+    }
+
+    void schedule(double due_s, std::coroutine_handle<> handle) {
+        int64_t due_tick = static_cast<int64_t>(std::ceil(due_s / tick_s_ - EPSILON));
+        if (due_tick <= current_tick_) {
+            due_tick = current_tick_ + 1;  // 最早在下一次推进时触发
+        }
+        slots_[static_cast<std::size_t>(due_tick) % slots_.size()].push_back({due_tick, handle});
+        ++pending_;
+    }
+
+    /**
+     * @brief 推进到 now_s，收集所有到期的协程
+     */
+    void advance(double now_s, std::vector<std::coroutine_handle<>>& due) {
+        int64_t target = static_cast<int64_t>(std::floor(now_s / tick_s_ + EPSILON));
+        if (target <= current_tick_) {
+            return;
+        }
+        int64_t span = std::min<int64_t>(target - current_tick_, static_cast<int64_t>(slots_.size()));
+        current_tick_ = target;
+        if (pending_ == 0) {
+            return;
+        }
+        for (int64_t i = 0; i < span; ++i) {
+            auto& slot = slots_[static_cast<std::size_t>(target - i) % slots_.size()];
+            for (std::size_t k = 0; k < slot.size();) {
+                if (slot[k].due_tick <= target) {
+                    due.push_back(slot[k].handle);
+                    slot[k] = slot.back();
+                    slot.pop_back();
+                    --pending_;
+                } else {
+                    ++k;
+                }
+            }
+        }
+    }
+
+    std::size_t pending() const { return pending_; }
+
+private:
+    static constexpr double EPSILON = 1e-9;
+
+    struct Entry {
+        int64_t due_tick;
+        std::coroutine_handle<> handle;
+    };
+
+    double tick_s_;
+    std::vector<std::vector<Entry>> slots_;
+    int64_t current_tick_ = 0;
+    std::size_t pending_ = 0;
+};
+
+/**
+ * @brief 协程调度器：管理 sleep 定时器和 until 条件等待
+ */
+class BehaviorScheduler {
+public:
+    TimerWheel& timers() { return timers_; }
+    double now() const { return now_s_; }
+
+    void sleepUntil(double due_s, std::coroutine_handle<> handle) {
+        timers_.schedule(due_s, handle);
+    }
+
+    void waitUntil(std::function<bool()> condition, std::coroutine_handle<> handle) {
+        waiters_.push_back({std::move(condition), handle});
+    }
+
+    /**
+     * @brief 推进到当前时间并恢复到期的协程
+     */
+    void run(double now_s) {
+        now_s_ = now_s;
+        due_.clear();
+        timers_.advance(now_s, due_);
+        for (std::size_t i = 0; i < waiters_.size();) {
+            if (waiters_[i].condition()) {
+                due_.push_back(waiters_[i].handle);
+                waiters_[i] = std::move(waiters_.back());
+                waiters_.pop_back();
+            } else {
+                ++i;
+            }
+        }
+        // 恢复过程中可能注册新的等待，先复制出本帧要恢复的协程
+        resuming_.swap(due_);
+        for (auto handle : resuming_) {
+            handle.resume();
+        }
+        resuming_.clear();
+    }
+
+    std::size_t waitingCount() const { return timers_.pending() + waiters_.size(); }
+
+private:
+    struct Waiter {
+        std::function<bool()> condition;
+        std::coroutine_handle<> handle;
+    };
+
+    TimerWheel timers_;
+    std::vector<Waiter> waiters_;
+    std::vector<std::coroutine_handle<>> due_;
+    std::vector<std::coroutine_handle<>> resuming_;
+    double now_s_ = 0.0;
+};
+
+/**
+ * @brief co_await sleep(seconds) 的等待体
+ */
+struct SleepAwaiter {
+    BehaviorScheduler* scheduler;
+    double duration_s;
+
+    bool await_ready() const noexcept { return duration_s <= 0.0; }
+    void await_suspend(std::coroutine_handle<> handle) {
+        scheduler->sleepUntil(scheduler->now() + duration_s, handle);
+    }
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief co_await until(condition) 的等待体
+ */
+struct UntilAwaiter {
+    BehaviorScheduler* scheduler;
+    std::function<bool()> condition;
+
+    bool await_ready() { return condition(); }
+    void await_suspend(std::coroutine_handle<> handle) {
+        scheduler->waitUntil(std::move(condition), handle);
+    }
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief 以协程描述逻辑的组件基类
+ * @details 派生类实现 behavior()，在第一次更新时启动；之后每帧推进调度器，
+ * 只恢复到期的协程。onUpdate() 可用于每帧都需要输出的连续量。
+ * 行为结束后组件不再恢复任何协程，只调用 onUpdate()。
+ */
+class SequencedComponent : public states::ComponentBase {
+public:
+    SequencedComponent(states::VehicleId id, const std::string& defaultName, const std::string& instanceName = "")
+        : states::ComponentBase(id, defaultName, instanceName) {
+        declareInput<void>(states::ComponentId{states::globalId, "TimingManager"});
+    }
+
+    /**
+     * @brief 协程帧内存池（恢复协程期间，新建的协程帧都从这里分配）
+     */
+    FrameArena& frameArena() { return arena_; }
+
+    bool isSequenceDone() const { return started_ && behavior_.done(); }
+
+protected:
+    /**
+     * @brief 组件的时序逻辑
+     */
+    virtual Task behavior() = 0;
+
+    /**
+     * @brief 每帧调用（在恢复到期协程之后）
+     */
+    virtual void onUpdate() {}
+
+    SleepAwaiter sleep(double duration_s) { return SleepAwaiter{&scheduler_, duration_s}; }
+    UntilAwaiter until(std::function<bool()> condition) { return UntilAwaiter{&scheduler_, std::move(condition)}; }
+
+    double now() const { return scheduler_.now(); }
+    const BehaviorScheduler& scheduler() const { return scheduler_; }
+
+    void updateImpl() override {
+        double now_s = getState<double>({{states::globalId, "TimingManager"}, "timing_current_s"});
+        FrameArena::Scope arena_scope(arena_);
+        if (!started_) {
+            double dt = getState<double>({{states::globalId, "TimingManager"}, "timing_delta_s"});
+            if (dt > 0.0) {
+                scheduler_.timers().setResolution(dt);
+            }
+            scheduler_.run(now_s);
+            behavior_ = behavior();
+            started_ = true;
+            behavior_.resume();
+        } else if (!behavior_.done()) {
+            scheduler_.run(now_s);
+            behavior_.rethrowIfFailed();
+        }
+        onUpdate();
+    }
+
+private:
+    // 声明顺序决定析构顺序：协程帧先于调度器和内存池销毁
+    FrameArena arena_;
+    BehaviorScheduler scheduler_;
+    Task behavior_;
+    bool started_ = false;
+};
+
+} // namespace gnc::coroutine
@@ -0,0 +1,126 @@
+/**
+ * @file external_inputs.hpp
+ * @brief 在帧边界生效的外部输入队列
+ *
+ * 外部输入（运行时的配置修改、其他线程投递的事件）经 ExternalInputs 排队，只在帧边界
+ * （帧开始前）生效，因此两次运行中输入落在同一帧、同一时刻。每个 StateManager 持有一个
+ * 队列，组件通过 ComponentBase::subscribeEvent() 订阅，订阅随组件析构自动解除。
+ */
+#pragma once
+
+#include "../components/utility/config_manager.hpp"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace core {
+
+/**
+ * @brief 事件订阅，析构时解除；订阅的队列先于订阅析构时什么也不做
+ */
+class EventSubscription {
+public:
+    EventSubscription() = default;
+    ~EventSubscription() { release(); }
+
+    EventSubscription(EventSubscription&& other) noexcept
+        : table_(std::move(other.table_)), channel_(std::move(other.channel_)), id_(other.id_) {}
+    EventSubscription& operator=(EventSubscription&& other) noexcept {
+        if (this != &other) {
+            release();
+            table_ = std::move(other.table_);
+            channel_ = std::move(other.channel_);
+            id_ = other.id_;
+        }
+        return *this;
+    }
+    EventSubscription(const EventSubscription&) = delete;
+    EventSubscription& operator=(const EventSubscription&) = delete;
+
+    /**
+     * @brief 解除订阅
+     */
+    void release();
+
+    bool active() const { return !table_.expired(); }
+
+private:
+    friend class ExternalInputs;
+    struct HandlerTable;
+
+    EventSubscription(std::weak_ptr<HandlerTable> table, std::string channel, uint64_t id)
+        : table_(std::move(table)), channel_(std::move(channel)), id_(id) {}
+
+    std::weak_ptr<HandlerTable> table_;
+    std::string channel_;
+    uint64_t id_ = 0;
+};
+
+/**
+ * @brief 在帧边界生效的外部输入队列（线程安全）
+ */
+class ExternalInputs {
+public:
+    struct Input {
+        enum class Kind : uint8_t { ConfigChange, Event };
+        Kind kind;
+        /// ConfigChange: {"file", "path", "value"}；Event: {"channel", "data"}
+        nlohmann::json payload;
+    };
+
+    using EventHandler = std::function<void(const nlohmann::json& data)>;
+
+    ExternalInputs();
+
+    ExternalInputs(const ExternalInputs&) = delete;
+    ExternalInputs& operator=(const ExternalInputs&) = delete;
+
+    /**
+     * @brief 投递配置修改，在下一帧开始前通过 ConfigManager::setConfigValue 生效
+     */
+    void postConfigChange(components::utility::ConfigFileType type, const std::string& json_path,
+                          const nlohmann::json& value);
+
+    /**
+     * @brief 投递事件，在下一帧开始前于仿真线程上调用该通道的处理函数
+     */
+    void postEvent(const std::string& channel, const nlohmann::json& data);
+
+    /**
+     * @brief 订阅事件通道，处理函数在仿真线程上调用，直到返回的订阅析构或被解除
+     */
+    [[nodiscard]] EventSubscription subscribe(const std::string& channel, EventHandler handler);
+
+    bool hasPending() const { return has_pending_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 取出全部待处理输入（按投递顺序）
+     */
+    std::vector<Input> drain();
+
+    /**
+     * @brief 使一个输入生效
+     */
+    void apply(const Input& input);
+
+    /**
+     * @brief 清空待处理输入
+     */
+    void clear();
+
+private:
+    std::mutex mutex_;
+    std::vector<Input> pending_;
+    std::atomic<bool> has_pending_{false};
+    std::shared_ptr<EventSubscription::HandlerTable> handlers_;
+};
+
+} // namespace core
+} // namespace gnc
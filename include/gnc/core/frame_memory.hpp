@@ -0,0 +1,92 @@
+/**
+ * @file frame_memory.hpp
+ * @brief 按帧释放的临时内存（每线程一个单调分配区）
+ *
+ * 组件在 update 中创建的临时容器（批量计算的中间数组、制导律的中间向量等）生命周期
+ * 不超过一帧。这些内存从本线程的单调分配区中顺序分配，释放为空操作，
+ * 由 StateManager 在每帧开始时整体回收，稳定运行后不再调用全局 new。
+ *
+ * @code
+ * void updateImpl() override {
+ *     auto samples = frameVector<double>(n);   // std::pmr::vector，下一帧开始时失效
+ *     ...
+ * }
+ * @endcode
+ *
+ * 注意：分配区中的对象不能跨帧保存，也不能写入状态（setState 会复制值）。
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace gnc {
+
+class FrameMemory final : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t INITIAL_CAPACITY = 64 * 1024;
+
+    /**
+     * @brief 当前线程的分配区
+     */
+    static FrameMemory& local() {
+        thread_local FrameMemory memory;
+        return memory;
+    }
+
+    static std::pmr::memory_resource* resource() {
+        return &local();
+    }
+
+    FrameMemory(const FrameMemory&) = delete;
+    FrameMemory& operator=(const FrameMemory&) = delete;
+
+    /**
+     * @brief 帧边界：回收本帧的全部分配
+     * @details 本帧用量超过初始缓冲区时（超出部分向全局堆申请），按峰值扩大缓冲区，
+     * 之后的帧不再触及全局堆
+     */
+    void reset() {
+        peak_bytes_ = std::max(peak_bytes_, bytes_this_frame_);
+        if (bytes_this_frame_ > buffer_.size()) {
+            monotonic_.reset();
+            buffer_.assign(std::bit_ceil(bytes_this_frame_) * 2, std::byte{0});
+        }
+        monotonic_.emplace(buffer_.data(), buffer_.size(), std::pmr::new_delete_resource());
+        bytes_this_frame_ = 0;
+    }
+
+    std::size_t bytesThisFrame() const { return bytes_this_frame_; }
+    std::size_t peakBytes() const { return std::max(peak_bytes_, bytes_this_frame_); }
+    std::size_t capacity() const { return buffer_.size(); }
+
+private:
+    FrameMemory() : buffer_(INITIAL_CAPACITY) {
+        monotonic_.emplace(buffer_.data(), buffer_.size(), std::pmr::new_delete_resource());
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        bytes_this_frame_ += bytes + alignment - 1;
+        return monotonic_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {
+        // 单调分配：在 reset() 时整体回收
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::vector<std::byte> buffer_;
+    std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+    std::size_t bytes_this_frame_ = 0;
+    std::size_t peak_bytes_ = 0;
+};
+
+} // namespace gnc
@@ -0,0 +1,142 @@
+/**
+ * @file hdr_histogram.hpp
+ * @brief 高动态范围（HDR）直方图
+ *
+ * 按 HdrHistogram 的对数-线性分桶方式记录整数值（如纳秒延迟）：
+ * 每个数量级内按固定有效位数线性细分，在整个可记录范围内保持相同的相对精度，
+ * 记录操作为 O(1) 且不分配内存，适合在实时循环中逐帧记录。
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace gnc {
+
+class HdrHistogram {
+public:
+    /**
+     * @param highest_trackable_value 可记录的最大值，更大的值按最大值记录
+     * @param significant_digits 有效十进制位数（1~5），决定相对精度
+     */
+    explicit HdrHistogram(uint64_t highest_trackable_value, int significant_digits = 3)
+        : highest_trackable_value_(std::max<uint64_t>(highest_trackable_value, 2)) {
+        if (significant_digits < 1 || significant_digits > 5) {
+            throw std::invalid_argument("HdrHistogram significant_digits must be in [1, 5]");
+        }
+        uint64_t largest_single_unit = 2 * static_cast<uint64_t>(std::pow(10, significant_digits));
+        int sub_bucket_count_magnitude = static_cast<int>(std::ceil(std::log2(static_cast<double>(largest_single_unit))));
+        sub_bucket_half_count_magnitude_ = std::max(sub_bucket_count_magnitude, 1) - 1;
+        sub_bucket_count_ = uint64_t{1} << (sub_bucket_half_count_magnitude_ + 1);
+        sub_bucket_half_count_ = sub_bucket_count_ / 2;
+        sub_bucket_mask_ = sub_bucket_count_ - 1;
+
+        int bucket_count = 1;
+        uint64_t smallest_untrackable = sub_bucket_count_;
+        while (smallest_untrackable <= highest_trackable_value_) {
+            if (smallest_untrackable > std::numeric_limits<uint64_t>::max() / 2) {
+                ++bucket_count;
+                break;
+            }
+            smallest_untrackable <<= 1;
+            ++bucket_count;
+        }
+        counts_.assign(static_cast<size_t>(bucket_count + 1) * sub_bucket_half_count_, 0);
+    }
+
+    void record(uint64_t value) {
+        value = std::min(value, highest_trackable_value_);
+        ++counts_[countsIndex(value)];
+        ++total_count_;
+        sum_ += static_cast<double>(value);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    /**
+     * @brief 合并另一个直方图的计数
+     * @throws std::invalid_argument 两者的分桶布局（最大值和有效位数）不同时抛出
+     */
+    void add(const HdrHistogram& other) {
+        if (other.counts_.size() != counts_.size() || other.sub_bucket_count_ != sub_bucket_count_) {
+            throw std::invalid_argument("HdrHistogram::add requires histograms with the same bucket layout");
+        }
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_count_ += other.total_count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        total_count_ = 0;
+        sum_ = 0.0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+    }
+
+    uint64_t count() const { return total_count_; }
+    uint64_t min() const { return total_count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return total_count_ ? sum_ / static_cast<double>(total_count_) : 0.0; }
+
+    /**
+     * @brief 百分位数（0~100），返回所在桶内可等价表示的最大值
+     */
+    uint64_t valueAtPercentile(double percentile) const {
+        if (total_count_ == 0) {
+            return 0;
+        }
+        percentile = std::clamp(percentile, 0.0, 100.0);
+        uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_count_)));
+        target = std::max<uint64_t>(target, 1);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            cumulative += counts_[i];
+            if (cumulative >= target) {
+                return std::min(highestEquivalentValue(i), max_);
+            }
+        }
+        return max_;
+    }
+
+private:
+    size_t countsIndex(uint64_t value) const {
+        int bucket_index = 63 - sub_bucket_half_count_magnitude_ - std::countl_zero(value | sub_bucket_mask_);
+        uint64_t sub_bucket_index = value >> bucket_index;
+        return (static_cast<size_t>(bucket_index + 1) << sub_bucket_half_count_magnitude_) +
+               static_cast<size_t>(sub_bucket_index - sub_bucket_half_count_);
+    }
+
+    uint64_t highestEquivalentValue(size_t index) const {
+        int bucket_index = static_cast<int>(index >> sub_bucket_half_count_magnitude_) - 1;
+        uint64_t sub_bucket_index = (index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+        if (bucket_index < 0) {
+            sub_bucket_index -= sub_bucket_half_count_;
+            bucket_index = 0;
+        }
+        uint64_t lowest = sub_bucket_index << bucket_index;
+        return lowest + (uint64_t{1} << bucket_index) - 1;
+    }
+
+    uint64_t highest_trackable_value_;
+    int sub_bucket_half_count_magnitude_ = 0;
+    uint64_t sub_bucket_count_ = 0;
+    uint64_t sub_bucket_half_count_ = 0;
+    uint64_t sub_bucket_mask_ = 0;
+    std::vector<uint64_t> counts_;
+    uint64_t total_count_ = 0;
+    double sum_ = 0.0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+};
+
+} // namespace gnc
@@ -0,0 +1,183 @@
+/**
+ * @file input_journal.hpp
+ * @brief 外部输入队列与确定性记录/回放日志
+ *
+ * 仿真结果只应取决于配置、主种子和运行中进入仿真的外部输入。外部输入（运行时的配置修改、
+ * 其他线程投递的事件）经 StateManager 的 ExternalInputs 排队，只在帧边界（帧开始前）生效，
+ * 因此两次运行中输入落在同一帧、同一时刻。
+ *
+ * InputJournal 在 record 模式下把这些输入连同其他与墙钟相关的决定写入紧凑的二进制日志：
+ *   - 主种子（文件头）以及随机数流位置（有变化的帧）
+ *   - 配置修改与外部事件（生效的帧）
+ *   - 实时运行中的优先级下限（超时降级）和帧预算卸载结果（推迟/跳过的组件）
+ *   - 每帧结束时的状态哈希与仿真时间（可关闭）
+ * replay 模式忽略实时节拍和实时产生的输入，按日志逐帧重放上述输入与决定，并在每帧结束时
+ * 比较状态哈希和随机数流位置，报告第一处分歧的帧号与仿真时间。
+ *
+ * 文件格式：MAGIC "GNCJRNL1"、uint64 文件头长度、文件头 JSON（version、master_seed、
+ * 各配置文件的哈希），随后为记录 [uint8 类型][uint64 帧号][uint32 长度][负载]，
+ * 以 End 记录（uint64 总帧数）结束。数值按本机字节序写入。
+ *
+ * 状态哈希只在同一构建、同一平台上可比；关闭 hash_states 时只记录输入。
+ */
+#pragma once
+
+#include "state_manager.hpp"
+#include "external_inputs.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace core {
+
+enum class JournalMode { Off, Record, Replay };
+
+/**
+ * @brief 记录/回放配置（core.yaml 中的 core.journal）
+ */
+struct JournalConfig {
+    JournalMode mode = JournalMode::Off;
+    std::string file = "logs/journal.gncjrnl";
+    bool hash_states = true;       ///< 每帧记录（回放时比较）状态哈希
+
+    static JournalConfig fromJson(const nlohmann::json& config);
+};
+
+enum class JournalRecordType : uint8_t {
+    FrameHash = 1,      ///< uint64 状态哈希 + double 仿真时间
+    RngPositions = 2,   ///< JSON {流名称: 位置}
+    ConfigChange = 3,   ///< JSON，见 ExternalInputs::Input
+    Event = 4,          ///< JSON，见 ExternalInputs::Input
+    PriorityFloor = 5,  ///< int32
+    Budget = 6,         ///< JSON {"deferred": [[vehicle, name]...], "shed": [...]}
+    End = 7             ///< uint64 总帧数
+};
+
+struct JournalRecord {
+    JournalRecordType type;
+    uint64_t frame = 0;
+    std::string payload;
+};
+
+/**
+ * @brief 回放结果
+ */
+struct JournalReplayReport {
+    uint64_t frames = 0;                ///< 已回放的帧数
+    uint64_t recorded_frames = 0;       ///< 日志中的帧数
+    uint64_t compared_frames = 0;       ///< 比较了状态哈希的帧数
+    uint64_t hash_mismatches = 0;
+    uint64_t rng_mismatches = 0;
+    uint64_t ignored_live_inputs = 0;   ///< 回放期间被忽略的实时输入
+    uint64_t first_divergent_frame = std::numeric_limits<uint64_t>::max();
+    double first_divergent_time_s = 0.0;
+
+    bool diverged() const { return first_divergent_frame != std::numeric_limits<uint64_t>::max(); }
+    bool passed() const { return !diverged() && frames == recorded_frames; }
+    nlohmann::json toJson() const;
+};
+
+/**
+ * @brief 帧边界上的外部输入处理与记录/回放
+ *
+ * @details 仿真循环在每帧 updateAll() 前后调用 beforeFrame() / afterFrame()。Off 模式下
+ * beforeFrame() 只应用待处理的外部输入。
+ */
+class InputJournal {
+public:
+    static constexpr char MAGIC[8] = {'G', 'N', 'C', 'J', 'R', 'N', 'L', '1'};
+    static constexpr int VERSION = 1;
+
+    /**
+     * @param master_seed record 模式写入文件头的主种子
+     * @throws std::runtime_error 日志文件无法打开或格式错误时抛出
+     */
+    InputJournal(JournalConfig config, StateManager& state_manager, uint64_t master_seed);
+    ~InputJournal();
+
+    InputJournal(const InputJournal&) = delete;
+    InputJournal& operator=(const InputJournal&) = delete;
+
+    JournalMode mode() const { return config_.mode; }
+    bool replaying() const { return config_.mode == JournalMode::Replay; }
+
+    /**
+     * @brief 日志记录的主种子（replay 模式），否则为构造时传入的种子
+     */
+    uint64_t masterSeed() const { return master_seed_; }
+
+    /**
+     * @brief 提供写入/比较的仿真时间
+     */
+    void setSimTime(StateHandle<double> sim_time) { sim_time_ = sim_time; }
+
+    void beforeFrame() {
+        if (config_.mode == JournalMode::Off) {
+            if (state_manager_.externalInputs()->hasPending()) {
+                applyLiveInputs();
+            }
+            return;
+        }
+        config_.mode == JournalMode::Record ? recordInputs() : replayInputs();
+    }
+
+    void afterFrame() {
+        if (config_.mode == JournalMode::Record) {
+            recordFrame();
+        } else if (config_.mode == JournalMode::Replay) {
+            checkFrame();
+        }
+    }
+
+    /**
+     * @brief 结束记录（写 End 记录并关闭文件）或输出回放报告；析构时自动调用
+     */
+    void finish();
+
+    const JournalReplayReport& report() const { return report_; }
+
+    /**
+     * @brief 读取日志文件
+     * @throws std::runtime_error 文件无法打开或格式错误时抛出
+     */
+    static std::vector<JournalRecord> read(const std::string& path, nlohmann::json* header = nullptr);
+
+private:
+    void applyLiveInputs();
+    void recordInputs();
+    void recordFrame();
+    void replayInputs();
+    void checkFrame();
+    void write(JournalRecordType type, const std::string& payload);
+    void markDivergence(const char* what);
+    double simTime() const { return sim_time_.valid() ? sim_time_.get() : 0.0; }
+
+    static nlohmann::json configHashes();
+
+    JournalConfig config_;
+    StateManager& state_manager_;
+    uint64_t master_seed_;
+    StateHandle<double> sim_time_;
+    uint64_t frame_ = 0;
+    bool finished_ = false;
+
+    // record
+    std::ofstream out_;
+    int recorded_floor_ = 0;
+    std::map<std::string, uint64_t> recorded_positions_;
+
+    // replay
+    std::vector<JournalRecord> records_;
+    size_t cursor_ = 0;
+    StateManager::BudgetDecisions replay_budget_;
+    std::map<std::string, uint64_t> expected_positions_;
+    JournalReplayReport report_;
+};
+
+} // namespace core
+} // namespace gnc
@@ -0,0 +1,208 @@
+/**
+ * @file metrics.hpp
+ * @brief 运行指标：计数器、仪表和 HDR 直方图，由后台线程定期导出
+ *
+ * 仿真线程上的记录不加锁：计数器和仪表为原子变量，直方图按 WriterReaderPhaser
+ * 在两个区间直方图之间切换——记录方每次只做两次原子加，导出线程切换区间后
+ * 等待正在进行的记录结束，再把上一个区间并入累计直方图。
+ *
+ * 注册在初始化阶段进行（加锁），返回的引用在注册表生命周期内有效。导出线程每隔
+ * interval_s 将全部指标写入文件：prometheus 格式整体覆盖写入（供 node_exporter 的
+ * textfile 采集器读取，直方图导出为累计分位数的 summary），jsonl 格式每次追加一行，
+ * 包含计数器的区间速率和直方图的区间分位数。
+ */
+#pragma once
+
+#include "hdr_histogram.hpp"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gnc {
+
+/**
+ * @brief 指标导出配置（core.yaml 中的 core.metrics）
+ */
+struct MetricsConfig {
+    bool enabled = false;
+    std::string format = "prometheus";         ///< prometheus 或 jsonl
+    std::string file = "logs/metrics.prom";
+    double interval_s = 5.0;                   ///< 导出周期（墙钟时间）
+    bool per_component = true;                 ///< 是否按组件类型记录更新耗时
+    bool per_instance = false;                 ///< 改为按组件实例（车辆、组件名）分别记录；每个序列约 900 KB
+
+    static MetricsConfig fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @brief 单调递增计数器
+ */
+class MetricsCounter {
+public:
+    void add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * @brief 瞬时值
+ */
+class MetricsGauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * @brief 单写者无锁直方图（单位由指标名约定，如 _ns）
+ */
+class MetricsHistogram {
+public:
+    explicit MetricsHistogram(uint64_t highest_trackable_value)
+        : buffers_{HdrHistogram(highest_trackable_value), HdrHistogram(highest_trackable_value)},
+          interval_(highest_trackable_value), cumulative_(highest_trackable_value) {}
+
+    /**
+     * @brief 记录一个值；同一直方图同一时刻只能有一个记录线程
+     */
+    void record(uint64_t value) {
+        const int64_t epoch = start_epoch_.fetch_add(1);
+        if (epoch < 0) {
+            buffers_[1].record(value);
+            odd_end_epoch_.fetch_add(1, std::memory_order_release);
+        } else {
+            buffers_[0].record(value);
+            even_end_epoch_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief 结束当前区间：切换记录缓冲区并把上一区间并入累计值（仅导出线程调用）
+     */
+    void rotate();
+
+    const HdrHistogram& interval() const { return interval_; }
+    const HdrHistogram& cumulative() const { return cumulative_; }
+
+private:
+    HdrHistogram buffers_[2];             ///< [0] 偶相位，[1] 奇相位
+    std::atomic<int64_t> start_epoch_{0};
+    std::atomic<int64_t> even_end_epoch_{0};
+    std::atomic<int64_t> odd_end_epoch_{std::numeric_limits<int64_t>::min()};
+    HdrHistogram interval_;
+    HdrHistogram cumulative_;
+};
+
+class MetricsRegistry {
+public:
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+    using Clock = std::chrono::steady_clock;
+
+    /// 直方图默认可记录到 60 s（以纳秒计）
+    static constexpr uint64_t DEFAULT_HIGHEST_NS = 60'000'000'000ULL;
+
+    static MetricsRegistry& getInstance();
+
+    ~MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief 获取或注册指标；名称和标签相同时返回已注册的同一对象
+     */
+    MetricsCounter& counter(const std::string& name, const std::string& help, const Labels& labels = {});
+    MetricsGauge& gauge(const std::string& name, const std::string& help, const Labels& labels = {});
+    MetricsHistogram& histogram(const std::string& name, const std::string& help, const Labels& labels = {},
+                                uint64_t highest_trackable_value = DEFAULT_HIGHEST_NS);
+
+    /**
+     * @brief 注册导出时采样的仪表，sample 在导出线程上调用，需自行保证线程安全
+     */
+    void sampledGauge(const std::string& name, const std::string& help, std::function<double()> sample);
+
+    /**
+     * @brief 启动后台导出线程
+     */
+    void start(const MetricsConfig& config);
+
+    /**
+     * @brief 停止导出线程，停止前再导出一次
+     */
+    void stop();
+
+    bool running() const { return flusher_.joinable(); }
+
+    /**
+     * @brief 是否正在导出指标；未注入指标对象的热路径以此判断是否计数
+     */
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 立即导出一次到配置的文件
+     */
+    void flush();
+
+    /**
+     * @brief 以 Prometheus 文本格式输出全部指标（直方图为累计分位数）
+     * @note 与 flush() 一样会结束直方图的当前区间
+     */
+    void writePrometheus(std::ostream& out);
+
+    /**
+     * @brief 输出一行 JSON：计数器的值和区间速率、仪表值、直方图的区间与累计统计
+     */
+    void writeJsonLine(std::ostream& out);
+
+private:
+    MetricsRegistry() = default;
+
+    enum class Kind { Counter, Gauge, Histogram, Sampled };
+
+    struct Metric {
+        Kind kind;
+        std::string name;
+        std::string help;
+        std::string labels;                  ///< 已格式化的标签，如 {vehicle="1"}
+        std::unique_ptr<MetricsCounter> counter;
+        std::unique_ptr<MetricsGauge> gauge;
+        std::unique_ptr<MetricsHistogram> histogram;
+        std::function<double()> sample;
+        uint64_t last_value = 0;             ///< 上次导出时的计数，用于计算区间速率
+    };
+
+    Metric& findOrAdd(Kind kind, const std::string& name, const std::string& help, const Labels& labels);
+    void rotateAll(Clock::time_point now);
+    void run();
+
+    std::mutex mutex_;                       ///< 保护注册表结构和导出过程
+    std::vector<std::unique_ptr<Metric>> metrics_;                 ///< 注册顺序
+    std::unordered_map<std::string, Metric*> index_;               ///< 名称 + 已格式化标签 -> 指标
+    MetricsConfig config_;
+    Clock::time_point last_export_ = Clock::now();
+    double interval_elapsed_s_ = 0.0;
+    std::thread flusher_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stop_requested_ = false;
+    static inline std::atomic<bool> enabled_{false};
+};
+
+} // namespace gnc
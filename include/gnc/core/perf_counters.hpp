@@ -0,0 +1,107 @@
+/**
+ * @file perf_counters.hpp
+ * @brief 按组件类型统计硬件性能计数器（Linux perf_event_open）
+ *
+ * 开启后 StateManager 在每次组件更新前后读取本线程的计数器组（周期、指令、L1D 读缺失、
+ * 末级缓存缺失、分支预测失败），按组件类型累计，结束时输出 IPC 和每千条指令缺失数汇总表。
+ * 批量更新按整批计入该类型。
+ *
+ * 计数器只统计用户态，perf_event_paranoid <= 2 时普通用户即可使用。内核不允许、
+ * 虚拟机没有硬件计数器或非 Linux 平台时 open() 返回 false，仿真照常运行；
+ * 个别计数器不可用时只缺少对应列。
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gnc {
+
+class PerfCounterProfiler {
+public:
+    enum Counter : size_t {
+        Cycles,
+        Instructions,
+        L1DReadMisses,
+        LLCMisses,
+        BranchMisses,
+        COUNTER_COUNT
+    };
+
+    using Sample = std::array<uint64_t, COUNTER_COUNT>;
+
+    /**
+     * @brief 一个组件类型的累计值
+     */
+    struct Totals {
+        uint64_t updates = 0;
+        Sample values{};
+    };
+
+    PerfCounterProfiler() = default;
+    ~PerfCounterProfiler();
+
+    PerfCounterProfiler(const PerfCounterProfiler&) = delete;
+    PerfCounterProfiler& operator=(const PerfCounterProfiler&) = delete;
+
+    /**
+     * @brief 在调用线程上打开计数器组并开始计数
+     * @return 周期计数器（组长）不可用时返回 false，此时不应使用本对象
+     */
+    bool open();
+
+    bool available() const { return leader_fd_ >= 0; }
+
+    bool counterAvailable(Counter counter) const { return slot_[counter] >= 0; }
+
+    /**
+     * @brief 获取组件类型的累计槽位，地址在本对象生命周期内不变
+     */
+    Totals* totalsFor(const std::string& type) {
+        auto& totals = totals_[type];
+        if (!totals) {
+            totals = std::make_unique<Totals>();
+        }
+        return totals.get();
+    }
+
+    /**
+     * @brief 读取当前计数（一次 read 系统调用读取整组）
+     */
+    Sample read() const;
+
+    /**
+     * @brief 累计从 before 到现在的增量
+     */
+    void accumulate(Totals& totals, const Sample& before) const {
+        const Sample after = read();
+        ++totals.updates;
+        for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+            totals.values[i] += after[i] - before[i];
+        }
+    }
+
+    /**
+     * @brief 输出按周期数降序排列的汇总表
+     */
+    void writeSummary(std::ostream& out) const;
+
+    /**
+     * @brief 计数器被内核分时复用时为 true（组内计数器无法同时调度）
+     */
+    bool multiplexed() const;
+
+private:
+    int leader_fd_ = -1;
+    std::vector<int> fds_;
+    std::array<int, COUNTER_COUNT> slot_ = {-1, -1, -1, -1, -1};  ///< 计数器在组读取结果中的位置
+    size_t group_size_ = 0;
+    std::unordered_map<std::string, std::unique_ptr<Totals>> totals_;
+};
+
+} // namespace gnc
@@ -0,0 +1,105 @@
+/**
+ * @file random_streams.hpp
+ * @brief 可复现的随机数流：每个使用方按名称取独立的流，种子由主种子派生
+ *
+ * 每个 StateManager 持有一组流（一次运行一组，同一进程中的多个仿真互不影响）。
+ * 主种子来自 core.yaml 的 core.random_seed。各流的种子为 splitmix64(主种子 ^ FNV-1a(名称))，
+ * 与流的创建顺序无关，新增一个使用方不会改变其他流的序列。每个流记录已抽取的次数（位置），
+ * 输入日志（InputJournal）按帧记录各流位置，回放时据此检查随机抽取是否与记录一致。
+ *
+ * 用法（组件注册后，如在 initialize() 中）：
+ *   rng_ = &randomStream("imu_noise_" + std::to_string(getVehicleId()));
+ *   std::normal_distribution<double> noise(0.0, sigma);
+ *   double n = noise(*rng_);
+ *
+ * 流的引用在所属 RandomStreams 生命周期内有效；同一个流不应被多个线程同时使用。
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+
+namespace gnc {
+namespace core {
+
+/**
+ * @brief 计数的随机数引擎，满足 UniformRandomBitGenerator，可直接用于 std 分布
+ */
+class RandomStream {
+public:
+    using result_type = uint64_t;
+
+    explicit RandomStream(uint64_t seed) : seed_(seed), engine_(seed) {}
+
+    result_type operator()() {
+        ++position_;
+        return engine_();
+    }
+
+    static constexpr result_type min() { return std::mt19937_64::min(); }
+    static constexpr result_type max() { return std::mt19937_64::max(); }
+
+    uint64_t seed() const { return seed_; }
+
+    /**
+     * @brief 自播种以来抽取的次数
+     */
+    uint64_t position() const { return position_; }
+
+    void reseed(uint64_t seed) {
+        seed_ = seed;
+        engine_.seed(seed);
+        position_ = 0;
+    }
+
+private:
+    uint64_t seed_;
+    std::mt19937_64 engine_;
+    uint64_t position_ = 0;
+};
+
+class RandomStreams {
+public:
+    static constexpr uint64_t DEFAULT_SEED = 1;
+
+    RandomStreams() = default;
+    explicit RandomStreams(uint64_t master_seed) : master_seed_(master_seed) {}
+
+    RandomStreams(const RandomStreams&) = delete;
+    RandomStreams& operator=(const RandomStreams&) = delete;
+
+    /**
+     * @brief 设置主种子，已创建的流按新种子重新播种并归零位置
+     */
+    void setMasterSeed(uint64_t seed);
+
+    uint64_t masterSeed() const;
+
+    /**
+     * @brief 按名称获取流，不存在时创建
+     */
+    RandomStream& stream(const std::string& name);
+
+    /**
+     * @brief 各流当前位置，按名称排序
+     */
+    std::map<std::string, uint64_t> positions() const;
+
+    /**
+     * @brief 由主种子和流名称派生流种子
+     */
+    static uint64_t deriveSeed(uint64_t master_seed, const std::string& name);
+
+private:
+    mutable std::mutex mutex_;
+    uint64_t master_seed_ = DEFAULT_SEED;
+    std::map<std::string, std::unique_ptr<RandomStream>> streams_;
+};
+
+} // namespace core
+} // namespace gnc
@@ -0,0 +1,107 @@
+#ifndef GNC_CORE_REAL_TIME_EXECUTOR_HPP_
+#define GNC_CORE_REAL_TIME_EXECUTOR_HPP_
+
+#include "gnc/core/state_manager.hpp"
+#include "gnc/core/hdr_histogram.hpp"
+#include "gnc/core/input_journal.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+
+namespace gnc {
+namespace core {
+
+/**
+ * @brief 帧超时后的处理策略
+ */
+enum class OverrunPolicy {
+    SkipLogging,      ///< 下一帧跳过记录类组件（优先级不高于 logging_priority）
+    DropLowPriority,  ///< 下一帧跳过优先级低于 priority_floor 的组件
+    Abort             ///< 连续超时达到 max_consecutive_overruns 后终止运行
+};
+
+/**
+ * @brief 实时运行配置（core.yaml 中的 core.real_time）
+ */
+struct RealTimeConfig {
+    bool enabled = false;
+    double speed = 1.0;                   ///< 仿真时间/墙钟时间之比，1.0 为实时
+    int cpu = -1;                         ///< 绑定的CPU核，-1 表示不绑定
+    int fifo_priority = 0;                ///< SCHED_FIFO 优先级（1~99），0 表示不请求
+    bool lock_memory = false;             ///< mlockall 并预先触碰栈和堆
+    size_t prefault_stack_kb = 256;
+    size_t prefault_heap_mb = 16;
+    OverrunPolicy overrun_policy = OverrunPolicy::SkipLogging;
+    int logging_priority = 100;           ///< SkipLogging 策略下，优先级不高于此值的组件被跳过
+    int priority_floor = 300;             ///< DropLowPriority 策略下的优先级下限
+    uint32_t max_consecutive_overruns = 10;
+    bool load_shedding = true;            ///< 帧内接近截止时间时推迟/跳过可卸载组件
+    double shed_at_fraction = 0.8;        ///< 帧内已用时间超过周期的该比例后开始推迟
+
+    static RealTimeConfig fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @brief 实时运行统计
+ */
+struct RealTimeStatistics {
+    uint64_t frames = 0;
+    uint64_t deadline_misses = 0;         ///< 执行结束晚于本帧截止时间的帧数
+    uint64_t degraded_frames = 0;         ///< 因上一帧超时而以提高的优先级下限运行的帧数
+    uint64_t deferred_updates = 0;        ///< 推迟到帧末执行的可卸载组件更新次数
+    uint64_t shed_updates = 0;            ///< 帧预算耗尽而跳过的可卸载组件更新次数
+    bool aborted = false;
+    HdrHistogram lateness_ns{10'000'000'000ULL};  ///< 实际开始时间相对计划开始时间的延迟
+    HdrHistogram execution_ns{10'000'000'000ULL}; ///< 单帧执行耗时
+};
+
+/**
+ * @brief 以墙钟时间为节拍的实时执行器
+ *
+ * @details 每帧计划开始时间为 start + k * period，用绝对时间睡眠（Linux 上为
+ * clock_nanosleep(TIMER_ABSTIME)），避免相对睡眠的误差累积。每帧记录开始延迟和执行耗时；
+ * 执行超过截止时间时按 OverrunPolicy 处理。落后超过一个周期时重新对齐节拍，不做追帧。
+ *
+ * 开启 load_shedding 时每帧向 StateManager 设置帧预算：帧内用时超过 shed_at_fraction
+ * 后轮到的可卸载组件（core.yaml 中 sheddable: true）推迟到帧末按优先级执行，
+ * 到截止时间仍未执行的本帧跳过，从而以降级代替超时。
+ *
+ * 绑核、SCHED_FIFO 和 mlockall 仅在 Linux 上可用；权限不足时记录警告并继续运行。
+ */
+class RealTimeExecutor {
+public:
+    RealTimeExecutor(StateManager& state_manager, StateHandle<bool> should_run,
+                     double time_step_s, RealTimeConfig config);
+
+    /**
+     * @brief 运行直到 TimingManager 要求停止或按策略终止
+     */
+    const RealTimeStatistics& run();
+
+    const RealTimeStatistics& statistics() const { return stats_; }
+
+    /**
+     * @brief 在每帧前后处理外部输入并记录超时降级与卸载结果（可为空）
+     */
+    void setJournal(InputJournal* journal) { journal_ = journal; }
+
+private:
+    void configureThread();
+    void handleOverrun();
+    void clearDegradation();
+    void logStatistics() const;
+
+    StateManager& state_manager_;
+    StateHandle<bool> should_run_;
+    int64_t period_ns_;
+    RealTimeConfig config_;
+    RealTimeStatistics stats_;
+    uint32_t consecutive_overruns_ = 0;
+    bool degraded_ = false;               ///< 下一帧以提高的优先级下限运行
+    InputJournal* journal_ = nullptr;
+};
+
+} // namespace core
+} // namespace gnc
+
+#endif // GNC_CORE_REAL_TIME_EXECUTOR_HPP_
@@ -0,0 +1,100 @@
+/**
+ * @file replay_harness.hpp
+ * @brief 组件回放：用记录的日志驱动选定组件并与记录的输出比对
+ *
+ * 只创建被测组件，其余组件由 ReplaySource 代替：ReplaySource 与原生产者同名、同飞行器，
+ * 每帧把日志中对应行的数值写入状态，被测组件因此看到与原仿真相同的输入。
+ * 没有 TimingManager 记录时，由时间列合成 timing_current_s / timing_delta_s 等状态。
+ *
+ * 组件未声明依赖就读取的状态（如 SimpleAerodynamics 读取 Dynamics）需通过 sources 指定，
+ * 回放源总是先于被测组件执行，因此这类读取拿到的是本帧记录值。
+ *
+ * 每帧执行后将被测组件的输出与日志中同名状态比较（NaN 跳过），不经过 Simulator，
+ * 帧与帧之间不等待，用于快速回归和单组件性能分析（见 tools/gnc_replay.cpp）。
+ *
+ * 日志格式见 RecordedLog：二进制日志（.gnclog）记录了精确的状态类型；CSV 只保留
+ * 6 位小数，比对时需要相应放宽 tolerance。
+ */
+#pragma once
+
+#include "vehicle_layout.hpp"
+#include "../components/utility/log_reader.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace core {
+
+struct ReplayConfig {
+    std::string log_file;
+    std::vector<ComponentSpec> components;  ///< 被测组件
+    states::VehicleId vehicle = 1;          ///< 被测组件所属飞行器
+    std::vector<states::ComponentId> sources;  ///< 额外回放的组件（被测组件未声明依赖但会读取的状态）
+    double tolerance = 1e-9;                ///< 绝对误差容限
+    size_t max_frames = 0;                  ///< 0 表示回放全部记录
+    size_t repeat = 1;                      ///< 重复回放次数（仅首轮比对，用于性能测量）
+
+    static ReplayConfig fromJson(const nlohmann::json& config);
+};
+
+/**
+ * @brief 一个被测输出状态的比对结果
+ */
+struct ReplayComparison {
+    states::StateId state;
+    size_t elements = 0;                    ///< 参与比对的分量数
+    size_t samples = 0;                     ///< 参与比对的数值个数
+    size_t mismatches = 0;
+    double max_abs_error = 0.0;
+    size_t first_mismatch_frame = std::numeric_limits<size_t>::max();
+    double first_mismatch_time_s = 0.0;
+
+    bool passed() const { return mismatches == 0; }
+    nlohmann::json toJson() const;
+};
+
+struct ReplayResult {
+    size_t frames = 0;                      ///< 含重复回放的总帧数
+    size_t hosted_components = 0;
+    size_t replayed_states = 0;             ///< 由日志提供的输入状态数
+    std::vector<ReplayComparison> comparisons;
+    std::vector<std::string> unrecorded_outputs;  ///< 日志中没有记录、无法比对的输出
+    double wall_time_s = 0.0;
+    uint64_t frame_p50_ns = 0;
+    uint64_t frame_p99_ns = 0;
+    uint64_t frame_max_ns = 0;
+    double frame_mean_ns = 0.0;
+
+    bool passed() const;
+    double framesPerSecond() const { return wall_time_s > 0.0 ? static_cast<double>(frames) / wall_time_s : 0.0; }
+    nlohmann::json toJson() const;
+};
+
+class ReplayHarness {
+public:
+    /**
+     * @brief 读取 config.log_file
+     * @throws std::runtime_error 日志无法读取时抛出
+     */
+    explicit ReplayHarness(ReplayConfig config);
+
+    ReplayHarness(ReplayConfig config, components::utility::RecordedLog log);
+
+    const components::utility::RecordedLog& log() const { return log_; }
+
+    /**
+     * @brief 创建被测组件与回放源并逐帧回放
+     * @throws ConfigurationError 被测组件的必需输入不在日志中或类型无法回放时抛出
+     */
+    ReplayResult run() const;
+
+private:
+    ReplayConfig config_;
+    components::utility::RecordedLog log_;
+};
+
+} // namespace core
+} // namespace gnc
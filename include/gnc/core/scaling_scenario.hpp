@@ -0,0 +1,117 @@
+/**
+ * @file scaling_scenario.hpp
+ * @brief 合成扩展性场景：生成指定规模的组件图并驱动 Simulator 测量
+ *
+ * 场景由 vehicles 架合成飞行器组成，每架有 components_per_vehicle 个 SyntheticComponent
+ * （实例名 Syn0、Syn1……），另有 0 号飞行器上的 TimingManager（可选再加 DataLogger）。
+ * 组件 k 只读取编号更小的组件的输出，因此依赖图无环：
+ *   - fan_in：每个组件读取的本飞行器上游组件数；
+ *   - fan_out：每个组件最多被多少个本飞行器组件读取，0 表示不限；
+ *   - cross_vehicle_reads：每个组件读取下一架飞行器上游组件的个数；
+ *   - outputs_per_component / state_size：输出个数及每个输出（std::vector<double>）的长度；
+ *   - work_iterations：每次更新的模拟计算量。
+ * 连接关系由 seed 决定，同一配置每次生成相同的图。生成的配置通过 vehicle_templates 展开，
+ * 所有飞行器共享一份组件列表。
+ *
+ * run() 运行期间临时替换 ConfigManager 中的 core 配置（以及启用 DataLogger 时的
+ * utility.data_logger），返回或抛出异常时恢复原值；合成组件以场景专用的类型名注册到
+ * 组件工厂，运行结束后注销。由于配置是进程级的，多个场景的 run() 会依次执行，
+ * 且运行期间不应在其他线程上初始化 Simulator。主要用于独立的基准程序（见 tools/gnc_scaling.cpp）。
+ */
+#pragma once
+
+#include "simulator.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace core {
+
+struct ScalingScenarioConfig {
+    size_t vehicles = 10;
+    size_t components_per_vehicle = 10;
+    size_t fan_in = 2;
+    size_t fan_out = 0;
+    size_t outputs_per_component = 1;
+    size_t state_size = 3;
+    size_t cross_vehicle_reads = 0;
+    size_t work_iterations = 0;
+    bool data_logger = false;             ///< 在 0 号飞行器上加入 DataLogger，记录全部合成状态（CSV）
+    std::string data_logger_file = "logs/scaling_data.csv";
+    size_t frames = 200;
+    double time_step_s = 0.01;
+    uint64_t seed = 1;
+    nlohmann::json core_overrides = nlohmann::json::object();  ///< 合并进生成的 core 配置（如 startup）
+
+    static ScalingScenarioConfig fromJson(const nlohmann::json& config);
+    nlohmann::json toJson() const;
+};
+
+/**
+ * @brief 一个合成组件的连接关系
+ */
+struct SyntheticComponentSpec {
+    struct Input {
+        size_t component;                 ///< 上游组件编号
+        size_t output;                    ///< 上游输出编号
+        bool next_vehicle;                ///< 读取下一架合成飞行器（跨飞行器读取）
+    };
+    std::vector<Input> inputs;
+};
+
+struct SyntheticLayout {
+    ScalingScenarioConfig config;
+    states::VehicleId first_vehicle = 1;
+    std::vector<SyntheticComponentSpec> components;
+};
+
+struct ScalingResult {
+    ScalingScenarioConfig config;
+    size_t components = 0;                ///< 含 TimingManager 等基础组件
+    size_t states = 0;                    ///< 合成组件的输出状态数
+    size_t edges = 0;                     ///< 合成组件的输入声明数
+    double startup_s = 0.0;               ///< 构造 Simulator 并完成 initialize() 的墙钟时间
+    RunStatistics run;
+    uint64_t frame_p50_ns = 0;
+    uint64_t frame_p99_ns = 0;
+    uint64_t frame_max_ns = 0;
+    double frame_mean_ns = 0.0;
+    int64_t rss_before_kb = 0;            ///< 以下内存数据来自 /proc/self/status，其他平台为 0
+    int64_t rss_after_startup_kb = 0;
+    int64_t rss_after_run_kb = 0;
+    int64_t peak_rss_kb = 0;              ///< 进程级峰值，多个场景依次运行时单调不减
+
+    nlohmann::json toJson() const;
+};
+
+class ScalingScenario {
+public:
+    explicit ScalingScenario(ScalingScenarioConfig config);
+
+    const SyntheticLayout& layout() const { return *layout_; }
+
+    /**
+     * @brief 生成的 core 配置（含 vehicle_templates 与 vehicles）
+     */
+    nlohmann::json coreConfig() const;
+
+    /**
+     * @brief 生成的配置中合成组件的工厂类型名，每个场景不同
+     */
+    const std::string& componentType() const { return component_type_; }
+
+    /**
+     * @brief 临时安装配置、初始化 Simulator 并运行 config.frames 帧
+     */
+    ScalingResult run() const;
+
+private:
+    std::string component_type_;
+    std::shared_ptr<const SyntheticLayout> layout_;
+};
+
+} // namespace core
+} // namespace gnc
@@ -2,11 +2,30 @@
 #define GNC_CORE_SIMULATOR_HPP_
 
 #include "gnc/core/state_manager.hpp"
+#include "gnc/core/real_time_executor.hpp"
+#include "gnc/core/input_journal.hpp"
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
 
 namespace gnc {
 namespace core {
 
+class TimingManagerComponent;
+
+/**
+ * @brief 一次运行的吞吐统计
+ */
+struct RunStatistics {
+    uint64_t steps = 0;          ///< 执行的帧数
+    double sim_time_s = 0.0;     ///< 推进的仿真时间
+    double wall_time_s = 0.0;    ///< 消耗的墙钟时间
+
+    double stepsPerSecond() const { return wall_time_s > 0.0 ? steps / wall_time_s : 0.0; }
+    double simToWallRatio() const { return wall_time_s > 0.0 ? sim_time_s / wall_time_s : 0.0; }
+};
+
 class Simulator {
 public:
     Simulator();
@@ -21,8 +40,77 @@ public:
     void run();
     void step(); // step不再需要dt参数
 
+    /**
+     * @brief 连续执行至多 ticks 帧，TimingManager 要求停止时提前结束
+     * @details 紧凑循环：终止条件通过预解析的句柄检查，统计只在首尾各取一次时钟
+     */
+    RunStatistics runFor(uint64_t ticks);
+
+    /**
+     * @brief 连续执行直到 predicate 返回 true（每帧执行前检查）或 TimingManager 要求停止
+     */
+    RunStatistics runUntil(const std::function<bool()>& predicate);
+
+    /**
+     * @brief 实时运行：按墙钟时间为每帧定拍，可替代 run()
+     * @details 配置来自 core.real_time；core.real_time.enabled 为 true 时 run() 也会走这里。
+     * 实时模式下不使用离散事件跳跃。回放输入日志（core.journal.mode: replay）时不按墙钟定拍，
+     * run() 改为紧凑循环
+     */
+    RealTimeStatistics runRealTime();
+
+    /**
+     * @brief 本次运行的外部输入队列：其他线程在此投递配置修改和事件，于下一帧开始前生效
+     */
+    ExternalInputs& externalInputs() { return *state_manager_->externalInputs(); }
+
 private:
+    /**
+     * @brief 混合离散事件调度：没有活动飞行器时，把下一帧的时钟直接推进到最早的事件
+     */
+    void scheduleDiscreteEventJump();
+
+    /**
+     * @brief 下一帧推进后的仿真时间
+     */
+    double nextFrameTime() const;
+
+    /**
+     * @brief 紧凑执行循环，每帧执行前调用 stop(steps) 判断是否结束
+     */
+    template <typename StopCondition>
+    RunStatistics runLoop(StopCondition&& stop);
+
+    void logRunStatistics(const RunStatistics& stats) const;
+
+    /**
+     * @brief 输出按组件类型汇总的硬件性能计数器表（日志及可选的文件）
+     */
+    void writePerfSummary() const;
+
+    /**
+     * @brief 输出状态访问审计报告及数据流图（DOT / JSON，可选）
+     */
+    void writeAccessAudit() const;
+
+    /**
+     * @brief 注册仿真循环的运行指标并启动后台导出线程
+     */
+    void startMetrics(const MetricsConfig& config);
+
     std::unique_ptr<StateManager> state_manager_;
+    StateHandle<bool> should_run_;
+    TimingManagerComponent* timing_ = nullptr;
+    bool discrete_event_mode_ = false;
+    RealTimeConfig real_time_config_;
+    std::unique_ptr<PerfCounterProfiler> perf_profiler_;
+    std::string perf_summary_file_;
+    std::unique_ptr<StateAccessAudit> access_audit_;
+    size_t audit_top_n_ = 20;
+    std::string audit_dot_file_;
+    std::string audit_json_file_;
+    std::unique_ptr<InputJournal> journal_;
+    bool metrics_enabled_ = false;
     bool is_initialized_ = false;
 };
 
@@ -0,0 +1,107 @@
+/**
+ * @file startup_profiler.hpp
+ * @brief 启动阶段计时
+ *
+ * 记录初始化各阶段（配置加载、组件创建、注册、排序、组件 initialize() 等）的墙钟耗时，
+ * 同名阶段累加；另外记录每个组件 initialize() 的耗时，初始化结束时输出报告。
+ * 并行初始化时组件耗时之和可以大于 "initialize components" 阶段的耗时。
+ */
+#pragma once
+
+#include "../common/types.hpp"
+#include "../components/utility/simple_logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gnc {
+
+class StartupProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 作用域计时，析构时计入对应阶段
+     */
+    class Phase {
+    public:
+        Phase(StartupProfiler* profiler, std::string name)
+            : profiler_(profiler), name_(std::move(name)), start_(Clock::now()) {}
+
+        ~Phase() {
+            if (profiler_) {
+                profiler_->record(name_, std::chrono::duration<double>(Clock::now() - start_).count());
+            }
+        }
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+    private:
+        StartupProfiler* profiler_;
+        std::string name_;
+        Clock::time_point start_;
+    };
+
+    StartupProfiler() : start_(Clock::now()) {}
+
+    /**
+     * @brief 开始一个阶段；profiler 为空时不计时
+     */
+    static Phase phase(StartupProfiler* profiler, std::string name) {
+        return Phase(profiler, std::move(name));
+    }
+
+    void record(const std::string& name, double seconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(phases_.begin(), phases_.end(), [&name](const auto& entry) { return entry.first == name; });
+        if (it == phases_.end()) {
+            phases_.emplace_back(name, seconds);
+        } else {
+            it->second += seconds;
+        }
+    }
+
+    /**
+     * @brief 记录单个组件 initialize() 的耗时（可在初始化线程上调用）
+     */
+    void recordComponent(const states::ComponentId& id, double seconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        components_.emplace_back(id, seconds);
+    }
+
+    double elapsed() const { return std::chrono::duration<double>(Clock::now() - start_).count(); }
+
+    /**
+     * @brief 输出各阶段耗时及占比，以及耗时最长的 top_n 个组件
+     */
+    void logReport(size_t top_n = 5) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const double total = elapsed();
+        LOG_INFO("[Startup] Initialization took {:.1f} ms:", total * 1e3);
+        double accounted = 0.0;
+        for (const auto& [name, seconds] : phases_) {
+            accounted += seconds;
+            LOG_INFO("[Startup]   {:<28} {:>9.2f} ms {:>5.1f}%", name.c_str(), seconds * 1e3, 100.0 * seconds / total);
+        }
+        LOG_INFO("[Startup]   {:<28} {:>9.2f} ms {:>5.1f}%", "(other)", (total - accounted) * 1e3,
+                 100.0 * (total - accounted) / total);
+
+        std::sort(components_.begin(), components_.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+        for (size_t i = 0; i < std::min(top_n, components_.size()); ++i) {
+            const auto& [id, seconds] = components_[i];
+            LOG_INFO("[Startup]   initialize {}-{}: {:.2f} ms", id.vehicleId, id.name.c_str(), seconds * 1e3);
+        }
+    }
+
+private:
+    Clock::time_point start_;
+    std::mutex mutex_;
+    std::vector<std::pair<std::string, double>> phases_;
+    std::vector<std::pair<states::ComponentId, double>> components_;
+};
+
+} // namespace gnc
@@ -11,11 +11,47 @@
  */
 #pragma once
 #include "../common/types.hpp"
+#include "../common/exceptions.hpp"
 #include <string>
 #include <any>
+#include <cstdint>
+#include <functional>
+#include <typeinfo>
+
+namespace gnc::core {
+class RandomStreams;
+class ExternalInputs;
+} // namespace gnc::core
 
 namespace gnc::states {
 
+class IStateAccess;
+
+/**
+ * @brief 预解析的状态句柄
+ * @details 绑定时完成一次哈希查找和类型检查，之后的读取直接访问存储槽，
+ * 适用于仿真主循环等每帧都读取同一状态的场景。存储槽在 StateManager 生命周期内地址不变。
+ * 派生状态需要按需求值，不能绑定为句柄。绑定时若已开启状态访问审计，之后每次读取同样计入审计。
+ */
+template <typename T>
+class StateHandle {
+public:
+    StateHandle() = default;
+
+    bool valid() const { return value_ != nullptr; }
+
+    const T& get() const;
+
+private:
+    friend class IStateAccess;
+    StateHandle(const std::any* value, const IStateAccess* audit, const StateId* audit_key)
+        : value_(value), audit_(audit), audit_key_(audit_key) {}
+
+    const std::any* value_ = nullptr;
+    const IStateAccess* audit_ = nullptr;     ///< 绑定时开启了审计才非空
+    const StateId* audit_key_ = nullptr;
+};
+
 /**
  * @brief 状态访问接口
  * @details 定义了状态系统的核心访问接口，提供类型安全的状态读写操作
@@ -53,6 +89,106 @@ public:
         setStateImpl(id, std::any(value), typeid(T).name());
     }
 
+    /**
+     * @brief 绑定状态句柄
+     * @throws StateAccessError 状态不存在、为派生状态、类型不匹配或实现不支持句柄时抛出
+     */
+    template<typename T>
+    StateHandle<T> getStateHandle(const StateId& id) const {
+        const std::any* value = bindStateImpl(id, typeid(T));
+        const StateId* audit_key = handleAuditKey(id);
+        return StateHandle<T>(value, audit_key ? this : nullptr, audit_key);
+    }
+
+    // --- 飞行器活动状态（调度提示，默认实现视所有飞行器为活动） ---
+
+    /**
+     * @brief 设置飞行器是否处于活动状态
+     * @param vehicle 飞行器ID
+     * @param active false 表示休眠：该飞行器的所有组件在执行计划中被跳过，
+     *               其状态保持最后一次写入的值
+     */
+    virtual void setVehicleActive(VehicleId vehicle, bool active) {
+        (void)vehicle;
+        (void)active;
+    }
+
+    /**
+     * @brief 查询飞行器是否处于活动状态
+     */
+    virtual bool isVehicleActive(VehicleId vehicle) const {
+        (void)vehicle;
+        return true;
+    }
+
+    /**
+     * @brief 设置休眠飞行器的唤醒条件
+     * @param vehicle 飞行器ID
+     * @param condition 唤醒条件，仅在飞行器休眠时于每帧开始求值一次，返回true即唤醒
+     */
+    virtual void setWakeCondition(VehicleId vehicle, std::function<bool()> condition) {
+        (void)vehicle;
+        (void)condition;
+    }
+
+    /**
+     * @brief 登记一个离散事件时刻
+     * @param time_s 仿真时间（秒）。混合离散事件调度模式下，没有活动飞行器时
+     *               仿真时钟可直接跳到最早的事件时刻
+     */
+    virtual void scheduleWakeAt(double time_s) {
+        (void)time_s;
+    }
+
+    // --- 本次运行的服务（默认实现不提供） ---
+
+    /**
+     * @brief 本次运行的随机数流，种子由主种子派生
+     */
+    virtual core::RandomStreams* randomStreams() {
+        return nullptr;
+    }
+
+    /**
+     * @brief 本次运行的外部输入队列
+     */
+    virtual core::ExternalInputs* externalInputs() {
+        return nullptr;
+    }
+
+    /**
+     * @brief 本次运行中按名称共享的计数器（初值 0），供同类组件汇总统计
+     * @return 计数器地址，在状态管理器生命周期内有效；只应在仿真线程上修改
+     */
+    virtual int64_t* runCounter(const std::string& name) {
+        (void)name;
+        return nullptr;
+    }
+
+    /// 把 source 的值就地复制到 destination（两者类型相同），避免每帧重新分配
+    using StateCopier = void (*)(std::any& destination, const std::any& source);
+
+    /**
+     * @brief 登记按上一帧读取的状态：每帧开始前（任何组件更新前）保存一份快照
+     * @details 读取快照不依赖执行顺序，也不产生依赖边，适用于相互引用的跨飞行器读取
+     * @param type 请求的值类型，须与状态当前值的类型一致
+     * @return 快照地址，在状态管理器生命周期内有效
+     */
+    virtual const std::any* previousFrameState(const StateId& id, const std::type_info& type, StateCopier copy) {
+        (void)id;
+        (void)type;
+        (void)copy;
+        return nullptr;
+    }
+
+    /**
+     * @brief 状态是否被数据记录组件选中记录（记录组件初始化后有效）
+     */
+    virtual bool isStateLogged(const StateId& id) const {
+        (void)id;
+        return false;
+    }
+
 protected:
     /**
      * @brief 获取状态值的底层实现
@@ -69,6 +205,46 @@ protected:
      * @param type 类型名称（由RTTI生成）
      */
     virtual void setStateImpl(const StateId& id, const std::any& value, const std::string& type) = 0;
+
+    /**
+     * @brief 绑定状态句柄的底层实现
+     * @return 状态存储槽，在实现对象生命周期内地址不变
+     */
+    virtual const std::any* bindStateImpl(const StateId& id, const std::type_info& type) const {
+        (void)type;
+        throw StateAccessError("IStateAccess", "State '" + id.name + "' cannot be bound to a handle.");
+    }
+
+    /**
+     * @brief 开启状态访问审计时返回状态在审计中的键，否则返回 nullptr（句柄读取不计入审计）
+     */
+    virtual const StateId* handleAuditKey(const StateId& id) const {
+        (void)id;
+        return nullptr;
+    }
+
+    /**
+     * @brief 记录一次经句柄的读取，key 为 handleAuditKey() 的返回值
+     */
+    virtual void recordHandleRead(const StateId* key) const {
+        (void)key;
+    }
+
+private:
+    template <typename T>
+    friend class StateHandle;
 };
 
+template <typename T>
+const T& StateHandle<T>::get() const {
+    if (audit_) [[unlikely]] {
+        audit_->recordHandleRead(audit_key_);
+    }
+    const T* value = std::any_cast<T>(value_);
+    if (!value) {
+        throw StateAccessError("StateHandle", "Bound state is unset or its type has changed.");
+    }
+    return *value;
+}
+
 } // namespace gnc::states
\ No newline at end of file
@@ -0,0 +1,128 @@
+/**
+ * @file state_access_audit.hpp
+ * @brief 状态访问审计：统计组件实际读写了哪些状态
+ *
+ * 组件通过 declareInput<void>(ComponentId) 声明的依赖只到组件级，且不一定与
+ * get/getState 实际读取的状态一致。开启审计后 StateManager 把每次状态读写（含审计开启后
+ * 绑定的句柄的读取）记到正在更新的组件名下（派生状态求值期间的读取记到派生状态的所属
+ * 组件），据此：
+ * - 给出热点状态（每帧读取次数最多）和跨飞行器读取
+ * - 找出未声明依赖的读取；读取方与产生方之间没有任何依赖路径时，二者的相对顺序
+ *   不受保证，并行执行时会产生数据竞争
+ * - 导出状态级数据流图（DOT / JSON）
+ *
+ * 审计按指针记录访问，开销为每次读写一次哈希查找，只用于诊断运行。
+ */
+#pragma once
+
+#include "../common/types.hpp"
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gnc {
+
+class StateAccessAudit {
+public:
+    /**
+     * @brief 一个组件对一个状态的访问统计
+     */
+    struct Access {
+        states::ComponentId accessor;   ///< 访问方；组件更新之外的访问记为 [external]
+        states::StateId state;
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+        uint64_t frames = 0;            ///< 发生访问的帧数
+        uint64_t last_frame = 0;
+    };
+
+    /**
+     * @brief 数据流图的一条边：consumer 读取 producer 的状态
+     */
+    struct Edge {
+        const Access* access = nullptr;
+        bool cross_vehicle = false;     ///< 读取其他飞行器（不含全局飞行器）的状态
+        bool declared = false;          ///< consumer 声明了对 producer 的依赖
+        bool ordered = false;           ///< 依赖路径保证 producer 先于 consumer 执行
+
+        const states::ComponentId& producer() const { return access->state.component; }
+        const states::ComponentId& consumer() const { return access->accessor; }
+    };
+
+    /**
+     * @brief 依赖查询：(producer, consumer) -> bool
+     */
+    using DependencyQuery = std::function<bool(const states::ComponentId&, const states::ComponentId&)>;
+
+    void beginFrame() { ++frame_; }
+
+    uint64_t frames() const { return frame_; }
+
+    /**
+     * @param accessor 访问方组件 ID，nullptr 表示组件更新之外
+     * @param state 状态 ID，需在审计期间地址不变（StateManager 状态表中的键）
+     */
+    void recordRead(const states::ComponentId* accessor, const states::StateId* state) {
+        Access& access = lookup(accessor, state);
+        ++access.reads;
+        touch(access);
+    }
+
+    void recordWrite(const states::ComponentId* accessor, const states::StateId* state) {
+        Access& access = lookup(accessor, state);
+        ++access.writes;
+        touch(access);
+    }
+
+    /**
+     * @brief 全部访问记录
+     */
+    std::vector<const Access*> accesses() const;
+
+    /**
+     * @brief 由读取记录生成组件之间的数据流（不含组件读取自身状态）
+     * @param declared consumer 是否直接声明了对 producer 的依赖
+     * @param ordered 执行顺序是否保证 producer 先于 consumer
+     */
+    std::vector<Edge> dataflow(const DependencyQuery& declared, const DependencyQuery& ordered) const;
+
+    /**
+     * @brief 记录热点状态、跨飞行器读取和未声明依赖的读取
+     */
+    void logReport(const std::vector<Edge>& edges, size_t top_n) const;
+
+    void writeDot(std::ostream& out, const std::vector<Edge>& edges) const;
+
+    void writeJson(std::ostream& out, const std::vector<Edge>& edges) const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const std::pair<const void*, const void*>& key) const {
+            return std::hash<const void*>()(key.first) * 31 ^ std::hash<const void*>()(key.second);
+        }
+    };
+
+    Access& lookup(const states::ComponentId* accessor, const states::StateId* state) {
+        auto [it, inserted] = accesses_.try_emplace({accessor, state});
+        if (inserted) {
+            it->second.accessor = accessor ? *accessor : states::ComponentId{states::globalId, "[external]"};
+            it->second.state = *state;
+        }
+        return it->second;
+    }
+
+    void touch(Access& access) const {
+        if (access.last_frame != frame_ || access.frames == 0) {
+            access.last_frame = frame_;
+            ++access.frames;
+        }
+    }
+
+    std::unordered_map<std::pair<const void*, const void*>, Access, KeyHash> accesses_;
+    uint64_t frame_ = 0;
+};
+
+} // namespace gnc
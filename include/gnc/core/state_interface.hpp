@@ -91,6 +91,11 @@ public:
     const std::vector<StateSpec>& getInputs() const { return inputs_; }
     const std::vector<StateSpec>& getOutputs() const { return outputs_; }
 
+    /**
+     * @brief 取出输出规格（移动，之后本接口不再包含输出），避免复制默认值和计算函数
+     */
+    std::vector<StateSpec> releaseOutputs() { return std::move(outputs_); }
+
     /**
      * @brief 验证接口完整性
      * @details 检查：
@@ -3,6 +3,14 @@
 #include "component_base.hpp"
 #include "../common/exceptions.hpp"
 #include "state_access.hpp"
+#include "component_factory.hpp"
+#include "frame_memory.hpp"
+#include "allocation_tracker.hpp"
+#include "perf_counters.hpp"
+#include "state_access_audit.hpp"
+#include "metrics.hpp"
+#include "startup_profiler.hpp"
+#include "task_pool.hpp"
 #include "../../math/math.hpp"  // 添加数学类型支持
 #include <unordered_map>
 #include <unordered_set>
@@ -10,7 +18,14 @@
 #include <any>
 #include <vector>
 #include <functional> // for std::function in topological sort
+#include <algorithm>
+#include <limits>
 #include <queue> // for priority_queue in priority-aware sorting
+#include <map>
+#include <mutex>
+#include <span>
+#include <typeindex>
+#include <chrono>
 #include "../components/utility/simple_logger.hpp"
 #include "../components/utility/config_manager.hpp"
 
@@ -45,27 +60,47 @@ public:
                 delete component;
             }
         }
+        if (skippedUpdates_ > 0) {
+            LOG_INFO("[StateManager] Skipped {} component updates whose inputs were unchanged", skippedUpdates_);
+        }
+        if (droppedUpdates_ > 0) {
+            LOG_INFO("[StateManager] Dropped {} low-priority component updates under overload", droppedUpdates_);
+        }
+        if (AllocationTracker::enabled() && steadyStateFrames_ > 0) {
+            logAllocationReport();
+        }
+        if (deferredUpdates_ > 0 || shedUpdates_ > 0) {
+            LOG_INFO("[StateManager] Deferred {} sheddable component updates near the frame deadline, shed {}",
+                     deferredUpdates_, shedUpdates_);
+        }
         components_.clear();
         states_.clear();
+        componentOutputVersions_.clear();
+        derivedStates_.clear();
+        derivedDependents_.clear();
         componentDependencies_.clear();
         LOG_INFO("[StateManager] Shutdown complete.");
     }
 
-    void registerComponent(ComponentBase* component, int priority = DEFAULT_PRIORITY) {
+    /**
+     * @param priority 执行优先级（1~1000）
+     * @param sheddable 帧预算紧张时是否允许推迟或跳过该组件（如数据记录、遥测、诊断）
+     */
+    void registerComponent(ComponentBase* component, int priority = DEFAULT_PRIORITY, bool sheddable = false) {
         if (!component) return;
         auto id = component->getComponentId();
         if (components_.count(id)) {
             throw ConfigurationError("StateManager", "Component '" + id.name + "' already registered.");
         }
 
+        StateInterface interface = component->getInterface();
         try {
-            component->getInterface().validate();
+            interface.validate();
         } catch (const std::exception& e) {
             throw ConfigurationError("StateManager", "Component '" + id.name + "' interface validation failed: " + e.what());
         }
 
-        auto interface = component->getInterface();
-        
+
         // Extract component-level dependencies from simplified inputs
         std::unordered_set<ComponentId, std::hash<ComponentId>> componentDeps;
         for (const auto& spec : interface.getInputs()) {
@@ -79,15 +114,31 @@ public:
         
         // Store component priority
         componentPriorities_[id] = priority;
+        if (sheddable) {
+            sheddableComponents_.insert(id);
+        }
         
         // Initialize output states
-        for (const auto& spec : interface.getOutputs()) {
-            states_[StateId{id, spec.name}] = spec.default_value.has_value() ? std::any(spec.default_value) : std::any();
+        uint64_t& output_version = componentOutputVersions_[id];
+        for (auto& spec : interface.releaseOutputs()) {
+            StateId state_id{id, std::move(spec.name)};
+            if (spec.compute) {
+                derivedStates_[state_id].compute = std::move(spec.compute);
+            }
+            stateTypes_[state_id] = std::move(spec.type);
+            states_[std::move(state_id)] = StateSlot{std::move(spec.default_value), 0, &output_version};
         }
 
         component->setStateAccess(this);
         components_[id] = component;
-        LOG_INFO("[StateManager] Registered component: {}-{} with priority {}", id.vehicleId, id.name.c_str(), priority);
+        auto& activity = vehicleActivity_[id.vehicleId];
+        if (!activity.registered) {
+            activity.registered = true;
+            if (activity.active && id.vehicleId != globalId) {
+                ++activeVehicleCount_;
+            }
+        }
+        LOG_DEBUG("[StateManager] Registered component: {}-{} with priority {}", id.vehicleId, id.name.c_str(), priority);
         needsRevalidation_ = true;
     }
 
@@ -95,6 +146,7 @@ public:
         if (!needsRevalidation_) return;
 
         LOG_DEBUG("[StateManager] Validating dependencies and performing topological sort...");
+        const auto sort_start = StartupProfiler::Clock::now();
         
         // 1. Component priorities are already loaded during registration
         
@@ -139,15 +191,21 @@ public:
         // 5. 组件依赖验证 (增强)
         validateComponentDependencies();
 
-        // 6. 初始化所有组件
-        LOG_INFO("[StateManager] Initializing components...");
-        for (const auto& id : executionOrder_) {
-            if (components_.count(id)) {
-                LOG_DEBUG("[Initialize] -> {}", id.name.c_str());
-                components_.at(id)->initialize();
-            }
+        if (startupProfiler_) {
+            startupProfiler_->record("sort and validate",
+                                     std::chrono::duration<double>(StartupProfiler::Clock::now() - sort_start).count());
+        }
+
+        // 6. 初始化所有组件（休眠飞行器同样初始化，以便唤醒后直接运行）
+        {
+            auto phase = StartupProfiler::phase(startupProfiler_, "initialize components");
+            initializeComponents();
         }
 
+        // 7. 生成预解析的执行计划
+        auto phase = StartupProfiler::phase(startupProfiler_, "build execution plan");
+        buildExecutionPlan();
+
         needsRevalidation_ = false;
     }
 
@@ -155,12 +213,468 @@ public:
         if (needsRevalidation_) {
             validateAndSortComponents();
         }
-        for (const auto& id : executionOrder_) {
-            if (components_.count(id)) {
-                LOG_TRACE("[Update] -> {}", id.name.c_str());
-                components_.at(id)->update();
+        if (frameTime_) [[unlikely]] {
+            const auto start = MetricsRegistry::Clock::now();
+            updateFrame();
+            frameTime_->record(static_cast<uint64_t>(std::chrono::nanoseconds(MetricsRegistry::Clock::now() - start).count()));
+            framesTotal_->add();
+            if (simTime_.valid()) {
+                simTimeGauge_->set(simTime_.get());
             }
+            return;
+        }
+        updateFrame();
+    }
+
+    // --- 状态版本 ---
+
+    /**
+     * @brief 获取状态版本号
+     * @details 版本号仅在状态值实际发生变化时递增，写入相同的值不改变版本
+     * @throws StateAccessError 如果状态不存在
+     */
+    uint64_t getStateVersion(const StateId& state_id) const {
+        auto it = states_.find(state_id);
+        if (it == states_.end()) {
+            throw StateAccessError("StateManager", "State '" + state_id.name + "' not found for component '" + state_id.component.name + "'.");
         }
+        return it->second.version;
+    }
+
+    /**
+     * @brief 获取组件的输出版本号（任一输出变化时递增）
+     */
+    uint64_t getComponentOutputVersion(const ComponentId& component_id) const {
+        auto it = componentOutputVersions_.find(component_id);
+        return it == componentOutputVersions_.end() ? 0 : it->second;
+    }
+
+    /**
+     * @brief 获取因输入未变化而跳过的组件更新次数
+     */
+    uint64_t getSkippedUpdateCount() const {
+        return skippedUpdates_;
+    }
+
+    /**
+     * @brief 获取执行计划中批量更新步骤的数量
+     */
+    size_t getBatchedStepCount() const {
+        return static_cast<size_t>(std::count_if(executionPlan_.begin(), executionPlan_.end(),
+            [](const ExecutionStep& step) { return !step.batch_members.empty(); }));
+    }
+
+    // --- 过载降级 ---
+
+    /**
+     * @brief 设置优先级下限，优先级低于该值的组件在之后的帧中被跳过
+     * @param floor 0 表示不跳过任何组件
+     * @details 供实时执行器在帧超时后临时卸载低优先级组件（如 DataLogger）
+     */
+    void setPriorityFloor(int floor) {
+        priorityFloor_ = floor;
+    }
+
+    int getPriorityFloor() const {
+        return priorityFloor_;
+    }
+
+    /**
+     * @brief 获取因优先级下限而跳过的组件更新次数
+     */
+    uint64_t getDroppedUpdateCount() const {
+        return droppedUpdates_;
+    }
+
+    // --- 帧预算 ---
+
+    using BudgetClock = std::chrono::steady_clock;
+
+    /**
+     * @brief 设置帧预算，之后每帧生效直到 clearFrameBudget()
+     * @param defer_after 晚于该时刻才轮到的可卸载组件推迟到帧末执行
+     * @param deadline 帧末按优先级从高到低执行被推迟的组件，超过该时刻后剩余的本帧跳过
+     * @details 仅在预算生效时、且仅对可卸载组件读取时钟；不可卸载组件从不推迟
+     */
+    void setFrameBudget(BudgetClock::time_point defer_after, BudgetClock::time_point deadline) {
+        budgetActive_ = true;
+        deferAfter_ = defer_after;
+        budgetDeadline_ = deadline;
+    }
+
+    void clearFrameBudget() {
+        budgetActive_ = false;
+        replayedBudget_ = nullptr;
+    }
+
+    /**
+     * @brief 一帧内帧预算的卸载结果
+     */
+    struct BudgetDecisions {
+        std::vector<ComponentId> deferred;   ///< 推迟到帧末的组件（含之后被跳过的）
+        std::vector<ComponentId> shed;       ///< 本帧被跳过的组件
+
+        bool empty() const { return deferred.empty() && shed.empty(); }
+    };
+
+    /**
+     * @brief 最近一帧的卸载结果，供确定性回放记录
+     */
+    const BudgetDecisions& getLastBudgetDecisions() const {
+        return lastBudgetDecisions_;
+    }
+
+    /**
+     * @brief 用记录的卸载结果代替时钟判断，直到 clearFrameBudget()
+     * @param decisions 之后每帧使用的卸载结果，由调用方在帧间更新；必须在使用期间保持有效
+     * @details 回放时据此重现实时运行中与墙钟相关的调度，使状态逐帧一致
+     */
+    void replayBudgetDecisions(const BudgetDecisions* decisions) {
+        replayedBudget_ = decisions;
+        budgetActive_ = decisions != nullptr;
+    }
+
+    // --- 稳态分配检查（GNC_TRACK_ALLOCATIONS 构建） ---
+
+    /**
+     * @brief 组件在稳定运行阶段的全局堆分配统计
+     */
+    struct ComponentAllocationReport {
+        ComponentId component;               ///< 框架自身（非组件更新期间）的分配记为 [framework]
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        uint64_t frames = 0;                 ///< 发生分配的帧数
+        uint64_t max_per_frame = 0;
+        std::vector<std::string> sample_stack;  ///< 第一次分配的调用栈
+    };
+
+    void setAllocationCheck(const AllocationCheckConfig& config) {
+        allocationCheck_ = config;
+    }
+
+    const AllocationCheckConfig& getAllocationCheck() const {
+        return allocationCheck_;
+    }
+
+    /**
+     * @brief 稳定运行阶段（预热帧之后）的全局堆分配总次数，未开启统计时为 0
+     */
+    uint64_t getSteadyStateAllocationCount() const {
+        return steadyStateAllocations_;
+    }
+
+    /**
+     * @brief 按分配次数从多到少列出发生过分配的组件
+     */
+    std::vector<ComponentAllocationReport> getAllocationReport() const {
+        std::vector<ComponentAllocationReport> report;
+        auto add = [&report](const ComponentId& id, const AllocationStats& stats) {
+            if (stats.counters.count > 0) {
+                report.push_back({id, stats.counters.count, stats.counters.bytes, stats.frames, stats.max_per_frame,
+                                  AllocationTracker::symbolize(stats.counters)});
+            }
+        };
+        add(ComponentId{globalId, "[framework]"}, frameworkAllocations_);
+        for (const auto& [id, stats] : allocationStats_) {
+            add(id, stats);
+        }
+        std::sort(report.begin(), report.end(), [](const auto& a, const auto& b) { return a.allocations > b.allocations; });
+        return report;
+    }
+
+    // --- 硬件性能计数器 ---
+
+    /**
+     * @brief 设置性能计数器，之后每次组件更新前后读取计数并按组件类型累计
+     * @param profiler 已在仿真线程上 open() 成功的计数器，nullptr 表示关闭；由调用方持有
+     */
+    void setPerfProfiler(PerfCounterProfiler* profiler) {
+        perfProfiler_ = profiler;
+        for (auto& step : executionPlan_) {
+            resolvePerfTotals(step);
+            for (auto& member : step.batch_members) {
+                resolvePerfTotals(member);
+            }
+        }
+    }
+
+    // --- 启动 ---
+
+    /**
+     * @brief 设置启动计时，排序、组件初始化和执行计划生成计入对应阶段
+     * @param profiler 由调用方持有，nullptr 表示关闭
+     */
+    void setStartupProfiler(StartupProfiler* profiler) {
+        startupProfiler_ = profiler;
+    }
+
+    /**
+     * @brief 设置组件初始化线程数
+     * @details 大于 1 时，声明了 setIndependentInitialization 的组件在线程池上并行初始化，
+     * 其余组件仍按执行顺序在调用线程上初始化；0 表示使用硬件并发数
+     */
+    void setInitializationThreads(size_t threads) {
+        initThreads_ = threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads;
+    }
+
+    // --- 运行指标 ---
+
+    /**
+     * @brief 开始记录帧耗时、帧数和（可选）每个组件的更新耗时
+     * @param metrics 指标注册表，nullptr 表示关闭
+     * @param sim_time 仿真时间状态，有效时每帧写入 gnc_sim_time_s 仪表
+     * @param per_component 是否记录组件更新耗时，默认按组件类型汇总为一个直方图
+     * @param per_instance 为每个组件实例单独注册直方图（带车辆和组件名标签）；每个直方图约 900 KB，
+     *                     大规模场景下只宜临时开启
+     * @details 批量步骤按整批计入第一个成员（同一批成员类型相同）
+     */
+    void setMetrics(MetricsRegistry* metrics, StateHandle<double> sim_time = {}, bool per_component = true,
+                    bool per_instance = false) {
+        frameTime_ = metrics ? &metrics->histogram("gnc_frame_time_ns", "Wall time of one StateManager frame") : nullptr;
+        framesTotal_ = metrics ? &metrics->counter("gnc_frames_total", "Frames executed") : nullptr;
+        simTimeGauge_ = metrics ? &metrics->gauge("gnc_sim_time_s", "Simulation time at the end of the last frame") : nullptr;
+        simTime_ = metrics ? sim_time : StateHandle<double>{};
+        componentMetrics_ = metrics && per_component ? metrics : nullptr;
+        perInstanceMetrics_ = per_instance;
+        for (auto& step : executionPlan_) {
+            resolveUpdateTime(step);
+            for (auto& member : step.batch_members) {
+                resolveUpdateTime(member);
+            }
+        }
+    }
+
+    // --- 状态访问审计 ---
+
+    /**
+     * @brief 设置状态访问审计，之后每次状态读写记到正在更新的组件名下
+     * @details 审计期间批量步骤的成员逐个更新，以便按飞行器归属读取
+     * @param audit 审计对象，nullptr 表示关闭；由调用方持有
+     */
+    void setAccessAudit(StateAccessAudit* audit) {
+        accessAudit_ = audit;
+        auditAccessor_ = nullptr;
+    }
+
+    /**
+     * @brief 由审计记录生成状态级数据流，并按声明的依赖标注每条边
+     */
+    std::vector<StateAccessAudit::Edge> analyzeAccessAudit() const {
+        if (!accessAudit_) {
+            return {};
+        }
+        return accessAudit_->dataflow(
+            [this](const ComponentId& producer, const ComponentId& consumer) {
+                return declaresDependency(consumer, producer);
+            },
+            [this](const ComponentId& producer, const ComponentId& consumer) {
+                return isOrderedBefore(producer, consumer);
+            });
+    }
+
+    /**
+     * @brief consumer 是否直接声明了对 producer 的依赖
+     */
+    bool declaresDependency(const ComponentId& consumer, const ComponentId& producer) const {
+        auto it = componentDependencies_.find(consumer);
+        return it != componentDependencies_.end() && it->second.count(producer) > 0;
+    }
+
+    /**
+     * @brief 依赖图中是否存在从 consumer 到 producer 的路径，即 producer 必定先于 consumer 执行
+     */
+    bool isOrderedBefore(const ComponentId& producer, const ComponentId& consumer) const {
+        std::unordered_set<ComponentId, std::hash<ComponentId>> visited;
+        std::vector<ComponentId> pending{consumer};
+        while (!pending.empty()) {
+            const ComponentId current = std::move(pending.back());
+            pending.pop_back();
+            auto it = componentDependencies_.find(current);
+            if (it == componentDependencies_.end()) {
+                continue;
+            }
+            for (const auto& dependency : it->second) {
+                if (dependency == producer) {
+                    return true;
+                }
+                if (visited.insert(dependency).second) {
+                    pending.push_back(dependency);
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 获取因帧预算推迟到帧末的组件更新次数（含之后被跳过的）
+     */
+    uint64_t getDeferredUpdateCount() const {
+        return deferredUpdates_;
+    }
+
+    /**
+     * @brief 获取因帧预算耗尽而跳过的组件更新次数
+     */
+    uint64_t getShedUpdateCount() const {
+        return shedUpdates_;
+    }
+
+    /**
+     * @brief 按组件统计的跳过次数
+     */
+    const std::unordered_map<ComponentId, uint64_t, std::hash<ComponentId>>& getShedCounts() const {
+        return shedCounts_;
+    }
+
+    // --- 飞行器活动状态 ---
+
+    void setVehicleActive(VehicleId vehicle, bool active) override {
+        if (vehicle == globalId && !active) {
+            LOG_WARN("[StateManager] Global vehicle {} cannot be deactivated, request ignored", vehicle);
+            return;
+        }
+
+        auto& activity = vehicleActivity_[vehicle];
+        if (activity.active == active) {
+            return;
+        }
+        activity.active = active;
+        if (activity.registered && vehicle != globalId) {
+            if (active) {
+                ++activeVehicleCount_;
+            } else {
+                --activeVehicleCount_;
+            }
+        }
+
+        auto it = std::find(sleepingVehicles_.begin(), sleepingVehicles_.end(), vehicle);
+        if (active) {
+            if (it != sleepingVehicles_.end()) {
+                sleepingVehicles_.erase(it);
+            }
+            LOG_DEBUG("[StateManager] Vehicle {} activated", vehicle);
+        } else {
+            if (it == sleepingVehicles_.end()) {
+                sleepingVehicles_.push_back(vehicle);
+            }
+            LOG_DEBUG("[StateManager] Vehicle {} deactivated, its components will be skipped", vehicle);
+        }
+    }
+
+    bool isVehicleActive(VehicleId vehicle) const override {
+        auto it = vehicleActivity_.find(vehicle);
+        return it == vehicleActivity_.end() || it->second.active;
+    }
+
+    // --- 离散事件 ---
+
+    void scheduleWakeAt(double time_s) override {
+        pendingEvents_.push(time_s);
+    }
+
+    // --- 本次运行的服务 ---
+
+    /**
+     * @brief 本次运行的随机数流；主种子须在组件取流之前设置
+     */
+    core::RandomStreams* randomStreams() override {
+        return &randomStreams_;
+    }
+
+    /**
+     * @brief 本次运行的外部输入队列，可从任意线程投递
+     */
+    core::ExternalInputs* externalInputs() override {
+        return &externalInputs_;
+    }
+
+    int64_t* runCounter(const std::string& name) override {
+        std::lock_guard<std::mutex> lock(runServicesMutex_);
+        return &runCounters_[name];
+    }
+
+    /**
+     * @throws std::runtime_error 状态不存在、尚无值或类型不符时抛出；此时不登记快照
+     */
+    const std::any* previousFrameState(const StateId& id, const std::type_info& type, StateCopier copy) override {
+        std::lock_guard<std::mutex> lock(runServicesMutex_);
+        const std::string path = std::to_string(id.component.vehicleId) + "." + id.component.name + "." + id.name;
+        auto slot = states_.find(id);
+        if (slot == states_.end()) {
+            throw std::runtime_error("Previous-frame state " + path + " does not exist");
+        }
+        // 复制函数按 type 直接取值，登记前必须确认类型，否则每帧复制时会解引用空指针
+        if (!slot->second.value.has_value()) {
+            throw std::runtime_error("Previous-frame state " + path + " has no value yet");
+        }
+        if (slot->second.value.type() != type) {
+            throw std::runtime_error("Previous-frame state " + path + " has a different type");
+        }
+        auto [snapshot, inserted] = previousFrameStates_.try_emplace(id, slot->second.value);
+        if (inserted) {
+            previousFrameCopies_.push_back({&slot->second, &snapshot->second, copy});
+        }
+        return &snapshot->second;
+    }
+
+    bool isStateLogged(const StateId& id) const override {
+        return loggedStates_.count(id) > 0;
+    }
+
+    /**
+     * @brief 记录组件登记其选中的状态，供 isStateLogged() 查询
+     */
+    void markStateLogged(const StateId& id) {
+        std::lock_guard<std::mutex> lock(runServicesMutex_);
+        loggedStates_.insert(id);
+    }
+
+    /**
+     * @brief 获取晚于 now_s 的最早事件时刻，已过期的事件被丢弃
+     * @return 没有待处理事件时返回 false
+     */
+    bool nextEventTime(double now_s, double& event_s) {
+        while (!pendingEvents_.empty() && pendingEvents_.top() <= now_s + EVENT_TOLERANCE_S) {
+            pendingEvents_.pop();
+        }
+        if (pendingEvents_.empty()) {
+            return false;
+        }
+        event_s = pendingEvents_.top();
+        return true;
+    }
+
+    /**
+     * @brief 混合离散事件调度的跳跃目标：没有活动的非全局飞行器时取晚于 now_s 的最早事件
+     * @return 有飞行器需要连续积分或没有待处理事件时返回 false
+     */
+    bool nextDiscreteEventJump(double now_s, double& event_s) {
+        return !hasActiveVehicles() && nextEventTime(now_s, event_s);
+    }
+
+    /**
+     * @brief 是否有非全局飞行器处于活动状态（即存在需要连续积分的动力学）
+     */
+    bool hasActiveVehicles() const {
+        return activeVehicleCount_ > 0;
+    }
+
+    /**
+     * @brief 已注册组件且处于活动状态的非全局飞行器数量，在注册和休眠/唤醒时维护
+     */
+    size_t getActiveVehicleCount() const {
+        return activeVehicleCount_;
+    }
+
+    void setWakeCondition(VehicleId vehicle, std::function<bool()> condition) override {
+        vehicleActivity_[vehicle].wake_condition = std::move(condition);
+    }
+
+    /**
+     * @brief 获取当前处于休眠状态的飞行器数量
+     */
+    size_t getSleepingVehicleCount() const {
+        return sleepingVehicles_.size();
     }
 
     /**
@@ -199,11 +713,9 @@ public:
      */
     std::vector<StateId> getAllOutputStates() const {
         std::vector<StateId> all_states;
-        for (const auto& [component_id, component] : components_) {
-            auto interface = component->getInterface();
-            for (const auto& output : interface.getOutputs()) {
-                all_states.push_back(StateId{component_id, output.name});
-            }
+        all_states.reserve(states_.size());
+        for (const auto& [state_id, slot] : states_) {
+            all_states.push_back(state_id);
         }
         return all_states;
     }
@@ -214,16 +726,29 @@ public:
      * @return 状态的类型名称字符串，如果状态不存在则返回空字符串
      */
     std::string getStateType(const StateId& state_id) const {
-        auto it = components_.find(state_id.component);
-        if (it != components_.end()) {
-            auto interface = it->second->getInterface();
-            for (const auto& output : interface.getOutputs()) {
-                if (output.name == state_id.name) {
-                    return output.type;
-                }
+        auto it = stateTypes_.find(state_id);
+        return it != stateTypes_.end() ? it->second : "";
+    }
+
+    /**
+     * @brief 全部已存储状态值的哈希，用于逐帧比较两次运行是否一致
+     * @details 与遍历顺序无关，只在同一构建的两次运行之间可比。派生状态不求值、不参与；
+     * anyEquals 不支持的类型只计入状态标识
+     */
+    uint64_t computeStateHash() const {
+        uint64_t hash = 0;
+        for (const auto& [id, slot] : states_) {
+            if (!derivedStates_.empty() && derivedStates_.count(id)) {
+                continue;
             }
+            // 逐项混合后相加，结果与 unordered_map 的遍历顺序无关
+            uint64_t item = std::hash<StateId>{}(id) ^ (hashValue(slot.value) * 0x9E3779B97F4A7C15ULL);
+            item ^= item >> 33;
+            item *= 0xFF51AFD7ED558CCDULL;
+            item ^= item >> 33;
+            hash += item;
         }
-        return "";
+        return hash;
     }
 
     /**
@@ -235,15 +760,39 @@ public:
     const std::any& getRawStateValue(const StateId& state_id) const {
         auto it = states_.find(state_id);
         if (it != states_.end()) {
-            return it->second;
+            if (accessAudit_) [[unlikely]] {
+                accessAudit_->recordRead(auditAccessor_, &it->first);
+            }
+            // 派生状态在这里同样按需求值，DataLogger等观察者的读取会触发计算
+            return derivedStates_.empty() ? it->second.value : resolveState(state_id, it->second.value);
         }
         throw StateAccessError("StateManager", "State '" + state_id.name + "' not found for component '" + state_id.component.name + "'.");
     }
 
+    /**
+     * @brief 获取派生状态的依赖列表（由最近的求值记录）
+     * @param state_id 派生状态标识符
+     * @return 依赖的状态ID；普通状态或尚未求值时为空
+     */
+    std::vector<StateId> getDerivedStateDependencies(const StateId& state_id) const {
+        auto it = derivedStates_.find(state_id);
+        if (it == derivedStates_.end()) {
+            return {};
+        }
+        return std::vector<StateId>(it->second.dependencies.begin(), it->second.dependencies.end());
+    }
+
 protected:
     const std::any& getStateImpl(const StateId& id, const std::string& type) const override {
-        if (states_.count(id)) {
-            const auto& value = states_.at(id);
+        if (!evaluationStack_.empty()) {
+            recordDerivedDependency(id);
+        }
+        auto it = states_.find(id);
+        if (it != states_.end()) {
+            if (accessAudit_) [[unlikely]] {
+                accessAudit_->recordRead(auditAccessor_, &it->first);
+            }
+            const auto& value = derivedStates_.empty() ? it->second.value : resolveState(id, it->second.value);
             if (value.type() == typeid(void)) {
                  throw StateAccessError("StateManager", "State '" + id.name + "' of component '" + id.component.name + "' has not been initialized (is empty).");
             }
@@ -257,9 +806,55 @@ protected:
         throw StateAccessError("StateManager", "State '" + id.name + "' not found for component '" + id.component.name + "'.");
     }
 
+    const std::any* bindStateImpl(const StateId& id, const std::type_info& type) const override {
+        auto it = states_.find(id);
+        if (it == states_.end()) {
+            throw StateAccessError("StateManager", "State '" + id.name + "' not found for component '" + id.component.name + "'.");
+        }
+        if (derivedStates_.count(id)) {
+            throw StateAccessError("StateManager", "Derived state '" + id.name + "' cannot be bound to a handle.");
+        }
+        const std::any& value = it->second.value;
+        if (value.has_value() && value.type() != type) {
+            throw StateAccessError("StateManager", "Type mismatch for state '" + id.name + "'. Requested " +
+                                   type.name() + " but has " + value.type().name());
+        }
+        return &value;
+    }
+
+    const StateId* handleAuditKey(const StateId& id) const override {
+        if (!accessAudit_) {
+            return nullptr;
+        }
+        auto it = states_.find(id);
+        return it != states_.end() ? &it->first : nullptr;
+    }
+
+    void recordHandleRead(const StateId* key) const override {
+        // 审计可能在绑定之后被关闭
+        if (accessAudit_) {
+            accessAudit_->recordRead(auditAccessor_, key);
+        }
+    }
+
     void setStateImpl(const StateId& id, const std::any& value, const std::string& /* type */) override {
-         if (states_.count(id)) {
-            states_[id] = value;
+        auto it = states_.find(id);
+        if (it != states_.end()) {
+            if (accessAudit_) [[unlikely]] {
+                accessAudit_->recordWrite(auditAccessor_, &it->first);
+            }
+            if (!derivedStates_.empty()) {
+                if (derivedStates_.count(id)) {
+                    throw StateAccessError("StateManager", "Derived state '" + id.name + "' is read-only.");
+                }
+                invalidateDependents(id);
+            }
+            StateSlot& slot = it->second;
+            if (!anyEquals(slot.value, value)) {
+                slot.value = value;
+                ++slot.version;
+                ++*slot.owner_version;
+            }
         } else {
             // 原则上不应该发生，因为输出状态在注册时已创建
             throw StateAccessError("StateManager", "Attempt to set an undeclared output state '" + id.name + "'.");
@@ -267,6 +862,794 @@ protected:
     }
 
 private:
+    /**
+     * @brief 按执行顺序初始化全部组件
+     * @details 独立初始化的组件提交到线程池，先等待其依赖（含并行初始化中的依赖）完成；
+     * 其他组件在调用线程上初始化，开始前同样等待并行初始化中的依赖。
+     * 任一组件初始化失败时等待其余任务结束后抛出第一个异常
+     */
+    void initializeComponents() {
+        LOG_INFO("[StateManager] Initializing components...");
+        std::unordered_map<ComponentId, std::shared_future<void>, std::hash<ComponentId>> pending;
+        std::vector<std::shared_future<void>> all_pending;
+        std::unique_ptr<TaskPool> pool;
+
+        auto initializeOne = [this](ComponentBase* component) {
+            const auto start = StartupProfiler::Clock::now();
+            LOG_DEBUG("[Initialize] -> {}", component->getName().c_str());
+            component->initialize();
+            if (startupProfiler_) {
+                startupProfiler_->recordComponent(component->getComponentId(),
+                                                  std::chrono::duration<double>(StartupProfiler::Clock::now() - start).count());
+            }
+        };
+        // 组件依赖中仍在并行初始化的部分
+        auto pendingDependencies = [this, &pending](const ComponentId& id) {
+            std::vector<std::shared_future<void>> dependencies;
+            auto deps_it = componentDependencies_.find(id);
+            if (deps_it != componentDependencies_.end()) {
+                for (const auto& dependency : deps_it->second) {
+                    auto it = pending.find(dependency);
+                    if (it != pending.end()) {
+                        dependencies.push_back(it->second);
+                    }
+                }
+            }
+            return dependencies;
+        };
+
+        try {
+            for (const auto& id : executionOrder_) {
+                auto it = components_.find(id);
+                if (it == components_.end()) {
+                    continue;
+                }
+                ComponentBase* component = it->second;
+                auto dependencies = pendingDependencies(id);
+                if (initThreads_ > 1 && component->isIndependentInitialization()) {
+                    if (!pool) {
+                        const auto independent = std::count_if(components_.begin(), components_.end(), [](const auto& entry) {
+                            return entry.second->isIndependentInitialization();
+                        });
+                        pool = std::make_unique<TaskPool>(std::min(initThreads_, static_cast<size_t>(independent)));
+                    }
+                    // 依赖都是更早提交的任务，FIFO 保证等待不会死锁
+                    std::shared_future<void> future = pool->submit([initializeOne, component, dependencies]() {
+                        for (const auto& dependency : dependencies) {
+                            dependency.get();
+                        }
+                        initializeOne(component);
+                    }).share();
+                    pending.emplace(id, future);
+                    all_pending.push_back(std::move(future));
+                    continue;
+                }
+                for (const auto& dependency : dependencies) {
+                    dependency.get();
+                }
+                initializeOne(component);
+            }
+        } catch (...) {
+            for (const auto& future : all_pending) {
+                future.wait();
+            }
+            throw;
+        }
+        for (const auto& future : all_pending) {
+            future.wait();
+        }
+        for (const auto& future : all_pending) {
+            future.get();
+        }
+        if (!all_pending.empty()) {
+            LOG_INFO("[StateManager] Initialized {} independent components on {} threads", all_pending.size(), pool->size());
+        }
+    }
+
+    /**
+     * @brief 执行一帧（不含帧耗时统计）
+     */
+    void updateFrame() {
+        // 新的一帧：所有派生状态的缓存随帧号自动失效，上一帧的临时内存整体回收
+        ++frameCounter_;
+        FrameMemory::local().reset();
+        for (auto& copy : previousFrameCopies_) {
+            copy.copy(*copy.snapshot, copy.slot->value);
+        }
+        lastBudgetDecisions_.deferred.clear();
+        lastBudgetDecisions_.shed.clear();
+        if (accessAudit_) [[unlikely]] {
+            accessAudit_->beginFrame();
+        }
+        if constexpr (AllocationTracker::enabled()) {
+            if (frameCounter_ > allocationCheck_.warmup_frames) {
+                runTrackedFrame();
+                return;
+            }
+        }
+        runFrame();
+    }
+
+    /**
+     * @brief 状态存储槽
+     */
+    struct StateSlot {
+        std::any value;                     ///< 状态值
+        uint64_t version = 0;               ///< 值发生变化时递增
+        uint64_t* owner_version = nullptr;  ///< 所属组件的输出版本（指向 componentOutputVersions_）
+    };
+
+    /**
+     * @brief 比较两个 std::any 的值是否相等
+     * @details 对常用状态类型做类型分派，未知类型一律视为不相等（即总是"已变化"）
+     */
+    static bool anyEquals(const std::any& a, const std::any& b) {
+        if (a.type() != b.type()) {
+            return false;
+        }
+        const std::type_info& type = a.type();
+        if (type == typeid(void)) {
+            return true;
+        } else if (type == typeid(double)) {
+            return *std::any_cast<double>(&a) == *std::any_cast<double>(&b);
+        } else if (type == typeid(int)) {
+            return *std::any_cast<int>(&a) == *std::any_cast<int>(&b);
+        } else if (type == typeid(bool)) {
+            return *std::any_cast<bool>(&a) == *std::any_cast<bool>(&b);
+        } else if (type == typeid(uint64_t)) {
+            return *std::any_cast<uint64_t>(&a) == *std::any_cast<uint64_t>(&b);
+        } else if (type == typeid(std::string)) {
+            return *std::any_cast<std::string>(&a) == *std::any_cast<std::string>(&b);
+        } else if (type == typeid(Vector3d)) {
+            return *std::any_cast<Vector3d>(&a) == *std::any_cast<Vector3d>(&b);
+        } else if (type == typeid(Quaterniond)) {
+            return std::any_cast<Quaterniond>(&a)->coeffs() == std::any_cast<Quaterniond>(&b)->coeffs();
+        } else if (type == typeid(std::vector<double>)) {
+            return *std::any_cast<std::vector<double>>(&a) == *std::any_cast<std::vector<double>>(&b);
+        }
+        return false;
+    }
+
+    /**
+     * @brief 状态值的 FNV-1a 哈希（按位），类型与 anyEquals 一致
+     */
+    static uint64_t hashValue(const std::any& value) {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        auto bytes = [&hash](const void* data, size_t size) {
+            const auto* p = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ p[i]) * 0x100000001B3ULL;
+            }
+        };
+        const std::type_info& type = value.type();
+        if (type == typeid(double)) {
+            bytes(std::any_cast<double>(&value), sizeof(double));
+        } else if (type == typeid(int)) {
+            bytes(std::any_cast<int>(&value), sizeof(int));
+        } else if (type == typeid(bool)) {
+            const unsigned char b = *std::any_cast<bool>(&value) ? 1 : 0;
+            bytes(&b, 1);
+        } else if (type == typeid(uint64_t)) {
+            bytes(std::any_cast<uint64_t>(&value), sizeof(uint64_t));
+        } else if (type == typeid(std::string)) {
+            const auto& text = *std::any_cast<std::string>(&value);
+            bytes(text.data(), text.size());
+        } else if (type == typeid(Vector3d)) {
+            bytes(std::any_cast<Vector3d>(&value)->data(), 3 * sizeof(double));
+        } else if (type == typeid(Quaterniond)) {
+            bytes(std::any_cast<Quaterniond>(&value)->coeffs().data(), 4 * sizeof(double));
+        } else if (type == typeid(std::vector<double>)) {
+            const auto& values = *std::any_cast<std::vector<double>>(&value);
+            bytes(values.data(), values.size() * sizeof(double));
+        }
+        return hash;
+    }
+
+    /**
+     * @brief 飞行器活动状态
+     */
+    struct VehicleActivity {
+        bool active = true;                   ///< 是否活动
+        bool registered = false;              ///< 是否已有组件注册，只有这类飞行器计入活动数量
+        std::function<bool()> wake_condition; ///< 休眠期间的唤醒条件（可选）
+    };
+
+    /**
+     * @brief 派生状态（惰性求值，按帧缓存）
+     */
+    struct DerivedState {
+        std::function<std::any()> compute;   ///< 计算函数
+        std::any value;                      ///< 缓存的求值结果
+        uint64_t evaluated_frame = NOT_EVALUATED;  ///< 求值时的帧号
+        bool evaluating = false;             ///< 正在求值（用于循环检测）
+        StateSlot* slot = nullptr;           ///< 对应的状态存储槽（用于版本号）
+        std::unordered_set<StateId, std::hash<StateId>> dependencies;  ///< 求值时读取过的状态
+    };
+
+    static constexpr uint64_t NOT_EVALUATED = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * @brief 组件的稳态分配统计
+     */
+    struct AllocationStats {
+        AllocationCounters counters;
+        uint64_t frames = 0;         ///< 发生分配的帧数
+        uint64_t max_per_frame = 0;
+    };
+
+    /**
+     * @brief 执行计划中的一步
+     * @details 组件指针和活动状态指针在排序后一次性解析，避免每帧的哈希查找
+     */
+    struct ExecutionStep {
+        ComponentBase* component = nullptr;
+        const ComponentId* id = nullptr;     ///< components_ 中的键，地址稳定
+        const VehicleActivity* activity = nullptr;
+        int priority = DEFAULT_PRIORITY;
+        bool sheddable = false;              ///< 帧预算紧张时可推迟或跳过
+        std::vector<DerivedState*> derived;  ///< 该组件的派生输出，组件更新后失效
+
+        // "输入未变化时跳过"策略
+        bool skip_if_inputs_unchanged = false;
+        bool has_run = false;
+        std::vector<const uint64_t*> input_versions;  ///< 声明的输入（组件输出版本或状态版本）
+        std::vector<uint64_t> seen_versions;          ///< 上次执行时看到的输入版本
+
+        AllocationStats* allocations = nullptr;  ///< 稳态分配统计（GNC_TRACK_ALLOCATIONS）
+        PerfCounterProfiler::Totals* perf = nullptr;  ///< 该组件类型的性能计数器累计
+        MetricsHistogram* update_time = nullptr;      ///< 该组件的更新耗时（运行指标）
+
+        // 批量更新：非空时本步骤代表同一类型的一组组件，component 为空
+        BatchUpdater batch_updater = nullptr;
+        std::vector<ExecutionStep> batch_members;
+    };
+
+    /**
+     * @brief 检查组件的输入版本自上次执行后是否都未变化，并记录当前版本
+     */
+    static bool inputsUnchanged(ExecutionStep& step) {
+        bool unchanged = step.has_run;
+        for (size_t i = 0; i < step.input_versions.size(); ++i) {
+            uint64_t version = *step.input_versions[i];
+            if (version != step.seen_versions[i]) {
+                step.seen_versions[i] = version;
+                unchanged = false;
+            }
+        }
+        step.has_run = true;
+        return unchanged;
+    }
+
+    /**
+     * @brief 判断本帧是否需要执行该步骤（飞行器活动且输入已变化）
+     */
+    bool shouldRun(ExecutionStep& step) {
+        if (!step.activity->active) {
+            return false;
+        }
+        if (step.priority < priorityFloor_) {
+            ++droppedUpdates_;
+            return false;
+        }
+        if (step.sheddable && budgetActive_ && shouldDefer(step)) {
+            ++deferredUpdates_;
+            deferredSteps_.push_back(&step);
+            lastBudgetDecisions_.deferred.push_back(step.component->getComponentId());
+            return false;
+        }
+        if (step.skip_if_inputs_unchanged && inputsUnchanged(step)) {
+            ++skippedUpdates_;
+            return false;
+        }
+        return true;
+    }
+
+    bool shouldDefer(const ExecutionStep& step) const {
+        if (replayedBudget_) {
+            const auto& deferred = replayedBudget_->deferred;
+            return std::find(deferred.begin(), deferred.end(), step.component->getComponentId()) != deferred.end();
+        }
+        return BudgetClock::now() >= deferAfter_;
+    }
+
+    bool shouldShed(const ExecutionStep& step) const {
+        if (replayedBudget_) {
+            const auto& shed = replayedBudget_->shed;
+            return std::find(shed.begin(), shed.end(), step.component->getComponentId()) != shed.end();
+        }
+        return BudgetClock::now() >= budgetDeadline_;
+    }
+
+    /**
+     * @brief 组件更新后的处理
+     * @details 组件内部数据已变化，本帧内之前的派生求值结果作废；
+     * 派生值无法廉价比较，保守地视为已变化
+     */
+    static void afterUpdate(ExecutionStep& step) {
+        for (DerivedState* derived : step.derived) {
+            derived->evaluated_frame = NOT_EVALUATED;
+            ++derived->slot->version;
+            ++*derived->slot->owner_version;
+        }
+    }
+
+    /**
+     * @brief 执行一帧
+     */
+    void runFrame() {
+        if (!sleepingVehicles_.empty()) {
+            evaluateWakeConditions();
+        }
+        for (auto& step : executionPlan_) {
+            if (!step.batch_members.empty()) {
+                runBatch(step);
+                continue;
+            }
+            if (!shouldRun(step)) {
+                continue;
+            }
+            LOG_TRACE("[Update] -> {}", step.component->getName().c_str());
+            instrumentedUpdate(step, [&step]() { step.component->update(); });
+            afterUpdate(step);
+        }
+        if (!deferredSteps_.empty()) {
+            runDeferred();
+        }
+        auditAccessor_ = nullptr;
+    }
+
+    /**
+     * @brief 稳定运行阶段的一帧：统计全局堆分配并归属到正在更新的组件
+     * @details 组件更新之外的分配（唤醒条件、延迟执行等框架开销）记为 [framework]。
+     * 首次发现分配时告警一次；fail_on_allocation 时抛出 AllocationError
+     */
+    void runTrackedFrame() {
+        if (steadyStateFrames_ == 0) {
+            AllocationTracker::setStackSampling(allocationCheck_.sample_stacks);
+        }
+        const uint64_t count_before = AllocationTracker::allocationCount();
+        const uint64_t bytes_before = AllocationTracker::allocatedBytes();
+        const uint64_t framework_before = frameworkAllocations_.counters.count;
+        allocatingComponents_.clear();
+        trackingFrame_ = true;
+        {
+            AllocationTracker::Scope scope(&frameworkAllocations_.counters);
+            runFrame();
+        }
+        trackingFrame_ = false;
+        recordAllocations(frameworkAllocations_, framework_before, nullptr);
+
+        const uint64_t allocations = AllocationTracker::allocationCount() - count_before;
+        ++steadyStateFrames_;
+        steadyStateAllocations_ += allocations;
+        steadyStateAllocatedBytes_ += AllocationTracker::allocatedBytes() - bytes_before;
+        if (allocations == 0) {
+            return;
+        }
+        std::string culprits;
+        for (const ComponentBase* component : allocatingComponents_) {
+            culprits += (culprits.empty() ? "" : ", ") + component->getName();
+        }
+        if (culprits.empty()) {
+            culprits = "[framework]";
+        }
+        if (allocationCheck_.fail_on_allocation) {
+            throw AllocationError("StateManager", "Frame " + std::to_string(frameCounter_) + " made " +
+                                  std::to_string(allocations) + " global allocations after warm-up in: " + culprits);
+        }
+        if (steadyStateAllocations_ == allocations) {
+            LOG_WARN("[StateManager] Frame {} made {} global allocations after warm-up in: {}",
+                     frameCounter_, allocations, culprits.c_str());
+        }
+    }
+
+    /**
+     * @brief 执行组件更新；开启运行指标时记录更新耗时
+     * @details 批量步骤按整批计入第一个成员（同一批成员类型相同）
+     */
+    template <typename Update>
+    void instrumentedUpdate(ExecutionStep& step, Update&& update) {
+        if (accessAudit_) [[unlikely]] {
+            auditAccessor_ = step.id;
+        }
+        if (step.update_time) [[unlikely]] {
+            const auto start = MetricsRegistry::Clock::now();
+            countedUpdate(step, update);
+            step.update_time->record(static_cast<uint64_t>(std::chrono::nanoseconds(MetricsRegistry::Clock::now() - start).count()));
+            return;
+        }
+        countedUpdate(step, update);
+    }
+
+    /**
+     * @brief 执行组件更新；开启性能计数器时读取更新前后的计数
+     * @details 批量步骤按整批计入第一个成员的类型
+     */
+    template <typename Update>
+    void countedUpdate(ExecutionStep& step, Update&& update) {
+        if (step.perf) [[unlikely]] {
+            const PerfCounterProfiler::Sample before = perfProfiler_->read();
+            trackedUpdate(step, update);
+            perfProfiler_->accumulate(*step.perf, before);
+            return;
+        }
+        trackedUpdate(step, update);
+    }
+
+    void resolvePerfTotals(ExecutionStep& step) {
+        step.perf = perfProfiler_ && step.component ? perfProfiler_->totalsFor(step.component->getComponentType()) : nullptr;
+    }
+
+    void resolveUpdateTime(ExecutionStep& step) {
+        if (!componentMetrics_ || !step.component) {
+            step.update_time = nullptr;
+            return;
+        }
+        MetricsRegistry::Labels labels;
+        if (perInstanceMetrics_) {
+            labels = {{"vehicle", std::to_string(step.component->getVehicleId())}, {"component", step.component->getName()}};
+        }
+        labels.emplace_back("type", step.component->getComponentType());
+        // 按类型汇总时同类型的所有步骤共享一个直方图，它们都在仿真线程上依次记录
+        step.update_time = &componentMetrics_->histogram("gnc_component_update_ns", "Wall time of one component update",
+                                                         labels);
+    }
+
+    /**
+     * @brief 执行组件更新；稳定运行阶段将期间的分配记到该组件名下
+     * @details 批量步骤的分配记到第一个成员名下
+     */
+    template <typename Update>
+    void trackedUpdate(ExecutionStep& step, Update&& update) {
+        if constexpr (AllocationTracker::enabled()) {
+            if (trackingFrame_ && step.allocations) {
+                AllocationStats& stats = *step.allocations;
+                const uint64_t before = stats.counters.count;
+                {
+                    AllocationTracker::Scope scope(&stats.counters);
+                    update();
+                }
+                recordAllocations(stats, before, step.component);
+                return;
+            }
+        }
+        update();
+    }
+
+    void recordAllocations(AllocationStats& stats, uint64_t count_before, const ComponentBase* component) {
+        const uint64_t allocations = stats.counters.count - count_before;
+        if (allocations == 0) {
+            return;
+        }
+        ++stats.frames;
+        stats.max_per_frame = std::max(stats.max_per_frame, allocations);
+        if (component) {
+            allocatingComponents_.push_back(component);
+        }
+    }
+
+    void logAllocationReport() const {
+        LOG_INFO("[StateManager] {} global allocations ({} bytes) in {} steady-state frames, frame memory peak {} bytes",
+                 steadyStateAllocations_, steadyStateAllocatedBytes_, steadyStateFrames_, FrameMemory::local().peakBytes());
+        constexpr size_t MAX_LOGGED_FRAMES = 8;
+        for (const auto& entry : getAllocationReport()) {
+            LOG_INFO("[StateManager]   {}-{}: {} allocations ({} bytes) in {} frames, max {} per frame",
+                     entry.component.vehicleId, entry.component.name.c_str(), entry.allocations, entry.bytes,
+                     entry.frames, entry.max_per_frame);
+            for (size_t i = 0; i < std::min(entry.sample_stack.size(), MAX_LOGGED_FRAMES); ++i) {
+                LOG_INFO("[StateManager]       at {}", entry.sample_stack[i].c_str());
+            }
+        }
+    }
+
+    /**
+     * @brief 帧末执行被推迟的可卸载组件
+     * @details 按优先级从高到低执行，到达帧截止时间后其余组件本帧跳过。
+     * 被推迟的组件在本帧内晚于其下游组件执行，下游读取的是上一帧的输出
+     */
+    void runDeferred() {
+        std::stable_sort(deferredSteps_.begin(), deferredSteps_.end(),
+                         [](const ExecutionStep* a, const ExecutionStep* b) { return a->priority > b->priority; });
+        for (ExecutionStep* step : deferredSteps_) {
+            if (shouldShed(*step)) {
+                ++shedUpdates_;
+                ++shedCounts_[step->component->getComponentId()];
+                lastBudgetDecisions_.shed.push_back(step->component->getComponentId());
+                continue;
+            }
+            if (step->skip_if_inputs_unchanged && inputsUnchanged(*step)) {
+                ++skippedUpdates_;
+                continue;
+            }
+            LOG_TRACE("[Update] -> {} (deferred)", step->component->getName().c_str());
+            instrumentedUpdate(*step, [step]() { step->component->update(); });
+            afterUpdate(*step);
+        }
+        deferredSteps_.clear();
+    }
+
+    /**
+     * @brief 执行批量步骤：筛选本帧需要更新的成员，一次调用批量更新函数
+     * @details 只剩一个成员或开启状态访问审计时逐个调用 update()，无需经过批量函数
+     */
+    void runBatch(ExecutionStep& batch) {
+        batchComponents_.clear();
+        batchSteps_.clear();
+        for (auto& member : batch.batch_members) {
+            if (shouldRun(member)) {
+                batchComponents_.push_back(member.component);
+                batchSteps_.push_back(&member);
+            }
+        }
+        if (batchComponents_.empty()) {
+            return;
+        }
+        if (batchComponents_.size() == 1 || accessAudit_) {
+            for (ExecutionStep* member : batchSteps_) {
+                instrumentedUpdate(*member, [member]() { member->component->update(); });
+            }
+        } else {
+            LOG_TRACE("[Update] -> batch of {} {}", batchComponents_.size(),
+                      batchComponents_.front()->getComponentType().c_str());
+            instrumentedUpdate(*batchSteps_.front(), [this, &batch]() {
+                batch.batch_updater(std::span<ComponentBase* const>(batchComponents_));
+            });
+        }
+        for (ExecutionStep* member : batchSteps_) {
+            afterUpdate(*member);
+        }
+    }
+
+    /**
+     * @brief 若为派生状态则按需求值，否则返回存储值
+     */
+    const std::any& resolveState(const StateId& id, const std::any& stored) const {
+        auto it = derivedStates_.find(id);
+        if (it == derivedStates_.end()) {
+            return stored;
+        }
+        return evaluateDerived(id, it->second);
+    }
+
+    /**
+     * @brief 求值派生状态，本帧内已求值则直接返回缓存
+     * @throws DependencyError 派生状态之间存在循环依赖时抛出
+     */
+    const std::any& evaluateDerived(const StateId& id, DerivedState& derived) const {
+        if (derived.evaluated_frame == frameCounter_) {
+            return derived.value;
+        }
+        if (derived.evaluating) {
+            throw DependencyError("StateManager", "Cyclic evaluation of derived state '" + id.name +
+                                  "' of component '" + id.component.name + "'.");
+        }
+
+        derived.evaluating = true;
+        evaluationStack_.push_back(&derived);
+        // 求值期间的读取记到派生状态的所属组件名下
+        const ComponentId* accessor = auditAccessor_;
+        if (accessAudit_) [[unlikely]] {
+            auto owner = components_.find(id.component);
+            auditAccessor_ = owner != components_.end() ? &owner->first : nullptr;
+        }
+        try {
+            derived.value = derived.compute();
+        } catch (...) {
+            evaluationStack_.pop_back();
+            derived.evaluating = false;
+            auditAccessor_ = accessor;
+            throw;
+        }
+        evaluationStack_.pop_back();
+        derived.evaluating = false;
+        auditAccessor_ = accessor;
+        derived.evaluated_frame = frameCounter_;
+        return derived.value;
+    }
+
+    /**
+     * @brief 记录正在求值的派生状态读取了哪个状态
+     */
+    void recordDerivedDependency(const StateId& id) const {
+        DerivedState* reader = evaluationStack_.back();
+        if (reader->dependencies.insert(id).second) {
+            derivedDependents_[id].push_back(reader);
+        }
+    }
+
+    /**
+     * @brief 状态被改写时，使依赖它的派生状态缓存失效
+     */
+    void invalidateDependents(const StateId& id) {
+        auto it = derivedDependents_.find(id);
+        if (it != derivedDependents_.end()) {
+            for (DerivedState* derived : it->second) {
+                derived->evaluated_frame = NOT_EVALUATED;
+            }
+        }
+    }
+
+    /**
+     * @brief 根据执行顺序生成执行计划
+     * @details vehicleActivity_ 为节点式容器，元素指针在插入新元素后依然有效
+     */
+    void buildExecutionPlan() {
+        std::vector<ExecutionStep> steps;
+        steps.reserve(executionOrder_.size());
+        for (const auto& id : executionOrder_) {
+            auto it = components_.find(id);
+            if (it != components_.end()) {
+                ExecutionStep step;
+                step.component = it->second;
+                step.id = &it->first;
+                step.activity = &vehicleActivity_[id.vehicleId];
+                step.priority = componentPriorities_.count(id) ? componentPriorities_.at(id) : DEFAULT_PRIORITY;
+                step.sheddable = sheddableComponents_.count(id) > 0;
+                if (AllocationTracker::enabled()) {
+                    step.allocations = &allocationStats_[id];
+                }
+                resolvePerfTotals(step);
+                resolveUpdateTime(step);
+                for (auto& [state_id, derived] : derivedStates_) {
+                    if (state_id.component == id) {
+                        derived.slot = &states_.at(state_id);
+                        step.derived.push_back(&derived);
+                    }
+                }
+                if (it->second->isSkipIfInputsUnchanged()) {
+                    resolveInputVersions(it->second, step);
+                }
+                steps.push_back(std::move(step));
+            }
+        }
+        groupBatchSteps(std::move(steps));
+        // 预留逐帧使用的缓冲区，避免稳定运行阶段扩容
+        deferredSteps_.reserve(executionOrder_.size());
+        allocatingComponents_.reserve(executionOrder_.size());
+    }
+
+    /**
+     * @brief 将同一类型、同一依赖层级的组件合并为批量步骤
+     * @details 层级为组件到无依赖组件的最长依赖路径长度。依赖边总是从低层级指向高层级，
+     * 因此同层级的实例之间互不依赖，合并后的图仍无环。合并后按 Kahn 算法重新排序，
+     * 就绪节点中优先选择原执行顺序最靠前的，没有可合并的组件时执行顺序保持不变。
+     * 未提供批量更新函数的类型保持逐个更新。
+     */
+    void groupBatchSteps(std::vector<ExecutionStep> steps) {
+        const size_t count = steps.size();
+        std::unordered_map<ComponentId, size_t, std::hash<ComponentId>> position;
+        for (size_t i = 0; i < count; ++i) {
+            position[steps[i].component->getComponentId()] = i;
+        }
+
+        // 1. 计算依赖层级（steps 已按拓扑序排列，依赖项总在前面）
+        std::vector<std::vector<size_t>> deps(count);
+        std::vector<size_t> level(count, 0);
+        for (size_t i = 0; i < count; ++i) {
+            auto deps_it = componentDependencies_.find(steps[i].component->getComponentId());
+            if (deps_it == componentDependencies_.end()) {
+                continue;
+            }
+            for (const auto& dep : deps_it->second) {
+                auto pos_it = position.find(dep);
+                if (pos_it != position.end()) {
+                    deps[i].push_back(pos_it->second);
+                    level[i] = std::max(level[i], level[pos_it->second] + 1);
+                }
+            }
+        }
+
+        // 2. 按 (类型, 层级) 分组；node_of 为每个步骤所属的节点，节点以首个成员的位置编号
+        const auto& factory = ComponentFactory::getInstance();
+        std::vector<size_t> node_of(count);
+        std::vector<BatchUpdater> updaters(count, nullptr);
+        std::map<std::pair<std::type_index, size_t>, size_t> group_leader;
+        for (size_t i = 0; i < count; ++i) {
+            node_of[i] = i;
+            const std::type_index type(typeid(*steps[i].component));
+            BatchUpdater updater = factory.getBatchUpdater(type);
+            if (!updater) {
+                continue;
+            }
+            auto [it, inserted] = group_leader.emplace(std::make_pair(type, level[i]), i);
+            node_of[i] = it->second;
+            updaters[it->second] = updater;
+        }
+
+        std::vector<std::vector<size_t>> members(count);
+        for (size_t i = 0; i < count; ++i) {
+            members[node_of[i]].push_back(i);
+        }
+
+        // 3. 在合并后的图上重新拓扑排序
+        std::vector<size_t> pending(count, 0);
+        std::vector<std::vector<size_t>> dependents(count);
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t dep : deps[i]) {
+                dependents[node_of[dep]].push_back(node_of[i]);
+                ++pending[node_of[i]];
+            }
+        }
+        std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+        for (size_t node = 0; node < count; ++node) {
+            if (!members[node].empty() && pending[node] == 0) {
+                ready.push(node);
+            }
+        }
+
+        executionPlan_.clear();
+        executionPlan_.reserve(count);
+        while (!ready.empty()) {
+            size_t node = ready.top();
+            ready.pop();
+            for (size_t next : dependents[node]) {
+                if (--pending[next] == 0) {
+                    ready.push(next);
+                }
+            }
+
+            if (members[node].size() == 1) {
+                executionPlan_.push_back(std::move(steps[node]));
+                continue;
+            }
+            ExecutionStep batch;
+            batch.batch_updater = updaters[node];
+            for (size_t member : members[node]) {
+                batch.batch_members.push_back(std::move(steps[member]));
+            }
+            LOG_INFO("[StateManager] Batched {} instances of {} into one update step",
+                     batch.batch_members.size(),
+                     batch.batch_members.front().component->getComponentType().c_str());
+            executionPlan_.push_back(std::move(batch));
+        }
+    }
+
+    /**
+     * @brief 解析组件声明的输入（包括可选输入）对应的版本计数器
+     * @details 组件级输入使用被依赖组件的输出版本，状态级输入使用该状态的版本；
+     * 未注册的可选输入被忽略
+     */
+    void resolveInputVersions(ComponentBase* component, ExecutionStep& step) {
+        step.skip_if_inputs_unchanged = true;
+        auto interface = component->getInterface();
+        for (const auto& spec : interface.getInputs()) {
+            if (!spec.source) {
+                continue;
+            }
+            if (spec.source->name.empty()) {
+                auto version_it = componentOutputVersions_.find(spec.source->component);
+                if (version_it != componentOutputVersions_.end()) {
+                    step.input_versions.push_back(&version_it->second);
+                }
+            } else {
+                auto state_it = states_.find(*spec.source);
+                if (state_it != states_.end()) {
+                    step.input_versions.push_back(&state_it->second.version);
+                }
+            }
+        }
+        step.seen_versions.assign(step.input_versions.size(), 0);
+        LOG_DEBUG("[StateManager] {} skips updates while its {} inputs are unchanged",
+                  component->getName().c_str(), step.input_versions.size());
+    }
+
+    /**
+     * @brief 对休眠飞行器求值唤醒条件
+     * @details 只遍历休眠列表，活动飞行器没有任何额外开销
+     */
+    void evaluateWakeConditions() {
+        std::vector<VehicleId> to_wake;
+        for (VehicleId vehicle : sleepingVehicles_) {
+            const auto& activity = vehicleActivity_[vehicle];
+            if (activity.wake_condition && activity.wake_condition()) {
+                to_wake.push_back(vehicle);
+            }
+        }
+        for (VehicleId vehicle : to_wake) {
+            setVehicleActive(vehicle, true);
+        }
+    }
+
     /**
      * @brief 验证组件依赖关系的完整性
      * @details 在组件初始化前检查所有组件级依赖，包括：
@@ -738,10 +2121,73 @@ private:
     }
 
     std::unordered_map<ComponentId, ComponentBase*, std::hash<ComponentId>> components_;
-    std::unordered_map<StateId, std::any, std::hash<StateId>> states_;
+    core::RandomStreams randomStreams_;
+    core::ExternalInputs externalInputs_;
+    // 组件可用的运行期服务：共享计数器、上一帧快照、被记录的状态
+    struct PreviousFrameCopy {
+        const StateSlot* slot;
+        std::any* snapshot;
+        StateCopier copy;
+    };
+    std::mutex runServicesMutex_;                  ///< 登记可能发生在并行初始化中
+    std::unordered_map<std::string, int64_t> runCounters_;
+    std::unordered_map<StateId, std::any, std::hash<StateId>> previousFrameStates_;
+    std::vector<PreviousFrameCopy> previousFrameCopies_;
+    std::unordered_set<StateId, std::hash<StateId>> loggedStates_;
+    std::unordered_map<StateId, StateSlot, std::hash<StateId>> states_;
+    std::unordered_map<StateId, std::string, std::hash<StateId>> stateTypes_;  ///< 输出状态声明的类型名
+    std::unordered_map<ComponentId, uint64_t, std::hash<ComponentId>> componentOutputVersions_;
     std::vector<ComponentId> executionOrder_;
     std::unordered_map<ComponentId, std::unordered_set<ComponentId, std::hash<ComponentId>>, std::hash<ComponentId>> componentDependencies_;
     std::unordered_map<ComponentId, int, std::hash<ComponentId>> componentPriorities_;
+    std::unordered_set<ComponentId, std::hash<ComponentId>> sheddableComponents_;
+    std::vector<ExecutionStep> executionPlan_;
+    std::vector<ComponentBase*> batchComponents_;  ///< 批量步骤的复用缓冲区
+    std::vector<ExecutionStep*> batchSteps_;
+    std::unordered_map<VehicleId, VehicleActivity> vehicleActivity_;
+    size_t activeVehicleCount_{0};  ///< 活动的非全局飞行器数量
+    std::vector<VehicleId> sleepingVehicles_;
+    // 派生状态：求值结果缓存在 const 读取路径中更新，因此为 mutable
+    mutable std::unordered_map<StateId, DerivedState, std::hash<StateId>> derivedStates_;
+    mutable std::unordered_map<StateId, std::vector<DerivedState*>, std::hash<StateId>> derivedDependents_;
+    mutable std::vector<DerivedState*> evaluationStack_;
+    std::priority_queue<double, std::vector<double>, std::greater<double>> pendingEvents_;
+    static constexpr double EVENT_TOLERANCE_S = 1e-9;
+    uint64_t frameCounter_{0};
+    uint64_t skippedUpdates_{0};
+    uint64_t droppedUpdates_{0};
+    int priorityFloor_{0};
+    // 稳态分配检查（GNC_TRACK_ALLOCATIONS）
+    AllocationCheckConfig allocationCheck_;
+    std::unordered_map<ComponentId, AllocationStats, std::hash<ComponentId>> allocationStats_;
+    AllocationStats frameworkAllocations_;
+    std::vector<const ComponentBase*> allocatingComponents_;
+    bool trackingFrame_{false};
+    uint64_t steadyStateFrames_{0};
+    uint64_t steadyStateAllocations_{0};
+    uint64_t steadyStateAllocatedBytes_{0};
+    PerfCounterProfiler* perfProfiler_{nullptr};
+    StateAccessAudit* accessAudit_{nullptr};
+    StartupProfiler* startupProfiler_{nullptr};
+    size_t initThreads_{1};
+    // 运行指标
+    MetricsHistogram* frameTime_{nullptr};
+    MetricsCounter* framesTotal_{nullptr};
+    MetricsGauge* simTimeGauge_{nullptr};
+    StateHandle<double> simTime_;
+    MetricsRegistry* componentMetrics_{nullptr};
+    bool perInstanceMetrics_{false};
+    mutable const ComponentId* auditAccessor_{nullptr};  ///< 正在更新的组件，派生求值期间临时切换
+    // 帧预算
+    bool budgetActive_{false};
+    BudgetClock::time_point deferAfter_{};
+    BudgetClock::time_point budgetDeadline_{};
+    std::vector<ExecutionStep*> deferredSteps_;
+    uint64_t deferredUpdates_{0};
+    uint64_t shedUpdates_{0};
+    std::unordered_map<ComponentId, uint64_t, std::hash<ComponentId>> shedCounts_;
+    BudgetDecisions lastBudgetDecisions_;
+    const BudgetDecisions* replayedBudget_{nullptr};
     static constexpr int DEFAULT_PRIORITY = 500;
     bool needsRevalidation_{true};
 };
@@ -0,0 +1,246 @@
+/**
+ * @file static_pipeline.hpp
+ * @brief 编译期静态组件流水线
+ *
+ * 对于构型固定的飞行器，不需要运行时可插拔性。静态流水线在编译期解析阶段之间的
+ * 依赖关系和执行顺序，所有阶段的状态存放在一个生成的结构体中，按成员直接访问，
+ * 步进函数没有虚调用、没有 std::function、没有字符串查找，可被编译器完全内联。
+ *
+ * 阶段（Stage）是普通的类，约定如下：
+ * - `struct Outputs { ... };`：该阶段写入的状态，作为流水线状态结构体的基类之一
+ * - `using Depends = gnc::pipeline::Depends<OtherStage...>;`：可选，所依赖的阶段
+ * - `template <typename State> void step(State& state, const StepContext& ctx);`
+ *
+ * 使用示例：
+ * @code
+ * using Pipeline = gnc::pipeline::StaticPipeline<DynamicsStage, AtmosphereStage, AeroStage>;
+ * Pipeline pipeline;
+ * pipeline.step({dt, t, vehicle});
+ * double rho = pipeline.state().air_density_kg_m3;
+ * @endcode
+ *
+ * 整条流水线可通过 StaticPipelineComponent 作为单个组件注册到动态框架中。
+ */
+#pragma once
+
+#include "component_base.hpp"
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace gnc::pipeline {
+
+/**
+ * @brief 阶段依赖列表
+ */
+template <typename... Stages>
+struct Depends {};
+
+/**
+ * @brief 单步执行上下文
+ */
+struct StepContext {
+    double dt_s = 0.0;                 ///< 步长
+    double time_s = 0.0;               ///< 当前仿真时间
+    states::VehicleId vehicle = 0;     ///< 所属飞行器
+};
+
+namespace detail {
+
+template <typename Stage>
+struct DependsOf {
+    using type = Depends<>;
+};
+
+template <typename Stage>
+    requires requires { typename Stage::Depends; }
+struct DependsOf<Stage> {
+    using type = typename Stage::Depends;
+};
+
+/**
+ * @brief 类型在阶段列表中的下标，不存在时返回列表长度
+ */
+template <typename T, typename... Stages>
+constexpr std::size_t indexOf() {
+    constexpr std::array<bool, sizeof...(Stages)> matches{std::is_same_v<T, Stages>...};
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return sizeof...(Stages);
+}
+
+template <typename Deps, typename... Stages>
+struct DependencyIndices;
+
+template <typename... Deps, typename... Stages>
+struct DependencyIndices<Depends<Deps...>, Stages...> {
+    static constexpr std::array<std::size_t, sizeof...(Deps)> value{indexOf<Deps, Stages...>()...};
+};
+
+/**
+ * @brief 编译期依赖图：edges[i][j] 表示阶段 i 依赖阶段 j
+ */
+template <typename... Stages>
+struct DependencyGraph {
+    static constexpr std::size_t size = sizeof...(Stages);
+
+    static constexpr bool allDependenciesPresent() {
+        bool present = true;
+        ((present = present && [] {
+            for (std::size_t dep : DependencyIndices<typename DependsOf<Stages>::type, Stages...>::value) {
+                if (dep >= size) {
+                    return false;
+                }
+            }
+            return true;
+        }()), ...);
+        return present;
+    }
+
+    static constexpr std::array<std::array<bool, size>, size> edges() {
+        std::array<std::array<bool, size>, size> result{};
+        std::size_t stage = 0;
+        ((
+            [&] {
+                for (std::size_t dep : DependencyIndices<typename DependsOf<Stages>::type, Stages...>::value) {
+                    if (dep < size) {
+                        result[stage][dep] = true;
+                    }
+                }
+                ++stage;
+            }()
+        ), ...);
+        return result;
+    }
+
+    /**
+     * @brief Kahn 拓扑排序；就绪阶段中优先选择声明顺序靠前的，存在环时 acyclic 为 false
+     */
+    struct Order {
+        std::array<std::size_t, size> indices{};
+        bool acyclic = true;
+    };
+
+    static constexpr Order order() {
+        constexpr auto graph = edges();
+        Order result;
+        std::array<bool, size> done{};
+        for (std::size_t slot = 0; slot < size; ++slot) {
+            std::size_t next = size;
+            for (std::size_t i = 0; i < size && next == size; ++i) {
+                if (done[i]) {
+                    continue;
+                }
+                bool ready = true;
+                for (std::size_t j = 0; j < size; ++j) {
+                    if (graph[i][j] && !done[j]) {
+                        ready = false;
+                        break;
+                    }
+                }
+                if (ready) {
+                    next = i;
+                }
+            }
+            if (next == size) {
+                result.acyclic = false;
+                return result;
+            }
+            done[next] = true;
+            result.indices[slot] = next;
+        }
+        return result;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief 编译期静态流水线
+ * @tparam Stages 阶段类型，声明顺序任意，执行顺序由 Depends 在编译期确定
+ */
+template <typename... Stages>
+class StaticPipeline {
+    using Graph = detail::DependencyGraph<Stages...>;
+    static_assert(sizeof...(Stages) > 0, "StaticPipeline requires at least one stage");
+    static_assert(Graph::allDependenciesPresent(),
+                  "StaticPipeline: a stage depends on a stage that is not part of the pipeline");
+    static_assert(Graph::order().acyclic, "StaticPipeline: cyclic dependency between stages");
+
+public:
+    /**
+     * @brief 生成的状态结构体，包含所有阶段的输出
+     */
+    struct State : Stages::Outputs... {};
+
+    /**
+     * @brief 编译期确定的执行顺序（阶段在模板参数中的下标）
+     */
+    static constexpr auto executionOrder = Graph::order().indices;
+
+    /**
+     * @brief 按依赖顺序执行所有阶段一次
+     */
+    void step(const StepContext& ctx) {
+        stepInOrder(ctx, std::make_index_sequence<sizeof...(Stages)>{});
+    }
+
+    State& state() { return state_; }
+    const State& state() const { return state_; }
+
+    /**
+     * @brief 访问阶段实例（用于配置参数）
+     */
+    template <typename Stage>
+    Stage& stage() {
+        return std::get<Stage>(stages_);
+    }
+
+private:
+    template <std::size_t... Slots>
+    void stepInOrder(const StepContext& ctx, std::index_sequence<Slots...>) {
+        (std::get<executionOrder[Slots]>(stages_).step(state_, ctx), ...);
+    }
+
+    std::tuple<Stages...> stages_;
+    State state_{};
+};
+
+/**
+ * @brief 将静态流水线包装为动态框架中的单个组件
+ * @details 每帧从 TimingManager 读取时间和步长后执行整条流水线，再调用 publish()
+ * 把需要对外可见的状态写入 StateManager。派生类负责声明输出并实现 publish()。
+ * @tparam Pipeline StaticPipeline 实例化类型
+ */
+template <typename Pipeline>
+class StaticPipelineComponent : public states::ComponentBase {
+public:
+    StaticPipelineComponent(states::VehicleId id, const std::string& defaultName, const std::string& instanceName = "")
+        : states::ComponentBase(id, defaultName, instanceName) {
+        declareInput<void>(states::ComponentId{states::globalId, "TimingManager"});
+    }
+
+protected:
+    void updateImpl() override {
+        StepContext ctx;
+        ctx.dt_s = getState<double>({{states::globalId, "TimingManager"}, "timing_delta_s"});
+        ctx.time_s = getState<double>({{states::globalId, "TimingManager"}, "timing_current_s"});
+        ctx.vehicle = getVehicleId();
+        pipeline_.step(ctx);
+        publish(pipeline_.state());
+    }
+
+    /**
+     * @brief 将流水线状态发布到动态框架
+     */
+    virtual void publish(const typename Pipeline::State& state) = 0;
+
+    Pipeline pipeline_;
+};
+
+} // namespace gnc::pipeline
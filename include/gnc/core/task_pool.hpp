@@ -0,0 +1,90 @@
+/**
+ * @file task_pool.hpp
+ * @brief 固定线程数的任务池
+ *
+ * 任务按提交顺序（FIFO）取出执行，submit() 返回的 future 传递任务的结果或异常。
+ * 任务可以等待更早提交的任务的 future：FIFO 保证被等待的任务已被某个线程取走，不会死锁。
+ * 析构时执行完队列中剩余的任务后再退出。
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gnc {
+
+class TaskPool {
+public:
+    /**
+     * @param threads 线程数，0 表示使用硬件并发数
+     */
+    explicit TaskPool(size_t threads = 0) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this]() { work(); });
+        }
+    }
+
+    ~TaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& task) {
+        auto packaged = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(task));
+        auto future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.emplace_back([packaged]() { (*packaged)(); });
+        }
+        ready_.notify_one();
+        return future;
+    }
+
+private:
+    void work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                task = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> queue_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stopping_ = false;
+};
+
+} // namespace gnc
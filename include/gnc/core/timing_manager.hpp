@@ -4,6 +4,7 @@
 #include "gnc/core/component_base.hpp"
 #include "gnc/components/utility/config_manager.hpp"
 #include "gnc/components/utility/simple_logger.hpp"
+#include <algorithm>
 
 using namespace gnc::components::utility;
 
@@ -39,6 +40,30 @@ public:
      */
     void initialize() override;
 
+    void finalize() override;
+
+    /**
+     * @brief Makes the next frame advance the clock to one step before target_s.
+     *
+     * Used by the hybrid discrete-event mode when no continuous dynamics are
+     * active. The target is clamped to the simulation duration, and the jump is
+     * ignored if it would not advance further than a regular step. Landing one
+     * step early means the frame that reaches target_s is a regular fixed step,
+     * so vehicles woken by the event never see the idle gap in
+     * "timing_delta_s". Only the jump frame itself, in which no vehicle is
+     * active, reports the elapsed time.
+     */
+    void scheduleJumpTo(double target_s);
+
+    double getCurrentTime() const { return current_time_s_; }
+    double getTimeStep() const { return time_step_s_; }
+    double getDuration() const { return duration_s_; }
+
+    /**
+     * @brief Simulation time after the next frame (accounts for a scheduled jump).
+     */
+    double getNextTime() const { return current_time_s_ + nextStep(); }
+
 protected:
     /**
      * @brief Updates the simulation time and checks for termination conditions.
@@ -50,13 +75,22 @@ private:
     double duration_s_ = 10.0; // Default duration
     double time_step_s_ = 1; // Default time step
 
+    double nextStep() const {
+        return pending_jump_s_ > 0.0 ? pending_jump_s_ - current_time_s_ : time_step_s_;
+    }
+
     // Internal state
     double current_time_s_ = 0.0;
     uint64_t frame_count_ = 0;
     bool should_run_ = true;
+
+    // Discrete-event jumps
+    double pending_jump_s_ = 0.0;
+    uint64_t jump_count_ = 0;
+    double jumped_time_s_ = 0.0;
 };
 
-TimingManagerComponent::TimingManagerComponent(VehicleId vehicleId, const std::string& instanceName)
+inline TimingManagerComponent::TimingManagerComponent(VehicleId vehicleId, const std::string& instanceName)
     : ComponentBase(vehicleId, "TimingManager", instanceName) {
     
     // Declare the states this component will provide to the system
@@ -66,7 +100,7 @@ TimingManagerComponent::TimingManagerComponent(VehicleId vehicleId, const std::s
     declareOutput<bool>("timing_should_run",10);
 }
 
-void TimingManagerComponent::initialize() {
+inline void TimingManagerComponent::initialize() {
     LOG_COMPONENT_DEBUG("Initializing TimingManager...");
 
     try {
@@ -94,10 +128,36 @@ void TimingManagerComponent::initialize() {
     setState("timing_should_run", should_run_);
 }
 
-void TimingManagerComponent::updateImpl() {
+inline void TimingManagerComponent::finalize() {
+    if (jump_count_ > 0) {
+        LOG_COMPONENT_INFO("Discrete-event mode skipped {:.3f}s of idle time in {} jumps.", jumped_time_s_, jump_count_);
+    }
+}
+
+inline void TimingManagerComponent::scheduleJumpTo(double target_s) {
+    const double landing_s = std::min(target_s, duration_s_) - time_step_s_;
+    if (landing_s <= current_time_s_ + time_step_s_) {
+        pending_jump_s_ = 0.0;
+        return;
+    }
+    pending_jump_s_ = landing_s;
+}
+
+inline void TimingManagerComponent::updateImpl() {
     // Increment frame count and time
     frame_count_++;
-    current_time_s_ += time_step_s_;
+    double step_s = nextStep();
+    current_time_s_ += step_s;
+
+    if (pending_jump_s_ > 0.0) {
+        // Land exactly on the jump target and report the elapsed time for this frame only
+        current_time_s_ = pending_jump_s_;
+        pending_jump_s_ = 0.0;
+        ++jump_count_;
+        jumped_time_s_ += step_s - time_step_s_;
+        LOG_COMPONENT_DEBUG("Jumped {}s to t = {}s", step_s, current_time_s_);
+    }
+    setState("timing_delta_s", step_s);
 
     // Check if the simulation duration has been reached
     if (current_time_s_ >= duration_s_) {
@@ -109,7 +169,6 @@ void TimingManagerComponent::updateImpl() {
     setState("timing_current_s", current_time_s_);
     setState("timing_frame_count", frame_count_);
     setState("timing_should_run", should_run_);
-    // a simple impliementation just assume delta_s is constant, so it doesn't need to be updated every frame
 }
 
 static gnc::ComponentRegistrar<TimingManagerComponent> timing_manager_registrar("TimingManager");
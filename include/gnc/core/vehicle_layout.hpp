@@ -0,0 +1,70 @@
+/**
+ * @file vehicle_layout.hpp
+ * @brief 飞行器组件布局：模板与批量展开
+ *
+ * core.vehicle_templates 定义具名的组件列表，core.vehicles 中的条目可以直接列出组件，
+ * 也可以引用模板并用 count 或 id_range 一次声明一组飞行器：
+ *
+ *   vehicle_templates:
+ *     interceptor:
+ *       components: [SimpleAtmosphere, {type: GuidanceWithPhase, priority: 600}]
+ *   vehicles:
+ *     - {template: interceptor, id_range: [10, 2009], active: false, wake_at_s: 1.0}
+ *     - {template: interceptor, id: 5, count: 3, overrides: {GuidanceWithPhase: {priority: 700}}}
+ *
+ * 每个模板只解析一次，同一条目展开出的所有飞行器共享同一份不可变的组件列表；
+ * overrides（按组件 name 匹配，未指定 name 时按 type）、extra_components 和
+ * remove 会为该条目生成一份派生列表，而不是为每架飞行器复制一份。
+ */
+#pragma once
+
+#include "../common/types.hpp"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gnc {
+namespace core {
+
+/**
+ * @brief 一个组件的创建参数
+ */
+struct ComponentSpec {
+    std::string type;
+    std::string name;                     ///< 实例名，空表示使用组件默认名
+    int priority = 500;
+    bool sheddable = false;
+
+    /**
+     * @brief 解析字符串（仅类型）或 {type, name, priority, sheddable} 对象
+     */
+    static ComponentSpec fromJson(const nlohmann::json& config);
+
+    /// 覆盖项匹配用的键：有实例名时为实例名，否则为类型名
+    const std::string& key() const { return name.empty() ? type : name; }
+};
+
+using ComponentList = std::vector<ComponentSpec>;
+
+/**
+ * @brief 一组连续 ID 的飞行器，共享同一份组件列表
+ */
+struct VehicleGroup {
+    states::VehicleId first_id = 0;
+    size_t count = 1;
+    std::string source;                   ///< 模板名，直接列出组件时为空
+    std::shared_ptr<const ComponentList> components;
+    bool active = true;
+    std::optional<double> wake_at_s;
+};
+
+/**
+ * @brief 解析 core 节点下的 vehicle_templates 与 vehicles
+ * @throws gnc::ConfigurationError 模板不存在、ID 范围非法或飞行器 ID 重复时抛出
+ */
+std::vector<VehicleGroup> parseVehicleLayout(const nlohmann::json& core);
+
+} // namespace core
+} // namespace gnc
@@ -0,0 +1,147 @@
+/**
+ * @file binary_writer.cpp
+ * @brief Binary file writer implementation
+ */
+
+#include "gnc/components/utility/binary_writer.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+namespace {
+
+/**
+ * @brief Append a timestamp to the file name, like the CSV and HDF5 writers
+ */
+std::string timestampedPath(const std::string& base_path) {
+    const std::filesystem::path path(base_path);
+    const auto now = std::chrono::system_clock::now();
+    const auto time_t = std::chrono::system_clock::to_time_t(now);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+
+    std::stringstream name;
+    name << path.stem().string() << "_" << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S") << "_"
+         << std::setfill('0') << std::setw(3) << ms.count() << path.extension().string();
+    return (path.parent_path() / name.str()).string();
+}
+
+double toDouble(const std::any& value) {
+    if (value.type() == typeid(double)) {
+        return std::any_cast<double>(value);
+    } else if (value.type() == typeid(float)) {
+        return std::any_cast<float>(value);
+    } else if (value.type() == typeid(int)) {
+        return std::any_cast<int>(value);
+    } else if (value.type() == typeid(bool)) {
+        return std::any_cast<bool>(value) ? 1.0 : 0.0;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace
+
+void BinaryWriter::describeColumns(const std::vector<ColumnInfo>& columns) {
+    columns_ = columns;
+}
+
+void BinaryWriter::initialize(const std::string& file_path,
+                              const std::vector<gnc::states::StateId>& states,
+                              bool include_metadata,
+                              const nlohmann::json& metadata_json) {
+    if (initialized_) {
+        throw std::runtime_error("BinaryWriter already initialized");
+    }
+    if (!columns_.empty() && columns_.size() != states.size()) {
+        throw std::runtime_error("BinaryWriter column descriptions do not match the states list");
+    }
+
+    nlohmann::json columns = nlohmann::json::array();
+    for (size_t i = 0; i < states.size(); ++i) {
+        nlohmann::json column = {
+            {"vehicle", states[i].component.vehicleId},
+            {"component", states[i].component.name},
+            {"name", states[i].name},
+        };
+        if (!columns_.empty() && !columns_[i].source.name.empty()) {
+            column["state"] = columns_[i].source.name;
+            column["type"] = columns_[i].type_name;
+            column["index"] = columns_[i].component_index;
+        }
+        columns.push_back(std::move(column));
+    }
+    nlohmann::json header = {{"version", 1}, {"columns", std::move(columns)}};
+    if (include_metadata && !metadata_json.is_null()) {
+        header["metadata"] = metadata_json;
+    }
+    std::string header_text = header.dump();
+    // Pad with whitespace so that the rows start 8-byte aligned and can be read in place
+    header_text.append((alignof(double) - (sizeof(MAGIC) + sizeof(uint64_t) + header_text.size()) % alignof(double)) %
+                           alignof(double),
+                       ' ');
+
+    file_path_ = timestampedPath(file_path);
+    const std::filesystem::path path(file_path_);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+    file_stream_.open(file_path_, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_stream_.is_open()) {
+        throw std::runtime_error("Failed to open binary log file: " + file_path_);
+    }
+
+    const uint64_t header_size = header_text.size();
+    file_stream_.write(MAGIC, sizeof(MAGIC));
+    file_stream_.write(reinterpret_cast<const char*>(&header_size), sizeof(header_size));
+    file_stream_.write(header_text.data(), static_cast<std::streamsize>(header_text.size()));
+    if (!file_stream_) {
+        throw std::runtime_error("Failed to write binary log header: " + file_path_);
+    }
+
+    column_count_ = states.size();
+    row_.assign(column_count_ + 1, 0.0);
+    rows_written_ = 0;
+    initialized_ = true;
+    LOG_INFO("Created binary log file: {}", file_path_);
+}
+
+void BinaryWriter::writeDataPoint(double time, const std::vector<std::any>& values) {
+    if (!initialized_) {
+        throw std::runtime_error("BinaryWriter not initialized");
+    }
+    if (values.size() != column_count_) {
+        throw std::runtime_error("Values count (" + std::to_string(values.size()) +
+                                 ") does not match states count (" + std::to_string(column_count_) + ")");
+    }
+
+    row_[0] = time;
+    for (size_t i = 0; i < values.size(); ++i) {
+        row_[i + 1] = toDouble(values[i]);
+    }
+    file_stream_.write(reinterpret_cast<const char*>(row_.data()), static_cast<std::streamsize>(row_.size() * sizeof(double)));
+    if (!file_stream_) {
+        throw std::runtime_error("Failed to write data point to " + file_path_);
+    }
+    ++rows_written_;
+}
+
+void BinaryWriter::finalize() {
+    if (!initialized_) {
+        return;
+    }
+    file_stream_.flush();
+    file_stream_.close();
+    initialized_ = false;
+    LOG_DEBUG("BinaryWriter finalized after {} rows", rows_written_);
+}
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
@@ -0,0 +1,457 @@
+/**
+ * @file campaign_stats.cpp
+ * @brief Campaign-level aggregation implementation
+ */
+
+#include "gnc/components/utility/campaign_stats.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+namespace {
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * @brief Reductions that are run properties rather than statistics worth aggregating
+ */
+bool isAggregated(const std::string& reduction) {
+    return reduction != "samples" && reduction != "threshold";
+}
+
+/**
+ * @brief "p50", "p99", "p99.9" for quantile 0.5, 0.99, 0.999
+ */
+std::string quantileName(double q) {
+    std::ostringstream name;
+    name << 'p' << std::setprecision(6) << q * 100.0;
+    return name.str();
+}
+
+std::string utcTimestamp() {
+    const auto time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::stringstream timestamp;
+    timestamp << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%SZ");
+    return timestamp.str();
+}
+
+} // namespace
+
+// ============================================================================
+// RunningStats
+// ============================================================================
+
+void RunningStats::add(double value) {
+    ++count_;
+    const double delta = value - mean_;
+    mean_ += delta / static_cast<double>(count_);
+    m2_ += delta * (value - mean_);
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void RunningStats::merge(const RunningStats& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0) {
+        *this = other;
+        return;
+    }
+    const double n_a = static_cast<double>(count_);
+    const double n_b = static_cast<double>(other.count_);
+    const double n = n_a + n_b;
+    const double delta = other.mean_ - mean_;
+    mean_ += delta * n_b / n;
+    m2_ += other.m2_ + delta * delta * n_a * n_b / n;
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+double RunningStats::variance() const {
+    return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : NaN;
+}
+
+double RunningStats::stddev() const {
+    return std::sqrt(variance());
+}
+
+nlohmann::json RunningStats::toJson() const {
+    return {{"count", count_}, {"mean", mean()}, {"std", stddev()}, {"min", min()}, {"max", max()}, {"m2", m2_}};
+}
+
+RunningStats RunningStats::fromJson(const nlohmann::json& json) {
+    RunningStats stats;
+    stats.count_ = json.at("count").get<uint64_t>();
+    if (stats.count_ > 0) {
+        stats.mean_ = json.at("mean").get<double>();
+        stats.m2_ = json.at("m2").get<double>();
+        stats.min_ = json.at("min").get<double>();
+        stats.max_ = json.at("max").get<double>();
+    }
+    return stats;
+}
+
+// ============================================================================
+// TDigest
+// ============================================================================
+
+void TDigest::add(double value, double weight) {
+    if (std::isnan(value) || weight <= 0.0) {
+        return;
+    }
+    buffer_.push_back({value, weight});
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    if (buffer_.size() >= static_cast<size_t>(5.0 * compression_)) {
+        compress();
+    }
+}
+
+void TDigest::merge(const TDigest& other) {
+    other.compress();
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    compress();
+}
+
+void TDigest::compress() const {
+    if (buffer_.empty()) {
+        return;
+    }
+    buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+    std::sort(buffer_.begin(), buffer_.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+    double total = 0.0;
+    for (const auto& centroid : buffer_) {
+        total += centroid.weight;
+    }
+    // k1 scale: a centroid may span at most one unit of k, which is narrow near q = 0 and q = 1
+    const double pi = std::acos(-1.0);
+    auto k = [&](double q) { return compression_ / (2.0 * pi) * std::asin(2.0 * std::min(1.0, q) - 1.0); };
+
+    centroids_.clear();
+    Centroid current = buffer_.front();
+    double weight_before = 0.0;
+    double k_lower = k(0.0);
+    for (size_t i = 1; i < buffer_.size(); ++i) {
+        const Centroid& next = buffer_[i];
+        if (k((weight_before + current.weight + next.weight) / total) - k_lower <= 1.0) {
+            current.mean += (next.mean - current.mean) * next.weight / (current.weight + next.weight);
+            current.weight += next.weight;
+        } else {
+            weight_before += current.weight;
+            k_lower = k(weight_before / total);
+            centroids_.push_back(current);
+            current = next;
+        }
+    }
+    centroids_.push_back(current);
+    buffer_.clear();
+}
+
+double TDigest::totalWeight() const {
+    compress();
+    double total = 0.0;
+    for (const auto& centroid : centroids_) {
+        total += centroid.weight;
+    }
+    return total;
+}
+
+const std::vector<TDigest::Centroid>& TDigest::centroids() const {
+    compress();
+    return centroids_;
+}
+
+double TDigest::quantile(double q) const {
+    compress();
+    if (centroids_.empty()) {
+        return NaN;
+    }
+    if (centroids_.size() == 1) {
+        return centroids_.front().mean;
+    }
+    const double total = totalWeight();
+    const double index = std::clamp(q, 0.0, 1.0) * total;
+
+    // Between min and the centre of the first centroid, and symmetrically at the top
+    const Centroid& first = centroids_.front();
+    if (index < first.weight / 2.0) {
+        return min_ + (first.mean - min_) * index / (first.weight / 2.0);
+    }
+    const Centroid& last = centroids_.back();
+    if (index > total - last.weight / 2.0) {
+        return max_ - (max_ - last.mean) * (total - index) / (last.weight / 2.0);
+    }
+
+    double centre = first.weight / 2.0;
+    for (size_t i = 0; i + 1 < centroids_.size(); ++i) {
+        const double step = (centroids_[i].weight + centroids_[i + 1].weight) / 2.0;
+        if (centre + step >= index) {
+            const double t = (index - centre) / step;
+            return centroids_[i].mean + t * (centroids_[i + 1].mean - centroids_[i].mean);
+        }
+        centre += step;
+    }
+    return last.mean;
+}
+
+double TDigest::cdf(double value) const {
+    compress();
+    if (centroids_.empty()) {
+        return NaN;
+    }
+    if (value < min_) {
+        return 0.0;
+    }
+    if (value >= max_) {
+        return 1.0;
+    }
+    const double total = totalWeight();
+
+    // Piecewise linear through (min, 0), the centroid centres and (max, total)
+    double previous_x = min_;
+    double previous_weight = 0.0;
+    double cumulative = 0.0;
+    for (const auto& centroid : centroids_) {
+        const double centre_weight = cumulative + centroid.weight / 2.0;
+        if (value < centroid.mean) {
+            const double span = centroid.mean - previous_x;
+            const double t = span > 0.0 ? (value - previous_x) / span : 1.0;
+            return (previous_weight + t * (centre_weight - previous_weight)) / total;
+        }
+        previous_x = centroid.mean;
+        previous_weight = centre_weight;
+        cumulative += centroid.weight;
+    }
+    const double span = max_ - previous_x;
+    const double t = span > 0.0 ? (value - previous_x) / span : 1.0;
+    return (previous_weight + t * (total - previous_weight)) / total;
+}
+
+nlohmann::json TDigest::toJson() const {
+    compress();
+    nlohmann::json centroids = nlohmann::json::array();
+    for (const auto& centroid : centroids_) {
+        centroids.push_back({centroid.mean, centroid.weight});
+    }
+    return {{"compression", compression_}, {"min", min_}, {"max", max_}, {"centroids", std::move(centroids)}};
+}
+
+TDigest TDigest::fromJson(const nlohmann::json& json) {
+    TDigest digest(json.at("compression").get<double>());
+    for (const auto& centroid : json.at("centroids")) {
+        digest.buffer_.push_back({centroid.at(0).get<double>(), centroid.at(1).get<double>()});
+    }
+    if (!digest.buffer_.empty()) {
+        digest.min_ = json.at("min").get<double>();
+        digest.max_ = json.at("max").get<double>();
+    }
+    digest.compress();
+    return digest;
+}
+
+// ============================================================================
+// CampaignAggregator
+// ============================================================================
+
+CampaignOptions CampaignOptions::fromJson(const nlohmann::json& config) {
+    CampaignOptions options;
+    if (config.contains("quantiles")) {
+        options.quantiles = config.at("quantiles").get<std::vector<double>>();
+    }
+    options.histogram_bins = config.value("histogram_bins", options.histogram_bins);
+    options.compression = config.value("compression", options.compression);
+    options.include_sketches = config.value("include_sketches", options.include_sketches);
+    return options;
+}
+
+bool CampaignAggregator::isRunSummary(const nlohmann::json& json) {
+    return json.is_object() && json.value("kind", "") == "run_summary" && json.contains("states");
+}
+
+CampaignAggregator::Field& CampaignAggregator::field(const std::string& state, const std::string& reduction) {
+    auto& fields = states_[state];
+    auto it = fields.find(reduction);
+    if (it == fields.end()) {
+        it = fields.emplace(reduction, Field{RunningStats{}, TDigest(options_.compression)}).first;
+    }
+    return it->second;
+}
+
+bool CampaignAggregator::addRun(const nlohmann::json& summary, const std::string& source) {
+    if (!isRunSummary(summary)) {
+        throw std::runtime_error("Not a run summary record: " + source);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!sources_.insert(source).second) {
+        return false;
+    }
+    for (const auto& state : summary.at("states").items()) {
+        for (const auto& reduction : state.value().items()) {
+            const auto& value = reduction.value();
+            // NaN reductions (e.g. a state never sampled) are written as null and skipped
+            if (!value.is_number() || !isAggregated(reduction.key())) {
+                continue;
+            }
+            const double x = value.get<double>();
+            Field& target = field(state.key(), reduction.key());
+            target.stats.add(x);
+            target.digest.add(x);
+        }
+    }
+    return true;
+}
+
+void CampaignAggregator::merge(const CampaignAggregator& other) {
+    if (&other == this) {
+        return;
+    }
+    std::scoped_lock lock(mutex_, other.mutex_);
+    for (const auto& source : other.sources_) {
+        if (sources_.count(source)) {
+            throw std::runtime_error("Cannot merge campaigns that both aggregated run " + source);
+        }
+    }
+    for (const auto& [state, fields] : other.states_) {
+        for (const auto& [reduction, source] : fields) {
+            Field& target = field(state, reduction);
+            target.stats.merge(source.stats);
+            target.digest.merge(source.digest);
+        }
+    }
+    sources_.insert(other.sources_.begin(), other.sources_.end());
+}
+
+void CampaignAggregator::load(const nlohmann::json& record) {
+    if (!record.is_object() || record.value("kind", "") != "campaign") {
+        throw std::runtime_error("Not a campaign record");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& source : record.at("sources")) {
+        if (sources_.count(source.get<std::string>())) {
+            throw std::runtime_error("Campaign record shares already aggregated run " + source.get<std::string>());
+        }
+    }
+    for (const auto& state : record.at("states").items()) {
+        for (const auto& reduction : state.value().items()) {
+            if (!reduction.value().contains("sketch")) {
+                throw std::runtime_error("Campaign record was written without sketches and cannot be resumed");
+            }
+        }
+    }
+    for (const auto& state : record.at("states").items()) {
+        for (const auto& reduction : state.value().items()) {
+            const auto& entry = reduction.value();
+            Field& target = field(state.key(), reduction.key());
+            target.stats.merge(RunningStats::fromJson(entry));
+            target.digest.merge(TDigest::fromJson(entry.at("sketch")));
+        }
+    }
+    for (const auto& source : record.at("sources")) {
+        sources_.insert(source.get<std::string>());
+    }
+}
+
+bool CampaignAggregator::contains(const std::string& source) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sources_.count(source) > 0;
+}
+
+size_t CampaignAggregator::runs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sources_.size();
+}
+
+nlohmann::json CampaignAggregator::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json states = nlohmann::json::object();
+    for (const auto& [state, fields] : states_) {
+        nlohmann::json& state_json = states[state];
+        for (const auto& [reduction, field] : fields) {
+            nlohmann::json entry = field.stats.toJson();
+            if (!options_.include_sketches) {
+                entry.erase("m2");
+            }
+
+            nlohmann::json quantiles = nlohmann::json::object();
+            for (double q : options_.quantiles) {
+                quantiles[quantileName(q)] = field.digest.quantile(q);
+            }
+            entry["quantiles"] = std::move(quantiles);
+
+            // Bin counts are estimated from the sketch CDF, so they need not be integers
+            if (options_.histogram_bins > 0 && field.stats.count() > 0) {
+                const double lower = field.stats.min();
+                const double upper = field.stats.max();
+                const size_t bins = upper > lower ? options_.histogram_bins : 1;
+                const double width = (upper - lower) / static_cast<double>(bins);
+                const double total = static_cast<double>(field.stats.count());
+                std::vector<double> edges(bins + 1);
+                std::vector<double> counts(bins);
+                double previous = 0.0;
+                for (size_t i = 0; i <= bins; ++i) {
+                    edges[i] = i == bins ? upper : lower + width * static_cast<double>(i);
+                    if (i > 0) {
+                        const double cumulative = i == bins ? 1.0 : field.digest.cdf(edges[i]);
+                        counts[i - 1] = (cumulative - previous) * total;
+                        previous = cumulative;
+                    }
+                }
+                entry["histogram"] = {{"edges", std::move(edges)}, {"counts", std::move(counts)}};
+            }
+
+            if (options_.include_sketches) {
+                entry["sketch"] = field.digest.toJson();
+            }
+            state_json[reduction] = std::move(entry);
+        }
+    }
+
+    nlohmann::json record = {
+        {"kind", "campaign"},
+        {"version", 1},
+        {"runs", sources_.size()},
+        {"updated", utcTimestamp()},
+        {"states", std::move(states)},
+    };
+    if (options_.include_sketches) {
+        record["sources"] = sources_;
+    }
+    return record;
+}
+
+void CampaignAggregator::write(const std::string& path) const {
+    const std::string text = toJson().dump(1);
+    const std::filesystem::path target(path);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path());
+    }
+    // Write next to the target and rename, so readers never see a partial file
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::out | std::ios::trunc);
+        file << text << '\n';
+        if (!file) {
+            throw std::runtime_error("Failed to write campaign statistics: " + temporary);
+        }
+    }
+    std::filesystem::rename(temporary, target);
+}
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
@@ -181,6 +181,13 @@ void CSVWriter::writeMetadata() {
 }
 
 void CSVWriter::writeHeader() {
+    // Column names carry no vehicle id, so record it per column for readers (see RecordedLog)
+    file_stream_ << "# vehicles: ";
+    for (size_t i = 0; i < states_.size(); ++i) {
+        file_stream_ << (i > 0 ? "," : "") << states_[i].component.vehicleId;
+    }
+    file_stream_ << "\n";
+
     // Start with time column
     file_stream_ << "time";
 
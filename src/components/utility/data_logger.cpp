@@ -4,8 +4,10 @@
  */
 
 #include "gnc/components/utility/data_logger.hpp"
+#include "gnc/components/utility/binary_writer.hpp"
 #include "gnc/components/utility/csv_writer.hpp"
 #include "gnc/components/utility/hdf5_writer.hpp"
+#include "gnc/components/utility/summary_writer.hpp"
 #include "gnc/components/utility/simple_logger.hpp"
 #include "gnc/components/utility/config_manager.hpp"
 #include "gnc/core/state_manager.hpp"
@@ -19,6 +21,7 @@
 #include <sstream>
 #include <cstdio>
 #include <limits>
+#include <algorithm>
 
 // Platform-specific includes for popen/pclose
 #ifdef _WIN32
@@ -43,6 +46,10 @@ namespace utility {
 std::unique_ptr<FileWriter> createFileWriter(const std::string& format) {
     if (format == "csv") {
         return std::make_unique<CSVWriter>();
+    } else if (format == "binary") {
+        return std::make_unique<BinaryWriter>();
+    } else if (format == "summary") {
+        return std::make_unique<SummaryWriter>();
     } else if (format == "hdf5") {
         if (!HDF5Writer::isHDF5Available()) {
             LOG_WARN("HDF5 library not available, falling back to CSV format");
@@ -50,7 +57,7 @@ std::unique_ptr<FileWriter> createFileWriter(const std::string& format) {
         }
         return std::make_unique<HDF5Writer>();
     } else {
-        throw std::invalid_argument("Unsupported file format: " + format + ". Supported formats: csv, hdf5");
+        throw std::invalid_argument("Unsupported file format: " + format + ". Supported formats: csv, hdf5, binary, summary");
     }
 }
 
@@ -94,7 +101,9 @@ void DataLogger::initialize() {
 
         // Create flattened state IDs for file writer initialization
         std::vector<gnc::states::StateId> flattened_state_ids;
+        std::vector<ColumnInfo> columns;
         for (const auto& flattened_state : flattened_states_) {
+            columns.push_back({flattened_state.original_state_id, flattened_state.type_name, flattened_state.component_index});
             // Create a pseudo StateId for the flattened state
             gnc::states::StateId flattened_id = {
                 flattened_state.original_state_id.component,
@@ -103,8 +112,17 @@ void DataLogger::initialize() {
             flattened_state_ids.push_back(flattened_id);
         }
 
+        // Activity flag columns go after the state columns, one per logged vehicle
+        for (const auto& vehicle_id : logged_vehicles_) {
+            std::string vehicle_name = "Vehicle" + std::to_string(vehicle_id);
+            flattened_state_ids.push_back({{vehicle_id, vehicle_name}, vehicle_name + ".active"});
+            columns.push_back({{{vehicle_id, vehicle_name}, ""}, "", 0});
+        }
+
         // Initialize file writer
         try {
+            file_writer_->configure(writer_options_);
+            file_writer_->describeColumns(columns);
             file_writer_->initialize(file_path_, flattened_state_ids, log_metadata_, metadata_json);
             LOG_COMPONENT_DEBUG("File writer initialized successfully");
         } catch (const std::exception& e) {
@@ -112,6 +130,12 @@ void DataLogger::initialize() {
             throw;
         }
 
+        auto& metrics = gnc::MetricsRegistry::getInstance();
+        const gnc::MetricsRegistry::Labels labels = {{"logger", getName()}, {"format", output_format_}};
+        rows_written_ = &metrics.counter("gnc_writer_rows_total", "Data points written by DataLogger", labels);
+        values_written_ = &metrics.counter("gnc_writer_values_total", "Scalar values written by DataLogger", labels);
+        write_time_ = &metrics.histogram("gnc_writer_write_ns", "Wall time of one DataLogger writeDataPoint call", labels);
+
         initialized_ = true;
         LOG_COMPONENT_INFO("DataLogger initialization completed successfully");
         LOG_COMPONENT_INFO("Output format: {}, File path: {}", output_format_.c_str(), file_path_.c_str());
@@ -154,6 +178,8 @@ void DataLogger::finalize() {
         // Clear cached state data to free memory
         states_to_log_.clear();
         flattened_states_.clear();
+        logged_vehicles_.clear();
+        vehicle_active_.clear();
         selectors_.clear();
         
         // Reset timing state
@@ -220,7 +246,16 @@ void DataLogger::updateImpl() {
             return;
         }
 
+        // Sample vehicle activity once per frame; sleeping vehicles are recorded as NaN
+        for (size_t slot = 0; slot < logged_vehicles_.size(); ++slot) {
+            vehicle_active_[slot] = state_manager->isVehicleActive(logged_vehicles_[slot]) ? 1 : 0;
+        }
+
         for (const auto& flattened_state : flattened_states_) {
+            if (flattened_state.vehicle_slot != NO_VEHICLE_SLOT && !vehicle_active_[flattened_state.vehicle_slot]) {
+                values.emplace_back(std::numeric_limits<double>::quiet_NaN());
+                continue;
+            }
             try {
                 // Get the raw state value and extract the component
                 const std::any& raw_value = state_manager->getRawStateValue(flattened_state.original_state_id);
@@ -235,10 +270,19 @@ void DataLogger::updateImpl() {
             }
         }
 
+        for (char active : vehicle_active_) {
+            values.emplace_back(active ? 1.0 : 0.0);
+        }
+
         // Write data point using file writer
         if (file_writer_) {
             try {
+                const auto write_start = gnc::MetricsRegistry::Clock::now();
                 file_writer_->writeDataPoint(current_time, values);
+                write_time_->record(static_cast<uint64_t>(
+                    std::chrono::nanoseconds(gnc::MetricsRegistry::Clock::now() - write_start).count()));
+                rows_written_->add();
+                values_written_->add(values.size());
             } catch (const std::exception& e) {
                 LOG_COMPONENT_ERROR("Failed to write data point: {}", e.what());
             }
@@ -292,6 +336,14 @@ void DataLogger::loadConfiguration() {
             log_frequency_hz_ = 0.0;
         }
         
+        try {
+            log_vehicle_activity_ = data_logger_config.value("log_vehicle_activity", true);
+            LOG_COMPONENT_DEBUG("Loaded log_vehicle_activity: {}", log_vehicle_activity_);
+        } catch (const std::exception& e) {
+            LOG_COMPONENT_ERROR("Error loading log_vehicle_activity: {}", e.what());
+            log_vehicle_activity_ = true;
+        }
+
         try {
             log_metadata_ = data_logger_config.value("log_metadata", true);
             LOG_COMPONENT_DEBUG("Loaded log_metadata: {}", log_metadata_);
@@ -301,7 +353,8 @@ void DataLogger::loadConfiguration() {
         }
         
         // Validate output format
-        if (output_format_ != "hdf5" && output_format_ != "csv") {
+        if (output_format_ != "hdf5" && output_format_ != "csv" && output_format_ != "binary" &&
+            output_format_ != "summary") {
             LOG_COMPONENT_WARN("Invalid output format '{}', defaulting to 'hdf5'", output_format_);
             output_format_ = "hdf5";
         }
@@ -311,7 +364,13 @@ void DataLogger::loadConfiguration() {
             file_path_ = file_path_.substr(0, file_path_.find_last_of('.')) + ".csv";
         } else if (output_format_ == "hdf5" && file_path_.find(".csv") != std::string::npos) {
             file_path_ = file_path_.substr(0, file_path_.find_last_of('.')) + ".h5";
+        } else if (output_format_ == "binary" && file_path_.find(BinaryWriter::EXTENSION) == std::string::npos) {
+            file_path_ = file_path_.substr(0, file_path_.find_last_of('.')) + BinaryWriter::EXTENSION;
+        } else if (output_format_ == "summary" && file_path_.find(SummaryWriter::EXTENSION) == std::string::npos) {
+            file_path_ = file_path_.substr(0, file_path_.find_last_of('.')) + SummaryWriter::EXTENSION;
         }
+        writer_options_ = data_logger_config.contains(output_format_) ? data_logger_config[output_format_]
+                                                                      : nlohmann::json();
         
         // Load selectors configuration
         selectors_.clear();
@@ -426,6 +485,9 @@ void DataLogger::discoverAndSelectStates() {
     
     // Convert set to vector
     states_to_log_.assign(unique_states.begin(), unique_states.end());
+    for (const auto& state_id : states_to_log_) {
+        state_manager->markStateLogged(state_id);
+    }
     
     LOG_COMPONENT_INFO("State discovery completed, selected {} states for logging", states_to_log_.size());
     
@@ -439,6 +501,7 @@ void DataLogger::discoverAndSelectStates() {
 
     // Flatten multi-dimensional states
     flattenStates();
+    assignVehicleSlots();
 }
 
 void DataLogger::flattenStates() {
@@ -485,6 +548,26 @@ void DataLogger::flattenStates() {
                        states_to_log_.size(), flattened_states_.size());
 }
 
+void DataLogger::assignVehicleSlots() {
+    logged_vehicles_.clear();
+    if (log_vehicle_activity_) {
+        for (auto& flattened_state : flattened_states_) {
+            VehicleId vehicle_id = flattened_state.original_state_id.component.vehicleId;
+            if (vehicle_id == globalId) {
+                continue;
+            }
+            auto it = std::find(logged_vehicles_.begin(), logged_vehicles_.end(), vehicle_id);
+            flattened_state.vehicle_slot = static_cast<size_t>(std::distance(logged_vehicles_.begin(), it));
+            if (it == logged_vehicles_.end()) {
+                logged_vehicles_.push_back(vehicle_id);
+            }
+        }
+    }
+    vehicle_active_.assign(logged_vehicles_.size(), 1);
+
+    LOG_COMPONENT_DEBUG("Recording activity flags for {} vehicles", logged_vehicles_.size());
+}
+
 bool DataLogger::shouldLog(double current_time) const {
     // If frequency is 0, log every step
     if (log_frequency_hz_ <= 0.0) {
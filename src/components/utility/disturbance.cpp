@@ -87,6 +87,12 @@ void Disturbance::initialize() {
         // 使用默认值继续运行
         std::cout << "[Disturbance] Using default parameter values\n";
     }
+
+    try {
+        position_ = &previousFrameState<Vector3d>({{getVehicleId(), "Dynamics"}, "position_truth_m"});
+    } catch (const std::exception& e) {
+        std::cout << "[Disturbance] Altitude-based parameters disabled: " << e.what() << "\n";
+    }
 }
 
 void Disturbance::updateImpl() {
@@ -284,31 +290,29 @@ void Disturbance::updatePhasedParameters() {
 }
 
 void Disturbance::updateAltitudeBasedParameters() {
-    try {
-        // 尝试获取当前高度
-        double altitude = get<double>("Dynamics.altitude");
-        
-        // 基于高度调整控制增益
-        double gain_factor = 1.0;
-        if (altitude > 50000.0) {
-            // 高空：控制增益减少
-            gain_factor = 0.8;
-        } else if (altitude < 10000.0) {
-            // 低空：控制增益增加
-            gain_factor = 1.2;
-        }
-        
-        double current_gain = last_dynamic_values_.count("control_gain_factor") ? 
-            std::any_cast<double>(last_dynamic_values_["control_gain_factor"]) : 1.0;
-        
-        if (std::abs(current_gain - gain_factor) > 1e-6) {
-            setState("control_gain_factor", gain_factor);
-            last_dynamic_values_["control_gain_factor"] = gain_factor;
-        }
-        
-    } catch (...) {
-        // 高度状态不可用，使用默认值
+    if (!position_) {
+        return;
+    }
+    // 高度取上一帧位置的 Z 分量
+    double altitude = position_->z();
+
+    // 基于高度调整控制增益
+    double gain_factor = 1.0;
+    if (altitude > 50000.0) {
+        // 高空：控制增益减少
+        gain_factor = 0.8;
+    } else if (altitude < 10000.0) {
+        // 低空：控制增益增加
+        gain_factor = 1.2;
+    }
+
+    double current_gain = last_dynamic_values_.count("control_gain_factor") ? 
+        std::any_cast<double>(last_dynamic_values_["control_gain_factor"]) : 1.0;
+
+    if (std::abs(current_gain - gain_factor) > 1e-6) {
+        setState("control_gain_factor", gain_factor);
+        last_dynamic_values_["control_gain_factor"] = gain_factor;
     }
 }
 
-} // namespace gnc::components
\ No newline at end of file
+} // namespace gnc::components
@@ -0,0 +1,855 @@
+/**
+ * @file log_analysis.cpp
+ * @brief Parallel post-processing of many DataLogger recordings
+ */
+
+#include "gnc/components/utility/log_analysis.hpp"
+#include "gnc/components/utility/binary_writer.hpp"
+#include "gnc/core/task_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+/**
+ * @brief Parsed expression tree; definitions are shared subtrees
+ */
+class Expression {
+public:
+    enum class Kind { Number, Column, Time, Negate, Binary, Call };
+
+    Kind kind = Kind::Number;
+    double number = 0.0;
+    std::string name;                   ///< Column name or function name
+    char op = 0;                        ///< Binary operator
+    std::vector<std::shared_ptr<const Expression>> args;
+};
+
+namespace {
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+using ExpressionPtr = std::shared_ptr<const Expression>;
+
+// ============================================================================
+// Parsing
+// ============================================================================
+
+/**
+ * @brief Number of arguments a function takes; 0 for any number (at least one)
+ */
+int functionArity(const std::string& name) {
+    static const std::unordered_map<std::string, int> arities = {
+        {"abs", 1}, {"sqrt", 1}, {"exp", 1}, {"log", 1}, {"sin", 1}, {"cos", 1}, {"tan", 1},
+        {"asin", 1}, {"acos", 1}, {"atan", 1}, {"deg", 1}, {"rad", 1}, {"atan2", 2}, {"hypot", 2},
+        {"min", 0}, {"max", 0}, {"norm", 0},
+    };
+    const auto it = arities.find(name);
+    return it == arities.end() ? -1 : it->second;
+}
+
+class Parser {
+public:
+    Parser(const std::string& text, const std::map<std::string, ExpressionPtr>& definitions)
+        : text_(text), definitions_(definitions) {}
+
+    ExpressionPtr parse() {
+        ExpressionPtr result = parseSum();
+        skipSpace();
+        if (pos_ != text_.size()) {
+            fail("unexpected '" + std::string(1, text_[pos_]) + "'");
+        }
+        return result;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("Expression '" + text_ + "' at " + std::to_string(pos_) + ": " + message);
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool accept(char c) {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    static ExpressionPtr binary(char op, ExpressionPtr lhs, ExpressionPtr rhs) {
+        auto node = std::make_shared<Expression>();
+        node->kind = Expression::Kind::Binary;
+        node->op = op;
+        node->args = {std::move(lhs), std::move(rhs)};
+        return node;
+    }
+
+    ExpressionPtr parseSum() {
+        ExpressionPtr lhs = parseProduct();
+        for (;;) {
+            if (accept('+')) {
+                lhs = binary('+', lhs, parseProduct());
+            } else if (accept('-')) {
+                lhs = binary('-', lhs, parseProduct());
+            } else {
+                return lhs;
+            }
+        }
+    }
+
+    ExpressionPtr parseProduct() {
+        ExpressionPtr lhs = parseUnary();
+        for (;;) {
+            if (accept('*')) {
+                lhs = binary('*', lhs, parseUnary());
+            } else if (accept('/')) {
+                lhs = binary('/', lhs, parseUnary());
+            } else {
+                return lhs;
+            }
+        }
+    }
+
+    ExpressionPtr parseUnary() {
+        if (accept('-')) {
+            auto node = std::make_shared<Expression>();
+            node->kind = Expression::Kind::Negate;
+            node->args = {parseUnary()};
+            return node;
+        }
+        accept('+');
+        return parsePower();
+    }
+
+    ExpressionPtr parsePower() {
+        ExpressionPtr base = parsePrimary();
+        if (accept('^')) {
+            return binary('^', base, parseUnary());
+        }
+        return base;
+    }
+
+    ExpressionPtr parsePrimary() {
+        skipSpace();
+        if (pos_ >= text_.size()) {
+            fail("unexpected end");
+        }
+        const char c = text_[pos_];
+        if (accept('(')) {
+            ExpressionPtr inner = parseSum();
+            if (!accept(')')) {
+                fail("expected ')'");
+            }
+            return inner;
+        }
+        if (accept('[')) {
+            const size_t end = text_.find(']', pos_);
+            if (end == std::string::npos) {
+                fail("expected ']'");
+            }
+            auto node = std::make_shared<Expression>();
+            node->kind = Expression::Kind::Column;
+            node->name = text_.substr(pos_, end - pos_);
+            pos_ = end + 1;
+            return node;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            size_t used = 0;
+            auto node = std::make_shared<Expression>();
+            try {
+                node->number = std::stod(text_.substr(pos_), &used);
+            } catch (const std::exception&) {
+                fail("invalid number");
+            }
+            pos_ += used;
+            return node;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            const size_t start = pos_;
+            while (pos_ < text_.size() &&
+                   (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_' || text_[pos_] == '.')) {
+                ++pos_;
+            }
+            const std::string identifier = text_.substr(start, pos_ - start);
+            if (accept('(')) {
+                return parseCall(identifier);
+            }
+            const auto definition = definitions_.find(identifier);
+            if (definition != definitions_.end()) {
+                return definition->second;
+            }
+            auto node = std::make_shared<Expression>();
+            node->kind = identifier == "t" ? Expression::Kind::Time : Expression::Kind::Column;
+            node->name = identifier;
+            return node;
+        }
+        fail("unexpected '" + std::string(1, c) + "'");
+    }
+
+    ExpressionPtr parseCall(const std::string& function) {
+        const int arity = functionArity(function);
+        if (arity < 0) {
+            fail("unknown function " + function);
+        }
+        auto node = std::make_shared<Expression>();
+        node->kind = Expression::Kind::Call;
+        node->name = function;
+        if (!accept(')')) {
+            do {
+                node->args.push_back(parseSum());
+            } while (accept(','));
+            if (!accept(')')) {
+                fail("expected ')'");
+            }
+        }
+        if ((arity > 0 && node->args.size() != static_cast<size_t>(arity)) || node->args.empty()) {
+            fail(function + " takes " + (arity > 0 ? std::to_string(arity) : "at least one") + " argument(s)");
+        }
+        return node;
+    }
+
+    const std::string& text_;
+    const std::map<std::string, ExpressionPtr>& definitions_;
+    size_t pos_ = 0;
+};
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+/**
+ * @brief An expression bound to the columns of one run
+ */
+struct BoundNode {
+    const Expression* expression = nullptr;
+    const double* column = nullptr;     ///< Column and Time nodes
+    std::vector<BoundNode> children;
+};
+
+/**
+ * @brief Column lookup for one run: full names and names without the vehicle prefix
+ */
+class ColumnIndex {
+public:
+    ColumnIndex(const LogView& view, const std::string& path) : view_(view), path_(path) {
+        for (size_t j = 0; j < view.names.size(); ++j) {
+            full_.emplace(view.names[j], j);
+            if (view.vehicles) {
+                const std::string suffix = view.names[j].substr(view.names[j].find('.') + 1);
+                const auto inserted = suffix_.emplace(suffix, j);
+                if (!inserted.second) {
+                    inserted.first->second = AMBIGUOUS;
+                }
+            }
+        }
+    }
+
+    const double* find(const std::string& name) const {
+        const auto full = full_.find(name);
+        if (full != full_.end()) {
+            return view_.columns[full->second];
+        }
+        const auto suffix = suffix_.find(name);
+        if (suffix == suffix_.end()) {
+            throw std::runtime_error("Column '" + name + "' not found in " + path_);
+        }
+        if (suffix->second == AMBIGUOUS) {
+            throw std::runtime_error("Column '" + name + "' is recorded for several vehicles in " + path_ +
+                                     "; use the vehicle prefix, e.g. [1." + name + "]");
+        }
+        return view_.columns[suffix->second];
+    }
+
+private:
+    static constexpr size_t AMBIGUOUS = static_cast<size_t>(-1);
+
+    const LogView& view_;
+    const std::string& path_;
+    std::unordered_map<std::string, size_t> full_;
+    std::unordered_map<std::string, size_t> suffix_;
+};
+
+BoundNode bindExpression(const Expression& expression, const LogView& view, const ColumnIndex& index,
+               std::set<const double*>& columns) {
+    BoundNode node;
+    node.expression = &expression;
+    if (expression.kind == Expression::Kind::Column) {
+        node.column = index.find(expression.name);
+        columns.insert(node.column);
+    } else if (expression.kind == Expression::Kind::Time) {
+        node.column = view.times;
+        columns.insert(node.column);
+    }
+    for (const auto& arg : expression.args) {
+        node.children.push_back(bindExpression(*arg, view, index, columns));
+    }
+    return node;
+}
+
+/**
+ * @brief Chunk-sized buffers for intermediate results, used as a stack
+ */
+class Scratch {
+public:
+    explicit Scratch(size_t size) : size_(size) {}
+
+    double* acquire() {
+        if (used_ == buffers_.size()) {
+            buffers_.emplace_back(size_);
+        }
+        return buffers_[used_++].data();
+    }
+    void release(size_t count = 1) { used_ -= count; }
+
+private:
+    size_t size_;
+    size_t used_ = 0;
+    std::vector<std::vector<double>> buffers_;
+};
+
+template <typename F>
+inline void unary(double* out, const double* a, size_t n, F f) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = f(a[i]);
+    }
+}
+
+/**
+ * @brief Evaluate rows [begin, begin + n) of a bound expression into out
+ */
+void evaluate(const BoundNode& node, size_t stride, size_t begin, size_t n, double* out, Scratch& scratch) {
+    const Expression& expression = *node.expression;
+    switch (expression.kind) {
+    case Expression::Kind::Number:
+        std::fill(out, out + n, expression.number);
+        return;
+    case Expression::Kind::Column:
+    case Expression::Kind::Time: {
+        const double* source = node.column + begin * stride;
+        if (stride == 1) {
+            std::copy(source, source + n, out);
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = source[i * stride];
+            }
+        }
+        return;
+    }
+    case Expression::Kind::Negate:
+        evaluate(node.children[0], stride, begin, n, out, scratch);
+        unary(out, out, n, [](double x) { return -x; });
+        return;
+    case Expression::Kind::Binary: {
+        evaluate(node.children[0], stride, begin, n, out, scratch);
+        const Expression& exponent = *expression.args[1];
+        if (expression.op == '^' && exponent.kind == Expression::Kind::Number && exponent.number == 2.0) {
+            for (size_t i = 0; i < n; ++i) out[i] *= out[i];
+            return;
+        }
+        double* rhs = scratch.acquire();
+        evaluate(node.children[1], stride, begin, n, rhs, scratch);
+        switch (expression.op) {
+        case '+': for (size_t i = 0; i < n; ++i) out[i] += rhs[i]; break;
+        case '-': for (size_t i = 0; i < n; ++i) out[i] -= rhs[i]; break;
+        case '*': for (size_t i = 0; i < n; ++i) out[i] *= rhs[i]; break;
+        case '/': for (size_t i = 0; i < n; ++i) out[i] /= rhs[i]; break;
+        default: for (size_t i = 0; i < n; ++i) out[i] = std::pow(out[i], rhs[i]);
+        }
+        scratch.release();
+        return;
+    }
+    case Expression::Kind::Call: {
+        const std::string& f = expression.name;
+        evaluate(node.children[0], stride, begin, n, out, scratch);
+        if (f == "norm") {
+            unary(out, out, n, [](double x) { return x * x; });
+        }
+        if (node.children.size() > 1) {
+            double* arg = scratch.acquire();
+            for (size_t k = 1; k < node.children.size(); ++k) {
+                evaluate(node.children[k], stride, begin, n, arg, scratch);
+                if (f == "norm") {
+                    for (size_t i = 0; i < n; ++i) out[i] += arg[i] * arg[i];
+                } else if (f == "min") {
+                    for (size_t i = 0; i < n; ++i) out[i] = std::fmin(out[i], arg[i]);
+                } else if (f == "max") {
+                    for (size_t i = 0; i < n; ++i) out[i] = std::fmax(out[i], arg[i]);
+                } else if (f == "atan2") {
+                    for (size_t i = 0; i < n; ++i) out[i] = std::atan2(out[i], arg[i]);
+                } else if (f == "hypot") {
+                    for (size_t i = 0; i < n; ++i) out[i] = std::hypot(out[i], arg[i]);
+                }
+            }
+            scratch.release();
+        }
+        static const double degrees = 180.0 / std::acos(-1.0);
+        if (f == "norm" || f == "sqrt") unary(out, out, n, [](double x) { return std::sqrt(x); });
+        else if (f == "abs") unary(out, out, n, [](double x) { return std::fabs(x); });
+        else if (f == "exp") unary(out, out, n, [](double x) { return std::exp(x); });
+        else if (f == "log") unary(out, out, n, [](double x) { return std::log(x); });
+        else if (f == "sin") unary(out, out, n, [](double x) { return std::sin(x); });
+        else if (f == "cos") unary(out, out, n, [](double x) { return std::cos(x); });
+        else if (f == "tan") unary(out, out, n, [](double x) { return std::tan(x); });
+        else if (f == "asin") unary(out, out, n, [](double x) { return std::asin(x); });
+        else if (f == "acos") unary(out, out, n, [](double x) { return std::acos(x); });
+        else if (f == "atan") unary(out, out, n, [](double x) { return std::atan(x); });
+        else if (f == "deg") unary(out, out, n, [](double x) { return x * degrees; });
+        else if (f == "rad") unary(out, out, n, [](double x) { return x / degrees; });
+        return;
+    }
+    }
+}
+
+// ============================================================================
+// Reductions
+// ============================================================================
+
+/**
+ * @brief Reduction state of one expression over a range of rows; NaN values are skipped
+ */
+struct Partial {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double sum_sq = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double time_of_min = NaN;
+    double max = -std::numeric_limits<double>::infinity();
+    double time_of_max = NaN;
+    double first = NaN;
+    double last = NaN;
+
+    /**
+     * @brief Reduce one chunk (two passes, so the variance is accurate)
+     */
+    static Partial of(const double* values, const double* times, size_t n) {
+        Partial partial;
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double x = values[i];
+            if (std::isnan(x)) {
+                continue;
+            }
+            if (partial.count == 0) {
+                partial.first = x;
+            }
+            partial.last = x;
+            ++partial.count;
+            sum += x;
+            partial.sum_sq += x * x;
+            if (x < partial.min) {
+                partial.min = x;
+                partial.time_of_min = times[i];
+            }
+            if (x > partial.max) {
+                partial.max = x;
+                partial.time_of_max = times[i];
+            }
+        }
+        if (partial.count > 0) {
+            partial.mean = sum / static_cast<double>(partial.count);
+            for (size_t i = 0; i < n; ++i) {
+                if (!std::isnan(values[i])) {
+                    const double d = values[i] - partial.mean;
+                    partial.m2 += d * d;
+                }
+            }
+        }
+        return partial;
+    }
+
+    /**
+     * @brief Append the reduction of the following rows
+     */
+    void merge(const Partial& next) {
+        if (next.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            *this = next;
+            return;
+        }
+        const double n_a = static_cast<double>(count);
+        const double n_b = static_cast<double>(next.count);
+        const double delta = next.mean - mean;
+        mean += delta * n_b / (n_a + n_b);
+        m2 += next.m2 + delta * delta * n_a * n_b / (n_a + n_b);
+        count += next.count;
+        sum_sq += next.sum_sq;
+        if (next.min < min) {
+            min = next.min;
+            time_of_min = next.time_of_min;
+        }
+        if (next.max > max) {
+            max = next.max;
+            time_of_max = next.time_of_max;
+        }
+        last = next.last;
+    }
+
+    double value(ReductionOp op) const {
+        if (count == 0) {
+            return NaN;
+        }
+        switch (op) {
+        case ReductionOp::Min: return min;
+        case ReductionOp::Max: return max;
+        case ReductionOp::Mean: return mean;
+        case ReductionOp::Rms: return std::sqrt(sum_sq / static_cast<double>(count));
+        case ReductionOp::Std: return count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : NaN;
+        case ReductionOp::First: return first;
+        case ReductionOp::Final: return last;
+        case ReductionOp::TimeOfMin: return time_of_min;
+        case ReductionOp::TimeOfMax: return time_of_max;
+        }
+        return NaN;
+    }
+};
+
+/**
+ * @brief A row range of one run
+ */
+struct WorkItem {
+    size_t run = 0;
+    size_t chunk = 0;                   ///< Chunk index within the run
+    size_t begin = 0;
+    size_t count = 0;
+};
+
+/**
+ * @brief Run fn(item, scratch) for every item on `threads` workers pulling from a shared counter
+ */
+void parallelFor(const std::vector<WorkItem>& items, size_t threads, size_t chunk_rows,
+                 const std::function<void(const WorkItem&, Scratch&)>& fn) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max<size_t>(1, items.size()));
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        Scratch scratch(chunk_rows);
+        for (size_t i = next++; i < items.size(); i = next++) {
+            fn(items[i], scratch);
+        }
+    };
+    if (threads == 1) {
+        worker();
+        return;
+    }
+    TaskPool pool(threads);
+    std::vector<std::future<void>> futures;
+    for (size_t t = 0; t < threads; ++t) {
+        futures.push_back(pool.submit(worker));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+std::vector<WorkItem> splitRuns(const std::vector<std::unique_ptr<LogView>>& runs, size_t chunk_rows,
+                                std::vector<size_t>& chunks_per_run) {
+    std::vector<WorkItem> items;
+    chunks_per_run.assign(runs.size(), 0);
+    for (size_t r = 0; r < runs.size(); ++r) {
+        for (size_t begin = 0; begin < runs[r]->rows; begin += chunk_rows) {
+            items.push_back({r, chunks_per_run[r]++, begin, std::min(chunk_rows, runs[r]->rows - begin)});
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Linear interpolation of (times, values) onto grid; NaN outside the recorded span
+ */
+void interpolate(const double* times, size_t stride, const double* values, size_t rows, const std::vector<double>& grid,
+                 double* out) {
+    size_t j = 0;
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const double t = grid[i];
+        if (rows == 0 || t < times[0] || t > times[(rows - 1) * stride]) {
+            out[i] = NaN;
+            continue;
+        }
+        while (j + 1 < rows && times[(j + 1) * stride] < t) {
+            ++j;
+        }
+        const double t0 = times[j * stride];
+        if (j + 1 >= rows || t0 == t) {
+            out[i] = values[j];
+            continue;
+        }
+        const double t1 = times[(j + 1) * stride];
+        out[i] = t1 > t0 ? values[j] + (values[j + 1] - values[j]) * (t - t0) / (t1 - t0) : values[j];
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// ReductionSpec
+// ============================================================================
+
+ReductionSpec ReductionSpec::parse(const std::string& text) {
+    static const std::map<std::string, ReductionOp> ops = {
+        {"min", ReductionOp::Min}, {"max", ReductionOp::Max}, {"mean", ReductionOp::Mean},
+        {"rms", ReductionOp::Rms}, {"std", ReductionOp::Std}, {"first", ReductionOp::First},
+        {"final", ReductionOp::Final}, {"time_of_min", ReductionOp::TimeOfMin},
+        {"time_of_max", ReductionOp::TimeOfMax},
+    };
+    const auto equals = text.find('=');
+    const auto colon = text.find(':', equals == std::string::npos ? 0 : equals);
+    if (equals == std::string::npos || colon == std::string::npos) {
+        throw std::invalid_argument("Reduction '" + text + "' should be NAME=OP:EXPR");
+    }
+    const std::string op = text.substr(equals + 1, colon - equals - 1);
+    const auto it = ops.find(op);
+    if (it == ops.end()) {
+        throw std::invalid_argument("Unknown reduction '" + op +
+                                    "' (min, max, mean, rms, std, first, final, time_of_min, time_of_max)");
+    }
+    return {text.substr(0, equals), it->second, text.substr(colon + 1)};
+}
+
+// ============================================================================
+// RunSet
+// ============================================================================
+
+RunSet::RunSet() = default;
+RunSet::~RunSet() = default;
+RunSet::RunSet(RunSet&&) noexcept = default;
+RunSet& RunSet::operator=(RunSet&&) noexcept = default;
+
+RunSet RunSet::open(const std::vector<std::string>& paths, size_t threads) {
+    RunSet set;
+    set.paths_ = paths;
+    set.runs_.resize(paths.size());
+    std::vector<WorkItem> items;
+    for (size_t r = 0; r < paths.size(); ++r) {
+        items.push_back({r, 0, 0, 0});
+    }
+    // The HDF5 library is not thread-safe; only binary logs are opened concurrently
+    std::mutex loader;
+    parallelFor(items, threads, 0, [&](const WorkItem& item, Scratch&) {
+        const std::string& path = paths[item.run];
+        if (std::filesystem::path(path).extension().string() == BinaryWriter::EXTENSION) {
+            set.runs_[item.run] = std::make_unique<LogView>(LogView::open(path));
+        } else {
+            std::lock_guard<std::mutex> lock(loader);
+            set.runs_[item.run] = std::make_unique<LogView>(LogView::open(path));
+        }
+    });
+    return set;
+}
+
+std::shared_ptr<const Expression> RunSet::parse(const std::string& expression) const {
+    return Parser(expression, definitions_).parse();
+}
+
+void RunSet::define(const std::string& name, const std::string& expression) {
+    definitions_[name] = parse(expression);
+}
+
+Matrix RunSet::reduce(const std::vector<ReductionSpec>& specs, const AnalysisOptions& options) {
+    const auto start = std::chrono::steady_clock::now();
+
+    // Specs sharing an expression evaluate it once
+    std::vector<std::string> texts;
+    std::vector<size_t> expression_of(specs.size());
+    for (size_t s = 0; s < specs.size(); ++s) {
+        const auto it = std::find(texts.begin(), texts.end(), specs[s].expression);
+        expression_of[s] = static_cast<size_t>(std::distance(texts.begin(), it));
+        if (it == texts.end()) {
+            texts.push_back(specs[s].expression);
+        }
+    }
+    std::vector<ExpressionPtr> expressions;
+    for (const auto& text : texts) {
+        expressions.push_back(parse(text));
+    }
+
+    std::vector<std::vector<BoundNode>> bound(runs_.size());
+    stats_ = {};
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        const ColumnIndex index(*runs_[r], paths_[r]);
+        std::set<const double*> columns;
+        for (const auto& expression : expressions) {
+            bound[r].push_back(bindExpression(*expression, *runs_[r], index, columns));
+        }
+        stats_.rows += runs_[r]->rows;
+        stats_.bytes += runs_[r]->rows * (columns.size() + 1) * sizeof(double);
+    }
+
+    const size_t chunk_rows = std::max<size_t>(1, options.chunk_rows);
+    std::vector<size_t> chunks_per_run;
+    const std::vector<WorkItem> items = splitRuns(runs_, chunk_rows, chunks_per_run);
+    std::vector<size_t> first_chunk(runs_.size() + 1, 0);
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        first_chunk[r + 1] = first_chunk[r] + chunks_per_run[r];
+    }
+    // partials[(first_chunk[run] + chunk) * expressions + e]
+    std::vector<Partial> partials(items.size() * expressions.size());
+
+    parallelFor(items, options.threads, chunk_rows, [&](const WorkItem& item, Scratch& scratch) {
+        const LogView& view = *runs_[item.run];
+        double* times = scratch.acquire();
+        double* values = scratch.acquire();
+        for (size_t i = 0; i < item.count; ++i) {
+            times[i] = view.times[(item.begin + i) * view.stride];
+        }
+        for (size_t e = 0; e < expressions.size(); ++e) {
+            evaluate(bound[item.run][e], view.stride, item.begin, item.count, values, scratch);
+            partials[(first_chunk[item.run] + item.chunk) * expressions.size() + e] =
+                Partial::of(values, times, item.count);
+        }
+        scratch.release(2);
+    });
+
+    Matrix result(runs_.size(), specs.size(), NaN);
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        for (size_t e = 0; e < expressions.size(); ++e) {
+            Partial total;
+            for (size_t c = first_chunk[r]; c < first_chunk[r + 1]; ++c) {
+                total.merge(partials[c * expressions.size() + e]);
+            }
+            for (size_t s = 0; s < specs.size(); ++s) {
+                if (expression_of[s] == e) {
+                    result(r, s) = total.value(specs[s].op);
+                }
+            }
+        }
+    }
+    stats_.elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+SeriesResult RunSet::series(const std::string& text, const AnalysisOptions& options) {
+    const auto start = std::chrono::steady_clock::now();
+    const ExpressionPtr expression = parse(text);
+
+    SeriesResult result;
+    if (runs_.empty()) {
+        return result;
+    }
+    const LogView& reference = *runs_.front();
+    result.times.resize(reference.rows);
+    for (size_t i = 0; i < reference.rows; ++i) {
+        result.times[i] = reference.time(i);
+    }
+    const size_t grid = result.times.size();
+    result.values = Matrix(runs_.size(), grid, NaN);
+
+    std::vector<BoundNode> bound;
+    stats_ = {};
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        const ColumnIndex index(*runs_[r], paths_[r]);
+        std::set<const double*> columns;
+        bound.push_back(bindExpression(*expression, *runs_[r], index, columns));
+        stats_.rows += runs_[r]->rows;
+        stats_.bytes += runs_[r]->rows * (columns.size() + 1) * sizeof(double);
+    }
+
+    // Runs on the reference grid are written straight into the result; the others go
+    // through a per-run buffer and are interpolated afterwards
+    std::vector<WorkItem> per_run;
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        per_run.push_back({r, 0, 0, 0});
+    }
+    std::vector<char> on_grid(runs_.size(), 0);
+    parallelFor(per_run, options.threads, 0, [&](const WorkItem& item, Scratch&) {
+        const LogView& view = *runs_[item.run];
+        bool same = view.rows == grid;
+        for (size_t i = 0; same && i < grid; ++i) {
+            same = view.time(i) == result.times[i];
+        }
+        on_grid[item.run] = same ? 1 : 0;
+    });
+    std::vector<std::vector<double>> buffers(runs_.size());
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        if (!on_grid[r]) {
+            buffers[r].resize(runs_[r]->rows);
+        }
+    }
+
+    const size_t chunk_rows = std::max<size_t>(1, options.chunk_rows);
+    std::vector<size_t> chunks_per_run;
+    const std::vector<WorkItem> items = splitRuns(runs_, chunk_rows, chunks_per_run);
+    parallelFor(items, options.threads, chunk_rows, [&](const WorkItem& item, Scratch& scratch) {
+        double* out = on_grid[item.run] ? &result.values(item.run, 0) : buffers[item.run].data();
+        evaluate(bound[item.run], runs_[item.run]->stride, item.begin, item.count, out + item.begin, scratch);
+    });
+    parallelFor(per_run, options.threads, 0, [&](const WorkItem& item, Scratch&) {
+        if (!on_grid[item.run]) {
+            const LogView& view = *runs_[item.run];
+            interpolate(view.times, view.stride, buffers[item.run].data(), view.rows, result.times,
+                        &result.values(item.run, 0));
+            std::vector<double>().swap(buffers[item.run]);
+        }
+    });
+
+    stats_.elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+Matrix percentileBands(const SeriesResult& series, const std::vector<double>& percentiles, size_t threads) {
+    const size_t runs = series.values.rows;
+    const size_t grid = series.values.cols;
+    Matrix bands(percentiles.size(), grid, NaN);
+
+    // Blocks of grid times, transposed so that each time's values across runs are contiguous
+    constexpr size_t BLOCK = 256;
+    std::vector<WorkItem> items;
+    for (size_t begin = 0; begin < grid; begin += BLOCK) {
+        items.push_back({0, 0, begin, std::min(BLOCK, grid - begin)});
+    }
+    parallelFor(items, threads, 0, [&](const WorkItem& item, Scratch&) {
+        std::vector<double> block(item.count * runs);
+        for (size_t r = 0; r < runs; ++r) {
+            const double* row = series.values.row(r) + item.begin;
+            for (size_t i = 0; i < item.count; ++i) {
+                block[i * runs + r] = row[i];
+            }
+        }
+        for (size_t i = 0; i < item.count; ++i) {
+            double* first = block.data() + i * runs;
+            double* last = std::remove_if(first, first + runs, [](double x) { return std::isnan(x); });
+            const size_t n = static_cast<size_t>(last - first);
+            if (n == 0) {
+                continue;
+            }
+            for (size_t p = 0; p < percentiles.size(); ++p) {
+                // Linear interpolation between order statistics
+                const double position = std::clamp(percentiles[p], 0.0, 100.0) / 100.0 * static_cast<double>(n - 1);
+                const size_t k = static_cast<size_t>(position);
+                std::nth_element(first, first + k, last);
+                double value = first[k];
+                if (position > static_cast<double>(k) && k + 1 < n) {
+                    value += (*std::min_element(first + k + 1, last) - value) * (position - static_cast<double>(k));
+                }
+                bands(p, item.begin + i) = value;
+            }
+        }
+    });
+    return bands;
+}
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
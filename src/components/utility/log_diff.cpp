@@ -0,0 +1,372 @@
+/**
+ * @file log_diff.cpp
+ * @brief Run-to-run comparison of DataLogger recordings
+ */
+
+#include "gnc/components/utility/log_diff.hpp"
+#include "gnc/components/utility/log_reader.hpp"
+#include "gnc/core/task_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <regex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+namespace {
+
+/**
+ * @brief Drop the vehicle prefix from every name (when only one of the logs records vehicles)
+ */
+void stripVehicles(LogView& source) {
+    for (auto& name : source.names) {
+        name = name.substr(name.find('.') + 1);
+    }
+    source.vehicles = false;
+}
+
+/**
+ * @brief Row pairs to compare; identity when both logs share their time column
+ */
+struct RowAlignment {
+    bool identity = false;
+    uint64_t count = 0;
+    std::vector<uint64_t> a;
+    std::vector<uint64_t> b;
+    uint64_t only_a = 0;
+    uint64_t only_b = 0;
+
+    uint64_t rowA(uint64_t i) const { return identity ? i : a[i]; }
+    uint64_t rowB(uint64_t i) const { return identity ? i : b[i]; }
+};
+
+RowAlignment alignRows(const LogView& a, const LogView& b, double tolerance) {
+    RowAlignment alignment;
+    const uint64_t common = std::min(a.rows, b.rows);
+    uint64_t equal = 0;
+    while (equal < common && std::fabs(a.time(equal) - b.time(equal)) <= tolerance) {
+        ++equal;
+    }
+    if (equal == common) {
+        alignment.identity = true;
+        alignment.count = common;
+        alignment.only_a = a.rows - common;
+        alignment.only_b = b.rows - common;
+        return alignment;
+    }
+
+    uint64_t i = 0;
+    uint64_t j = 0;
+    while (i < a.rows && j < b.rows) {
+        const double ta = a.time(i);
+        const double tb = b.time(j);
+        if (std::fabs(ta - tb) <= tolerance) {
+            alignment.a.push_back(i++);
+            alignment.b.push_back(j++);
+        } else if (ta < tb) {
+            ++i;
+            ++alignment.only_a;
+        } else {
+            ++j;
+            ++alignment.only_b;
+        }
+    }
+    alignment.only_a += a.rows - i;
+    alignment.only_b += b.rows - j;
+    alignment.count = alignment.a.size();
+    return alignment;
+}
+
+struct ChunkStats {
+    std::vector<double> max_abs;
+    std::vector<uint64_t> mismatches;
+    std::vector<uint64_t> first_row;
+
+    explicit ChunkStats(size_t columns)
+        : max_abs(columns, 0.0), mismatches(columns, 0), first_row(columns, std::numeric_limits<uint64_t>::max()) {}
+};
+
+/**
+ * @brief Branch-free so that the row loop vectorizes
+ * @details Non-finite values bypass the tolerance, whose limit would itself be
+ * inf or NaN: inf matches only the same-signed inf, NaN matches only NaN.
+ */
+inline bool mismatch(double a, double b, double abs_tolerance, double rel_tolerance) {
+    constexpr double largest = std::numeric_limits<double>::max();
+    const bool finite = (std::fabs(a) <= largest) & (std::fabs(b) <= largest);
+    const bool identical = (a == b) | ((a != a) & (b != b));
+    const double limit = abs_tolerance + rel_tolerance * std::max(std::fabs(a), std::fabs(b));
+    return (finite & (std::fabs(a - b) > limit)) | (!finite & !identical);
+}
+
+/**
+ * @brief Compare row pairs [begin, end) of the alignment
+ */
+class RowScanner {
+public:
+    RowScanner(const LogView& a, const LogView& b, const RowAlignment& alignment,
+               const std::vector<size_t>& columns_a, const std::vector<size_t>& columns_b,
+               const std::vector<double>& abs_tolerance, const std::vector<double>& rel_tolerance)
+        : a_(a), b_(b), alignment_(alignment), abs_(abs_tolerance), rel_(rel_tolerance) {
+        for (size_t k = 0; k < columns_a.size(); ++k) {
+            columns_a_.push_back(a.columns[columns_a[k]]);
+            columns_b_.push_back(b.columns[columns_b[k]]);
+        }
+        // Same layout on both sides: row r of the matched columns is one contiguous run of doubles
+        contiguous_ = a.row_major && b.row_major && columns_a.size() == a.columns.size() &&
+                      columns_b.size() == b.columns.size();
+        for (size_t k = 0; contiguous_ && k < columns_a.size(); ++k) {
+            contiguous_ = columns_a[k] == k && columns_b[k] == k;
+        }
+    }
+
+    ChunkStats scan(uint64_t begin, uint64_t end) const {
+        const size_t n = columns_a_.size();
+        ChunkStats stats(n);
+        const double* abs = abs_.data();
+        const double* rel = rel_.data();
+        double* max_abs = stats.max_abs.data();
+        for (uint64_t i = begin; i < end; ++i) {
+            const uint64_t ra = alignment_.rowA(i);
+            const uint64_t rb = alignment_.rowB(i);
+            bool any = false;
+            if (contiguous_) {
+                const double* pa = columns_a_.empty() ? nullptr : columns_a_[0] + ra * a_.stride;
+                const double* pb = columns_b_.empty() ? nullptr : columns_b_[0] + rb * b_.stride;
+                for (size_t k = 0; k < n; ++k) {
+                    const double error = std::fabs(pa[k] - pb[k]);
+                    max_abs[k] = error > max_abs[k] ? error : max_abs[k];
+                    any |= mismatch(pa[k], pb[k], abs[k], rel[k]);
+                }
+            } else {
+                for (size_t k = 0; k < n; ++k) {
+                    const double va = columns_a_[k][ra * a_.stride];
+                    const double vb = columns_b_[k][rb * b_.stride];
+                    const double error = std::fabs(va - vb);
+                    max_abs[k] = error > max_abs[k] ? error : max_abs[k];
+                    any |= mismatch(va, vb, abs[k], rel[k]);
+                }
+            }
+            if (any) {
+                record(stats, ra, rb);
+            }
+        }
+        return stats;
+    }
+
+private:
+    void record(ChunkStats& stats, uint64_t ra, uint64_t rb) const {
+        for (size_t k = 0; k < columns_a_.size(); ++k) {
+            if (mismatch(columns_a_[k][ra * a_.stride], columns_b_[k][rb * b_.stride], abs_[k], rel_[k])) {
+                ++stats.mismatches[k];
+                stats.first_row[k] = std::min(stats.first_row[k], ra);
+            }
+        }
+    }
+
+    const LogView& a_;
+    const LogView& b_;
+    const RowAlignment& alignment_;
+    std::vector<const double*> columns_a_;
+    std::vector<const double*> columns_b_;
+    const std::vector<double>& abs_;
+    const std::vector<double>& rel_;
+    bool contiguous_ = false;
+};
+
+} // namespace
+
+DiffOptions DiffOptions::fromJson(const nlohmann::json& config) {
+    DiffOptions options;
+    options.abs_tolerance = config.value("abs_tolerance", options.abs_tolerance);
+    options.rel_tolerance = config.value("rel_tolerance", options.rel_tolerance);
+    options.time_tolerance = config.value("time_tolerance", options.time_tolerance);
+    options.include = config.value("include", options.include);
+    options.allow_missing = config.value("allow_missing", options.allow_missing);
+    options.threads = config.value("threads", options.threads);
+    for (const auto& entry : config.value("overrides", nlohmann::json::array())) {
+        options.overrides.push_back({entry.at("pattern").get<std::string>(), entry.value("abs", options.abs_tolerance),
+                                     entry.value("rel", options.rel_tolerance)});
+    }
+    return options;
+}
+
+nlohmann::json ColumnDiff::toJson() const {
+    nlohmann::json json = {
+        {"name", name},
+        {"abs_tolerance", abs_tolerance},
+        {"rel_tolerance", rel_tolerance},
+        {"mismatches", mismatches},
+        {"max_abs_error", max_abs_error},
+    };
+    if (diverged()) {
+        json["first_divergence_time"] = first_divergence_time;
+    }
+    return json;
+}
+
+bool DiffResult::passed() const {
+    return (allow_missing || structurallyEqual()) &&
+           std::none_of(columns.begin(), columns.end(), [](const ColumnDiff& column) { return column.diverged(); });
+}
+
+const ColumnDiff* DiffResult::firstDivergence() const {
+    const ColumnDiff* first = nullptr;
+    for (const auto& column : columns) {
+        if (column.diverged() && (!first || column.first_divergence_row < first->first_divergence_row)) {
+            first = &column;
+        }
+    }
+    return first;
+}
+
+nlohmann::json DiffResult::toJson() const {
+    nlohmann::json json = {
+        {"passed", passed()},
+        {"rows_a", rows_a},
+        {"rows_b", rows_b},
+        {"compared_rows", compared_rows},
+        {"rows_only_a", rows_only_a},
+        {"rows_only_b", rows_only_b},
+        {"only_in_a", only_in_a},
+        {"only_in_b", only_in_b},
+        {"elapsed_s", elapsed_s},
+        {"bytes_scanned", bytes_scanned},
+        {"columns", nlohmann::json::array()},
+    };
+    for (const auto& column : columns) {
+        json["columns"].push_back(column.toJson());
+    }
+    if (const ColumnDiff* first = firstDivergence()) {
+        json["first_divergence_time"] = first->first_divergence_time;
+        json["first_divergence_column"] = first->name;
+    }
+    return json;
+}
+
+DiffResult diffLogs(const std::string& path_a, const std::string& path_b, const DiffOptions& options) {
+    const auto start = std::chrono::steady_clock::now();
+    LogView a = LogView::open(path_a);
+    LogView b = LogView::open(path_b);
+    if (a.vehicles != b.vehicles) {
+        // HDF5 and older CSV logs carry no vehicle ids; match those by flattened name alone
+        stripVehicles(a.vehicles ? a : b);
+    }
+
+    std::vector<std::regex> patterns;
+    try {
+        for (const auto& tolerance : options.overrides) {
+            patterns.emplace_back(tolerance.pattern);
+        }
+    } catch (const std::regex_error& e) {
+        throw std::runtime_error(std::string("Invalid tolerance pattern: ") + e.what());
+    }
+    std::optional<std::regex> include;
+    if (!options.include.empty()) {
+        try {
+            include.emplace(options.include);
+        } catch (const std::regex_error& e) {
+            throw std::runtime_error("Invalid include pattern '" + options.include + "': " + e.what());
+        }
+    }
+    auto included = [&include](const std::string& name) { return !include || std::regex_search(name, *include); };
+
+    DiffResult result;
+    result.rows_a = a.rows;
+    result.rows_b = b.rows;
+    result.allow_missing = options.allow_missing;
+
+    std::unordered_map<std::string, size_t> index_b;
+    for (size_t j = 0; j < b.names.size(); ++j) {
+        index_b.emplace(b.names[j], j);
+    }
+    std::vector<size_t> columns_a;
+    std::vector<size_t> columns_b;
+    std::vector<double> abs_tolerance;
+    std::vector<double> rel_tolerance;
+    std::vector<bool> matched_b(b.names.size(), false);
+    for (size_t j = 0; j < a.names.size(); ++j) {
+        const std::string& name = a.names[j];
+        if (!included(name)) {
+            continue;
+        }
+        const auto it = index_b.find(name);
+        if (it == index_b.end() || matched_b[it->second]) {
+            result.only_in_a.push_back(name);
+            continue;
+        }
+        matched_b[it->second] = true;
+        columns_a.push_back(j);
+        columns_b.push_back(it->second);
+
+        ColumnDiff column;
+        column.name = name;
+        column.abs_tolerance = options.abs_tolerance;
+        column.rel_tolerance = options.rel_tolerance;
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            if (std::regex_search(name, patterns[p])) {
+                column.abs_tolerance = options.overrides[p].abs;
+                column.rel_tolerance = options.overrides[p].rel;
+                break;
+            }
+        }
+        abs_tolerance.push_back(column.abs_tolerance);
+        rel_tolerance.push_back(column.rel_tolerance);
+        result.columns.push_back(std::move(column));
+    }
+    for (size_t j = 0; j < b.names.size(); ++j) {
+        if (!matched_b[j] && included(b.names[j])) {
+            result.only_in_b.push_back(b.names[j]);
+        }
+    }
+
+    const RowAlignment alignment = alignRows(a, b, options.time_tolerance);
+    result.compared_rows = alignment.count;
+    result.rows_only_a = alignment.only_a;
+    result.rows_only_b = alignment.only_b;
+
+    const RowScanner scanner(a, b, alignment, columns_a, columns_b, abs_tolerance, rel_tolerance);
+    std::vector<ChunkStats> chunks;
+    constexpr uint64_t MIN_ROWS_PER_TASK = 1 << 14;
+    const size_t threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    if (threads == 1 || alignment.count < 2 * MIN_ROWS_PER_TASK) {
+        chunks.push_back(scanner.scan(0, alignment.count));
+    } else {
+        const uint64_t tasks = std::min<uint64_t>(threads * 4, alignment.count / MIN_ROWS_PER_TASK);
+        TaskPool pool(threads);
+        std::vector<std::future<ChunkStats>> futures;
+        for (uint64_t t = 0; t < tasks; ++t) {
+            const uint64_t begin = alignment.count * t / tasks;
+            const uint64_t end = alignment.count * (t + 1) / tasks;
+            futures.push_back(pool.submit([&scanner, begin, end]() { return scanner.scan(begin, end); }));
+        }
+        for (auto& future : futures) {
+            chunks.push_back(future.get());
+        }
+    }
+
+    for (size_t k = 0; k < result.columns.size(); ++k) {
+        auto& column = result.columns[k];
+        for (const auto& chunk : chunks) {
+            column.max_abs_error = std::max(column.max_abs_error, chunk.max_abs[k]);
+            column.mismatches += chunk.mismatches[k];
+            column.first_divergence_row = std::min(column.first_divergence_row, chunk.first_row[k]);
+        }
+        if (column.diverged()) {
+            column.first_divergence_time = a.time(column.first_divergence_row);
+        }
+    }
+
+    result.bytes_scanned = alignment.count * (columns_a.size() + 1) * 2 * sizeof(double);
+    result.elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
@@ -0,0 +1,351 @@
+/**
+ * @file log_reader.cpp
+ * @brief Readers for files written by DataLogger
+ */
+
+#include "gnc/components/utility/log_reader.hpp"
+#include "gnc/components/utility/binary_writer.hpp"
+#include "math/math.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef HDF5_AVAILABLE
+#include <H5Cpp.h>
+#endif
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+namespace {
+
+/**
+ * @brief Split a flattened name "Component.state" into its state part
+ */
+std::string stateOf(const std::string& component, const std::string& flattened_name) {
+    const std::string prefix = component + ".";
+    if (flattened_name.compare(0, prefix.size(), prefix) == 0) {
+        return flattened_name.substr(prefix.size());
+    }
+    return flattened_name;
+}
+
+} // namespace
+
+RecordedLog RecordedLog::load(const std::string& path) {
+    const std::string extension = std::filesystem::path(path).extension().string();
+    if (extension == BinaryWriter::EXTENSION) {
+        return loadBinary(path);
+    } else if (extension == ".csv") {
+        return loadCsv(path);
+    } else if (extension == ".h5" || extension == ".hdf5") {
+        return loadHdf5(path);
+    }
+    throw std::runtime_error("Unsupported log format '" + extension + "' (expected .gnclog, .csv or .h5)");
+}
+
+MappedBinaryLog::MappedBinaryLog(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open log file: " + path);
+    }
+    char magic[sizeof(BinaryWriter::MAGIC)];
+    uint64_t header_size = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&header_size), sizeof(header_size));
+    if (!file || std::memcmp(magic, BinaryWriter::MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a GNC binary log: " + path);
+    }
+    std::string header_text(header_size, '\0');
+    file.read(header_text.data(), static_cast<std::streamsize>(header_size));
+    const auto header = nlohmann::json::parse(header_text);
+
+    metadata_ = header.value("metadata", nlohmann::json::object());
+    for (const auto& entry : header.at("columns")) {
+        LogColumn column;
+        column.vehicle = entry.at("vehicle").get<gnc::states::VehicleId>();
+        column.component = entry.at("component").get<std::string>();
+        column.name = entry.value("name", "");
+        column.state = entry.value("state", "");
+        column.type_name = entry.value("type", "");
+        column.index = entry.value("index", 0);
+        columns_.push_back(std::move(column));
+    }
+
+    const size_t data_offset = sizeof(magic) + sizeof(header_size) + header_size;
+    file.seekg(0, std::ios::end);
+    const auto file_size = static_cast<size_t>(file.tellg());
+    // A partially written last row (interrupted run) is ignored
+    rows_ = (file_size - data_offset) / (width() * sizeof(double));
+    const size_t data_bytes = rows_ * width() * sizeof(double);
+
+#if defined(__unix__) || defined(__APPLE__)
+    if (data_offset % alignof(double) == 0 && data_bytes > 0) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            void* mapping = ::mmap(nullptr, data_offset + data_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapping != MAP_FAILED) {
+                ::madvise(mapping, data_offset + data_bytes, MADV_SEQUENTIAL);
+                mapping_ = mapping;
+                mapping_size_ = data_offset + data_bytes;
+                data_ = reinterpret_cast<const double*>(static_cast<const char*>(mapping) + data_offset);
+                return;
+            }
+        }
+    }
+#endif
+    buffer_.resize(rows_ * width());
+    file.seekg(static_cast<std::streamoff>(data_offset));
+    file.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(data_bytes));
+    data_ = buffer_.data();
+}
+
+MappedBinaryLog::~MappedBinaryLog() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapping_) {
+        ::munmap(mapping_, mapping_size_);
+    }
+#endif
+}
+
+RecordedLog RecordedLog::loadBinary(const std::string& path) {
+    const MappedBinaryLog mapped(path);
+    RecordedLog log;
+    log.metadata_ = mapped.metadata();
+    log.columns_ = mapped.columns();
+
+    const size_t rows = mapped.rows();
+    log.times_.resize(rows);
+    log.values_.assign(log.columns_.size(), std::vector<double>(rows));
+    for (size_t row = 0; row < rows; ++row) {
+        const double* values = mapped.row(row);
+        log.times_[row] = values[0];
+        for (size_t column = 0; column < log.columns_.size(); ++column) {
+            log.values_[column][row] = values[column + 1];
+        }
+    }
+    return log;
+}
+
+RecordedLog RecordedLog::loadCsv(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open log file: " + path);
+    }
+
+    RecordedLog log;
+    std::string line;
+    bool header_read = false;
+    std::vector<gnc::states::VehicleId> vehicles;
+    const std::string vehicles_prefix = "# vehicles: ";
+    while (std::getline(file, line)) {
+        if (line.compare(0, vehicles_prefix.size(), vehicles_prefix) == 0) {
+            std::stringstream ids(line.substr(vehicles_prefix.size()));
+            std::string id;
+            while (std::getline(ids, id, ',')) {
+                vehicles.push_back(std::stoull(id));
+            }
+            continue;
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::stringstream cells(line);
+        std::string cell;
+        if (!header_read) {
+            // Column names are "<component>.<flattened name>", where the flattened name itself
+            // starts with "<component>."; vehicle ids come from the "# vehicles:" line if present
+            std::getline(cells, cell, ',');
+            while (std::getline(cells, cell, ',')) {
+                const auto dot = cell.find('.');
+                LogColumn column;
+                column.component = cell.substr(0, dot);
+                if (log.columns_.size() < vehicles.size()) {
+                    column.vehicle = vehicles[log.columns_.size()];
+                }
+                log.addColumn(std::move(column), dot == std::string::npos ? cell : cell.substr(dot + 1));
+            }
+            log.values_.resize(log.columns_.size());
+            header_read = true;
+            continue;
+        }
+        std::getline(cells, cell, ',');
+        log.times_.push_back(std::strtod(cell.c_str(), nullptr));
+        for (auto& values : log.values_) {
+            values.push_back(std::getline(cells, cell, ',') ? std::strtod(cell.c_str(), nullptr)
+                                                             : std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+    log.inferTypes();
+    return log;
+}
+
+RecordedLog RecordedLog::loadHdf5(const std::string& path) {
+#ifdef HDF5_AVAILABLE
+    using namespace H5;
+    RecordedLog log;
+    try {
+        H5File file(path, H5F_ACC_RDONLY);
+        Group data = file.openGroup("/data");
+
+        auto readColumn = [](const DataSet& dataset) {
+            hsize_t dims[2] = {0, 1};
+            dataset.getSpace().getSimpleExtentDims(dims);
+            std::vector<double> values(dims[0] * std::max<hsize_t>(dims[1], 1));
+            dataset.read(values.data(), PredType::NATIVE_DOUBLE);
+            if (dims[1] > 1) {
+                // DataLogger writes flattened scalars; keep only the first column of wider datasets
+                for (hsize_t row = 0; row < dims[0]; ++row) {
+                    values[row] = values[row * dims[1]];
+                }
+                values.resize(dims[0]);
+            }
+            return values;
+        };
+
+        log.times_ = readColumn(data.openDataSet("time"));
+        for (hsize_t i = 0; i < data.getNumObjs(); ++i) {
+            const std::string component = data.getObjnameByIdx(i);
+            if (data.getObjTypeByIdx(i) != H5G_GROUP) {
+                continue;
+            }
+            Group group = data.openGroup(component);
+            for (hsize_t j = 0; j < group.getNumObjs(); ++j) {
+                const std::string name = group.getObjnameByIdx(j);
+                LogColumn column;
+                column.component = component;
+                log.addColumn(std::move(column), name);
+                log.values_.push_back(readColumn(group.openDataSet(name)));
+                log.values_.back().resize(log.times_.size(), std::numeric_limits<double>::quiet_NaN());
+            }
+        }
+    } catch (const Exception& e) {
+        throw std::runtime_error("Failed to read HDF5 log " + path + ": " + e.getCDetailMsg());
+    }
+    log.inferTypes();
+    return log;
+#else
+    throw std::runtime_error("Cannot read " + path + ": built without HDF5 support");
+#endif
+}
+
+void RecordedLog::addColumn(LogColumn column, const std::string& flattened_name) {
+    column.name = flattened_name;
+    column.state = stateOf(column.component, flattened_name);
+    columns_.push_back(std::move(column));
+}
+
+void RecordedLog::inferTypes() {
+    // Group by (vehicle, component, state name without suffix) and infer the type from the suffixes
+    using Key = std::tuple<std::optional<gnc::states::VehicleId>, std::string, std::string>;
+    std::map<Key, std::map<char, size_t>> groups;
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        auto& column = columns_[i];
+        if (!column.type_name.empty()) {
+            continue;
+        }
+        column.type_name = typeid(double).name();
+        const auto& state = column.state;
+        if (state.size() > 2 && state[state.size() - 2] == '_' && std::strchr("wxyz", state.back())) {
+            groups[{column.vehicle, column.component, state.substr(0, state.size() - 2)}][state.back()] = i;
+        }
+    }
+    for (const auto& [key, suffixes] : groups) {
+        const bool has_xyz = suffixes.count('x') && suffixes.count('y') && suffixes.count('z');
+        if (!has_xyz) {
+            continue;
+        }
+        const bool quaternion = suffixes.count('w') > 0;
+        for (const auto& [suffix, index] : suffixes) {
+            auto& column = columns_[index];
+            column.state = std::get<2>(key);
+            if (quaternion) {
+                column.type_name = typeid(Quaterniond).name();
+                column.index = suffix == 'w' ? 0 : suffix - 'x' + 1;
+            } else {
+                column.type_name = typeid(Vector3d).name();
+                column.index = suffix - 'x';
+            }
+        }
+    }
+}
+
+std::vector<size_t> RecordedLog::findState(gnc::states::VehicleId vehicle, const std::string& component,
+                                           const std::string& state) const {
+    std::vector<size_t> found;
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        const auto& column = columns_[i];
+        if (column.component != component || column.state != state || (column.vehicle && *column.vehicle != vehicle)) {
+            continue;
+        }
+        // Without vehicle information equally named columns may come from several vehicles;
+        // keep the first column for each element
+        if (std::none_of(found.begin(), found.end(), [&](size_t f) { return columns_[f].index == column.index; })) {
+            found.push_back(i);
+        }
+    }
+    std::sort(found.begin(), found.end(), [this](size_t a, size_t b) { return columns_[a].index < columns_[b].index; });
+    return found;
+}
+
+std::vector<std::string> RecordedLog::statesOf(gnc::states::VehicleId vehicle, const std::string& component) const {
+    std::vector<std::string> states;
+    for (const auto& column : columns_) {
+        if (column.component == component && !column.state.empty() && (!column.vehicle || *column.vehicle == vehicle) &&
+            std::find(states.begin(), states.end(), column.state) == states.end()) {
+            states.push_back(column.state);
+        }
+    }
+    return states;
+}
+
+LogView LogView::open(const std::string& path) {
+    LogView view;
+    const std::vector<LogColumn>* columns = nullptr;
+    if (std::filesystem::path(path).extension().string() == BinaryWriter::EXTENSION) {
+        view.mapped = std::make_unique<MappedBinaryLog>(path);
+        view.rows = view.mapped->rows();
+        view.stride = view.mapped->width();
+        view.times = view.mapped->row(0);
+        view.row_major = true;
+        columns = &view.mapped->columns();
+        for (size_t j = 0; j < columns->size(); ++j) {
+            view.columns.push_back(view.times + 1 + j);
+        }
+    } else {
+        view.loaded = std::make_unique<RecordedLog>(RecordedLog::load(path));
+        view.rows = view.loaded->rows();
+        view.times = view.loaded->times().data();
+        columns = &view.loaded->columns();
+        for (size_t j = 0; j < columns->size(); ++j) {
+            view.columns.push_back(view.loaded->column(j).data());
+        }
+    }
+
+    view.vehicles = std::all_of(columns->begin(), columns->end(),
+                                [](const LogColumn& column) { return column.vehicle.has_value(); });
+    for (const auto& column : *columns) {
+        std::string name = column.name.empty() ? column.component + "." + column.state : column.name;
+        view.names.push_back(view.vehicles ? std::to_string(*column.vehicle) + "." + name : name);
+    }
+    return view;
+}
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
@@ -177,6 +177,9 @@ std::shared_ptr<spdlog::logger> SimpleLogger::getComponentLogger(const std::stri
         initialize("gnc_default");
     }
     
+    // 组件可能在并行初始化线程上首次获取日志器
+    std::lock_guard<std::mutex> lock(component_loggers_mutex_);
+
     // 检查是否已存在该组件的日志器
     auto it = component_loggers_.find(component_name);
     if (it != component_loggers_.end()) {
@@ -235,6 +238,7 @@ void SimpleLogger::setLogLevel(LogLevel level) {
     }
     
     // 设置所有组件日志器级别
+    std::lock_guard<std::mutex> lock(component_loggers_mutex_);
     for (auto& [name, logger] : component_loggers_) {
         if (logger) {
             logger->set_level(spdlog_level);
@@ -251,6 +255,7 @@ void SimpleLogger::flush() {
         main_logger_->flush();
     }
     
+    std::lock_guard<std::mutex> lock(component_loggers_mutex_);
     for (auto& [name, logger] : component_loggers_) {
         if (logger) {
             logger->flush();
@@ -258,6 +263,11 @@ void SimpleLogger::flush() {
     }
 }
 
+size_t SimpleLogger::queueDepth() const {
+    auto pool = spdlog::thread_pool();
+    return pool ? pool->queue_size() : 0;
+}
+
 void SimpleLogger::shutdown() {
     if (!initialized_) {
         return;
@@ -271,7 +281,10 @@ void SimpleLogger::shutdown() {
     flush();
     
     // 清理组件日志器
-    component_loggers_.clear();
+    {
+        std::lock_guard<std::mutex> lock(component_loggers_mutex_);
+        component_loggers_.clear();
+    }
     
     // 清理主日志器
     main_logger_.reset();
@@ -0,0 +1,216 @@
+/**
+ * @file summary_writer.cpp
+ * @brief Streaming reduction writer implementation
+ */
+
+#include "gnc/components/utility/summary_writer.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+
+namespace gnc {
+namespace components {
+namespace utility {
+
+namespace {
+
+/**
+ * @brief Append a timestamp to the file name, like the other writers
+ */
+std::string timestampedPath(const std::string& base_path) {
+    const std::filesystem::path path(base_path);
+    const auto now = std::chrono::system_clock::now();
+    const auto time_t = std::chrono::system_clock::to_time_t(now);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+
+    std::stringstream name;
+    name << path.stem().string() << "_" << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S") << "_"
+         << std::setfill('0') << std::setw(3) << ms.count() << path.extension().string();
+    return (path.parent_path() / name.str()).string();
+}
+
+double toDouble(const std::any& value) {
+    if (value.type() == typeid(double)) {
+        return std::any_cast<double>(value);
+    } else if (value.type() == typeid(float)) {
+        return std::any_cast<float>(value);
+    } else if (value.type() == typeid(int)) {
+        return std::any_cast<int>(value);
+    } else if (value.type() == typeid(bool)) {
+        return std::any_cast<bool>(value) ? 1.0 : 0.0;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace
+
+void SummaryWriter::Reduction::add(double time, double value) {
+    if (std::isnan(value)) {
+        above = false;
+        return;
+    }
+    if (value < min) {
+        min = value;
+        time_of_min = time;
+    }
+    if (value > max) {
+        max = value;
+        time_of_max = time;
+    }
+    if (above) {
+        time_above += time - last_time;
+    }
+    above = value > threshold;
+    last_time = time;
+    final = value;
+    sum += value;
+    sum_sq += value * value;
+    ++samples;
+}
+
+nlohmann::json SummaryWriter::Reduction::toJson() const {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double n = static_cast<double>(samples);
+    nlohmann::json json = {
+        {"samples", samples},
+        {"min", samples > 0 ? min : nan},
+        {"time_of_min", time_of_min},
+        {"max", samples > 0 ? max : nan},
+        {"time_of_max", time_of_max},
+        {"final", final},
+        {"mean", samples > 0 ? sum / n : nan},
+        {"rms", samples > 0 ? std::sqrt(sum_sq / n) : nan},
+    };
+    if (!std::isnan(threshold)) {
+        json["threshold"] = threshold;
+        json["time_above"] = time_above;
+    }
+    return json;
+}
+
+void SummaryWriter::configure(const nlohmann::json& options) {
+    thresholds_.clear();
+    if (!options.is_object() || !options.contains("thresholds")) {
+        return;
+    }
+    for (const auto& entry : options.at("thresholds")) {
+        SummaryThreshold threshold{entry.at("pattern").get<std::string>(), entry.at("above").get<double>()};
+        try {
+            std::regex check(threshold.pattern);
+        } catch (const std::regex_error& e) {
+            throw std::runtime_error("Invalid summary threshold pattern '" + threshold.pattern + "': " + e.what());
+        }
+        thresholds_.push_back(std::move(threshold));
+    }
+}
+
+void SummaryWriter::initialize(const std::string& file_path,
+                               const std::vector<gnc::states::StateId>& states,
+                               bool include_metadata,
+                               const nlohmann::json& metadata_json) {
+    if (initialized_) {
+        throw std::runtime_error("SummaryWriter already initialized");
+    }
+
+    std::vector<std::regex> patterns;
+    patterns.reserve(thresholds_.size());
+    for (const auto& threshold : thresholds_) {
+        patterns.emplace_back(threshold.pattern);
+    }
+
+    keys_.clear();
+    reductions_.assign(states.size(), Reduction{});
+    for (size_t i = 0; i < states.size(); ++i) {
+        keys_.push_back(std::to_string(states[i].component.vehicleId) + "." + states[i].name);
+        for (size_t t = 0; t < patterns.size(); ++t) {
+            if (std::regex_search(keys_.back(), patterns[t])) {
+                reductions_[i].threshold = thresholds_[t].above;
+                break;
+            }
+        }
+    }
+    metadata_ = include_metadata ? metadata_json : nlohmann::json();
+
+    // Open the temporary file up front so that a bad path fails at startup rather than after the run
+    file_path_ = timestampedPath(file_path);
+    const std::filesystem::path path(file_path_);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+    std::ofstream probe(file_path_ + ".tmp", std::ios::out | std::ios::trunc);
+    if (!probe.is_open()) {
+        throw std::runtime_error("Failed to open summary file: " + file_path_);
+    }
+
+    rows_ = 0;
+    start_time_ = std::numeric_limits<double>::quiet_NaN();
+    end_time_ = std::numeric_limits<double>::quiet_NaN();
+    initialized_ = true;
+    LOG_INFO("Created summary file: {} ({} columns)", file_path_, states.size());
+}
+
+void SummaryWriter::writeDataPoint(double time, const std::vector<std::any>& values) {
+    if (!initialized_) {
+        throw std::runtime_error("SummaryWriter not initialized");
+    }
+    if (values.size() != reductions_.size()) {
+        throw std::runtime_error("Values count (" + std::to_string(values.size()) +
+                                 ") does not match states count (" + std::to_string(reductions_.size()) + ")");
+    }
+
+    if (rows_ == 0) {
+        start_time_ = time;
+    }
+    end_time_ = time;
+    ++rows_;
+    for (size_t i = 0; i < values.size(); ++i) {
+        reductions_[i].add(time, toDouble(values[i]));
+    }
+}
+
+nlohmann::json SummaryWriter::summary() const {
+    nlohmann::json states = nlohmann::json::object();
+    for (size_t i = 0; i < keys_.size(); ++i) {
+        states[keys_[i]] = reductions_[i].toJson();
+    }
+    nlohmann::json record = {
+        {"kind", "run_summary"},
+        {"version", 1},
+        {"rows", rows_},
+        {"start_time", start_time_},
+        {"end_time", end_time_},
+        {"states", std::move(states)},
+    };
+    if (!metadata_.is_null()) {
+        record["metadata"] = metadata_;
+    }
+    return record;
+}
+
+void SummaryWriter::finalize() {
+    if (!initialized_) {
+        return;
+    }
+    // Written next to the target and renamed, so a campaign collector never reads a partial record
+    const std::string temporary = file_path_ + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::out | std::ios::trunc);
+        file << summary().dump(2) << '\n';
+        if (!file) {
+            throw std::runtime_error("Failed to write summary file: " + temporary);
+        }
+    }
+    std::filesystem::rename(temporary, file_path_);
+    initialized_ = false;
+    LOG_DEBUG("SummaryWriter finalized after {} rows", rows_);
+}
+
+} // namespace utility
+} // namespace components
+} // namespace gnc
@@ -0,0 +1,146 @@
+#include "gnc/core/allocation_tracker.hpp"
+#include <cstdlib>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#define GNC_HAS_BACKTRACE 1
+#endif
+
+#ifdef GNC_TRACK_ALLOCATIONS
+
+#include <atomic>
+#include <new>
+
+namespace {
+
+thread_local uint64_t t_allocation_count = 0;
+thread_local uint64_t t_allocated_bytes = 0;
+thread_local gnc::AllocationCounters* t_current = nullptr;
+thread_local bool t_sampling = false;  // 防止采样过程中的分配重入
+std::atomic<bool> g_stack_sampling{false};
+
+void attribute(std::size_t size) {
+    ++t_allocation_count;
+    t_allocated_bytes += size;
+    gnc::AllocationCounters* counters = t_current;
+    if (!counters) {
+        return;
+    }
+    ++counters->count;
+    counters->bytes += size;
+#ifdef GNC_HAS_BACKTRACE
+    if (counters->sample_depth == 0 && !t_sampling && g_stack_sampling.load(std::memory_order_relaxed)) {
+        t_sampling = true;
+        counters->sample_depth = backtrace(counters->sample_stack, gnc::AllocationCounters::MAX_STACK_DEPTH);
+        counters->sample_size = size;
+        t_sampling = false;
+    }
+#endif
+}
+
+void* trackedAllocate(std::size_t size) {
+    attribute(size);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* trackedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+    attribute(size);
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+    void* p = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // aligned_alloc 要求大小为对齐值的整数倍
+    void* p = std::aligned_alloc(align, ((size == 0 ? 1 : size) + align - 1) / align * align);
+#endif
+    if (p) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void trackedFreeAligned(void* p) noexcept {
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return trackedAllocate(size); }
+void* operator new[](std::size_t size) { return trackedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return trackedAllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return trackedAllocateAligned(size, alignment); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { trackedFreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { trackedFreeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { trackedFreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { trackedFreeAligned(p); }
+
+namespace gnc {
+
+uint64_t AllocationTracker::allocationCount() { return t_allocation_count; }
+uint64_t AllocationTracker::allocatedBytes() { return t_allocated_bytes; }
+
+void AllocationTracker::setStackSampling(bool enable) {
+#ifdef GNC_HAS_BACKTRACE
+    if (enable) {
+        // 首次调用 backtrace 会加载展开库并分配内存，提前在归属作用域之外完成
+        void* warmup[1];
+        backtrace(warmup, 1);
+    }
+#endif
+    g_stack_sampling.store(enable, std::memory_order_relaxed);
+}
+
+AllocationCounters* AllocationTracker::exchangeCurrent(AllocationCounters* counters) {
+    AllocationCounters* previous = t_current;
+    t_current = counters;
+    return previous;
+}
+
+} // namespace gnc
+
+#else
+
+namespace gnc {
+
+uint64_t AllocationTracker::allocationCount() { return 0; }
+uint64_t AllocationTracker::allocatedBytes() { return 0; }
+void AllocationTracker::setStackSampling(bool) {}
+AllocationCounters* AllocationTracker::exchangeCurrent(AllocationCounters*) { return nullptr; }
+
+} // namespace gnc
+
+#endif
+
+namespace gnc {
+
+std::vector<std::string> AllocationTracker::symbolize(const AllocationCounters& counters) {
+    std::vector<std::string> frames;
+#ifdef GNC_HAS_BACKTRACE
+    if (counters.sample_depth <= 0) {
+        return frames;
+    }
+    char** symbols = backtrace_symbols(counters.sample_stack, counters.sample_depth);
+    if (!symbols) {
+        return frames;
+    }
+    // 跳过分配器自身的帧（attribute、trackedAllocate、operator new）
+    for (int i = 3; i < counters.sample_depth; ++i) {
+        frames.emplace_back(symbols[i]);
+    }
+    std::free(symbols);
+#endif
+    return frames;
+}
+
+} // namespace gnc
@@ -0,0 +1,93 @@
+#include "gnc/core/external_inputs.hpp"
+#include <algorithm>
+
+namespace gnc {
+namespace core {
+
+using components::utility::ConfigFileType;
+using components::utility::ConfigManager;
+
+/**
+ * @brief 各通道的处理函数；订阅只持有弱引用，队列销毁后订阅自动失效
+ */
+struct EventSubscription::HandlerTable {
+    std::mutex mutex;
+    uint64_t next_id = 1;
+    std::map<std::string, std::vector<std::pair<uint64_t, ExternalInputs::EventHandler>>> channels;
+};
+
+void EventSubscription::release() {
+    if (auto table = table_.lock()) {
+        std::lock_guard<std::mutex> lock(table->mutex);
+        auto it = table->channels.find(channel_);
+        if (it != table->channels.end()) {
+            auto& handlers = it->second;
+            handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+                                          [this](const auto& entry) { return entry.first == id_; }),
+                           handlers.end());
+        }
+    }
+    table_.reset();
+}
+
+ExternalInputs::ExternalInputs() : handlers_(std::make_shared<EventSubscription::HandlerTable>()) {}
+
+void ExternalInputs::postConfigChange(ConfigFileType type, const std::string& json_path, const nlohmann::json& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back({Input::Kind::ConfigChange,
+                        {{"file", ConfigManager::configTypeToString(type)}, {"path", json_path}, {"value", value}}});
+    has_pending_.store(true, std::memory_order_release);
+}
+
+void ExternalInputs::postEvent(const std::string& channel, const nlohmann::json& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back({Input::Kind::Event, {{"channel", channel}, {"data", data}}});
+    has_pending_.store(true, std::memory_order_release);
+}
+
+EventSubscription ExternalInputs::subscribe(const std::string& channel, EventHandler handler) {
+    std::lock_guard<std::mutex> lock(handlers_->mutex);
+    const uint64_t id = handlers_->next_id++;
+    handlers_->channels[channel].emplace_back(id, std::move(handler));
+    return EventSubscription(handlers_, channel, id);
+}
+
+std::vector<ExternalInputs::Input> ExternalInputs::drain() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Input> inputs;
+    inputs.swap(pending_);
+    has_pending_.store(false, std::memory_order_release);
+    return inputs;
+}
+
+void ExternalInputs::apply(const Input& input) {
+    if (input.kind == Input::Kind::ConfigChange) {
+        ConfigManager::getInstance().setConfigValue(
+            ConfigManager::stringToConfigType(input.payload.at("file").get<std::string>()),
+            input.payload.at("path").get<std::string>(), input.payload.at("value"));
+        return;
+    }
+    // 复制后在锁外调用，处理函数中可以订阅或解除订阅
+    std::vector<EventHandler> handlers;
+    {
+        std::lock_guard<std::mutex> lock(handlers_->mutex);
+        auto it = handlers_->channels.find(input.payload.at("channel").get<std::string>());
+        if (it != handlers_->channels.end()) {
+            for (const auto& entry : it->second) {
+                handlers.push_back(entry.second);
+            }
+        }
+    }
+    for (const auto& handler : handlers) {
+        handler(input.payload.at("data"));
+    }
+}
+
+void ExternalInputs::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
+    has_pending_.store(false, std::memory_order_release);
+}
+
+} // namespace core
+} // namespace gnc
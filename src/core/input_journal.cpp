@@ -0,0 +1,347 @@
+#include "gnc/core/input_journal.hpp"
+#include "gnc/core/random_streams.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace gnc {
+namespace core {
+
+using components::utility::ConfigFileType;
+using components::utility::ConfigManager;
+
+namespace {
+
+constexpr ConfigFileType CONFIG_TYPES[] = {
+    ConfigFileType::CORE, ConfigFileType::DYNAMICS, ConfigFileType::ENVIRONMENT, ConfigFileType::EFFECTORS,
+    ConfigFileType::LOGIC, ConfigFileType::SENSORS, ConfigFileType::UTILITY,
+};
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+std::string toBytes(const T& value) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T fromBytes(const std::string& payload, size_t offset = 0) {
+    T value{};
+    if (payload.size() >= offset + sizeof(T)) {
+        std::memcpy(&value, payload.data() + offset, sizeof(T));
+    }
+    return value;
+}
+
+nlohmann::json componentList(const std::vector<states::ComponentId>& ids) {
+    nlohmann::json list = nlohmann::json::array();
+    for (const auto& id : ids) {
+        list.push_back({id.vehicleId, id.name});
+    }
+    return list;
+}
+
+std::vector<states::ComponentId> parseComponentList(const nlohmann::json& list) {
+    std::vector<states::ComponentId> ids;
+    for (const auto& entry : list) {
+        ids.push_back({entry.at(0).get<states::VehicleId>(), entry.at(1).get<std::string>()});
+    }
+    return ids;
+}
+
+} // namespace
+
+// ==================== InputJournal ====================
+
+JournalConfig JournalConfig::fromJson(const nlohmann::json& config) {
+    JournalConfig result;
+    const std::string mode = config.value("mode", std::string("off"));
+    if (mode == "record") {
+        result.mode = JournalMode::Record;
+    } else if (mode == "replay") {
+        result.mode = JournalMode::Replay;
+    } else if (mode != "off") {
+        throw ConfigurationError("InputJournal", "Unknown journal mode '" + mode + "' (expected off, record or replay)");
+    }
+    result.file = config.value("file", result.file);
+    result.hash_states = config.value("hash_states", result.hash_states);
+    return result;
+}
+
+nlohmann::json JournalReplayReport::toJson() const {
+    nlohmann::json json = {
+        {"frames", frames},
+        {"recorded_frames", recorded_frames},
+        {"compared_frames", compared_frames},
+        {"hash_mismatches", hash_mismatches},
+        {"rng_mismatches", rng_mismatches},
+        {"ignored_live_inputs", ignored_live_inputs},
+        {"passed", passed()},
+    };
+    if (diverged()) {
+        json["first_divergent_frame"] = first_divergent_frame;
+        json["first_divergent_time_s"] = first_divergent_time_s;
+    }
+    return json;
+}
+
+InputJournal::InputJournal(JournalConfig config, StateManager& state_manager, uint64_t master_seed)
+    : config_(std::move(config)), state_manager_(state_manager), master_seed_(master_seed) {
+    if (config_.mode == JournalMode::Record) {
+        const auto directory = std::filesystem::path(config_.file).parent_path();
+        if (!directory.empty()) {
+            std::filesystem::create_directories(directory);
+        }
+        out_.open(config_.file, std::ios::binary | std::ios::trunc);
+        if (!out_) {
+            throw std::runtime_error("Cannot open journal file for writing: " + config_.file);
+        }
+        const std::string header = nlohmann::json{
+            {"version", VERSION},
+            {"master_seed", master_seed_},
+            {"hash_states", config_.hash_states},
+            {"configs", configHashes()},
+        }.dump();
+        const uint64_t header_size = header.size();
+        out_.write(MAGIC, sizeof(MAGIC));
+        out_.write(reinterpret_cast<const char*>(&header_size), sizeof(header_size));
+        out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+        LOG_INFO("[Journal] Recording inputs to {} (seed {})", config_.file.c_str(), master_seed_);
+    } else if (config_.mode == JournalMode::Replay) {
+        nlohmann::json header;
+        records_ = read(config_.file, &header);
+        master_seed_ = header.at("master_seed").get<uint64_t>();
+        const auto current = configHashes();
+        const auto recorded = header.value("configs", nlohmann::json::object());
+        for (const auto& item : recorded.items()) {
+            if (current.value(item.key(), uint64_t{0}) != item.value().get<uint64_t>()) {
+                LOG_WARN("[Journal] {} configuration differs from the recorded run", item.key().c_str());
+            }
+        }
+        report_.recorded_frames = records_.empty() ? 0 : records_.back().frame + 1;
+        if (!records_.empty() && records_.back().type == JournalRecordType::End) {
+            report_.recorded_frames = fromBytes<uint64_t>(records_.back().payload);
+        }
+        state_manager_.replayBudgetDecisions(&replay_budget_);
+        LOG_INFO("[Journal] Replaying {} ({} frames, seed {})", config_.file.c_str(), report_.recorded_frames,
+                 master_seed_);
+    }
+}
+
+InputJournal::~InputJournal() {
+    finish();
+}
+
+void InputJournal::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    if (config_.mode == JournalMode::Record) {
+        write(JournalRecordType::End, toBytes(frame_));
+        out_.close();
+        LOG_INFO("[Journal] Recorded {} frames to {}", frame_, config_.file.c_str());
+    } else if (config_.mode == JournalMode::Replay) {
+        state_manager_.replayBudgetDecisions(nullptr);
+        if (report_.ignored_live_inputs > 0) {
+            LOG_WARN("[Journal] Ignored {} live inputs during replay", report_.ignored_live_inputs);
+        }
+        if (report_.diverged()) {
+            LOG_ERROR("[Journal] Replay diverged: {} state hash and {} RNG mismatches, first at frame {} (t = {} s)",
+                      report_.hash_mismatches, report_.rng_mismatches, report_.first_divergent_frame,
+                      report_.first_divergent_time_s);
+        } else if (report_.frames != report_.recorded_frames) {
+            LOG_WARN("[Journal] Replayed {} of {} recorded frames without divergence", report_.frames,
+                     report_.recorded_frames);
+        } else {
+            LOG_INFO("[Journal] Replay matched the recording: {} frames, {} state hashes compared", report_.frames,
+                     report_.compared_frames);
+        }
+    }
+}
+
+void InputJournal::applyLiveInputs() {
+    auto& inputs = *state_manager_.externalInputs();
+    for (const auto& input : inputs.drain()) {
+        inputs.apply(input);
+    }
+}
+
+void InputJournal::recordInputs() {
+    const int floor = state_manager_.getPriorityFloor();
+    if (floor != recorded_floor_) {
+        write(JournalRecordType::PriorityFloor, toBytes(static_cast<int32_t>(floor)));
+        recorded_floor_ = floor;
+    }
+    auto& inputs = *state_manager_.externalInputs();
+    if (!inputs.hasPending()) {
+        return;
+    }
+    for (const auto& input : inputs.drain()) {
+        write(input.kind == ExternalInputs::Input::Kind::ConfigChange ? JournalRecordType::ConfigChange
+                                                                        : JournalRecordType::Event,
+              input.payload.dump());
+        inputs.apply(input);
+    }
+}
+
+void InputJournal::recordFrame() {
+    const auto& budget = state_manager_.getLastBudgetDecisions();
+    if (!budget.empty()) {
+        write(JournalRecordType::Budget,
+              nlohmann::json{{"deferred", componentList(budget.deferred)}, {"shed", componentList(budget.shed)}}.dump());
+    }
+    auto positions = state_manager_.randomStreams()->positions();
+    if (positions != recorded_positions_) {
+        write(JournalRecordType::RngPositions, nlohmann::json(positions).dump());
+        recorded_positions_ = std::move(positions);
+    }
+    if (config_.hash_states) {
+        write(JournalRecordType::FrameHash, toBytes(state_manager_.computeStateHash()) + toBytes(simTime()));
+    }
+    ++frame_;
+}
+
+void InputJournal::replayInputs() {
+    auto& inputs = *state_manager_.externalInputs();
+    if (inputs.hasPending()) {
+        const size_t ignored = inputs.drain().size();
+        if (report_.ignored_live_inputs == 0) {
+            LOG_WARN("[Journal] Ignoring live inputs during replay; only journaled inputs are applied");
+        }
+        report_.ignored_live_inputs += ignored;
+    }
+
+    replay_budget_.deferred.clear();
+    replay_budget_.shed.clear();
+    while (cursor_ < records_.size() && records_[cursor_].frame < frame_) {
+        ++cursor_;
+    }
+    for (size_t i = cursor_; i < records_.size() && records_[i].frame == frame_; ++i) {
+        const auto& record = records_[i];
+        switch (record.type) {
+            case JournalRecordType::PriorityFloor:
+                state_manager_.setPriorityFloor(fromBytes<int32_t>(record.payload));
+                break;
+            case JournalRecordType::ConfigChange:
+                inputs.apply({ExternalInputs::Input::Kind::ConfigChange, nlohmann::json::parse(record.payload)});
+                break;
+            case JournalRecordType::Event:
+                inputs.apply({ExternalInputs::Input::Kind::Event, nlohmann::json::parse(record.payload)});
+                break;
+            case JournalRecordType::Budget: {
+                const auto budget = nlohmann::json::parse(record.payload);
+                replay_budget_.deferred = parseComponentList(budget.at("deferred"));
+                replay_budget_.shed = parseComponentList(budget.at("shed"));
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void InputJournal::checkFrame() {
+    for (; cursor_ < records_.size() && records_[cursor_].frame == frame_; ++cursor_) {
+        const auto& record = records_[cursor_];
+        if (record.type == JournalRecordType::RngPositions) {
+            expected_positions_ = nlohmann::json::parse(record.payload).get<std::map<std::string, uint64_t>>();
+        } else if (record.type == JournalRecordType::FrameHash && config_.hash_states) {
+            ++report_.compared_frames;
+            if (fromBytes<uint64_t>(record.payload) != state_manager_.computeStateHash()) {
+                ++report_.hash_mismatches;
+                markDivergence("state hash");
+            }
+        }
+    }
+    if (state_manager_.randomStreams()->positions() != expected_positions_) {
+        ++report_.rng_mismatches;
+        markDivergence("RNG positions");
+        expected_positions_ = state_manager_.randomStreams()->positions();
+    }
+    ++frame_;
+    ++report_.frames;
+}
+
+void InputJournal::markDivergence(const char* what) {
+    if (report_.diverged()) {
+        return;
+    }
+    report_.first_divergent_frame = frame_;
+    report_.first_divergent_time_s = simTime();
+    LOG_ERROR("[Journal] Replay diverged at frame {} (t = {} s): {} mismatch", frame_,
+              report_.first_divergent_time_s, what);
+}
+
+void InputJournal::write(JournalRecordType type, const std::string& payload) {
+    const auto type_byte = static_cast<uint8_t>(type);
+    const auto size = static_cast<uint32_t>(payload.size());
+    out_.write(reinterpret_cast<const char*>(&type_byte), sizeof(type_byte));
+    out_.write(reinterpret_cast<const char*>(&frame_), sizeof(frame_));
+    out_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out_.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+}
+
+std::vector<JournalRecord> InputJournal::read(const std::string& path, nlohmann::json* header) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open journal file: " + path);
+    }
+    char magic[sizeof(MAGIC)];
+    uint64_t header_size = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&header_size), sizeof(header_size));
+    if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a GNC input journal: " + path);
+    }
+    std::string header_text(header_size, '\0');
+    in.read(header_text.data(), static_cast<std::streamsize>(header_size));
+    if (header) {
+        *header = nlohmann::json::parse(header_text);
+    }
+
+    std::vector<JournalRecord> records;
+    while (true) {
+        uint8_t type = 0;
+        uint64_t frame = 0;
+        uint32_t size = 0;
+        in.read(reinterpret_cast<char*>(&type), sizeof(type));
+        in.read(reinterpret_cast<char*>(&frame), sizeof(frame));
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!in) {
+            break;
+        }
+        JournalRecord record{static_cast<JournalRecordType>(type), frame, std::string(size, '\0')};
+        in.read(record.payload.data(), size);
+        if (!in) {
+            LOG_WARN("[Journal] Truncated record at the end of {}", path.c_str());
+            break;
+        }
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+nlohmann::json InputJournal::configHashes() {
+    auto& config_manager = ConfigManager::getInstance();
+    nlohmann::json hashes = nlohmann::json::object();
+    for (const auto type : CONFIG_TYPES) {
+        auto config = config_manager.getConfig(type);
+        if (type == ConfigFileType::CORE && config.contains("core") && config["core"].is_object()) {
+            // 记录与回放的 journal 配置本来就不同
+            config["core"].erase("journal");
+        }
+        hashes[ConfigManager::configTypeToString(type)] = fnv1a(config.dump());
+    }
+    return hashes;
+}
+
+} // namespace core
+} // namespace gnc
@@ -0,0 +1,339 @@
+#include "gnc/core/metrics.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace gnc {
+
+namespace {
+
+constexpr double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+        }
+        escaped += c == '\n' ? 'n' : c;
+    }
+    return escaped;
+}
+
+std::string formatLabels(const MetricsRegistry::Labels& labels) {
+    if (labels.empty()) {
+        return "";
+    }
+    std::string result = "{";
+    for (const auto& [key, value] : labels) {
+        result += (result.size() > 1 ? "," : "") + key + "=\"" + escapeLabel(value) + "\"";
+    }
+    return result + "}";
+}
+
+/**
+ * @brief 在已格式化的标签后追加一个标签
+ */
+std::string appendLabel(const std::string& labels, const std::string& extra) {
+    if (labels.empty()) {
+        return "{" + extra + "}";
+    }
+    return labels.substr(0, labels.size() - 1) + "," + extra + "}";
+}
+
+nlohmann::json summarize(const HdrHistogram& histogram) {
+    return {
+        {"count", histogram.count()},
+        {"mean", histogram.mean()},
+        {"p50", histogram.valueAtPercentile(50.0)},
+        {"p90", histogram.valueAtPercentile(90.0)},
+        {"p99", histogram.valueAtPercentile(99.0)},
+        {"p999", histogram.valueAtPercentile(99.9)},
+        {"max", histogram.max()},
+    };
+}
+
+} // namespace
+
+MetricsConfig MetricsConfig::fromJson(const nlohmann::json& config) {
+    MetricsConfig result;
+    result.enabled = config.value("enabled", result.enabled);
+    result.format = config.value("format", result.format);
+    result.file = config.value("file", result.file);
+    result.interval_s = std::max(config.value("interval_s", result.interval_s), 0.1);
+    result.per_component = config.value("per_component", result.per_component);
+    result.per_instance = config.value("per_instance", result.per_instance);
+    if (result.format != "prometheus" && result.format != "jsonl") {
+        LOG_WARN("[Metrics] Unknown format '{}', using prometheus", result.format.c_str());
+        result.format = "prometheus";
+    }
+    return result;
+}
+
+void MetricsHistogram::rotate() {
+    // WriterReaderPhaser：切换相位后等待旧相位中已开始的记录全部结束
+    const bool next_even = start_epoch_.load() < 0;
+    const int64_t initial = next_even ? 0 : std::numeric_limits<int64_t>::min();
+    (next_even ? even_end_epoch_ : odd_end_epoch_).store(initial);
+    const int64_t start_at_flip = start_epoch_.exchange(initial);
+    const std::atomic<int64_t>& previous_end = next_even ? odd_end_epoch_ : even_end_epoch_;
+    while (previous_end.load(std::memory_order_acquire) != start_at_flip) {
+        std::this_thread::yield();
+    }
+
+    HdrHistogram& inactive = buffers_[next_even ? 1 : 0];
+    interval_.reset();
+    interval_.add(inactive);
+    cumulative_.add(inactive);
+    inactive.reset();
+}
+
+MetricsRegistry& MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::~MetricsRegistry() {
+    if (running()) {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex_);
+            stop_requested_ = true;
+        }
+        stop_cv_.notify_all();
+        flusher_.join();
+    }
+}
+
+MetricsRegistry::Metric& MetricsRegistry::findOrAdd(Kind kind, const std::string& name, const std::string& help,
+                                                    const Labels& labels) {
+    const std::string formatted = formatLabels(labels);
+    const auto [it, inserted] = index_.try_emplace(name + formatted, nullptr);
+    if (!inserted) {
+        if (it->second->kind != kind) {
+            throw std::invalid_argument("Metric '" + name + formatted + "' is already registered with another type");
+        }
+        return *it->second;
+    }
+    auto metric = std::make_unique<Metric>();
+    metric->kind = kind;
+    metric->name = name;
+    metric->help = help;
+    metric->labels = formatted;
+    it->second = metric.get();
+    metrics_.push_back(std::move(metric));
+    return *metrics_.back();
+}
+
+MetricsCounter& MetricsRegistry::counter(const std::string& name, const std::string& help, const Labels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Metric& metric = findOrAdd(Kind::Counter, name, help, labels);
+    if (!metric.counter) {
+        metric.counter = std::make_unique<MetricsCounter>();
+    }
+    return *metric.counter;
+}
+
+MetricsGauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const Labels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Metric& metric = findOrAdd(Kind::Gauge, name, help, labels);
+    if (!metric.gauge) {
+        metric.gauge = std::make_unique<MetricsGauge>();
+    }
+    return *metric.gauge;
+}
+
+MetricsHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const Labels& labels,
+                                             uint64_t highest_trackable_value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Metric& metric = findOrAdd(Kind::Histogram, name, help, labels);
+    if (!metric.histogram) {
+        metric.histogram = std::make_unique<MetricsHistogram>(highest_trackable_value);
+    }
+    return *metric.histogram;
+}
+
+void MetricsRegistry::sampledGauge(const std::string& name, const std::string& help, std::function<double()> sample) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    findOrAdd(Kind::Sampled, name, help, {}).sample = std::move(sample);
+}
+
+void MetricsRegistry::start(const MetricsConfig& config) {
+    if (running()) {
+        LOG_WARN("[Metrics] Exporter is already running");
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        last_export_ = Clock::now();
+    }
+    const std::filesystem::path path(config.file);
+    if (path.has_parent_path()) {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+    if (config.format == "jsonl") {
+        std::ofstream truncate(config.file, std::ios::trunc);
+    }
+    stop_requested_ = false;
+    flusher_ = std::thread([this]() { run(); });
+    enabled_.store(true, std::memory_order_relaxed);
+    LOG_INFO("[Metrics] Exporting {} metrics to {} every {} s", config.format.c_str(), config.file.c_str(),
+             config.interval_s);
+}
+
+void MetricsRegistry::stop() {
+    if (!running()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stop_requested_ = true;
+    }
+    enabled_.store(false, std::memory_order_relaxed);
+    stop_cv_.notify_all();
+    flusher_.join();
+    flush();
+}
+
+void MetricsRegistry::run() {
+    const auto interval = std::chrono::duration<double>(config_.interval_s);
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (!stop_cv_.wait_for(lock, interval, [this]() { return stop_requested_; })) {
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void MetricsRegistry::flush() {
+    std::ostringstream content;
+    if (config_.format == "jsonl") {
+        writeJsonLine(content);
+        std::ofstream file(config_.file, std::ios::app);
+        file << content.str();
+        if (!file) {
+            LOG_WARN("[Metrics] Cannot append to {}", config_.file.c_str());
+        }
+        return;
+    }
+    writePrometheus(content);
+    // 先写临时文件再改名，采集方不会读到写了一半的文件
+    const std::string temporary = config_.file + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file << content.str();
+        if (!file) {
+            LOG_WARN("[Metrics] Cannot write {}", temporary.c_str());
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, config_.file, error);
+    if (error) {
+        LOG_WARN("[Metrics] Cannot replace {}: {}", config_.file.c_str(), error.message().c_str());
+    }
+}
+
+void MetricsRegistry::rotateAll(Clock::time_point now) {
+    interval_elapsed_s_ = std::chrono::duration<double>(now - last_export_).count();
+    last_export_ = now;
+    for (auto& metric : metrics_) {
+        if (metric->histogram) {
+            metric->histogram->rotate();
+        }
+    }
+}
+
+void MetricsRegistry::writePrometheus(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rotateAll(Clock::now());
+
+    // 同名指标（不同标签）必须连续输出，且只有一组 HELP/TYPE
+    std::vector<Metric*> sorted;
+    for (auto& metric : metrics_) {
+        sorted.push_back(metric.get());
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Metric* a, const Metric* b) { return a->name < b->name; });
+
+    const std::string* previous = nullptr;
+    for (Metric* metric : sorted) {
+        if (!previous || *previous != metric->name) {
+            static const char* const TYPES[] = {"counter", "gauge", "summary", "gauge"};
+            out << "# HELP " << metric->name << ' ' << metric->help << '\n';
+            out << "# TYPE " << metric->name << ' ' << TYPES[static_cast<int>(metric->kind)] << '\n';
+            previous = &metric->name;
+        }
+        switch (metric->kind) {
+        case Kind::Counter:
+            out << metric->name << metric->labels << ' ' << metric->counter->value() << '\n';
+            break;
+        case Kind::Gauge:
+            out << metric->name << metric->labels << ' ' << metric->gauge->value() << '\n';
+            break;
+        case Kind::Sampled:
+            out << metric->name << metric->labels << ' ' << metric->sample() << '\n';
+            break;
+        case Kind::Histogram: {
+            const HdrHistogram& cumulative = metric->histogram->cumulative();
+            for (double quantile : QUANTILES) {
+                std::ostringstream label;
+                label << "quantile=\"" << quantile << '"';
+                out << metric->name << appendLabel(metric->labels, label.str()) << ' '
+                    << cumulative.valueAtPercentile(quantile * 100.0) << '\n';
+            }
+            out << metric->name << "_sum" << metric->labels << ' '
+                << static_cast<uint64_t>(cumulative.mean() * static_cast<double>(cumulative.count())) << '\n';
+            out << metric->name << "_count" << metric->labels << ' ' << cumulative.count() << '\n';
+            break;
+        }
+        }
+    }
+}
+
+void MetricsRegistry::writeJsonLine(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rotateAll(Clock::now());
+
+    nlohmann::json counters = nlohmann::json::object();
+    nlohmann::json gauges = nlohmann::json::object();
+    nlohmann::json histograms = nlohmann::json::object();
+    for (auto& metric : metrics_) {
+        const std::string key = metric->name + metric->labels;
+        switch (metric->kind) {
+        case Kind::Counter: {
+            const uint64_t value = metric->counter->value();
+            const double rate = interval_elapsed_s_ > 0.0
+                                    ? static_cast<double>(value - metric->last_value) / interval_elapsed_s_
+                                    : 0.0;
+            metric->last_value = value;
+            counters[key] = {{"value", value}, {"rate_per_s", rate}};
+            break;
+        }
+        case Kind::Gauge:
+            gauges[key] = metric->gauge->value();
+            break;
+        case Kind::Sampled:
+            gauges[key] = metric->sample();
+            break;
+        case Kind::Histogram:
+            histograms[key] = {{"interval", summarize(metric->histogram->interval())},
+                               {"total", summarize(metric->histogram->cumulative())}};
+            break;
+        }
+    }
+
+    const auto wall = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    nlohmann::json line = {
+        {"timestamp_s", wall},
+        {"interval_s", interval_elapsed_s_},
+        {"counters", std::move(counters)},
+        {"gauges", std::move(gauges)},
+        {"histograms", std::move(histograms)},
+    };
+    out << line.dump() << '\n';
+}
+
+} // namespace gnc
@@ -0,0 +1,173 @@
+#include "gnc/core/perf_counters.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace gnc {
+
+namespace {
+
+const char* const COUNTER_NAMES[PerfCounterProfiler::COUNTER_COUNT] = {
+    "cycles", "instructions", "L1D read misses", "LLC misses", "branch misses"};
+
+#ifdef __linux__
+struct CounterSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+const CounterSpec COUNTER_SPECS[PerfCounterProfiler::COUNTER_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+// 组读取格式：nr, time_enabled, time_running, values[nr]
+constexpr size_t READ_HEADER = 3;
+
+int openCounter(const CounterSpec& spec, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = group_fd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // pid = 0, cpu = -1：只统计调用线程，不限 CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+} // namespace
+
+PerfCounterProfiler::~PerfCounterProfiler() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        close(fd);
+    }
+#endif
+}
+
+bool PerfCounterProfiler::open() {
+#ifdef __linux__
+    if (available()) {
+        return true;
+    }
+    leader_fd_ = openCounter(COUNTER_SPECS[Cycles], -1);
+    if (leader_fd_ < 0) {
+        LOG_WARN("[PerfCounters] perf_event_open not available ({}); check /proc/sys/kernel/perf_event_paranoid",
+                 std::strerror(errno));
+        return false;
+    }
+    fds_.push_back(leader_fd_);
+    slot_[Cycles] = 0;
+    group_size_ = 1;
+    for (size_t i = Cycles + 1; i < COUNTER_COUNT; ++i) {
+        int fd = openCounter(COUNTER_SPECS[i], leader_fd_);
+        if (fd < 0) {
+            LOG_WARN("[PerfCounters] Counter '{}' unavailable ({})", COUNTER_NAMES[i], std::strerror(errno));
+            continue;
+        }
+        fds_.push_back(fd);
+        slot_[i] = static_cast<int>(group_size_++);
+    }
+    ioctl(leader_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    LOG_INFO("[PerfCounters] Opened {} hardware counters on the simulation thread", group_size_);
+    return true;
+#else
+    LOG_WARN("[PerfCounters] Hardware performance counters are only supported on Linux");
+    return false;
+#endif
+}
+
+PerfCounterProfiler::Sample PerfCounterProfiler::read() const {
+    Sample sample{};
+#ifdef __linux__
+    uint64_t buffer[READ_HEADER + COUNTER_COUNT];
+    if (::read(leader_fd_, buffer, sizeof(buffer)) <= 0) {
+        return sample;
+    }
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        if (slot_[i] >= 0) {
+            sample[i] = buffer[READ_HEADER + slot_[i]];
+        }
+    }
+#endif
+    return sample;
+}
+
+bool PerfCounterProfiler::multiplexed() const {
+#ifdef __linux__
+    uint64_t buffer[READ_HEADER + COUNTER_COUNT];
+    if (available() && ::read(leader_fd_, buffer, sizeof(buffer)) > 0) {
+        return buffer[2] < buffer[1];
+    }
+#endif
+    return false;
+}
+
+void PerfCounterProfiler::writeSummary(std::ostream& out) const {
+    std::vector<std::pair<std::string, const Totals*>> rows;
+    for (const auto& [type, totals] : totals_) {
+        if (totals->updates > 0) {
+            rows.emplace_back(type, totals.get());
+        }
+    }
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.second->values[Cycles] > b.second->values[Cycles];
+    });
+
+    auto perKiloInstr = [this](const Totals& totals, Counter counter) -> std::string {
+        if (!counterAvailable(counter) || !counterAvailable(Instructions) || totals.values[Instructions] == 0) {
+            return "-";
+        }
+        std::ostringstream value;
+        value << std::fixed << std::setprecision(2)
+              << 1000.0 * static_cast<double>(totals.values[counter]) / static_cast<double>(totals.values[Instructions]);
+        return value.str();
+    };
+
+    out << std::left << std::setw(32) << "component type" << std::right
+        << std::setw(10) << "updates" << std::setw(14) << "cycles/upd" << std::setw(8) << "IPC"
+        << std::setw(12) << "L1D/kinst" << std::setw(12) << "LLC/kinst" << std::setw(12) << "br/kinst" << '\n';
+    for (const auto& [type, totals] : rows) {
+        const double cycles = static_cast<double>(totals->values[Cycles]);
+        std::ostringstream ipc;
+        if (counterAvailable(Instructions) && cycles > 0) {
+            ipc << std::fixed << std::setprecision(2) << static_cast<double>(totals->values[Instructions]) / cycles;
+        } else {
+            ipc << "-";
+        }
+        out << std::left << std::setw(32) << type << std::right
+            << std::setw(10) << totals->updates
+            << std::setw(14) << static_cast<uint64_t>(cycles / static_cast<double>(totals->updates))
+            << std::setw(8) << ipc.str()
+            << std::setw(12) << perKiloInstr(*totals, L1DReadMisses)
+            << std::setw(12) << perKiloInstr(*totals, LLCMisses)
+            << std::setw(12) << perKiloInstr(*totals, BranchMisses) << '\n';
+    }
+    if (multiplexed()) {
+        out << "(counters were multiplexed by the kernel; ratios are approximate)\n";
+    }
+}
+
+} // namespace gnc
@@ -0,0 +1,50 @@
+#include "gnc/core/random_streams.hpp"
+
+namespace gnc {
+namespace core {
+
+void RandomStreams::setMasterSeed(uint64_t seed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    master_seed_ = seed;
+    for (auto& [name, stream] : streams_) {
+        stream->reseed(deriveSeed(seed, name));
+    }
+}
+
+uint64_t RandomStreams::masterSeed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return master_seed_;
+}
+
+RandomStream& RandomStreams::stream(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& stream = streams_[name];
+    if (!stream) {
+        stream = std::make_unique<RandomStream>(deriveSeed(master_seed_, name));
+    }
+    return *stream;
+}
+
+std::map<std::string, uint64_t> RandomStreams::positions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, uint64_t> result;
+    for (const auto& [name, stream] : streams_) {
+        result.emplace(name, stream->position());
+    }
+    return result;
+}
+
+uint64_t RandomStreams::deriveSeed(uint64_t master_seed, const std::string& name) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c : name) {
+        hash = (hash ^ c) * 0x100000001B3ULL;
+    }
+    // splitmix64
+    uint64_t z = (master_seed ^ hash) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace core
+} // namespace gnc
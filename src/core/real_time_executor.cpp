@@ -0,0 +1,265 @@
+#include "gnc/core/real_time_executor.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#endif
+
+namespace gnc {
+namespace core {
+
+namespace {
+
+constexpr int64_t NS_PER_S = 1'000'000'000;
+
+#ifdef __linux__
+int64_t monotonicNowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * NS_PER_S + ts.tv_nsec;
+}
+
+void sleepUntilNs(int64_t deadline_ns) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadline_ns / NS_PER_S);
+    ts.tv_nsec = static_cast<long>(deadline_ns % NS_PER_S);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+}
+
+/**
+ * @brief 触碰一段栈空间，使其在 mlockall 后常驻内存
+ */
+[[gnu::noinline]] void prefaultStack(size_t bytes) {
+    constexpr size_t CHUNK = 4096;
+    volatile unsigned char buffer[CHUNK];
+    std::memset(const_cast<unsigned char*>(buffer), 0, CHUNK);
+    if (bytes > CHUNK) {
+        prefaultStack(bytes - CHUNK);
+    }
+}
+
+/**
+ * @brief 预先分配并触碰一块堆内存后释放，配合 mallopt 使其留在进程内供后续分配复用
+ */
+void prefaultHeap(size_t bytes) {
+#ifdef __GLIBC__
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+    std::vector<unsigned char> block(bytes);
+    volatile unsigned char* pages = block.data();
+    for (size_t i = 0; i < bytes; i += 4096) {
+        pages[i] = 1;
+    }
+}
+#else
+int64_t monotonicNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void sleepUntilNs(int64_t deadline_ns) {
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline_ns)));
+}
+#endif
+
+OverrunPolicy parsePolicy(const std::string& name) {
+    if (name == "drop_low_priority") return OverrunPolicy::DropLowPriority;
+    if (name == "abort") return OverrunPolicy::Abort;
+    if (name != "skip_logging") {
+        LOG_WARN("[RealTime] Unknown overrun_policy '{}', using skip_logging", name.c_str());
+    }
+    return OverrunPolicy::SkipLogging;
+}
+
+} // namespace
+
+RealTimeConfig RealTimeConfig::fromJson(const nlohmann::json& config) {
+    RealTimeConfig result;
+    result.enabled = config.value("enabled", result.enabled);
+    result.speed = config.value("speed", result.speed);
+    result.cpu = config.value("cpu", result.cpu);
+    result.fifo_priority = config.value("fifo_priority", result.fifo_priority);
+    result.lock_memory = config.value("lock_memory", result.lock_memory);
+    result.prefault_stack_kb = config.value("prefault_stack_kb", result.prefault_stack_kb);
+    result.prefault_heap_mb = config.value("prefault_heap_mb", result.prefault_heap_mb);
+    result.overrun_policy = parsePolicy(config.value("overrun_policy", std::string("skip_logging")));
+    result.logging_priority = config.value("logging_priority", result.logging_priority);
+    result.priority_floor = config.value("priority_floor", result.priority_floor);
+    result.max_consecutive_overruns = config.value("max_consecutive_overruns", result.max_consecutive_overruns);
+    result.load_shedding = config.value("load_shedding", result.load_shedding);
+    result.shed_at_fraction = std::clamp(config.value("shed_at_fraction", result.shed_at_fraction), 0.0, 1.0);
+    return result;
+}
+
+RealTimeExecutor::RealTimeExecutor(StateManager& state_manager, StateHandle<bool> should_run,
+                                   double time_step_s, RealTimeConfig config)
+    : state_manager_(state_manager),
+      should_run_(should_run),
+      period_ns_(static_cast<int64_t>(time_step_s / std::max(config.speed, 1e-6) * NS_PER_S)),
+      config_(config) {
+    period_ns_ = std::max<int64_t>(period_ns_, 1);
+}
+
+void RealTimeExecutor::configureThread() {
+#ifdef __linux__
+    if (config_.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(config_.cpu, &cpus);
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (rc == 0) {
+            LOG_INFO("[RealTime] Pinned simulation thread to CPU {}", config_.cpu);
+        } else {
+            LOG_WARN("[RealTime] Failed to pin to CPU {}: {}", config_.cpu, std::strerror(rc));
+        }
+    }
+    if (config_.fifo_priority > 0) {
+        sched_param param{};
+        param.sched_priority = std::clamp(config_.fifo_priority,
+                                          sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc == 0) {
+            LOG_INFO("[RealTime] Running with SCHED_FIFO priority {}", param.sched_priority);
+        } else {
+            LOG_WARN("[RealTime] SCHED_FIFO not permitted ({}), staying on the default scheduler", std::strerror(rc));
+        }
+    }
+    if (config_.lock_memory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            prefaultStack(config_.prefault_stack_kb * 1024);
+            prefaultHeap(config_.prefault_heap_mb * 1024 * 1024);
+            LOG_INFO("[RealTime] Memory locked, prefaulted {} KB stack and {} MB heap",
+                     config_.prefault_stack_kb, config_.prefault_heap_mb);
+        } else {
+            LOG_WARN("[RealTime] mlockall failed: {}", std::strerror(errno));
+        }
+    }
+#else
+    if (config_.cpu >= 0 || config_.fifo_priority > 0 || config_.lock_memory) {
+        LOG_WARN("[RealTime] CPU pinning, SCHED_FIFO and memory locking are only supported on Linux");
+    }
+#endif
+}
+
+const RealTimeStatistics& RealTimeExecutor::run() {
+    configureThread();
+    LOG_INFO("[RealTime] Pacing frames every {:.3f} ms", period_ns_ / 1e6);
+
+    const uint64_t deferred_before = state_manager_.getDeferredUpdateCount();
+    const uint64_t shed_before = state_manager_.getShedUpdateCount();
+    const auto defer_offset_ns = static_cast<int64_t>(static_cast<double>(period_ns_) * config_.shed_at_fraction);
+
+    int64_t next_start_ns = monotonicNowNs();
+    while (should_run_.get()) {
+        sleepUntilNs(next_start_ns);
+        const int64_t start_ns = monotonicNowNs();
+        stats_.lateness_ns.record(static_cast<uint64_t>(std::max<int64_t>(start_ns - next_start_ns, 0)));
+
+        if (config_.load_shedding) {
+            // 预算相对计划开始时间计算，换算到 StateManager 使用的时钟
+            const auto budget_start = StateManager::BudgetClock::now() - std::chrono::nanoseconds(start_ns - next_start_ns);
+            state_manager_.setFrameBudget(budget_start + std::chrono::nanoseconds(defer_offset_ns),
+                                          budget_start + std::chrono::nanoseconds(period_ns_));
+        }
+        if (journal_) {
+            journal_->beforeFrame();
+        }
+        if (degraded_) {
+            ++stats_.degraded_frames;
+        }
+        state_manager_.updateAll();
+        if (journal_) {
+            journal_->afterFrame();
+        }
+        ++stats_.frames;
+
+        const int64_t end_ns = monotonicNowNs();
+        stats_.execution_ns.record(static_cast<uint64_t>(end_ns - start_ns));
+
+        const int64_t deadline_ns = next_start_ns + period_ns_;
+        if (end_ns > deadline_ns) {
+            ++stats_.deadline_misses;
+            handleOverrun();
+            if (stats_.aborted) {
+                break;
+            }
+        } else if (consecutive_overruns_ > 0) {
+            clearDegradation();
+        }
+
+        next_start_ns = deadline_ns;
+        if (end_ns > next_start_ns + period_ns_) {
+            // 落后超过一个周期，重新对齐节拍而不是连续追帧
+            next_start_ns = end_ns;
+        }
+    }
+
+    state_manager_.clearFrameBudget();
+    clearDegradation();
+    stats_.deferred_updates = state_manager_.getDeferredUpdateCount() - deferred_before;
+    stats_.shed_updates = state_manager_.getShedUpdateCount() - shed_before;
+    logStatistics();
+    return stats_;
+}
+
+void RealTimeExecutor::handleOverrun() {
+    ++consecutive_overruns_;
+    switch (config_.overrun_policy) {
+        case OverrunPolicy::SkipLogging:
+            state_manager_.setPriorityFloor(config_.logging_priority + 1);
+            degraded_ = true;
+            break;
+        case OverrunPolicy::DropLowPriority:
+            state_manager_.setPriorityFloor(config_.priority_floor);
+            degraded_ = true;
+            break;
+        case OverrunPolicy::Abort:
+            if (consecutive_overruns_ >= config_.max_consecutive_overruns) {
+                LOG_ERROR("[RealTime] {} consecutive deadline misses, aborting run", consecutive_overruns_);
+                stats_.aborted = true;
+            }
+            break;
+    }
+}
+
+void RealTimeExecutor::clearDegradation() {
+    consecutive_overruns_ = 0;
+    degraded_ = false;
+    state_manager_.setPriorityFloor(0);
+}
+
+void RealTimeExecutor::logStatistics() const {
+    auto us = [](uint64_t ns) { return ns / 1e3; };
+    LOG_INFO("[RealTime] {} frames, {} deadline misses, {} degraded frames{}",
+             stats_.frames, stats_.deadline_misses, stats_.degraded_frames, stats_.aborted ? " (aborted)" : "");
+    if (stats_.deferred_updates > 0) {
+        LOG_INFO("[RealTime] Load shedding: {} updates deferred to frame end, {} shed", stats_.deferred_updates,
+                 stats_.shed_updates);
+        for (const auto& [id, count] : state_manager_.getShedCounts()) {
+            LOG_INFO("[RealTime]   shed {}-{}: {}", id.vehicleId, id.name.c_str(), count);
+        }
+    }
+    LOG_INFO("[RealTime] Lateness us: p50 {:.1f}, p99 {:.1f}, p99.9 {:.1f}, max {:.1f}",
+             us(stats_.lateness_ns.valueAtPercentile(50)), us(stats_.lateness_ns.valueAtPercentile(99)),
+             us(stats_.lateness_ns.valueAtPercentile(99.9)), us(stats_.lateness_ns.max()));
+    LOG_INFO("[RealTime] Execution us: p50 {:.1f}, p99 {:.1f}, max {:.1f} (period {:.1f})",
+             us(stats_.execution_ns.valueAtPercentile(50)), us(stats_.execution_ns.valueAtPercentile(99)),
+             us(stats_.execution_ns.max()), period_ns_ / 1e3);
+}
+
+} // namespace core
+} // namespace gnc
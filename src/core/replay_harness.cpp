@@ -0,0 +1,456 @@
+#include "gnc/core/replay_harness.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include "gnc/core/component_factory.hpp"
+#include "gnc/core/hdr_histogram.hpp"
+#include "gnc/core/metrics.hpp"
+#include "gnc/core/state_manager.hpp"
+#include "math/math.hpp"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace gnc {
+namespace core {
+
+namespace {
+
+using components::utility::RecordedLog;
+
+constexpr const char* REPLAY_SOURCE_TYPE = "ReplaySource";
+constexpr int SOURCE_PRIORITY = 1000;
+constexpr size_t NO_COLUMN = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief 代替原生产者的回放源，每帧把日志当前行写入声明的输出
+ */
+class ReplaySource : public states::ComponentBase {
+public:
+    ReplaySource(const states::ComponentId& id, const size_t& row)
+        : ComponentBase(id.vehicleId, id.name), row_(row) {}
+
+    std::string getComponentType() const override { return REPLAY_SOURCE_TYPE; }
+
+    /**
+     * @param read 由行号得到状态值，同时用第 0 行的值作为默认值
+     */
+    template<typename T>
+    void addOutput(const std::string& name, std::function<T(size_t)> read, bool has_rows) {
+        declareOutput<T>(name, has_rows ? std::optional<T>(read(0)) : std::nullopt);
+        feeders_.push_back([this, name, read = std::move(read)](size_t row) { setState<T>(name, read(row)); });
+    }
+
+    size_t outputCount() const { return feeders_.size(); }
+
+protected:
+    void updateImpl() override {
+        for (const auto& feed : feeders_) {
+            feed(row_);
+        }
+    }
+
+private:
+    const size_t& row_;
+    std::vector<std::function<void(size_t)>> feeders_;
+};
+
+/**
+ * @brief 按记录列为回放源添加一个输出
+ * @param columns findState 返回的列，按分量序号排列
+ * @return type 不支持回放时返回 false
+ */
+bool addRecordedOutput(ReplaySource& source, const std::string& state, const std::string& type,
+                       const RecordedLog& log, const std::vector<size_t>& columns) {
+    // slots[i] 为第 i 个分量所在的列，未记录的分量回放为 0
+    std::vector<size_t> slots;
+    for (size_t column : columns) {
+        const auto index = static_cast<size_t>(std::max(log.columns()[column].index, 0));
+        if (slots.size() <= index) {
+            slots.resize(index + 1, NO_COLUMN);
+        }
+        slots[index] = column;
+    }
+    auto at = [&log, slots](size_t row, size_t index) {
+        return index < slots.size() && slots[index] != NO_COLUMN ? log.value(row, slots[index]) : 0.0;
+    };
+    const bool has_rows = log.rows() > 0;
+
+    if (type == typeid(double).name()) {
+        source.addOutput<double>(state, [at](size_t row) { return at(row, 0); }, has_rows);
+    } else if (type == typeid(float).name()) {
+        source.addOutput<float>(state, [at](size_t row) { return static_cast<float>(at(row, 0)); }, has_rows);
+    } else if (type == typeid(int).name()) {
+        source.addOutput<int>(state, [at](size_t row) { return static_cast<int>(std::lround(at(row, 0))); }, has_rows);
+    } else if (type == typeid(uint64_t).name()) {
+        source.addOutput<uint64_t>(state, [at](size_t row) { return static_cast<uint64_t>(std::llround(at(row, 0))); },
+                                   has_rows);
+    } else if (type == typeid(bool).name()) {
+        source.addOutput<bool>(state, [at](size_t row) { return at(row, 0) != 0.0; }, has_rows);
+    } else if (type == typeid(Vector3d).name()) {
+        source.addOutput<Vector3d>(state, [at](size_t row) { return Vector3d(at(row, 0), at(row, 1), at(row, 2)); },
+                                   has_rows);
+    } else if (type == typeid(Quaterniond).name()) {
+        source.addOutput<Quaterniond>(state, [at](size_t row) {
+            return Quaterniond(at(row, 0), at(row, 1), at(row, 2), at(row, 3));
+        }, has_rows);
+    } else if (type == typeid(std::vector<double>).name()) {
+        // DataLogger 只记录 vector<double> 的首个元素，回放长度以记录到的分量为准
+        source.addOutput<std::vector<double>>(state, [at, size = slots.size()](size_t row) {
+            std::vector<double> values(size);
+            for (size_t i = 0; i < size; ++i) {
+                values[i] = at(row, i);
+            }
+            return values;
+        }, has_rows);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 没有 TimingManager 记录时由时间列合成计时状态
+ * @return state 不是 TimingManager 输出时返回 false
+ */
+bool addTimingOutput(ReplaySource& source, const std::string& state, const RecordedLog& log) {
+    const auto& times = log.times();
+    const bool has_rows = !times.empty();
+    if (state == "timing_current_s") {
+        source.addOutput<double>(state, [&times](size_t row) { return times[row]; }, has_rows);
+    } else if (state == "timing_delta_s") {
+        source.addOutput<double>(state, [&times](size_t row) {
+            if (row > 0) {
+                return times[row] - times[row - 1];
+            }
+            return times.size() > 1 ? times[1] - times[0] : 0.0;
+        }, has_rows);
+    } else if (state == "timing_frame_count") {
+        source.addOutput<uint64_t>(state, [](size_t row) { return static_cast<uint64_t>(row + 1); }, has_rows);
+    } else if (state == "timing_should_run") {
+        source.addOutput<bool>(state, [](size_t) { return true; }, has_rows);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 把状态值展开为与 DataLogger 相同的分量序列，不支持的类型返回 false
+ */
+bool flatten(const std::any& value, std::vector<double>& out) {
+    out.clear();
+    if (value.type() == typeid(double)) {
+        out.push_back(std::any_cast<double>(value));
+    } else if (value.type() == typeid(float)) {
+        out.push_back(std::any_cast<float>(value));
+    } else if (value.type() == typeid(int)) {
+        out.push_back(std::any_cast<int>(value));
+    } else if (value.type() == typeid(uint64_t)) {
+        out.push_back(static_cast<double>(std::any_cast<uint64_t>(value)));
+    } else if (value.type() == typeid(bool)) {
+        out.push_back(std::any_cast<bool>(value) ? 1.0 : 0.0);
+    } else if (value.type() == typeid(Vector3d)) {
+        const auto& v = std::any_cast<const Vector3d&>(value);
+        out.assign({v.x(), v.y(), v.z()});
+    } else if (value.type() == typeid(Quaterniond)) {
+        const auto& q = std::any_cast<const Quaterniond&>(value);
+        out.assign({q.w(), q.x(), q.y(), q.z()});
+    } else if (value.type() == typeid(std::vector<double>)) {
+        out = std::any_cast<const std::vector<double>&>(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string describe(const states::StateId& id) {
+    return std::to_string(id.component.vehicleId) + "." + id.component.name + "." + id.name;
+}
+
+/**
+ * @brief 某个被替代组件需要回放的状态
+ */
+struct ReplayedComponent {
+    std::map<std::string, std::pair<std::string, bool>> states;  ///< 状态名 -> (类型, 是否必需)
+    bool all_states = false;              ///< 组件级依赖：回放日志中该组件的全部状态
+};
+
+} // namespace
+
+ReplayConfig ReplayConfig::fromJson(const nlohmann::json& config) {
+    ReplayConfig result;
+    result.log_file = config.value("log_file", result.log_file);
+    for (const auto& component : config.value("components", nlohmann::json::array())) {
+        result.components.push_back(ComponentSpec::fromJson(component));
+    }
+    result.vehicle = config.value("vehicle", result.vehicle);
+    for (const auto& source : config.value("sources", nlohmann::json::array())) {
+        // "Name" 表示被测飞行器上的组件，或 {vehicle, name}
+        if (source.is_string()) {
+            result.sources.emplace_back(result.vehicle, source.get<std::string>());
+        } else {
+            result.sources.emplace_back(source.value("vehicle", result.vehicle), source.at("name").get<std::string>());
+        }
+    }
+    result.tolerance = config.value("tolerance", result.tolerance);
+    result.max_frames = config.value("max_frames", result.max_frames);
+    result.repeat = std::max<size_t>(config.value("repeat", result.repeat), 1);
+    return result;
+}
+
+nlohmann::json ReplayComparison::toJson() const {
+    nlohmann::json result = {
+        {"vehicle", state.component.vehicleId},
+        {"component", state.component.name},
+        {"state", state.name},
+        {"elements", elements},
+        {"samples", samples},
+        {"mismatches", mismatches},
+        {"max_abs_error", max_abs_error},
+    };
+    if (!passed()) {
+        result["first_mismatch_frame"] = first_mismatch_frame;
+        result["first_mismatch_time_s"] = first_mismatch_time_s;
+    }
+    return result;
+}
+
+bool ReplayResult::passed() const {
+    return std::all_of(comparisons.begin(), comparisons.end(), [](const auto& c) { return c.passed(); });
+}
+
+nlohmann::json ReplayResult::toJson() const {
+    nlohmann::json compared = nlohmann::json::array();
+    for (const auto& comparison : comparisons) {
+        compared.push_back(comparison.toJson());
+    }
+    return {
+        {"passed", passed()},
+        {"frames", frames},
+        {"hosted_components", hosted_components},
+        {"replayed_states", replayed_states},
+        {"comparisons", std::move(compared)},
+        {"unrecorded_outputs", unrecorded_outputs},
+        {"wall_time_s", wall_time_s},
+        {"frames_per_s", framesPerSecond()},
+        {"frame_mean_ns", frame_mean_ns},
+        {"frame_p50_ns", frame_p50_ns},
+        {"frame_p99_ns", frame_p99_ns},
+        {"frame_max_ns", frame_max_ns},
+    };
+}
+
+ReplayHarness::ReplayHarness(ReplayConfig config)
+    : config_(std::move(config)), log_(RecordedLog::load(config_.log_file)) {}
+
+ReplayHarness::ReplayHarness(ReplayConfig config, RecordedLog log)
+    : config_(std::move(config)), log_(std::move(log)) {}
+
+ReplayResult ReplayHarness::run() const {
+    using Clock = std::chrono::steady_clock;
+    if (config_.components.empty()) {
+        throw ConfigurationError("ReplayHarness", "No components selected for replay");
+    }
+
+    // 1. 创建被测组件
+    std::vector<std::unique_ptr<states::ComponentBase>> hosted;
+    std::vector<states::ComponentBase*> hosted_components;
+    std::unordered_set<states::ComponentId, std::hash<states::ComponentId>> hosted_ids;
+    for (const auto& spec : config_.components) {
+        std::unique_ptr<states::ComponentBase> component(
+            ComponentFactory::getInstance().createComponent(spec.type, config_.vehicle, spec.name));
+        if (!component) {
+            throw ConfigurationError("ReplayHarness", "Unknown component type '" + spec.type + "'");
+        }
+        hosted_ids.insert(component->getComponentId());
+        hosted_components.push_back(component.get());
+        hosted.push_back(std::move(component));
+    }
+
+    // 2. 收集被测组件之外的输入来源；组件可能不声明就读取计时状态，因此总是提供 TimingManager，
+    //    其他未声明的读取需要通过 config_.sources 指定
+    std::unordered_map<states::ComponentId, ReplayedComponent, std::hash<states::ComponentId>> replayed;
+    const states::ComponentId timing{states::globalId, "TimingManager"};
+    if (!hosted_ids.count(timing)) {
+        auto& states = replayed[timing].states;
+        states["timing_current_s"] = {typeid(double).name(), false};
+        states["timing_delta_s"] = {typeid(double).name(), false};
+        states["timing_frame_count"] = {typeid(uint64_t).name(), false};
+        states["timing_should_run"] = {typeid(bool).name(), false};
+    }
+    for (const auto& id : config_.sources) {
+        if (!hosted_ids.count(id)) {
+            replayed[id].all_states = true;
+        }
+    }
+    for (const auto& component : hosted) {
+        const auto interface = component->getInterface();
+        for (const auto& input : interface.getInputs()) {
+            if (!input.source || hosted_ids.count(input.source->component)) {
+                continue;
+            }
+            auto& source = replayed[input.source->component];
+            if (input.source->name.empty()) {
+                source.all_states = true;
+            } else {
+                auto& [type, required] = source.states[input.source->name];
+                type = input.type;
+                required = required || input.required;
+            }
+        }
+    }
+
+    // 3. 为每个来源创建回放源
+    size_t row = 0;
+    ReplayResult result;
+    result.hosted_components = hosted.size();
+    std::vector<std::unique_ptr<ReplaySource>> sources;
+    std::vector<std::string> missing;
+    for (const auto& [id, needed] : replayed) {
+        auto source = std::make_unique<ReplaySource>(id, row);
+        std::unordered_set<std::string> added;
+        auto add = [&](const std::string& state, const std::string& type, bool required) {
+            const auto columns = log_.findState(id.vehicleId, id.name, state);
+            if (columns.empty()) {
+                if (id == timing && addTimingOutput(*source, state, log_)) {
+                    added.insert(state);
+                } else if (required) {
+                    missing.push_back(describe({id, state}));
+                }
+                return;
+            }
+            if (addRecordedOutput(*source, state, type, log_, columns)) {
+                added.insert(state);
+            } else if (required) {
+                throw ConfigurationError("ReplayHarness", "Cannot replay state " + describe({id, state}) +
+                                         " of type " + type);
+            } else {
+                LOG_WARN("[Replay] Skipping recorded state {} of unsupported type {}", describe({id, state}), type);
+            }
+        };
+        for (const auto& [state, spec] : needed.states) {
+            add(state, spec.first, spec.second);
+        }
+        if (needed.all_states) {
+            for (const auto& state : log_.statesOf(id.vehicleId, id.name)) {
+                if (!added.count(state)) {
+                    add(state, log_.columns()[log_.findState(id.vehicleId, id.name, state).front()].type_name, false);
+                }
+            }
+            if (added.empty() && needed.states.empty()) {
+                LOG_WARN("[Replay] No recorded states for {} (vehicle {}), replaying it without outputs",
+                         id.name, id.vehicleId);
+            }
+        }
+        result.replayed_states += source->outputCount();
+        sources.push_back(std::move(source));
+    }
+    if (!missing.empty()) {
+        std::string message = "Required inputs are not in the log:";
+        for (const auto& state : missing) {
+            message += " " + state;
+        }
+        throw ConfigurationError("ReplayHarness", message);
+    }
+
+    // 4. 注册到独立的 StateManager，回放源先于被测组件执行
+    StateManager manager;
+    for (auto& source : sources) {
+        manager.registerComponent(source.get(), SOURCE_PRIORITY);
+        source.release();
+    }
+    for (size_t i = 0; i < hosted.size(); ++i) {
+        manager.registerComponent(hosted[i].get(), config_.components[i].priority);
+        hosted[i].release();
+    }
+    manager.validateAndSortComponents();
+
+    // 5. 被测组件输出与日志列的对应关系
+    struct Target {
+        states::StateId state;
+        std::vector<size_t> columns;
+    };
+    std::vector<Target> targets;
+    for (const auto* component : hosted_components) {
+        const auto id = component->getComponentId();
+        const auto interface = component->getInterface();
+        for (const auto& output : interface.getOutputs()) {
+            states::StateId state{id, output.name};
+            auto columns = log_.findState(id.vehicleId, id.name, output.name);
+            if (columns.empty()) {
+                result.unrecorded_outputs.push_back(describe(state));
+                continue;
+            }
+            ReplayComparison comparison;
+            comparison.state = state;
+            comparison.elements = columns.size();
+            result.comparisons.push_back(comparison);
+            targets.push_back({std::move(state), std::move(columns)});
+        }
+    }
+
+    // 6. 逐帧回放
+    const size_t rows = config_.max_frames > 0 ? std::min(config_.max_frames, log_.rows()) : log_.rows();
+    LOG_INFO("[Replay] {} hosted components, {} replayed states, {} frames x {}", result.hosted_components,
+             result.replayed_states, rows, config_.repeat);
+    HdrHistogram frame_times(MetricsRegistry::DEFAULT_HIGHEST_NS);
+    std::vector<double> actual;
+    const auto start = Clock::now();
+    for (size_t pass = 0; pass < config_.repeat; ++pass) {
+        for (row = 0; row < rows; ++row) {
+            const auto frame_start = Clock::now();
+            manager.updateAll();
+            frame_times.record(static_cast<uint64_t>(std::chrono::nanoseconds(Clock::now() - frame_start).count()));
+            if (pass > 0) {
+                continue;
+            }
+            for (size_t t = 0; t < targets.size(); ++t) {
+                auto& comparison = result.comparisons[t];
+                if (!flatten(manager.getRawStateValue(targets[t].state), actual)) {
+                    continue;
+                }
+                for (size_t column : targets[t].columns) {
+                    const double expected = log_.value(row, column);
+                    const auto index = static_cast<size_t>(std::max(log_.columns()[column].index, 0));
+                    if (std::isnan(expected) || index >= actual.size()) {
+                        continue;
+                    }
+                    const double error = std::isnan(actual[index]) ? std::numeric_limits<double>::infinity()
+                                                                   : std::abs(actual[index] - expected);
+                    ++comparison.samples;
+                    comparison.max_abs_error = std::max(comparison.max_abs_error, error);
+                    if (error > config_.tolerance) {
+                        if (comparison.mismatches++ == 0) {
+                            comparison.first_mismatch_frame = row;
+                            comparison.first_mismatch_time_s = log_.times()[row];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    result.wall_time_s = std::chrono::duration<double>(Clock::now() - start).count();
+    result.frames = rows * config_.repeat;
+    result.frame_mean_ns = frame_times.mean();
+    result.frame_p50_ns = frame_times.valueAtPercentile(50.0);
+    result.frame_p99_ns = frame_times.valueAtPercentile(99.0);
+    result.frame_max_ns = frame_times.max();
+
+    for (const auto& comparison : result.comparisons) {
+        if (!comparison.passed()) {
+            LOG_WARN("[Replay] {} differs from the recording in {} of {} samples (max error {:.3e}, first at frame {})",
+                     describe(comparison.state), comparison.mismatches, comparison.samples, comparison.max_abs_error,
+                     comparison.first_mismatch_frame);
+        }
+    }
+    LOG_INFO("[Replay] {} frames in {:.3f} s ({:.0f} frames/s), {} outputs compared, {}", result.frames,
+             result.wall_time_s, result.framesPerSecond(), result.comparisons.size(),
+             result.passed() ? "all match" : "mismatches found");
+    return result;
+}
+
+} // namespace core
+} // namespace gnc
@@ -0,0 +1,361 @@
+#include "gnc/core/scaling_scenario.hpp"
+#include "gnc/components/utility/config_manager.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include "gnc/core/component_factory.hpp"
+#include "gnc/core/hdr_histogram.hpp"
+#include "gnc/core/metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+
+namespace gnc {
+namespace core {
+
+namespace {
+
+constexpr const char* SYNTHETIC_TYPE = "SyntheticComponent";
+
+/// 用于生成每个场景各自的工厂类型名
+std::atomic<uint64_t> next_scenario{0};
+
+/// ConfigManager 和组件工厂是进程级的，同一时间只运行一个场景
+std::mutex run_mutex;
+
+std::string componentName(size_t index) {
+    return "Syn" + std::to_string(index);
+}
+
+std::string outputName(size_t index) {
+    return "out" + std::to_string(index);
+}
+
+/**
+ * @brief 读取 /proc/self/status 中的内存字段（kB），不可用时返回 0
+ */
+int64_t readStatusKb(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0 && line.size() > field.size() && line[field.size()] == ':') {
+            std::istringstream value(line.substr(field.size() + 1));
+            int64_t kb = 0;
+            value >> kb;
+            return kb;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 按场景连接关系读写合成状态的组件
+ */
+class SyntheticComponent : public states::ComponentBase {
+public:
+    SyntheticComponent(states::VehicleId id, const std::string& instanceName,
+                       std::shared_ptr<const SyntheticLayout> layout)
+        : ComponentBase(id, SYNTHETIC_TYPE, instanceName), layout_(std::move(layout)) {
+        if (instanceName.rfind("Syn", 0) != 0) {
+            throw ConfigurationError(SYNTHETIC_TYPE, "Synthetic component name '" + instanceName + "' is not SynN");
+        }
+        const auto& config = layout_->config;
+        const size_t index = std::stoul(instanceName.substr(3));
+        const size_t slot = static_cast<size_t>(id - layout_->first_vehicle);
+        const states::VehicleId next_vehicle = layout_->first_vehicle + (slot + 1) % config.vehicles;
+
+        buffer_.assign(config.state_size, 0.0);
+        for (size_t output = 0; output < config.outputs_per_component; ++output) {
+            outputs_.push_back(outputName(output));
+            declareOutput<std::vector<double>>(outputs_.back(), buffer_);
+        }
+        for (const auto& input : layout_->components.at(index).inputs) {
+            const states::StateId state{{input.next_vehicle ? next_vehicle : id, componentName(input.component)},
+                                        outputName(input.output)};
+            inputs_.push_back(state);
+            declareInput<std::vector<double>>(state);
+        }
+    }
+
+    std::string getComponentType() const override { return SYNTHETIC_TYPE; }
+
+protected:
+    void updateImpl() override {
+        double sum = static_cast<double>(getVehicleId());
+        for (const auto& input : inputs_) {
+            const auto& value = getState<std::vector<double>>(input);
+            sum += std::accumulate(value.begin(), value.end(), 0.0);
+        }
+        double work = sum;
+        for (size_t i = 0; i < layout_->config.work_iterations; ++i) {
+            work = work * 0.999999 + 1e-6;
+        }
+        for (size_t i = 0; i < buffer_.size(); ++i) {
+            buffer_[i] = work * 1e-3 + static_cast<double>(i);
+        }
+        for (const auto& output : outputs_) {
+            setState(output, buffer_);
+        }
+    }
+
+private:
+    std::shared_ptr<const SyntheticLayout> layout_;
+    std::vector<states::StateId> inputs_;
+    std::vector<std::string> outputs_;
+    std::vector<double> buffer_;
+};
+
+/**
+ * @brief 在作用域内以场景专用的类型名注册合成组件，创建者持有该场景的连接关系
+ */
+class ScopedSyntheticType {
+public:
+    ScopedSyntheticType(const std::string& type, std::shared_ptr<const SyntheticLayout> layout) : type_(type) {
+        ComponentFactory::getInstance().registerCreator(type_,
+            [layout = std::move(layout)](states::VehicleId id, const std::string& instanceName) -> states::ComponentBase* {
+                return new SyntheticComponent(id, instanceName, layout);
+            });
+    }
+
+    ~ScopedSyntheticType() { ComponentFactory::getInstance().unregisterCreator(type_); }
+
+    ScopedSyntheticType(const ScopedSyntheticType&) = delete;
+    ScopedSyntheticType& operator=(const ScopedSyntheticType&) = delete;
+
+private:
+    std::string type_;
+};
+
+/**
+ * @brief 在作用域内替换 ConfigManager 中的一项配置，离开作用域（含异常）时恢复原值
+ * @details 原先不存在的项恢复为空对象，读取方按缺省配置处理
+ */
+class ScopedConfigValue {
+public:
+    ScopedConfigValue(components::utility::ConfigFileType type, std::string path, const nlohmann::json& value)
+        : type_(type), path_(std::move(path)) {
+        auto& config_manager = components::utility::ConfigManager::getInstance();
+        std::string pointer = "/" + path_;
+        std::replace(pointer.begin(), pointer.end(), '.', '/');
+        const nlohmann::json current = config_manager.getConfig(type_);
+        const nlohmann::json::json_pointer location(pointer);
+        previous_ = current.contains(location) ? current.at(location) : nlohmann::json::object();
+        config_manager.setConfigValue(type_, path_, value);
+    }
+
+    ~ScopedConfigValue() {
+        components::utility::ConfigManager::getInstance().setConfigValue(type_, path_, previous_);
+    }
+
+    ScopedConfigValue(const ScopedConfigValue&) = delete;
+    ScopedConfigValue& operator=(const ScopedConfigValue&) = delete;
+
+private:
+    components::utility::ConfigFileType type_;
+    std::string path_;
+    nlohmann::json previous_;
+};
+
+/**
+ * @brief 为组件 k 选取 count 个编号小于 k 的上游组件，优先选择尚未达到 fan_out 上限的
+ */
+std::vector<size_t> pickUpstream(size_t k, size_t count, size_t fan_out, std::vector<size_t>& consumers,
+                                 std::mt19937_64& rng) {
+    std::vector<size_t> candidates(k);
+    std::iota(candidates.begin(), candidates.end(), size_t{0});
+    std::shuffle(candidates.begin(), candidates.end(), rng);
+    if (fan_out > 0) {
+        std::stable_partition(candidates.begin(), candidates.end(),
+                              [&consumers, fan_out](size_t c) { return consumers[c] < fan_out; });
+    }
+    candidates.resize(std::min(count, candidates.size()));
+    for (size_t c : candidates) {
+        ++consumers[c];
+    }
+    return candidates;
+}
+
+} // namespace
+
+ScalingScenarioConfig ScalingScenarioConfig::fromJson(const nlohmann::json& config) {
+    ScalingScenarioConfig result;
+    result.vehicles = std::max<size_t>(config.value("vehicles", result.vehicles), 1);
+    result.components_per_vehicle = std::max<size_t>(config.value("components_per_vehicle", result.components_per_vehicle), 1);
+    result.fan_in = config.value("fan_in", result.fan_in);
+    result.fan_out = config.value("fan_out", result.fan_out);
+    result.outputs_per_component = std::max<size_t>(config.value("outputs_per_component", result.outputs_per_component), 1);
+    result.state_size = std::max<size_t>(config.value("state_size", result.state_size), 1);
+    result.cross_vehicle_reads = config.value("cross_vehicle_reads", result.cross_vehicle_reads);
+    result.work_iterations = config.value("work_iterations", result.work_iterations);
+    result.data_logger = config.value("data_logger", result.data_logger);
+    result.data_logger_file = config.value("data_logger_file", result.data_logger_file);
+    result.frames = config.value("frames", result.frames);
+    result.time_step_s = config.value("time_step_s", result.time_step_s);
+    result.seed = config.value("seed", result.seed);
+    result.core_overrides = config.value("core_overrides", result.core_overrides);
+    return result;
+}
+
+nlohmann::json ScalingScenarioConfig::toJson() const {
+    return {
+        {"vehicles", vehicles},
+        {"components_per_vehicle", components_per_vehicle},
+        {"fan_in", fan_in},
+        {"fan_out", fan_out},
+        {"outputs_per_component", outputs_per_component},
+        {"state_size", state_size},
+        {"cross_vehicle_reads", cross_vehicle_reads},
+        {"work_iterations", work_iterations},
+        {"data_logger", data_logger},
+        {"frames", frames},
+        {"time_step_s", time_step_s},
+        {"seed", seed},
+    };
+}
+
+nlohmann::json ScalingResult::toJson() const {
+    return {
+        {"config", config.toJson()},
+        {"components", components},
+        {"states", states},
+        {"edges", edges},
+        {"startup_s", startup_s},
+        {"frames", run.steps},
+        {"run_wall_s", run.wall_time_s},
+        {"frames_per_s", run.stepsPerSecond()},
+        {"frame_mean_ns", frame_mean_ns},
+        {"frame_p50_ns", frame_p50_ns},
+        {"frame_p99_ns", frame_p99_ns},
+        {"frame_max_ns", frame_max_ns},
+        {"rss_before_kb", rss_before_kb},
+        {"rss_after_startup_kb", rss_after_startup_kb},
+        {"rss_after_run_kb", rss_after_run_kb},
+        {"peak_rss_kb", peak_rss_kb},
+    };
+}
+
+ScalingScenario::ScalingScenario(ScalingScenarioConfig config)
+    : component_type_(std::string(SYNTHETIC_TYPE) + "#" + std::to_string(next_scenario++)) {
+    auto layout = std::make_shared<SyntheticLayout>();
+    std::mt19937_64 rng(config.seed);
+    const size_t count = config.components_per_vehicle;
+    std::vector<size_t> consumers(count, 0);
+    std::uniform_int_distribution<size_t> output(0, config.outputs_per_component - 1);
+
+    layout->components.resize(count);
+    for (size_t k = 1; k < count; ++k) {
+        auto& inputs = layout->components[k].inputs;
+        for (size_t upstream : pickUpstream(k, config.fan_in, config.fan_out, consumers, rng)) {
+            inputs.push_back({upstream, output(rng), false});
+        }
+        if (config.vehicles > 1) {
+            // 输入按 "组件.状态" 去重，跨飞行器读取不能与本飞行器输入重名，因此避开已选的上游
+            std::vector<size_t> remote;
+            for (size_t upstream = 0; upstream < k; ++upstream) {
+                if (std::none_of(inputs.begin(), inputs.end(), [upstream](const auto& in) { return in.component == upstream; })) {
+                    remote.push_back(upstream);
+                }
+            }
+            std::shuffle(remote.begin(), remote.end(), rng);
+            remote.resize(std::min(config.cross_vehicle_reads, remote.size()));
+            for (size_t upstream : remote) {
+                inputs.push_back({upstream, output(rng), true});
+            }
+        }
+    }
+    layout->config = std::move(config);
+    layout_ = std::move(layout);
+}
+
+nlohmann::json ScalingScenario::coreConfig() const {
+    const auto& config = layout_->config;
+    nlohmann::json components = nlohmann::json::array();
+    for (size_t k = 0; k < config.components_per_vehicle; ++k) {
+        components.push_back({{"type", component_type_}, {"name", componentName(k)}});
+    }
+    nlohmann::json base = nlohmann::json::array({{{"type", "TimingManager"}, {"priority", 1000}}});
+    if (config.data_logger) {
+        base.push_back({{"type", "DataLogger"}, {"priority", 100}});
+    }
+
+    nlohmann::json core = {
+        {"timing", {
+            {"duration_s", static_cast<double>(config.frames + 1) * config.time_step_s},
+            {"time_step_s", config.time_step_s},
+        }},
+        {"startup", {{"profile", false}}},
+        {"vehicle_templates", {{"synthetic", {{"components", std::move(components)}}}}},
+        {"vehicles", nlohmann::json::array({
+            {{"id", 0}, {"components", std::move(base)}},
+            {{"template", "synthetic"},
+             {"id_range", {layout_->first_vehicle, layout_->first_vehicle + config.vehicles - 1}}},
+        })},
+    };
+    core.merge_patch(config.core_overrides);
+    return core;
+}
+
+ScalingResult ScalingScenario::run() const {
+    using Clock = std::chrono::steady_clock;
+    const auto& config = layout_->config;
+    ScalingResult result;
+    result.config = config;
+    result.components = config.vehicles * config.components_per_vehicle + (config.data_logger ? 2 : 1);
+    result.states = config.vehicles * config.components_per_vehicle * config.outputs_per_component;
+    for (const auto& component : layout_->components) {
+        result.edges += component.inputs.size() * config.vehicles;
+    }
+
+    std::lock_guard<std::mutex> lock(run_mutex);
+    const ScopedSyntheticType synthetic_type(component_type_, layout_);
+    const ScopedConfigValue core_config(components::utility::ConfigFileType::CORE, "core", coreConfig());
+    std::optional<ScopedConfigValue> logger_config;
+    if (config.data_logger) {
+        logger_config.emplace(components::utility::ConfigFileType::UTILITY, "utility.data_logger", nlohmann::json{
+            {"format", "csv"},
+            {"file_path", config.data_logger_file},
+            {"log_frequency_hz", 0},
+            {"log_metadata", false},
+            {"log_vehicle_activity", false},
+            {"selectors", nlohmann::json::array({{{"component_regex", "^Syn[0-9]+$"}, {"state_regex", ".*"}}})},
+        });
+    }
+
+    LOG_INFO("[Scaling] {} vehicles x {} components, {} states, {} input edges", config.vehicles,
+             config.components_per_vehicle, result.states, result.edges);
+    result.rss_before_kb = readStatusKb("VmRSS");
+    HdrHistogram frame_times(MetricsRegistry::DEFAULT_HIGHEST_NS);
+    {
+        const auto start = Clock::now();
+        Simulator simulator;
+        simulator.initialize();
+        result.startup_s = std::chrono::duration<double>(Clock::now() - start).count();
+        result.rss_after_startup_kb = readStatusKb("VmRSS");
+
+        // 每帧执行前调用一次谓词，相邻两次调用的间隔即上一帧的耗时
+        uint64_t frames = 0;
+        Clock::time_point previous;
+        result.run = simulator.runUntil([&]() {
+            const auto now = Clock::now();
+            if (frames > 0) {
+                frame_times.record(static_cast<uint64_t>(std::chrono::nanoseconds(now - previous).count()));
+            }
+            previous = now;
+            return frames++ >= config.frames;
+        });
+        result.rss_after_run_kb = readStatusKb("VmRSS");
+    }
+    result.peak_rss_kb = readStatusKb("VmHWM");
+    result.frame_mean_ns = frame_times.mean();
+    result.frame_p50_ns = frame_times.valueAtPercentile(50.0);
+    result.frame_p99_ns = frame_times.valueAtPercentile(99.0);
+    result.frame_max_ns = frame_times.max();
+    return result;
+}
+
+} // namespace core
+} // namespace gnc
@@ -2,7 +2,12 @@
 #include "gnc/components/utility/config_manager.hpp"
 #include "gnc/components/utility/simple_logger.hpp"
 #include "gnc/core/component_factory.hpp"
+#include "gnc/core/random_streams.hpp"
+#include "gnc/core/vehicle_layout.hpp"
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 // Auto-generated component includes for self-registration
 // This file is automatically generated by CMake and includes all component headers
@@ -23,6 +28,18 @@ Simulator::Simulator()
 }
 
 Simulator::~Simulator() {
+    if (perf_profiler_) {
+        writePerfSummary();
+    }
+    if (metrics_enabled_) {
+        state_manager_->setMetrics(nullptr);
+        MetricsRegistry::getInstance().stop();
+    }
+    if (access_audit_) {
+        writeAccessAudit();
+        state_manager_->setAccessAudit(nullptr);
+    }
+    journal_.reset();
     LOG_INFO("Simulator shutting down.");
 }
 
@@ -34,43 +51,168 @@ void Simulator::initialize() {
 
     LOG_INFO("GNC Simulation Framework Initializing...");
 
-    auto& config_manager = utility::ConfigManager::getInstance();
+    StartupProfiler startup;
+    nlohmann::json core_config;
+    {
+        auto phase = StartupProfiler::phase(&startup, "load config");
+        core_config = utility::ConfigManager::getInstance().getConfig(utility::ConfigFileType::CORE);
+    }
+    bool profile_startup = true;
+    if (core_config.contains("core") && core_config["core"].contains("startup")) {
+        const auto& startup_config = core_config["core"]["startup"];
+        profile_startup = startup_config.value("profile", profile_startup);
+        state_manager_->setInitializationThreads(startup_config.value("init_threads", size_t{1}));
+    }
+
+    // 主种子须在组件创建前确定；回放时使用日志记录的种子
+    {
+        uint64_t seed = RandomStreams::DEFAULT_SEED;
+        JournalConfig journal_config;
+        if (core_config.contains("core")) {
+            seed = core_config["core"].value("random_seed", seed);
+            if (core_config["core"].contains("journal")) {
+                journal_config = JournalConfig::fromJson(core_config["core"]["journal"]);
+            }
+        }
+        journal_ = std::make_unique<InputJournal>(journal_config, *state_manager_, seed);
+        state_manager_->randomStreams()->setMasterSeed(journal_->masterSeed());
+        LOG_INFO("Random master seed: {}", journal_->masterSeed());
+    }
 
     // Load vehicle-specific components from config
-    auto vehicles_config = config_manager.getConfig(utility::ConfigFileType::CORE)["core"]["vehicles"];
-    for (const auto& vehicle_config : vehicles_config) {
-        VehicleId vehicle_id = vehicle_config["id"].get<VehicleId>();
-        LOG_INFO("Loading components for Vehicle ID: {}", vehicle_id);
-
-        for (const auto& comp_config : vehicle_config["components"]) {
-            std::string type_str;
-            std::string instance_name;
-            int priority = 500; // 默认优先级
-
-            if (comp_config.is_string()) {
-                type_str = comp_config.get<std::string>();
-            } else if (comp_config.is_object()) {
-                type_str = comp_config["type"].get<std::string>();
-                if (comp_config.contains("name")) {
-                    instance_name = comp_config["name"].get<std::string>();
+    // 模板和批量条目直接展开为组件创建，同一条目的飞行器共享一份解析好的组件列表
+    std::vector<VehicleGroup> vehicle_groups;
+    {
+        auto phase = StartupProfiler::phase(&startup, "parse vehicle layout");
+        vehicle_groups = parseVehicleLayout(core_config["core"]);
+    }
+    for (const auto& group : vehicle_groups) {
+        if (group.count == 1) {
+            LOG_INFO("Loading components for Vehicle ID: {}", group.first_id);
+        } else {
+            LOG_INFO("Loading {} vehicles (IDs {}-{}) from template '{}'", group.count, group.first_id,
+                     group.first_id + group.count - 1, group.source.c_str());
+        }
+
+        // 每个条目只开启一次计时阶段，避免逐组件记录的开销；注册前组件由 unique_ptr 持有，失败时不泄漏
+        std::vector<std::unique_ptr<ComponentBase>> created;
+        created.reserve(group.count * group.components->size());
+        {
+            auto phase = StartupProfiler::phase(&startup, "create components");
+            for (VehicleId vehicle_id = group.first_id; vehicle_id < group.first_id + group.count; ++vehicle_id) {
+                for (const ComponentSpec& spec : *group.components) {
+                    created.emplace_back(ComponentFactory::getInstance().createComponent(spec.type, vehicle_id, spec.name));
                 }
-                if (comp_config.contains("priority")) {
-                    priority = comp_config["priority"].get<int>();
-                    // 验证优先级范围
-                    if (priority < 1 || priority > 1000) {
-                        LOG_WARN("Component '{}' priority {} is out of range [1-1000], using default priority 500", type_str.c_str(), priority);
-                        priority = 500;
+            }
+        }
+        {
+            auto phase = StartupProfiler::phase(&startup, "register components");
+            auto component = created.begin();
+            for (size_t k = 0; k < group.count; ++k) {
+                for (const ComponentSpec& spec : *group.components) {
+                    state_manager_->registerComponent(component->get(), spec.priority, spec.sheddable);
+                    ComponentBase* registered = component->release();
+                    if (auto* timing = dynamic_cast<TimingManagerComponent*>(registered)) {
+                        timing_ = timing;
                     }
+                    ++component;
                 }
             }
-            ComponentBase* component = ComponentFactory::getInstance().createComponent(type_str, vehicle_id, instance_name);
-            state_manager_->registerComponent(component, priority);
+        }
+
+        for (VehicleId vehicle_id = group.first_id; vehicle_id < group.first_id + group.count; ++vehicle_id) {
+            // 飞行器初始活动状态（如尚未发射的飞行器），以及可选的按时间唤醒条件
+            if (!group.active) {
+                state_manager_->setVehicleActive(vehicle_id, false);
+            }
+            if (group.wake_at_s) {
+                const double wake_at_s = *group.wake_at_s;
+                // 唤醒条件在帧开始时求值，此时TimingManager尚未推进，因此比较本帧推进后的时间
+                state_manager_->setWakeCondition(vehicle_id, [this, wake_at_s]() {
+                    return nextFrameTime() >= wake_at_s - 1e-9;
+                });
+            }
+        }
+        if (group.wake_at_s) {
+            state_manager_->scheduleWakeAt(*group.wake_at_s);
+            if (group.count == 1) {
+                LOG_INFO("Vehicle {} will wake at t = {} s", group.first_id, *group.wake_at_s);
+            } else {
+                LOG_INFO("Vehicles {}-{} will wake at t = {} s", group.first_id, group.first_id + group.count - 1,
+                         *group.wake_at_s);
+            }
+        }
+    }
+
+    // 混合离散事件调度（默认关闭，始终以固定步长推进）
+    if (core_config.contains("core") && core_config["core"].contains("timing")) {
+        discrete_event_mode_ = core_config["core"]["timing"].value("discrete_event", false);
+    }
+    if (discrete_event_mode_ && !timing_) {
+        LOG_WARN("Discrete-event mode requires a TimingManager component, falling back to fixed stepping");
+        discrete_event_mode_ = false;
+    }
+    if (discrete_event_mode_) {
+        LOG_INFO("Hybrid discrete-event scheduling enabled");
+    }
+    if (core_config.contains("core") && core_config["core"].contains("real_time")) {
+        real_time_config_ = RealTimeConfig::fromJson(core_config["core"]["real_time"]);
+    }
+    if (core_config.contains("core") && core_config["core"].contains("profiling")) {
+        const auto& profiling_config = core_config["core"]["profiling"];
+        if (profiling_config.value("perf_counters", false)) {
+            // 计数器只统计打开它的线程，仿真循环与初始化在同一线程上运行
+            perf_profiler_ = std::make_unique<PerfCounterProfiler>();
+            if (perf_profiler_->open()) {
+                perf_summary_file_ = profiling_config.value("summary_file", std::string());
+                state_manager_->setPerfProfiler(perf_profiler_.get());
+            } else {
+                LOG_WARN("Hardware performance counters unavailable, continuing without per-component profiling");
+                perf_profiler_.reset();
+            }
+        }
+    }
+    if (core_config.contains("core") && core_config["core"].contains("audit")) {
+        const auto& audit_config = core_config["core"]["audit"];
+        if (audit_config.value("state_access", false)) {
+            access_audit_ = std::make_unique<StateAccessAudit>();
+            audit_top_n_ = audit_config.value("top_n", audit_top_n_);
+            audit_dot_file_ = audit_config.value("dot_file", std::string());
+            audit_json_file_ = audit_config.value("json_file", std::string());
+            state_manager_->setAccessAudit(access_audit_.get());
+            LOG_INFO("State access audit enabled");
+        }
+    }
+    if (core_config.contains("core") && core_config["core"].contains("allocation_check")) {
+        const auto& check_config = core_config["core"]["allocation_check"];
+        AllocationCheckConfig check;
+        check.warmup_frames = check_config.value("warmup_frames", check.warmup_frames);
+        check.sample_stacks = check_config.value("sample_stacks", check.sample_stacks);
+        check.fail_on_allocation = check_config.value("fail_on_allocation", check.fail_on_allocation);
+        state_manager_->setAllocationCheck(check);
+        if (!AllocationTracker::enabled()) {
+            LOG_DEBUG("allocation_check is configured but the build has GNC_TRACK_ALLOCATIONS disabled");
         }
     }
 
     // Finalize setup
+    state_manager_->setStartupProfiler(&startup);
     state_manager_->validateAndSortComponents();
+    state_manager_->setStartupProfiler(nullptr);
+    should_run_ = state_manager_->getStateHandle<bool>({{globalId, "TimingManager"}, "timing_should_run"});
+    if (timing_) {
+        journal_->setSimTime(state_manager_->getStateHandle<double>({{globalId, "TimingManager"}, "timing_current_s"}));
+    }
+    if (core_config.contains("core") && core_config["core"].contains("metrics")) {
+        const MetricsConfig metrics_config = MetricsConfig::fromJson(core_config["core"]["metrics"]);
+        if (metrics_config.enabled) {
+            startMetrics(metrics_config);
+        }
+    }
     is_initialized_ = true;
+    if (profile_startup) {
+        startup.logReport();
+    }
     LOG_INFO("Simulator initialization complete.");
 }
 
@@ -79,7 +221,9 @@ void Simulator::step() {
         LOG_ERROR("Cannot step simulation before it is initialized.");
         return;
     }
-    state_manager_->updateAll(); 
+    journal_->beforeFrame();
+    state_manager_->updateAll();
+    journal_->afterFrame();
 }
 
 void Simulator::run() {
@@ -88,20 +232,177 @@ void Simulator::run() {
         return;
     }
 
-    LOG_INFO("Starting data-driven simulation loop...");
+    if (real_time_config_.enabled && !journal_->replaying()) {
+        runRealTime();
+        return;
+    }
 
-    // The ID for the state that controls the loop
-    const StateId should_run_id {
-        ComponentId{globalId, "TimingManager"}, // Vehicle 0, default name
-        "timing_should_run"
-    };
+    LOG_INFO("Starting data-driven simulation loop...");
 
     // Loop continues as long as the TimingManager says it should
-    while (state_manager_->getState<bool>(should_run_id)) {
-        step();
-    }
+    RunStatistics stats = runLoop([](uint64_t) { return false; });
 
     LOG_INFO("Simulation loop finished.");
+    logRunStatistics(stats);
+}
+
+RunStatistics Simulator::runFor(uint64_t ticks) {
+    if (!is_initialized_) {
+        LOG_ERROR("Cannot run simulation before it is initialized. Call initialize() first.");
+        return {};
+    }
+    RunStatistics stats = runLoop([ticks](uint64_t steps) { return steps >= ticks; });
+    logRunStatistics(stats);
+    return stats;
+}
+
+RunStatistics Simulator::runUntil(const std::function<bool()>& predicate) {
+    if (!is_initialized_) {
+        LOG_ERROR("Cannot run simulation before it is initialized. Call initialize() first.");
+        return {};
+    }
+    RunStatistics stats = runLoop([&predicate](uint64_t) { return predicate(); });
+    logRunStatistics(stats);
+    return stats;
+}
+
+RealTimeStatistics Simulator::runRealTime() {
+    if (!is_initialized_) {
+        LOG_ERROR("Cannot run simulation before it is initialized. Call initialize() first.");
+        return {};
+    }
+    if (!timing_) {
+        LOG_ERROR("Real-time mode requires a TimingManager component.");
+        return {};
+    }
+
+    LOG_INFO("Starting real-time simulation loop at {}x speed...", real_time_config_.speed);
+    RealTimeExecutor executor(*state_manager_, should_run_, timing_->getTimeStep(), real_time_config_);
+    executor.setJournal(journal_.get());
+    RealTimeStatistics stats = executor.run();
+    LOG_INFO("Real-time simulation loop finished.");
+    return stats;
+}
+
+template <typename StopCondition>
+RunStatistics Simulator::runLoop(StopCondition&& stop) {
+    const double start_sim_s = timing_ ? timing_->getCurrentTime() : 0.0;
+    const auto start_wall = std::chrono::steady_clock::now();
+
+    uint64_t steps = 0;
+    if (discrete_event_mode_) {
+        while (should_run_.get() && !stop(steps)) {
+            scheduleDiscreteEventJump();
+            journal_->beforeFrame();
+            state_manager_->updateAll();
+            journal_->afterFrame();
+            ++steps;
+        }
+    } else {
+        while (should_run_.get() && !stop(steps)) {
+            journal_->beforeFrame();
+            state_manager_->updateAll();
+            journal_->afterFrame();
+            ++steps;
+        }
+    }
+
+    RunStatistics stats;
+    stats.steps = steps;
+    stats.wall_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_wall).count();
+    stats.sim_time_s = timing_ ? timing_->getCurrentTime() - start_sim_s : 0.0;
+    return stats;
+}
+
+void Simulator::writePerfSummary() const {
+    std::ostringstream table;
+    perf_profiler_->writeSummary(table);
+    LOG_INFO("Hardware performance counters per component type:");
+    std::istringstream lines(table.str());
+    for (std::string line; std::getline(lines, line);) {
+        LOG_INFO("  {}", line.c_str());
+    }
+    if (!perf_summary_file_.empty()) {
+        std::ofstream file(perf_summary_file_);
+        if (file) {
+            file << table.str();
+            LOG_INFO("Performance counter summary written to {}", perf_summary_file_.c_str());
+        } else {
+            LOG_WARN("Cannot write performance counter summary to {}", perf_summary_file_.c_str());
+        }
+    }
+}
+
+void Simulator::startMetrics(const MetricsConfig& config) {
+    auto& metrics = MetricsRegistry::getInstance();
+    StateHandle<double> sim_time;
+    if (timing_) {
+        sim_time = state_manager_->getStateHandle<double>({{globalId, "TimingManager"}, "timing_current_s"});
+    }
+    state_manager_->setMetrics(&metrics, sim_time, config.per_component, config.per_instance);
+
+    metrics.sampledGauge("gnc_log_queue_depth", "Messages waiting in the async log queue", []() {
+        return static_cast<double>(utility::SimpleLogger::getInstance().queueDepth());
+    });
+    // 仿真速度按导出区间计算：区间内推进的仿真时间 / 墙钟时间
+    MetricsGauge& sim_time_gauge = metrics.gauge("gnc_sim_time_s", "Simulation time at the end of the last frame");
+    metrics.sampledGauge("gnc_sim_speed_ratio", "Simulated seconds per wall-clock second over the last export interval",
+                         [&sim_time_gauge, last_sim = 0.0, last_wall = MetricsRegistry::Clock::now()]() mutable {
+                             const double sim = sim_time_gauge.value();
+                             const auto wall = MetricsRegistry::Clock::now();
+                             const double elapsed = std::chrono::duration<double>(wall - last_wall).count();
+                             const double ratio = elapsed > 0.0 ? (sim - last_sim) / elapsed : 0.0;
+                             last_sim = sim;
+                             last_wall = wall;
+                             return ratio;
+                         });
+    metrics.start(config);
+    metrics_enabled_ = true;
+}
+
+void Simulator::writeAccessAudit() const {
+    const auto edges = state_manager_->analyzeAccessAudit();
+    access_audit_->logReport(edges, audit_top_n_);
+    if (!audit_dot_file_.empty()) {
+        std::ofstream file(audit_dot_file_);
+        if (file) {
+            access_audit_->writeDot(file, edges);
+            LOG_INFO("State dataflow graph written to {}", audit_dot_file_.c_str());
+        } else {
+            LOG_WARN("Cannot write state dataflow graph to {}", audit_dot_file_.c_str());
+        }
+    }
+    if (!audit_json_file_.empty()) {
+        std::ofstream file(audit_json_file_);
+        if (file) {
+            access_audit_->writeJson(file, edges);
+            LOG_INFO("State access audit written to {}", audit_json_file_.c_str());
+        } else {
+            LOG_WARN("Cannot write state access audit to {}", audit_json_file_.c_str());
+        }
+    }
+}
+
+void Simulator::logRunStatistics(const RunStatistics& stats) const {
+    LOG_INFO("Executed {} steps ({:.3f}s simulated) in {:.3f}s wall time: {:.0f} steps/s, sim/wall ratio {:.1f}",
+             stats.steps, stats.sim_time_s, stats.wall_time_s, stats.stepsPerSecond(), stats.simToWallRatio());
+}
+
+void Simulator::scheduleDiscreteEventJump() {
+    // 有活动飞行器时需要连续积分，保持固定步长；活动数量随休眠/唤醒维护，这里不遍历组件
+    double event_s = 0.0;
+    if (state_manager_->nextDiscreteEventJump(timing_->getCurrentTime(), event_s)) {
+        timing_->scheduleJumpTo(event_s);
+    }
+}
+
+double Simulator::nextFrameTime() const {
+    if (timing_) {
+        return timing_->getNextTime();
+    }
+    const ComponentId timing{globalId, "TimingManager"};
+    return state_manager_->getState<double>({timing, "timing_current_s"}) +
+           state_manager_->getState<double>({timing, "timing_delta_s"});
 }
 
 } // namespace core
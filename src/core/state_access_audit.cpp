@@ -0,0 +1,186 @@
+#include "gnc/core/state_access_audit.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+
+namespace gnc {
+
+using states::ComponentId;
+using states::StateId;
+
+namespace {
+
+std::string label(const ComponentId& id) {
+    return std::to_string(id.vehicleId) + "." + id.name;
+}
+
+std::string label(const StateId& id) {
+    return label(id.component) + "." + id.name;
+}
+
+} // namespace
+
+std::vector<const StateAccessAudit::Access*> StateAccessAudit::accesses() const {
+    std::vector<const Access*> result;
+    result.reserve(accesses_.size());
+    for (const auto& [key, access] : accesses_) {
+        result.push_back(&access);
+    }
+    std::sort(result.begin(), result.end(), [](const Access* a, const Access* b) {
+        return label(a->state) + label(a->accessor) < label(b->state) + label(b->accessor);
+    });
+    return result;
+}
+
+std::vector<StateAccessAudit::Edge> StateAccessAudit::dataflow(const DependencyQuery& declared,
+                                                               const DependencyQuery& ordered) const {
+    std::vector<Edge> edges;
+    for (const Access* access : accesses()) {
+        const ComponentId& producer = access->state.component;
+        const ComponentId& consumer = access->accessor;
+        if (access->reads == 0 || producer == consumer) {
+            continue;
+        }
+        Edge edge;
+        edge.access = access;
+        edge.cross_vehicle = producer.vehicleId != consumer.vehicleId && producer.vehicleId != states::globalId &&
+                             consumer.vehicleId != states::globalId;
+        edge.declared = declared(producer, consumer);
+        edge.ordered = edge.declared || ordered(producer, consumer);
+        edges.push_back(edge);
+    }
+    return edges;
+}
+
+void StateAccessAudit::logReport(const std::vector<Edge>& edges, size_t top_n) const {
+    const double frames = static_cast<double>(std::max<uint64_t>(frame_, 1));
+    LOG_INFO("[StateAudit] {} state accesses recorded over {} frames", accesses_.size(), frame_);
+
+    // 热点状态：按每帧读取次数排序
+    struct Heat {
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+        size_t readers = 0;
+    };
+    std::map<std::string, Heat> heat;
+    for (const auto& [key, access] : accesses_) {
+        Heat& entry = heat[label(access.state)];
+        entry.reads += access.reads;
+        entry.writes += access.writes;
+        if (access.reads > 0) {
+            ++entry.readers;
+        }
+    }
+    std::vector<std::pair<std::string, Heat>> hottest(heat.begin(), heat.end());
+    std::sort(hottest.begin(), hottest.end(), [](const auto& a, const auto& b) { return a.second.reads > b.second.reads; });
+    LOG_INFO("[StateAudit] Hottest states (reads/frame, readers, writes/frame):");
+    for (size_t i = 0; i < std::min(top_n, hottest.size()); ++i) {
+        const auto& [name, entry] = hottest[i];
+        LOG_INFO("[StateAudit]   {:<48} {:>8.2f} {:>4} {:>8.2f}", name.c_str(), entry.reads / frames, entry.readers,
+                 entry.writes / frames);
+    }
+
+    size_t cross_vehicle = 0;
+    size_t undeclared = 0;
+    size_t unordered = 0;
+    for (const Edge& edge : edges) {
+        if (edge.cross_vehicle) {
+            ++cross_vehicle;
+            LOG_INFO("[StateAudit] Cross-vehicle read: {} reads {}", label(edge.consumer()).c_str(),
+                     label(edge.access->state).c_str());
+        }
+        if (!edge.declared) {
+            ++undeclared;
+            if (!edge.ordered) {
+                ++unordered;
+                LOG_WARN("[StateAudit] Undeclared, unordered read (unsafe in parallel): {} reads {}",
+                         label(edge.consumer()).c_str(), label(edge.access->state).c_str());
+            } else {
+                LOG_INFO("[StateAudit] Undeclared read ordered only transitively: {} reads {}",
+                         label(edge.consumer()).c_str(), label(edge.access->state).c_str());
+            }
+        }
+    }
+    LOG_INFO("[StateAudit] {} dataflow edges: {} cross-vehicle, {} undeclared, {} unordered",
+             edges.size(), cross_vehicle, undeclared, unordered);
+}
+
+void StateAccessAudit::writeDot(std::ostream& out, const std::vector<Edge>& edges) const {
+    // 节点为组件，边按 (producer, consumer) 合并，标注读取的状态名
+    std::map<std::pair<std::string, std::string>, std::vector<const Edge*>> grouped;
+    std::set<std::string> nodes;
+    for (const Edge& edge : edges) {
+        const std::string producer = label(edge.producer());
+        const std::string consumer = label(edge.consumer());
+        grouped[{producer, consumer}].push_back(&edge);
+        nodes.insert(producer);
+        nodes.insert(consumer);
+    }
+
+    out << "digraph state_dataflow {\n";
+    out << "  rankdir=LR;\n  node [shape=box];\n";
+    for (const auto& node : nodes) {
+        out << "  \"" << node << "\";\n";
+    }
+    for (const auto& [ends, group] : grouped) {
+        std::string states;
+        bool declared = true;
+        bool ordered = true;
+        bool cross_vehicle = false;
+        for (const Edge* edge : group) {
+            states += (states.empty() ? "" : "\\n") + edge->access->state.name;
+            declared = declared && edge->declared;
+            ordered = ordered && edge->ordered;
+            cross_vehicle = cross_vehicle || edge->cross_vehicle;
+        }
+        out << "  \"" << ends.first << "\" -> \"" << ends.second << "\" [label=\"" << states << "\"";
+        if (!ordered) {
+            out << ", color=red, style=bold";
+        } else if (!declared) {
+            out << ", color=orange, style=dashed";
+        } else if (cross_vehicle) {
+            out << ", color=blue";
+        }
+        out << "];\n";
+    }
+    out << "}\n";
+}
+
+void StateAccessAudit::writeJson(std::ostream& out, const std::vector<Edge>& edges) const {
+    const double frames = static_cast<double>(std::max<uint64_t>(frame_, 1));
+    nlohmann::json root;
+    root["frames"] = frame_;
+
+    nlohmann::json accesses = nlohmann::json::array();
+    for (const Access* access : this->accesses()) {
+        accesses.push_back({
+            {"accessor", label(access->accessor)},
+            {"state", label(access->state)},
+            {"reads_per_frame", access->reads / frames},
+            {"writes_per_frame", access->writes / frames},
+            {"frames", access->frames},
+        });
+    }
+    root["accesses"] = std::move(accesses);
+
+    nlohmann::json dataflow = nlohmann::json::array();
+    for (const Edge& edge : edges) {
+        dataflow.push_back({
+            {"producer", label(edge.producer())},
+            {"consumer", label(edge.consumer())},
+            {"state", edge.access->state.name},
+            {"reads", edge.access->reads},
+            {"frames", edge.access->frames},
+            {"cross_vehicle", edge.cross_vehicle},
+            {"declared", edge.declared},
+            {"ordered", edge.ordered},
+        });
+    }
+    root["dataflow"] = std::move(dataflow);
+    out << root.dump(2) << '\n';
+}
+
+} // namespace gnc
@@ -0,0 +1,139 @@
+#include "gnc/core/vehicle_layout.hpp"
+#include "gnc/common/exceptions.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+
+namespace gnc {
+namespace core {
+
+namespace {
+
+ComponentList parseComponentList(const nlohmann::json& config) {
+    ComponentList components;
+    components.reserve(config.size());
+    for (const auto& component : config) {
+        components.push_back(ComponentSpec::fromJson(component));
+    }
+    return components;
+}
+
+int checkedPriority(const std::string& type, int priority) {
+    if (priority < 1 || priority > 1000) {
+        LOG_WARN("Component '{}' priority {} is out of range [1-1000], using default priority 500", type.c_str(), priority);
+        return 500;
+    }
+    return priority;
+}
+
+/**
+ * @brief 在共享列表上应用条目级的 remove / overrides / extra_components，没有修改时原样返回
+ */
+std::shared_ptr<const ComponentList> customize(const std::shared_ptr<const ComponentList>& base,
+                                               const nlohmann::json& entry, const std::string& source) {
+    if (!entry.contains("overrides") && !entry.contains("extra_components") && !entry.contains("remove")) {
+        return base;
+    }
+    auto components = std::make_shared<ComponentList>(*base);
+
+    if (entry.contains("remove")) {
+        for (const auto& key : entry["remove"]) {
+            const auto name = key.get<std::string>();
+            const auto removed = std::erase_if(*components, [&name](const ComponentSpec& spec) { return spec.key() == name; });
+            if (removed == 0) {
+                throw ConfigurationError("Simulator", "Template '" + source + "' has no component '" + name + "' to remove");
+            }
+        }
+    }
+    if (entry.contains("overrides")) {
+        for (const auto& [name, fields] : entry["overrides"].items()) {
+            auto it = std::find_if(components->begin(), components->end(),
+                                   [&name](const ComponentSpec& spec) { return spec.key() == name; });
+            if (it == components->end()) {
+                throw ConfigurationError("Simulator", "Template '" + source + "' has no component '" + name + "' to override");
+            }
+            if (fields.contains("priority")) {
+                it->priority = checkedPriority(it->type, fields["priority"].get<int>());
+            }
+            it->sheddable = fields.value("sheddable", it->sheddable);
+        }
+    }
+    if (entry.contains("extra_components")) {
+        for (const auto& component : entry["extra_components"]) {
+            components->push_back(ComponentSpec::fromJson(component));
+        }
+    }
+    return components;
+}
+
+} // namespace
+
+ComponentSpec ComponentSpec::fromJson(const nlohmann::json& config) {
+    ComponentSpec spec;
+    if (config.is_string()) {
+        spec.type = config.get<std::string>();
+        return spec;
+    }
+    spec.type = config.at("type").get<std::string>();
+    spec.name = config.value("name", spec.name);
+    if (config.contains("priority")) {
+        spec.priority = checkedPriority(spec.type, config["priority"].get<int>());
+    }
+    spec.sheddable = config.value("sheddable", spec.sheddable);
+    return spec;
+}
+
+std::vector<VehicleGroup> parseVehicleLayout(const nlohmann::json& core) {
+    std::map<std::string, std::shared_ptr<const ComponentList>> templates;
+    if (core.contains("vehicle_templates")) {
+        for (const auto& [name, config] : core["vehicle_templates"].items()) {
+            templates.emplace(name, std::make_shared<const ComponentList>(parseComponentList(config.at("components"))));
+        }
+    }
+
+    std::vector<VehicleGroup> groups;
+    std::unordered_set<states::VehicleId> seen;
+    for (const auto& entry : core.at("vehicles")) {
+        VehicleGroup group;
+        if (entry.contains("template")) {
+            group.source = entry["template"].get<std::string>();
+            auto it = templates.find(group.source);
+            if (it == templates.end()) {
+                throw ConfigurationError("Simulator", "Unknown vehicle template '" + group.source + "'");
+            }
+            group.components = customize(it->second, entry, group.source);
+        } else {
+            group.components = std::make_shared<const ComponentList>(parseComponentList(entry.at("components")));
+        }
+
+        if (entry.contains("id_range")) {
+            const auto& range = entry["id_range"];
+            if (!range.is_array() || range.size() != 2 || range[1].get<states::VehicleId>() < range[0].get<states::VehicleId>()) {
+                throw ConfigurationError("Simulator", "id_range must be [first, last] with first <= last");
+            }
+            group.first_id = range[0].get<states::VehicleId>();
+            group.count = static_cast<size_t>(range[1].get<states::VehicleId>() - group.first_id) + 1;
+        } else {
+            group.first_id = entry.at("id").get<states::VehicleId>();
+            group.count = entry.value("count", size_t{1});
+        }
+
+        seen.reserve(seen.size() + group.count);
+        for (size_t i = 0; i < group.count; ++i) {
+            if (!seen.insert(group.first_id + i).second) {
+                throw ConfigurationError("Simulator", "Vehicle ID " + std::to_string(group.first_id + i) + " is declared more than once");
+            }
+        }
+
+        group.active = entry.value("active", true);
+        if (entry.contains("wake_at_s")) {
+            group.wake_at_s = entry["wake_at_s"].get<double>();
+        }
+        groups.push_back(std::move(group));
+    }
+    return groups;
+}
+
+} // namespace core
+} // namespace gnc
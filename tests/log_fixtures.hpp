@@ -0,0 +1,43 @@
+/**
+ * @file log_fixtures.hpp
+ * @brief 日志后处理测试共用的二进制日志夹具
+ */
+#pragma once
+
+#include "gnc/components/utility/binary_writer.hpp"
+#include <any>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gnc::test {
+
+/**
+ * @brief 在临时目录写一份 Plant 组件的二进制日志
+ * @param name 文件名（不含扩展名）
+ * @param rows 行数，第 row 行的时间为 dt * row
+ * @param columns 列名，记录为 Plant.<列名>
+ * @param values 给出每行各列的值，顺序与 columns 一致
+ * @return 日志文件路径
+ */
+inline std::string writeRun(const std::string& name, std::size_t rows, double dt,
+                            const std::vector<std::string>& columns,
+                            const std::function<std::vector<std::any>(std::size_t row, double t)>& values) {
+    const gnc::states::ComponentId component{1, "Plant"};
+    std::vector<gnc::states::StateId> states;
+    for (const auto& column : columns) {
+        states.push_back({component, "Plant." + column});
+    }
+    gnc::components::utility::BinaryWriter writer;
+    writer.initialize((std::filesystem::temp_directory_path() / (name + ".gnclog")).string(), states, false);
+    for (std::size_t row = 0; row < rows; ++row) {
+        const double t = dt * static_cast<double>(row);
+        writer.writeDataPoint(t, values(row, t));
+    }
+    writer.finalize();
+    return writer.filePath();
+}
+
+} // namespace gnc::test
@@ -0,0 +1,126 @@
+/**
+ * @file test_campaign_stats.cpp
+ * @brief 批量统计汇总单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/components/utility/campaign_stats.hpp"
+#include <algorithm>
+#include <random>
+#include <thread>
+
+using namespace gnc::components::utility;
+
+// 测试分块合并后的均值方差与直接计算一致，t-digest 分位数误差在容许范围内
+TEST(CampaignStatsTest, MergedSketchesMatchExactStatistics) {
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> normal(3.0, 2.0);
+    std::vector<double> samples(100000);
+    for (auto& sample : samples) {
+        sample = normal(rng);
+    }
+
+    RunningStats direct;
+    std::vector<RunningStats> partial_stats(4);
+    std::vector<TDigest> partial_digests(4);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        direct.add(samples[i]);
+        partial_stats[i % 4].add(samples[i]);
+        partial_digests[i % 4].add(samples[i]);
+    }
+    RunningStats merged;
+    TDigest digest;
+    for (size_t i = 0; i < 4; ++i) {
+        merged.merge(partial_stats[i]);
+        digest.merge(partial_digests[i]);
+    }
+    EXPECT_EQ(merged.count(), direct.count());
+    EXPECT_NEAR(merged.mean(), direct.mean(), 1e-12);
+    EXPECT_NEAR(merged.variance(), direct.variance(), 1e-9);
+    EXPECT_LT(digest.centroids().size(), 200u);
+
+    std::sort(samples.begin(), samples.end());
+    for (double q : {0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999}) {
+        // 以秩误差衡量：估计分位数以下的样本比例应接近 q
+        const double estimate = digest.quantile(q);
+        const double rank = static_cast<double>(std::upper_bound(samples.begin(), samples.end(), estimate) - samples.begin()) /
+                            static_cast<double>(samples.size());
+        EXPECT_NEAR(rank, q, 0.002) << "q = " << q;
+        EXPECT_NEAR(digest.cdf(samples[static_cast<size_t>(q * (samples.size() - 1))]), q, 0.002) << "q = " << q;
+    }
+    EXPECT_DOUBLE_EQ(digest.quantile(0.0), samples.front());
+    EXPECT_DOUBLE_EQ(digest.quantile(1.0), samples.back());
+}
+
+// 测试多线程加入运行记录、重复运行被忽略，以及从批量统计文件恢复
+TEST(CampaignStatsTest, AggregatesRunsFromThreadsAndResumes) {
+    auto summary = [](int run) {
+        return nlohmann::json{
+            {"kind", "run_summary"},
+            {"states", {{"1.Plant.x", {{"samples", 100}, {"max", static_cast<double>(run)}, {"rms", nullptr}}}}}};
+    };
+
+    CampaignAggregator aggregator;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int run = t; run < 400; run += 4) {
+                aggregator.addRun(summary(run), "run" + std::to_string(run));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(aggregator.addRun(summary(0), "run0"));
+    EXPECT_THROW(aggregator.addRun({{"states", nlohmann::json::object()}}, "bad"), std::runtime_error);
+    EXPECT_EQ(aggregator.runs(), 400u);
+
+    const nlohmann::json record = aggregator.toJson();
+    const auto& max = record["states"]["1.Plant.x"]["max"];
+    EXPECT_FALSE(record["states"]["1.Plant.x"].contains("samples"));
+    EXPECT_FALSE(record["states"]["1.Plant.x"].contains("rms"));
+    EXPECT_EQ(max["count"], 400);
+    EXPECT_NEAR(max["mean"].get<double>(), 199.5, 1e-9);
+    EXPECT_NEAR(max["quantiles"]["p50"].get<double>(), 199.5, 1.0);
+    double histogram_total = 0.0;
+    for (double count : max["histogram"]["counts"]) {
+        histogram_total += count;
+    }
+    EXPECT_NEAR(histogram_total, 400.0, 1e-6);
+
+    CampaignAggregator resumed;
+    resumed.load(record);
+    EXPECT_EQ(resumed.runs(), 400u);
+    EXPECT_TRUE(resumed.contains("run399"));
+    EXPECT_TRUE(resumed.addRun(summary(400), "run400"));
+    const nlohmann::json resumed_record = resumed.toJson();
+    const auto& resumed_max = resumed_record["states"]["1.Plant.x"]["max"];
+    EXPECT_EQ(resumed_max["count"], 401);
+    EXPECT_NEAR(resumed_max["mean"].get<double>(), 200.0, 1e-9);
+}
+
+// 测试合并不相交的部分统计，共享运行的合并或加载被拒绝且不改变统计
+TEST(CampaignStatsTest, MergeRejectsSharedRuns) {
+    auto summary = [](double max) {
+        return nlohmann::json{{"kind", "run_summary"}, {"states", {{"1.Plant.x", {{"max", max}}}}}};
+    };
+
+    CampaignAggregator first, second, overlapping;
+    first.addRun(summary(1.0), "run1");
+    first.addRun(summary(2.0), "run2");
+    second.addRun(summary(3.0), "run3");
+    overlapping.addRun(summary(2.0), "run2");
+    overlapping.addRun(summary(4.0), "run4");
+
+    first.merge(second);
+    EXPECT_EQ(first.runs(), 3u);
+    EXPECT_THROW(first.merge(overlapping), std::runtime_error);
+    EXPECT_THROW(first.load(overlapping.toJson()), std::runtime_error);
+
+    const nlohmann::json record = first.toJson();
+    EXPECT_EQ(first.runs(), 3u);
+    EXPECT_FALSE(first.contains("run4"));
+    EXPECT_EQ(record["states"]["1.Plant.x"]["max"]["count"], 3);
+    EXPECT_NEAR(record["states"]["1.Plant.x"]["max"]["mean"].get<double>(), 2.0, 1e-12);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file test_coroutine_behavior.cpp
+ * @brief 协程时序组件单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/state_manager.hpp"
+#include "gnc/core/coroutine_behavior.hpp"
+
+using namespace gnc;
+using namespace gnc::states;
+using namespace gnc::coroutine;
+
+namespace {
+
+// 最小时间源：每帧推进 0.1 s
+class FakeTiming : public ComponentBase {
+public:
+    FakeTiming() : ComponentBase(globalId, "TimingManager") {
+        declareOutput<double>("timing_current_s", 0.0);
+        declareOutput<double>("timing_delta_s", 0.1);
+    }
+
+    std::string getComponentType() const override { return "FakeTiming"; }
+
+protected:
+    void updateImpl() override {
+        setState("timing_current_s", 0.1 * frame_++);
+    }
+
+private:
+    int frame_ = 0;
+};
+
+// 记录每一步完成的时间
+class ScriptedSequence : public SequencedComponent {
+public:
+    explicit ScriptedSequence(VehicleId id) : SequencedComponent(id, "Script") {}
+
+    std::string getComponentType() const override { return "Script"; }
+
+    std::vector<double> marks;
+    bool gate = false;
+
+protected:
+    Task pause(double seconds) {
+        co_await sleep(seconds);
+        marks.push_back(now());
+    }
+
+    Task behavior() override {
+        co_await sleep(0.25);
+        marks.push_back(now());
+        co_await until([this]() { return gate; });
+        marks.push_back(now());
+        for (int i = 0; i < 3; ++i) {
+            co_await pause(0.1);
+        }
+    }
+};
+
+} // namespace
+
+// 测试 sleep 不早于到期时间恢复、until 条件满足后恢复、子任务帧复用内存池
+TEST(CoroutineBehaviorTest, SleepUntilAndNestedTasks) {
+    StateManager manager;
+    manager.registerComponent(new FakeTiming());
+    auto* script = new ScriptedSequence(1);
+    manager.registerComponent(script);
+
+    for (int i = 0; i < 5; ++i) {
+        manager.updateAll();  // t = 0.0 ... 0.4
+    }
+    ASSERT_EQ(script->marks.size(), 1u);
+    EXPECT_NEAR(script->marks[0], 0.3, 1e-9);
+
+    script->gate = true;
+    for (int i = 0; i < 6; ++i) {
+        manager.updateAll();  // t = 0.5 ... 1.0
+    }
+    ASSERT_EQ(script->marks.size(), 5u);
+    EXPECT_NEAR(script->marks[1], 0.5, 1e-9);
+    EXPECT_NEAR(script->marks[4], 0.8, 1e-9);
+    EXPECT_TRUE(script->isSequenceDone());
+
+    // 根任务的帧仍在使用，子任务的帧已全部归还
+    EXPECT_GT(script->frameArena().bytesInUse(), 0u);
+    EXPECT_LE(script->frameArena().bytesReserved(), 4096u);
+}
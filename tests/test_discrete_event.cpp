@@ -0,0 +1,186 @@
+/**
+ * @file test_discrete_event.cpp
+ * @brief 混合离散事件调度单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/state_manager.hpp"
+#include "gnc/core/timing_manager.hpp"
+#include "gnc/components/utility/config_manager.hpp"
+
+using namespace gnc;
+using namespace gnc::states;
+using gnc::core::TimingManagerComponent;
+
+namespace {
+
+const ComponentId TIMING{globalId, "TimingManager"};
+
+// 记录每次更新时看到的仿真时间和步长
+class ClockRecorder : public ComponentBase {
+public:
+    explicit ClockRecorder(VehicleId id) : ComponentBase(id, "ClockRecorder") {
+        declareInput<void>(TIMING);
+    }
+
+    std::string getComponentType() const override { return "ClockRecorder"; }
+
+    std::vector<double> times;
+    std::vector<double> deltas;
+
+protected:
+    void updateImpl() override {
+        times.push_back(getState<double>({TIMING, "timing_current_s"}));
+        deltas.push_back(getState<double>({TIMING, "timing_delta_s"}));
+    }
+};
+
+/**
+ * @brief 以 0.1 s 步长、10 s 时长运行的 StateManager + TimingManager，结束时恢复 core 配置
+ */
+class DiscreteEventTest : public ::testing::Test {
+protected:
+    static constexpr double STEP_S = 0.1;
+
+    void SetUp() override {
+        auto& config_manager = ConfigManager::getInstance();
+        original_ = config_manager.getConfigValue(ConfigFileType::CORE, "core", nlohmann::json::object());
+        nlohmann::json core = original_;
+        core["timing"] = {{"duration_s", 10.0}, {"time_step_s", STEP_S}};
+        config_manager.setConfigValue(ConfigFileType::CORE, "core", core);
+
+        timing_ = new TimingManagerComponent(globalId);
+        manager_.registerComponent(timing_);
+    }
+
+    void TearDown() override {
+        ConfigManager::getInstance().setConfigValue(ConfigFileType::CORE, "core", original_);
+    }
+
+    /**
+     * @brief 与 Simulator 的离散事件循环相同：先安排跳跃，再执行一帧
+     */
+    void frame() {
+        double event_s = 0.0;
+        if (manager_.nextDiscreteEventJump(timing_->getCurrentTime(), event_s)) {
+            timing_->scheduleJumpTo(event_s);
+        }
+        manager_.updateAll();
+    }
+
+    /**
+     * @brief 与 Simulator 对 wake_at_s 的处理相同：登记事件并按下一帧时间唤醒
+     */
+    void wakeAt(VehicleId vehicle, double wake_at_s) {
+        manager_.setWakeCondition(vehicle, [this, wake_at_s]() {
+            return timing_->getNextTime() >= wake_at_s - 1e-9;
+        });
+        manager_.scheduleWakeAt(wake_at_s);
+    }
+
+    double now() const { return manager_.getState<double>({TIMING, "timing_current_s"}); }
+    double delta() const { return manager_.getState<double>({TIMING, "timing_delta_s"}); }
+
+    StateManager manager_;
+    TimingManagerComponent* timing_ = nullptr;
+
+private:
+    nlohmann::json original_;
+};
+
+} // namespace
+
+// 测试没有活动飞行器时跳到最早事件的前一步，下一帧以固定步长到达事件
+TEST_F(DiscreteEventTest, JumpsToStepBeforeEarliestEvent) {
+    manager_.registerComponent(new ClockRecorder(1));
+    manager_.setVehicleActive(1, false);
+    manager_.scheduleWakeAt(5.0);
+    manager_.scheduleWakeAt(3.0);
+    manager_.validateAndSortComponents();
+
+    frame();
+    EXPECT_NEAR(now(), 3.0 - STEP_S, 1e-9);
+    EXPECT_NEAR(delta(), 3.0 - STEP_S, 1e-9);
+
+    frame();
+    EXPECT_NEAR(now(), 3.0, 1e-9);
+    EXPECT_DOUBLE_EQ(delta(), STEP_S);
+
+    frame();
+    EXPECT_NEAR(now(), 5.0 - STEP_S, 1e-9);
+    EXPECT_NEAR(delta(), 5.0 - 3.0 - STEP_S, 1e-9);
+}
+
+// 测试跳跃目标被限制在仿真时长内，最后一帧以固定步长结束
+TEST_F(DiscreteEventTest, ClampsJumpToDuration) {
+    manager_.scheduleWakeAt(50.0);
+    manager_.validateAndSortComponents();
+
+    frame();
+    EXPECT_NEAR(now(), 10.0 - STEP_S, 1e-9);
+    EXPECT_TRUE(manager_.getState<bool>({TIMING, "timing_should_run"}));
+
+    frame();
+    EXPECT_NEAR(now(), 10.0, 1e-9);
+    EXPECT_DOUBLE_EQ(delta(), STEP_S);
+    EXPECT_FALSE(manager_.getState<bool>({TIMING, "timing_should_run"}));
+}
+
+// 测试不超过一个步长的跳跃被忽略
+TEST_F(DiscreteEventTest, IgnoresJumpNoLongerThanOneStep) {
+    manager_.scheduleWakeAt(0.2);
+    manager_.validateAndSortComponents();
+
+    frame();
+    EXPECT_NEAR(now(), STEP_S, 1e-9);
+    EXPECT_DOUBLE_EQ(delta(), STEP_S);
+
+    frame();
+    EXPECT_NEAR(now(), 0.2, 1e-9);
+    EXPECT_DOUBLE_EQ(delta(), STEP_S);
+}
+
+// 测试由 wake_at_s 唤醒的飞行器在第一帧及之后都只看到固定步长
+TEST_F(DiscreteEventTest, WokenVehicleSeesFixedStep) {
+    auto* recorder = new ClockRecorder(1);
+    manager_.registerComponent(recorder);
+    manager_.setVehicleActive(1, false);
+    wakeAt(1, 2.0);
+    manager_.validateAndSortComponents();
+
+    frame();
+    EXPECT_TRUE(recorder->times.empty());
+    EXPECT_NEAR(now(), 2.0 - STEP_S, 1e-9);
+
+    for (int i = 0; i < 3; ++i) {
+        frame();
+    }
+    EXPECT_TRUE(manager_.isVehicleActive(1));
+    ASSERT_EQ(recorder->times.size(), 3u);
+    EXPECT_NEAR(recorder->times.front(), 2.0, 1e-9);
+    for (double dt : recorder->deltas) {
+        EXPECT_DOUBLE_EQ(dt, STEP_S);
+    }
+}
+
+// 测试有非全局飞行器活动时不跳跃，全部休眠后立即跳跃
+TEST_F(DiscreteEventTest, NoJumpWhileVehicleActive) {
+    auto* recorder = new ClockRecorder(1);
+    manager_.registerComponent(recorder);
+    manager_.registerComponent(new ClockRecorder(2));
+    manager_.setVehicleActive(2, false);
+    manager_.scheduleWakeAt(5.0);
+    manager_.validateAndSortComponents();
+
+    for (int i = 0; i < 3; ++i) {
+        frame();
+        EXPECT_DOUBLE_EQ(delta(), STEP_S);
+    }
+    EXPECT_NEAR(now(), 0.3, 1e-9);
+    EXPECT_EQ(recorder->times.size(), 3u);
+
+    manager_.setVehicleActive(1, false);
+    frame();
+    EXPECT_NEAR(now(), 5.0 - STEP_S, 1e-9);
+    EXPECT_EQ(recorder->times.size(), 3u);
+}
@@ -0,0 +1,57 @@
+/**
+ * @file test_disturbance.cpp
+ * @brief 拉偏参数组件单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/state_manager.hpp"
+#include "gnc/components/utility/disturbance.hpp"
+
+using namespace gnc;
+using namespace gnc::states;
+using gnc::components::Disturbance;
+
+namespace {
+
+// 按给定高度序列逐帧输出位置的动力学替身
+class ScriptedDynamics : public ComponentBase {
+public:
+    ScriptedDynamics(VehicleId id, std::vector<double> altitudes)
+        : ComponentBase(id, "Dynamics"), altitudes_(std::move(altitudes)) {
+        declareOutput<Vector3d>("position_truth_m", Vector3d(0.0, 0.0, 0.0));
+    }
+
+    std::string getComponentType() const override { return "ScriptedDynamics"; }
+
+protected:
+    void updateImpl() override {
+        double altitude = altitudes_[std::min(frame_++, altitudes_.size() - 1)];
+        setState("position_truth_m", Vector3d(0.0, 0.0, altitude));
+    }
+
+private:
+    std::vector<double> altitudes_;
+    size_t frame_ = 0;
+};
+
+} // namespace
+
+// 测试基于高度的动态参数随 Dynamics 位置逐帧变化（按上一帧位置计算）
+TEST(DisturbanceTest, AltitudeBasedGainFollowsDynamicsPosition) {
+    StateManager manager;
+    manager.registerComponent(new ScriptedDynamics(1, {60000.0, 20000.0, 5000.0}));
+    manager.registerComponent(new Disturbance(1));
+    manager.validateAndSortComponents();
+
+    const StateId gain{{1, "Disturbance"}, "control_gain_factor"};
+    std::vector<double> gains;
+    for (int i = 0; i < 4; ++i) {
+        manager.updateAll();
+        gains.push_back(manager.getState<double>(gain));
+    }
+
+    EXPECT_DOUBLE_EQ(gains[0], 1.2);   // 初始位置 0 m
+    EXPECT_DOUBLE_EQ(gains[1], 0.8);   // 60000 m
+    EXPECT_DOUBLE_EQ(gains[2], 1.0);   // 20000 m
+    EXPECT_DOUBLE_EQ(gains[3], 1.2);   // 5000 m
+}
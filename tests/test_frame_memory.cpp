@@ -0,0 +1,108 @@
+/**
+ * @file test_frame_memory.cpp
+ * @brief 按帧释放的临时内存单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/frame_memory.hpp"
+#include "gnc/core/state_manager.hpp"
+#include <cstdint>
+#include <thread>
+
+using namespace gnc;
+using namespace gnc::states;
+
+namespace {
+
+bool inRange(const void* pointer, const void* base, std::size_t size) {
+    auto address = reinterpret_cast<std::uintptr_t>(pointer);
+    auto start = reinterpret_cast<std::uintptr_t>(base);
+    return address >= start && address < start + size;
+}
+
+// 每次更新记录开始时本线程的本帧用量，并分配一个临时数组
+class TemporaryUser : public ComponentBase {
+public:
+    explicit TemporaryUser(VehicleId id) : ComponentBase(id, "Temporary") {}
+
+    std::string getComponentType() const override { return "TemporaryUser"; }
+
+    std::vector<std::size_t> bytes_at_start;
+    std::vector<const void*> data;
+
+protected:
+    void updateImpl() override {
+        bytes_at_start.push_back(FrameMemory::local().bytesThisFrame());
+        auto values = frameVector<double>(100);
+        data.push_back(values.data());
+    }
+};
+
+/**
+ * @brief 在新线程中运行，使用全新的线程局部分配区
+ */
+template <typename Body>
+void onFreshThread(Body body) {
+    std::thread thread(body);
+    thread.join();
+}
+
+} // namespace
+
+// 测试本帧分配来自缓冲区，reset() 后从缓冲区起点重新分配
+TEST(FrameMemoryTest, AllocatesFromBufferAndResetsPerFrame) {
+    onFreshThread([] {
+        FrameMemory& memory = FrameMemory::local();
+        const std::size_t capacity = memory.capacity();
+        ASSERT_EQ(capacity, FrameMemory::INITIAL_CAPACITY);
+
+        void* base = memory.allocate(64, 8);
+        void* next = memory.allocate(1024, 16);
+        EXPECT_TRUE(inRange(next, base, capacity));
+        EXPECT_NE(next, base);
+        EXPECT_GE(memory.bytesThisFrame(), 64u + 1024u);
+
+        memory.reset();
+        EXPECT_EQ(memory.bytesThisFrame(), 0u);
+        EXPECT_EQ(memory.capacity(), capacity);
+        EXPECT_EQ(memory.allocate(64, 8), base);
+    });
+}
+
+// 测试缓冲区用尽时向上游申请，下一帧按峰值扩大缓冲区后不再需要上游
+TEST(FrameMemoryTest, FallsBackToUpstreamWhenExhausted) {
+    onFreshThread([] {
+        FrameMemory& memory = FrameMemory::local();
+        const std::size_t capacity = memory.capacity();
+        void* base = memory.allocate(64, 8);
+        const std::size_t large = capacity * 2;
+        void* overflow = memory.allocate(large, 8);
+        EXPECT_FALSE(inRange(overflow, base, capacity));
+        EXPECT_GT(memory.peakBytes(), capacity);
+
+        memory.reset();
+        EXPECT_GE(memory.capacity(), 64u + large);
+        EXPECT_GE(memory.peakBytes(), large);
+        void* grown = memory.allocate(64, 8);
+        EXPECT_TRUE(inRange(memory.allocate(large, 8), grown, memory.capacity()));
+    });
+}
+
+// 测试 StateManager 在每帧开始时回收上一帧的临时内存
+TEST(FrameMemoryTest, StateManagerResetsBetweenFrames) {
+    onFreshThread([] {
+        StateManager manager;
+        auto* user = new TemporaryUser(1);
+        manager.registerComponent(user);
+        for (int i = 0; i < 3; ++i) {
+            manager.updateAll();
+        }
+
+        ASSERT_EQ(user->bytes_at_start.size(), 3u);
+        for (std::size_t bytes : user->bytes_at_start) {
+            EXPECT_EQ(bytes, 0u);
+        }
+        EXPECT_EQ(user->data[1], user->data[0]);
+        EXPECT_EQ(user->data[2], user->data[0]);
+    });
+}
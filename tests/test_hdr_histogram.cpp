@@ -0,0 +1,30 @@
+/**
+ * @file test_hdr_histogram.cpp
+ * @brief HDR直方图单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/hdr_histogram.hpp"
+
+using gnc::HdrHistogram;
+
+TEST(HdrHistogramTest, PercentilesStayWithinRelativePrecision) {
+    HdrHistogram histogram(3'600'000'000ULL, 3);
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value * 1000);
+    }
+
+    EXPECT_EQ(histogram.count(), 10000u);
+    EXPECT_EQ(histogram.min(), 1000u);
+    EXPECT_EQ(histogram.max(), 10'000'000u);
+    EXPECT_NEAR(static_cast<double>(histogram.valueAtPercentile(50)), 5'000'000.0, 5'000'000.0 * 1e-3);
+    EXPECT_NEAR(static_cast<double>(histogram.valueAtPercentile(99)), 9'900'000.0, 9'900'000.0 * 1e-3);
+    EXPECT_EQ(histogram.valueAtPercentile(100), 10'000'000u);
+
+    histogram.record(10'000'000'000ULL);
+    EXPECT_EQ(histogram.max(), 3'600'000'000u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.valueAtPercentile(99), 0u);
+}
@@ -0,0 +1,175 @@
+/**
+ * @file test_input_journal.cpp
+ * @brief 随机数流与输入日志记录/回放单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/input_journal.hpp"
+#include "gnc/core/random_streams.hpp"
+#include <filesystem>
+#include <random>
+
+using namespace gnc;
+using namespace gnc::core;
+using namespace gnc::states;
+
+namespace {
+
+// 随机游走组件：步长由 "gain" 事件设置，perturb_at 帧额外偏移以制造分歧
+class RandomWalkComponent : public ComponentBase {
+public:
+    RandomWalkComponent(VehicleId id, int perturb_at = -1) : ComponentBase(id, "RandomWalk"), perturb_at_(perturb_at) {
+        declareOutput<double>("value", 0.0);
+    }
+
+    std::string getComponentType() const override { return "RandomWalk"; }
+
+    void initialize() override {
+        rng_ = &randomStream("journal_test");
+        subscribeEvent("gain", [this](const nlohmann::json& data) { gain_ = data.get<double>(); });
+    }
+
+protected:
+    void updateImpl() override {
+        value_ += gain_ * std::uniform_real_distribution<double>(-1.0, 1.0)(*rng_);
+        if (++updates_ == perturb_at_) {
+            value_ += 1e-12;
+        }
+        setState("value", value_);
+    }
+
+private:
+    RandomStream* rng_ = nullptr;
+    int perturb_at_;
+    double gain_ = 1.0;
+    double value_ = 0.0;
+    int updates_ = 0;
+};
+
+class CountingComponent : public ComponentBase {
+public:
+    explicit CountingComponent(VehicleId id) : ComponentBase(id, "Counting") {
+        declareOutput<int>("count", 0);
+    }
+
+    std::string getComponentType() const override { return "Counting"; }
+
+    int updates = 0;
+
+protected:
+    void updateImpl() override { setState("count", ++updates); }
+};
+
+/**
+ * @brief 运行 10 帧：live_inputs 时第 4 帧投递事件、第 3 帧帧预算耗尽；返回可卸载组件的更新次数
+ */
+int runFrames(InputJournal& journal, StateManager& manager, bool live_inputs, int perturb_at = -1) {
+    auto* counting = new CountingComponent(2);
+    manager.registerComponent(new RandomWalkComponent(1, perturb_at), 900);
+    manager.registerComponent(counting, 100, true);
+    for (int frame = 0; frame < 10; ++frame) {
+        if (live_inputs && frame == 4) {
+            manager.externalInputs()->postEvent("gain", 3.0);
+        }
+        if (live_inputs && frame == 3) {
+            const auto past = StateManager::BudgetClock::now() - std::chrono::seconds(1);
+            manager.setFrameBudget(past, past);
+        } else if (!journal.replaying()) {
+            manager.clearFrameBudget();
+        }
+        journal.beforeFrame();
+        manager.updateAll();
+        journal.afterFrame();
+    }
+    journal.finish();
+    return counting->updates;
+}
+
+} // namespace
+
+// 测试流种子只取决于主种子和名称，重设主种子后流重新开始
+TEST(InputJournalTest, RandomStreamsAreReproducible) {
+    RandomStreams streams;
+    streams.setMasterSeed(7);
+    auto& stream = streams.stream("journal_seed_test");
+    const uint64_t first = stream();
+    stream();
+    EXPECT_EQ(streams.positions().at("journal_seed_test"), 2u);
+    EXPECT_NE(RandomStreams::deriveSeed(7, "a"), RandomStreams::deriveSeed(7, "b"));
+
+    streams.setMasterSeed(7);
+    EXPECT_EQ(stream.position(), 0u);
+    EXPECT_EQ(stream(), first);
+}
+
+// 测试回放重现事件与卸载结果，并定位状态分歧的帧
+TEST(InputJournalTest, ReplayReproducesRecordedRun) {
+    const std::string path = (std::filesystem::temp_directory_path() / "gnc_journal_test.gncjrnl").string();
+    JournalConfig config;
+    config.file = path;
+
+    config.mode = JournalMode::Record;
+    {
+        StateManager manager;
+        manager.randomStreams()->setMasterSeed(42);
+        InputJournal journal(config, manager, 42);
+        EXPECT_EQ(runFrames(journal, manager, true), 9);
+    }
+
+    config.mode = JournalMode::Replay;
+    {
+        StateManager manager;
+        InputJournal journal(config, manager, 0);
+        EXPECT_EQ(journal.masterSeed(), 42u);
+        manager.randomStreams()->setMasterSeed(journal.masterSeed());
+        EXPECT_EQ(runFrames(journal, manager, false), 9);
+        EXPECT_TRUE(journal.report().passed());
+        EXPECT_EQ(journal.report().compared_frames, 10u);
+    }
+
+    {
+        StateManager manager;
+        InputJournal journal(config, manager, 0);
+        manager.randomStreams()->setMasterSeed(journal.masterSeed());
+        runFrames(journal, manager, false, 7);
+        EXPECT_FALSE(journal.report().passed());
+        EXPECT_EQ(journal.report().first_divergent_frame, 6u);
+        EXPECT_EQ(journal.report().hash_mismatches, 4u);
+        EXPECT_EQ(journal.report().rng_mismatches, 0u);
+    }
+    std::filesystem::remove(path);
+}
+
+// 测试事件订阅随持有者析构解除，队列先析构时订阅失效而不访问已释放的处理函数表
+TEST(InputJournalTest, EventSubscriptionsEndWithTheirOwner) {
+    int calls = 0;
+    const ExternalInputs::Input event{ExternalInputs::Input::Kind::Event, {{"channel", "ping"}, {"data", 1}}};
+    {
+        ExternalInputs inputs;
+        {
+            EventSubscription subscription = inputs.subscribe("ping", [&calls](const nlohmann::json&) { ++calls; });
+            inputs.apply(event);
+        }
+        inputs.apply(event);
+        EXPECT_EQ(calls, 1);
+    }
+
+    EventSubscription outliving;
+    {
+        ExternalInputs inputs;
+        outliving = inputs.subscribe("ping", [&calls](const nlohmann::json&) { ++calls; });
+        EXPECT_TRUE(outliving.active());
+    }
+    EXPECT_FALSE(outliving.active());
+    outliving.release();
+
+    // 每个 StateManager 有自己的队列与随机数流
+    StateManager first;
+    StateManager second;
+    first.randomStreams()->setMasterSeed(3);
+    second.randomStreams()->setMasterSeed(4);
+    EXPECT_EQ(first.randomStreams()->masterSeed(), 3u);
+    first.externalInputs()->postEvent("ping", 2);
+    EXPECT_TRUE(first.externalInputs()->hasPending());
+    EXPECT_FALSE(second.externalInputs()->hasPending());
+}
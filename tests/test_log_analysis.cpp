@@ -0,0 +1,100 @@
+/**
+ * @file test_log_analysis.cpp
+ * @brief 批量后处理单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/components/utility/log_analysis.hpp"
+#include "log_fixtures.hpp"
+#include <cmath>
+#include <filesystem>
+
+using namespace gnc::components::utility;
+
+namespace {
+
+/**
+ * @brief 写一次运行：x = sin(t) + offset，y = cos(t)，z = sin(t)
+ */
+std::string writeRun(const std::string& name, size_t rows, double dt, double offset) {
+    return gnc::test::writeRun(name, rows, dt, {"x", "y", "z"}, [offset](size_t, double t) {
+        return std::vector<std::any>{std::sin(t) + offset, std::cos(t), std::sin(t)};
+    });
+}
+
+} // namespace
+
+// 测试分块并行归约与单块结果一致，表达式、命名表达式和带车辆前缀的列名
+TEST(LogAnalysisTest, ReducesExpressionsPerRun) {
+    const std::vector<std::string> paths = {writeRun("gnc_analysis_a", 10000, 0.01, 0.0),
+                                            writeRun("gnc_analysis_b", 10000, 0.01, 1.0)};
+    RunSet runs = RunSet::open(paths, 2);
+    runs.define("radius", "norm(Plant.z, Plant.y)");
+    const std::vector<ReductionSpec> specs = {
+        ReductionSpec::parse("peak=max:[1.Plant.x]"),
+        ReductionSpec::parse("peak_time=time_of_max:-abs(t - 42.5) + Plant.x * 0"),
+        ReductionSpec::parse("unit=max:abs(radius - 1)"),
+        ReductionSpec::parse("rms=rms:Plant.y"),
+        ReductionSpec::parse("end=final:t"),
+        ReductionSpec::parse("spread=std:2 * Plant.x ^ 2 - -1"),
+    };
+
+    AnalysisOptions options;
+    options.threads = 4;
+    options.chunk_rows = 999;
+    const Matrix chunked = runs.reduce(specs, options);
+    options.threads = 1;
+    options.chunk_rows = 1 << 20;
+    const Matrix single = runs.reduce(specs, options);
+
+    ASSERT_EQ(chunked.rows, 2u);
+    ASSERT_EQ(chunked.cols, specs.size());
+    for (size_t r = 0; r < 2; ++r) {
+        EXPECT_NEAR(chunked(r, 0), 1.0 + static_cast<double>(r), 1e-4);
+        EXPECT_NEAR(chunked(r, 1), 42.5, 1e-9);
+        EXPECT_LT(chunked(r, 2), 1e-12);
+        EXPECT_NEAR(chunked(r, 3), std::sqrt(0.5), 0.01);
+        EXPECT_DOUBLE_EQ(chunked(r, 4), 99.99);
+        for (size_t c = 0; c < specs.size(); ++c) {
+            EXPECT_NEAR(chunked(r, c), single(r, c), 1e-9) << specs[c].name;
+        }
+    }
+    EXPECT_EQ(runs.lastStats().rows, 20000u);
+
+    EXPECT_THROW(runs.reduce({ReductionSpec::parse("bad=max:Plant.w")}), std::runtime_error);
+    EXPECT_THROW(runs.reduce({ReductionSpec::parse("bad=max:sqrt(Plant.x")}), std::invalid_argument);
+    EXPECT_THROW(ReductionSpec::parse("bad=median:Plant.x"), std::invalid_argument);
+
+    for (const auto& path : paths) {
+        std::filesystem::remove(path);
+    }
+}
+
+// 测试不同时间网格的运行插值到公共网格后计算分位数带，超出记录范围的点不参与
+TEST(LogAnalysisTest, ComputesPercentileBandsOnCommonGrid) {
+    const std::vector<std::string> paths = {writeRun("gnc_bands_a", 10000, 0.01, 0.0),
+                                            writeRun("gnc_bands_b", 10000, 0.01, 1.0),
+                                            writeRun("gnc_bands_c", 5000, 0.02, 2.0)};
+    RunSet runs = RunSet::open(paths);
+    AnalysisOptions options;
+    options.chunk_rows = 4096;
+    const SeriesResult series = runs.series("Plant.x", options);
+    ASSERT_EQ(series.times.size(), 10000u);
+    ASSERT_EQ(series.values.rows, 3u);
+
+    const Matrix bands = percentileBands(series, {0.0, 50.0, 100.0}, 4);
+    for (size_t i : {100u, 101u, 7777u}) {
+        const double t = series.times[i];
+        EXPECT_NEAR(bands(0, i), std::sin(t), 1e-12);
+        EXPECT_NEAR(bands(1, i), std::sin(t) + 1.0, 1e-12);
+        EXPECT_NEAR(bands(2, i), std::sin(t) + 2.0, 1e-4);
+    }
+    // 最后一个网格点超出第三次运行的记录范围
+    EXPECT_TRUE(std::isnan(series.values(2, 9999)));
+    EXPECT_NEAR(bands(2, 9999), std::sin(99.99) + 1.0, 1e-12);
+    EXPECT_NEAR(bands(1, 9999), std::sin(99.99) + 0.5, 1e-12);
+
+    for (const auto& path : paths) {
+        std::filesystem::remove(path);
+    }
+}
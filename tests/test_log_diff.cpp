@@ -0,0 +1,115 @@
+/**
+ * @file test_log_diff.cpp
+ * @brief 运行对比单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/components/utility/log_diff.hpp"
+#include "log_fixtures.hpp"
+#include <cmath>
+#include <filesystem>
+
+using namespace gnc::components::utility;
+
+namespace {
+
+/**
+ * @brief 写一份含 x、y、z 三列的二进制日志；从 perturb_from 行起 y 加上 offset，extra 时多一列 w
+ */
+std::string writeRun(const std::string& name, size_t rows, size_t perturb_from, double offset, bool extra = false) {
+    std::vector<std::string> columns = {"x", "y", "z"};
+    if (extra) {
+        columns.push_back("w");
+    }
+    return gnc::test::writeRun(name, rows, 0.01, columns, [=](size_t row, double t) {
+        std::vector<std::any> values = {std::sin(t), std::cos(t) + (row >= perturb_from ? offset : 0.0), t * t};
+        if (extra) {
+            values.push_back(1.0);
+        }
+        return values;
+    });
+}
+
+/**
+ * @brief 写一行日志，每个值一列 Plant.c0、Plant.c1……
+ */
+std::string writeRow(const std::string& name, const std::vector<double>& row) {
+    std::vector<std::string> columns;
+    for (size_t k = 0; k < row.size(); ++k) {
+        columns.push_back("c" + std::to_string(k));
+    }
+    return gnc::test::writeRun(name, 1, 0.0, columns, [&row](size_t, double) {
+        return std::vector<std::any>(row.begin(), row.end());
+    });
+}
+
+} // namespace
+
+// 测试相同运行通过，偏差列报告首次分歧时间与最大误差，容差覆盖按列生效
+TEST(LogDiffTest, ReportsFirstDivergencePerColumn) {
+    const std::string baseline = writeRun("gnc_diff_baseline", 50000, 50000, 0.0);
+    const std::string same = writeRun("gnc_diff_same", 50000, 50000, 0.0);
+    const std::string drifted = writeRun("gnc_diff_drifted", 50000, 30000, 1e-6);
+
+    DiffOptions options;
+    options.threads = 4;
+    const DiffResult identical = diffLogs(baseline, same, options);
+    EXPECT_TRUE(identical.passed());
+    EXPECT_EQ(identical.compared_rows, 50000u);
+    EXPECT_EQ(identical.columns.size(), 3u);
+
+    const DiffResult result = diffLogs(baseline, drifted, options);
+    EXPECT_FALSE(result.passed());
+    ASSERT_NE(result.firstDivergence(), nullptr);
+    EXPECT_EQ(result.firstDivergence()->name, "1.Plant.y");
+    EXPECT_EQ(result.firstDivergence()->mismatches, 20000u);
+    EXPECT_NEAR(result.firstDivergence()->first_divergence_time, 300.0, 1e-9);
+    EXPECT_NEAR(result.firstDivergence()->max_abs_error, 1e-6, 1e-9);
+
+    options.overrides.push_back({"Plant\\.y$", 1e-5, 0.0});
+    EXPECT_TRUE(diffLogs(baseline, drifted, options).passed());
+
+    for (const auto& path : {baseline, same, drifted}) {
+        std::filesystem::remove(path);
+    }
+}
+
+// 测试只在一份日志中出现的列和行
+TEST(LogDiffTest, ReportsMissingColumnsAndRows) {
+    const std::string baseline = writeRun("gnc_diff_short", 100, 100, 0.0);
+    const std::string longer = writeRun("gnc_diff_long", 120, 120, 0.0, true);
+
+    DiffOptions options;
+    DiffResult result = diffLogs(baseline, longer, options);
+    EXPECT_FALSE(result.passed());
+    EXPECT_EQ(result.only_in_b, std::vector<std::string>{"1.Plant.w"});
+    EXPECT_EQ(result.compared_rows, 100u);
+    EXPECT_EQ(result.rows_only_b, 20u);
+
+    options.allow_missing = true;
+    EXPECT_TRUE(diffLogs(baseline, longer, options).passed());
+
+    std::filesystem::remove(baseline);
+    std::filesystem::remove(longer);
+}
+
+// 测试非有限值不经容差比较：inf 只与同号 inf 相同，NaN 只与 NaN 相同
+TEST(LogDiffTest, NonFiniteValuesMatchOnlyThemselves) {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    const std::string a = writeRow("gnc_diff_nonfinite_a", {inf, inf, nan, 1.0, inf, nan, -inf});
+    const std::string b = writeRow("gnc_diff_nonfinite_b", {1.0, -inf, 1.0, nan, inf, nan, -inf});
+
+    DiffOptions options;
+    options.rel_tolerance = 1e-3;
+    const DiffResult result = diffLogs(a, b, options);
+    ASSERT_EQ(result.columns.size(), 7u);
+    const std::vector<uint64_t> expected = {1, 1, 1, 1, 0, 0, 0};
+    for (size_t k = 0; k < expected.size(); ++k) {
+        EXPECT_EQ(result.columns[k].mismatches, expected[k]) << result.columns[k].name;
+    }
+    EXPECT_FALSE(result.passed());
+
+    std::filesystem::remove(a);
+    std::filesystem::remove(b);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_metrics.cpp
+ * @brief 运行指标单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/metrics.hpp"
+#include "gnc/core/state_manager.hpp"
+#include "gnc/coordination/coordinate_system_registry.hpp"
+#include <filesystem>
+#include <sstream>
+#include <thread>
+
+using namespace gnc;
+
+namespace {
+
+class TickComponent : public ComponentBase {
+public:
+    explicit TickComponent(VehicleId id) : ComponentBase(id, "Tick") {
+        declareOutput<int>("ticks", 0);
+    }
+
+    std::string getComponentType() const override { return "Tick"; }
+
+protected:
+    void updateImpl() override {
+        setState("ticks", getState<int>("ticks") + 1);
+    }
+};
+
+} // namespace
+
+// 测试记录线程与导出线程并发时，区间切换不丢失也不重复计数
+TEST(MetricsTest, HistogramRotationKeepsEveryRecord) {
+    MetricsHistogram histogram(1'000'000);
+    constexpr uint64_t RECORDS = 200000;
+    std::thread writer([&histogram]() {
+        for (uint64_t i = 0; i < RECORDS; ++i) {
+            histogram.record(i % 1000 + 1);
+        }
+    });
+    uint64_t rotated = 0;
+    for (int i = 0; i < 50; ++i) {
+        histogram.rotate();
+        rotated += histogram.interval().count();
+    }
+    writer.join();
+    histogram.rotate();
+    rotated += histogram.interval().count();
+
+    EXPECT_EQ(rotated, RECORDS);
+    EXPECT_EQ(histogram.cumulative().count(), RECORDS);
+    EXPECT_EQ(histogram.cumulative().max(), 1000u);
+}
+
+TEST(MetricsTest, PrometheusOutputGroupsLabelledSeries) {
+    auto& metrics = MetricsRegistry::getInstance();
+    metrics.counter("test_events_total", "Events", {{"source", "a"}}).add(3);
+    metrics.gauge("test_level", "Level").set(2.5);
+    auto& latency = metrics.histogram("test_latency_ns", "Latency", {{"source", "a"}});
+    latency.record(100);
+    latency.record(300);
+    metrics.counter("test_events_total", "Events", {{"source", "b"}}).add();
+    EXPECT_EQ(metrics.counter("test_events_total", "Events", {{"source", "a"}}).value(), 3u);
+
+    std::ostringstream out;
+    metrics.writePrometheus(out);
+    const std::string text = out.str();
+    EXPECT_NE(text.find("test_events_total{source=\"a\"} 3\ntest_events_total{source=\"b\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE test_level gauge\ntest_level 2.5\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ns{source=\"a\",quantile=\"0.5\"} 100\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ns_count{source=\"a\"} 2\n"), std::string::npos);
+    EXPECT_THROW(metrics.gauge("test_events_total", "Events", {{"source", "a"}}), std::invalid_argument);
+}
+
+// 测试组件更新耗时默认按类型汇总，per_instance 时每个实例一个序列
+TEST(MetricsTest, ComponentUpdateTimeIsAggregatedPerType) {
+    auto& metrics = MetricsRegistry::getInstance();
+    auto count_of = [&metrics](const std::string& series) {
+        std::ostringstream out;
+        metrics.writePrometheus(out);
+        const std::string text = out.str();
+        const std::string prefix = "gnc_component_update_ns_count" + series + " ";
+        const size_t at = text.find(prefix);
+        return at == std::string::npos ? -1 : std::stol(text.substr(at + prefix.size()));
+    };
+
+    StateManager manager;
+    for (VehicleId id = 1; id <= 3; ++id) {
+        manager.registerComponent(new TickComponent(id));
+    }
+    manager.validateAndSortComponents();
+    manager.setMetrics(&metrics);
+    manager.updateAll();
+    manager.updateAll();
+    EXPECT_EQ(count_of("{type=\"Tick\"}"), 6);
+    EXPECT_EQ(count_of("{vehicle=\"1\",component=\"Tick\",type=\"Tick\"}"), -1);
+
+    manager.setMetrics(&metrics, {}, true, true);
+    manager.updateAll();
+    EXPECT_EQ(count_of("{vehicle=\"1\",component=\"Tick\",type=\"Tick\"}"), 1);
+    manager.setMetrics(nullptr);
+}
+
+// 测试变换缓存的命中/未命中计数只在导出指标时累加
+TEST(MetricsTest, TransformCacheCountsOnlyWhileExporting) {
+    auto& metrics = MetricsRegistry::getInstance();
+    auto& hits = metrics.counter("gnc_transform_cache_hits_total", "Coordinate transform cache hits");
+    auto& misses = metrics.counter("gnc_transform_cache_misses_total", "Coordinate transform cache misses");
+    const uint64_t hits_before = hits.value();
+    const uint64_t misses_before = misses.value();
+
+    gnc::coordination::CoordinateSystemRegistry registry;
+    registry.addStaticTransform("BODY", "NED", Transform::Identity());
+    ASSERT_FALSE(MetricsRegistry::enabled());
+    registry.getTransform("BODY", "NED");
+    registry.getTransform("BODY", "NED");
+    EXPECT_EQ(hits.value(), hits_before);
+    EXPECT_EQ(misses.value(), misses_before);
+
+    MetricsConfig config;
+    config.enabled = true;
+    config.file = (std::filesystem::temp_directory_path() / "gnc_metrics_transform_cache.prom").string();
+    config.interval_s = 3600.0;
+    metrics.start(config);
+    EXPECT_TRUE(MetricsRegistry::enabled());
+    registry.getTransform("BODY", "NED");
+    registry.getTransform("NED", "BODY");
+    metrics.stop();
+    EXPECT_FALSE(MetricsRegistry::enabled());
+
+    EXPECT_EQ(hits.value(), hits_before + 1);
+    EXPECT_EQ(misses.value(), misses_before + 1);
+    std::filesystem::remove(config.file);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_multi_fidelity_dynamics.cpp
+ * @brief 多保真度动力学单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/state_manager.hpp"
+#include "gnc/components/dynamics/multi_fidelity_dynamics.hpp"
+
+using namespace gnc;
+using namespace gnc::states;
+using gnc::components::FidelityLevel;
+using gnc::components::MultiFidelityDynamics;
+using gnc::components::utility::ConfigFileType;
+using gnc::components::utility::ConfigManager;
+
+namespace {
+
+// 固定步长 0.1 s 的时间源
+class FakeTiming : public ComponentBase {
+public:
+    FakeTiming() : ComponentBase(globalId, "TimingManager") {
+        declareOutput<double>("timing_delta_s", 0.1);
+    }
+
+    std::string getComponentType() const override { return "FakeTiming"; }
+
+protected:
+    void updateImpl() override {}
+};
+
+// 占位组件：满足动力学组件声明的依赖
+class Placeholder : public ComponentBase {
+public:
+    Placeholder(VehicleId id, const std::string& name) : ComponentBase(id, name) {}
+
+    std::string getComponentType() const override { return "Placeholder"; }
+
+protected:
+    void updateImpl() override {}
+};
+
+/**
+ * @brief 注册时间源、占位依赖和 vehicles 架飞行器的多保真度动力学
+ */
+std::vector<MultiFidelityDynamics*> buildVehicles(StateManager& manager, VehicleId vehicles) {
+    manager.registerComponent(new FakeTiming());
+    manager.registerComponent(new Placeholder(globalId, "CoordinationInitializer"));
+    std::vector<MultiFidelityDynamics*> dynamics;
+    for (VehicleId id = 1; id <= vehicles; ++id) {
+        dynamics.push_back(new MultiFidelityDynamics(id));
+        manager.registerComponent(dynamics.back());
+    }
+    return dynamics;
+}
+
+void configure(const nlohmann::json& config) {
+    ConfigManager::getInstance().setConfigValue(ConfigFileType::DYNAMICS, "dynamics.multi_fidelity", config);
+}
+
+} // namespace
+
+// 测试 3-DOF↔6-DOF 切换前后位置、速度和姿态连续
+TEST(MultiFidelityDynamicsTest, HandOffKeepsStateContinuous) {
+    // 沿 (0.6, 0.8, 0) 方向以 100 m/s 飞过 1000 m 处的兴趣点，每帧 10 m
+    configure({{"initial_position", {0.0, 0.0, 0.0}},
+               {"initial_velocity", {60.0, 80.0, 0.0}},
+               {"points_of_interest", {{600.0, 800.0, 0.0}}},
+               {"promote_distance_m", 295.0},
+               {"demote_distance_m", 405.0},
+               {"min_dwell_steps", 10}});
+    StateManager manager;
+    auto* dynamics = buildVehicles(manager, 1).front();
+    manager.validateAndSortComponents();
+
+    const StateId position{{1, "Dynamics"}, "position_truth_m"};
+    const StateId velocity{{1, "Dynamics"}, "velocity_truth_mps"};
+    const StateId attitude{{1, "Dynamics"}, "attitude_truth_quat"};
+    const Vector3d v0(60.0, 80.0, 0.0);
+    const Quaterniond aligned = Quaterniond::FromTwoVectors(Vector3d::UnitX(), v0.normalized());
+
+    std::vector<int> levels;
+    for (int frame = 1; frame <= 200; ++frame) {
+        manager.updateAll();
+        levels.push_back(manager.getState<int>({{1, "Dynamics"}, "fidelity_level"}));
+        EXPECT_LT((manager.getState<Vector3d>(position) - v0 * 0.1 * frame).norm(), 1e-9) << "frame " << frame;
+        EXPECT_LT((manager.getState<Vector3d>(velocity) - v0).norm(), 1e-12) << "frame " << frame;
+        EXPECT_LT(manager.getState<Quaterniond>(attitude).angularDistance(aligned), 1e-12) << "frame " << frame;
+        EXPECT_LT(manager.getState<Vector3d>({{1, "Dynamics"}, "angular_rate_body_radps"}).norm(), 1e-12);
+    }
+
+    // 第 k 帧按上一帧末的路程 10(k-1) m 判断：k = 72（710 m）升级，k = 142（1410 m）降级
+    EXPECT_EQ(levels[70], 3);
+    EXPECT_EQ(levels[71], 6);
+    EXPECT_EQ(levels[140], 6);
+    EXPECT_EQ(levels[141], 3);
+    const auto& stats = dynamics->getStatistics();
+    EXPECT_EQ(stats.promotions, 1u);
+    EXPECT_EQ(stats.demotions, 1u);
+    EXPECT_EQ(stats.steps_6dof, 70u);
+    EXPECT_EQ(stats.totalSteps(), 200u);
+}
+
+// 测试步数占比按运行统计：同一进程中的两次运行互不影响；被记录的飞行器以 6-DOF 运行，
+// 相互引用的邻近条件不形成依赖环
+TEST(MultiFidelityDynamicsTest, FractionsAreReportedPerRun) {
+    configure({{"initial_velocity", {100.0, 0.0, 0.0}},
+               {"promote_distance_m", 1.0},
+               {"proximity_vehicles", {1, 2}},
+               {"promote_when_logged", true}});
+
+    StateManager first;
+    auto first_vehicles = buildVehicles(first, 2);
+    first.validateAndSortComponents();
+    for (int frame = 0; frame < 10; ++frame) {
+        first.updateAll();
+    }
+    // 两架飞行器同一起点、同一速度，始终相邻
+    EXPECT_EQ(first_vehicles[0]->getFidelityLevel(), FidelityLevel::RigidBody6DoF);
+    EXPECT_EQ(first_vehicles[1]->getFidelityLevel(), FidelityLevel::RigidBody6DoF);
+    EXPECT_EQ(first_vehicles[0]->getRunStatistics().totalSteps(), 20u);
+
+    configure({{"initial_velocity", {100.0, 0.0, 0.0}}, {"promote_when_logged", true}});
+    StateManager second;
+    auto second_vehicles = buildVehicles(second, 2);
+    second.validateAndSortComponents();
+    second.markStateLogged({{1, "Dynamics"}, "position_truth_m"});
+    for (int frame = 0; frame < 4; ++frame) {
+        second.updateAll();
+    }
+    EXPECT_EQ(second_vehicles[0]->getFidelityLevel(), FidelityLevel::RigidBody6DoF);
+    EXPECT_EQ(second_vehicles[1]->getFidelityLevel(), FidelityLevel::PointMass3DoF);
+
+    const auto run = second_vehicles[1]->getRunStatistics();
+    EXPECT_EQ(run.totalSteps(), 8u);
+    EXPECT_DOUBLE_EQ(run.fraction6DoF(), 0.5);
+    EXPECT_EQ(*second.runCounter("MultiFidelityDynamics.steps_3dof"), 4);
+    EXPECT_EQ(first_vehicles[0]->getRunStatistics().totalSteps(), 20u);
+    EXPECT_DOUBLE_EQ(first_vehicles[0]->getRunStatistics().fraction6DoF(), 1.0);
+}
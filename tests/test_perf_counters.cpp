@@ -0,0 +1,137 @@
+/**
+ * @file test_perf_counters.cpp
+ * @brief 硬件性能计数器单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/perf_counters.hpp"
+#include "gnc/core/state_manager.hpp"
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstddef>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace gnc;
+using namespace gnc::states;
+
+namespace {
+
+// 每次更新做少量整数运算，保证有指令可计
+class BusyComponent : public ComponentBase {
+public:
+    explicit BusyComponent(VehicleId id) : ComponentBase(id, "Busy") {}
+
+    std::string getComponentType() const override { return "BusyComponent"; }
+
+    volatile uint64_t sum = 0;
+
+protected:
+    void updateImpl() override {
+        for (uint64_t i = 0; i < 10000; ++i) {
+            sum = sum + i * i;
+        }
+    }
+};
+
+#ifdef __linux__
+/**
+ * @brief 对调用线程安装 seccomp 过滤器，使 perf_event_open 返回 EACCES
+ * @details 过滤器只作用于当前线程，线程结束后即失效
+ */
+bool denyPerfEventOpen() {
+    sock_filter filter[] = {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, SYS_perf_event_open, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | (EACCES & SECCOMP_RET_DATA)),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+    };
+    sock_fprog program{static_cast<unsigned short>(sizeof(filter) / sizeof(filter[0])), filter};
+    return prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == 0 &&
+           prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &program) == 0;
+}
+#endif
+
+} // namespace
+
+// 测试未打开的计数器：读取为零、汇总只有表头，不会访问无效描述符
+TEST(PerfCountersTest, UnopenedProfilerDegradesGracefully) {
+    PerfCounterProfiler profiler;
+    EXPECT_FALSE(profiler.available());
+    for (size_t i = 0; i < PerfCounterProfiler::COUNTER_COUNT; ++i) {
+        EXPECT_FALSE(profiler.counterAvailable(static_cast<PerfCounterProfiler::Counter>(i)));
+        EXPECT_EQ(profiler.read()[i], 0u);
+    }
+    EXPECT_FALSE(profiler.multiplexed());
+
+    std::ostringstream summary;
+    profiler.writeSummary(summary);
+    EXPECT_NE(summary.str().find("component type"), std::string::npos);
+    EXPECT_EQ(summary.str().find('\n'), summary.str().size() - 1);
+}
+
+#ifdef __linux__
+// 测试内核拒绝 perf_event_open（EACCES）时 open() 返回 false，对象保持不可用
+TEST(PerfCountersTest, OpenFailsGracefullyWhenKernelDenies) {
+    bool filtered = false;
+    bool opened = true;
+    bool available = true;
+    PerfCounterProfiler::Sample sample{};
+    sample.fill(1);
+    std::thread thread([&] {
+        filtered = denyPerfEventOpen();
+        if (!filtered) {
+            return;
+        }
+        PerfCounterProfiler profiler;
+        opened = profiler.open();
+        available = profiler.available();
+        sample = profiler.read();
+    });
+    thread.join();
+    if (!filtered) {
+        GTEST_SKIP() << "seccomp filters are not available";
+    }
+
+    EXPECT_FALSE(opened);
+    EXPECT_FALSE(available);
+    for (uint64_t value : sample) {
+        EXPECT_EQ(value, 0u);
+    }
+}
+#endif
+
+// 测试计数器可用时 StateManager 按组件类型累计每次更新的计数
+TEST(PerfCountersTest, CountsComponentUpdatesWhenAvailable) {
+    PerfCounterProfiler profiler;
+    if (!profiler.open()) {
+        GTEST_SKIP() << "hardware performance counters are not available";
+    }
+    ASSERT_TRUE(profiler.available());
+    ASSERT_TRUE(profiler.counterAvailable(PerfCounterProfiler::Cycles));
+
+    StateManager manager;
+    manager.registerComponent(new BusyComponent(1));
+    manager.setPerfProfiler(&profiler);
+    for (int i = 0; i < 5; ++i) {
+        manager.updateAll();
+    }
+
+    const PerfCounterProfiler::Totals* totals = profiler.totalsFor("BusyComponent");
+    EXPECT_EQ(totals->updates, 5u);
+    EXPECT_GT(totals->values[PerfCounterProfiler::Cycles], 0u);
+    if (profiler.counterAvailable(PerfCounterProfiler::Instructions)) {
+        EXPECT_GT(totals->values[PerfCounterProfiler::Instructions], 5u * 10000u);
+    }
+
+    std::ostringstream summary;
+    profiler.writeSummary(summary);
+    EXPECT_NE(summary.str().find("BusyComponent"), std::string::npos);
+    manager.setPerfProfiler(nullptr);
+}
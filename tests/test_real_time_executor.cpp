@@ -0,0 +1,121 @@
+/**
+ * @file test_real_time_executor.cpp
+ * @brief 实时执行器超时处理单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/real_time_executor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace gnc;
+using namespace gnc::core;
+using namespace gnc::states;
+
+namespace {
+
+// 运行 frames 帧后请求停止，并记录每帧开始时 StateManager 的优先级下限
+class FrameClock : public ComponentBase {
+public:
+    FrameClock(const StateManager& manager, int frames)
+        : ComponentBase(globalId, "Clock"), manager_(manager), frames_(frames) {
+        declareOutput<bool>("should_run", true);
+    }
+
+    std::string getComponentType() const override { return "FrameClock"; }
+
+    std::vector<int> floors;
+
+protected:
+    void updateImpl() override {
+        floors.push_back(manager_.getPriorityFloor());
+        setState("should_run", static_cast<int>(floors.size()) < frames_);
+    }
+
+private:
+    const StateManager& manager_;
+    int frames_;
+};
+
+// 在指定帧（从 1 开始）睡眠 sleep，使该帧超过截止时间
+class SlowComponent : public ComponentBase {
+public:
+    SlowComponent(std::vector<int> slow_frames, std::chrono::milliseconds sleep)
+        : ComponentBase(1, "Slow"), slow_frames_(std::move(slow_frames)), sleep_(sleep) {}
+
+    std::string getComponentType() const override { return "Slow"; }
+
+protected:
+    void updateImpl() override {
+        ++frame_;
+        if (std::find(slow_frames_.begin(), slow_frames_.end(), frame_) != slow_frames_.end()) {
+            std::this_thread::sleep_for(sleep_);
+        }
+    }
+
+private:
+    std::vector<int> slow_frames_;
+    std::chrono::milliseconds sleep_;
+    int frame_ = 0;
+};
+
+// 记录类组件：统计实际执行的帧数
+class LoggingComponent : public ComponentBase {
+public:
+    LoggingComponent() : ComponentBase(1, "Logging") {}
+
+    std::string getComponentType() const override { return "Logging"; }
+
+    int updates = 0;
+
+protected:
+    void updateImpl() override { ++updates; }
+};
+
+} // namespace
+
+// 测试连续两帧超时后下两帧提高优先级下限、跳过记录组件，按时完成一帧后下限恢复
+TEST(RealTimeExecutorTest, OverrunsRaiseAndRestorePriorityFloor) {
+    StateManager manager;
+    auto* clock = new FrameClock(manager, 6);
+    auto* logging = new LoggingComponent();
+    manager.registerComponent(clock, 1000);
+    manager.registerComponent(new SlowComponent({2, 3}, std::chrono::milliseconds(80)), 900);
+    manager.registerComponent(logging, 100);
+    manager.validateAndSortComponents();
+
+    RealTimeConfig config;
+    config.overrun_policy = OverrunPolicy::SkipLogging;
+    config.logging_priority = 100;
+    config.load_shedding = false;
+    RealTimeExecutor executor(manager, manager.getStateHandle<bool>({{globalId, "Clock"}, "should_run"}), 0.02, config);
+    const auto& stats = executor.run();
+
+    EXPECT_EQ(stats.frames, 6u);
+    EXPECT_EQ(stats.deadline_misses, 2u);
+    EXPECT_EQ(stats.degraded_frames, 2u);
+    EXPECT_FALSE(stats.aborted);
+    EXPECT_EQ(clock->floors, (std::vector<int>{0, 0, 101, 101, 0, 0}));
+    EXPECT_EQ(logging->updates, 4);
+    EXPECT_EQ(manager.getPriorityFloor(), 0);
+}
+
+// 测试 Abort 策略在连续超时达到上限后终止运行，且不降级
+TEST(RealTimeExecutorTest, AbortStopsAfterConsecutiveOverruns) {
+    StateManager manager;
+    manager.registerComponent(new FrameClock(manager, 10), 1000);
+    manager.registerComponent(new SlowComponent({1, 2, 3}, std::chrono::milliseconds(80)), 900);
+    manager.validateAndSortComponents();
+
+    RealTimeConfig config;
+    config.overrun_policy = OverrunPolicy::Abort;
+    config.max_consecutive_overruns = 2;
+    config.load_shedding = false;
+    RealTimeExecutor executor(manager, manager.getStateHandle<bool>({{globalId, "Clock"}, "should_run"}), 0.02, config);
+    const auto& stats = executor.run();
+
+    EXPECT_TRUE(stats.aborted);
+    EXPECT_EQ(stats.frames, 2u);
+    EXPECT_EQ(stats.degraded_frames, 0u);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_replay_harness.cpp
+ * @brief 日志读取与组件回放单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/replay_harness.hpp"
+#include "gnc/core/component_factory.hpp"
+#include "gnc/components/utility/binary_writer.hpp"
+#include "math/math.hpp"
+#include <filesystem>
+
+using namespace gnc::core;
+using gnc::components::utility::BinaryWriter;
+using gnc::components::utility::ColumnInfo;
+using gnc::components::utility::RecordedLog;
+using gnc::states::StateId;
+
+namespace {
+
+/**
+ * @brief 读取 Source.value 与 Source.offset，输出 value 的两倍与平移后的向量
+ */
+class ReplayTestComponent : public gnc::states::ComponentBase {
+public:
+    ReplayTestComponent(gnc::states::VehicleId id, const std::string& instanceName)
+        : ComponentBase(id, "ReplayTest", instanceName) {
+        declareInput<double>(StateId{{id, "Source"}, "value"});
+        declareInput<Vector3d>(StateId{{id, "Source"}, "offset"});
+        declareOutput<double>("doubled");
+        declareOutput<Vector3d>("shifted");
+    }
+
+    std::string getComponentType() const override { return "ReplayTest"; }
+
+protected:
+    void updateImpl() override {
+        const double value = getState<double>(StateId{{getVehicleId(), "Source"}, "value"});
+        const auto& offset = getState<Vector3d>(StateId{{getVehicleId(), "Source"}, "offset"});
+        setState("doubled", 2.0 * value);
+        setState("shifted", Vector3d(offset + Vector3d::Constant(value)));
+    }
+};
+
+/**
+ * @brief 按 DataLogger 的列布局写一份二进制日志，corrupt_frame 行的 doubled 写入错误值
+ */
+std::string writeRecording(size_t frames, size_t corrupt_frame) {
+    const gnc::states::ComponentId source{1, "Source"};
+    const gnc::states::ComponentId hosted{1, "ReplayTest"};
+    const std::vector<ColumnInfo> columns = {
+        {{source, "value"}, typeid(double).name(), 0},
+        {{source, "offset"}, typeid(Vector3d).name(), 0},
+        {{source, "offset"}, typeid(Vector3d).name(), 1},
+        {{source, "offset"}, typeid(Vector3d).name(), 2},
+        {{hosted, "doubled"}, typeid(double).name(), 0},
+        {{hosted, "shifted"}, typeid(Vector3d).name(), 0},
+        {{hosted, "shifted"}, typeid(Vector3d).name(), 1},
+        {{hosted, "shifted"}, typeid(Vector3d).name(), 2},
+    };
+    std::vector<StateId> states;
+    for (const auto& column : columns) {
+        states.push_back({column.source.component, column.source.component.name + "." + column.source.name});
+    }
+
+    BinaryWriter writer;
+    writer.describeColumns(columns);
+    writer.initialize((std::filesystem::temp_directory_path() / "gnc_replay_test.gnclog").string(), states, false);
+    for (size_t frame = 0; frame < frames; ++frame) {
+        const double value = 0.5 * static_cast<double>(frame);
+        const Vector3d offset(1.0, -2.0, static_cast<double>(frame));
+        const Vector3d shifted = offset + Vector3d::Constant(value);
+        writer.writeDataPoint(0.01 * static_cast<double>(frame), {
+            value, offset.x(), offset.y(), offset.z(),
+            frame == corrupt_frame ? 2.0 * value + 1.0 : 2.0 * value,
+            shifted.x(), shifted.y(), shifted.z(),
+        });
+    }
+    writer.finalize();
+    return writer.filePath();
+}
+
+void registerReplayTestComponent() {
+    gnc::ComponentFactory::getInstance().registerCreator("ReplayTest",
+        [](gnc::states::VehicleId id, const std::string& instanceName) -> gnc::states::ComponentBase* {
+            return new ReplayTestComponent(id, instanceName);
+        });
+}
+
+} // namespace
+
+// 测试二进制日志读回后保留状态、类型与分量序号
+TEST(ReplayHarnessTest, ReadsBinaryLogColumns) {
+    const std::string path = writeRecording(5, 5);
+    const RecordedLog log = RecordedLog::load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(log.rows(), 5u);
+    EXPECT_DOUBLE_EQ(log.times()[4], 0.04);
+    const auto offset = log.findState(1, "Source", "offset");
+    ASSERT_EQ(offset.size(), 3u);
+    EXPECT_EQ(log.columns()[offset[2]].type_name, typeid(Vector3d).name());
+    EXPECT_EQ(log.columns()[offset[2]].index, 2);
+    EXPECT_DOUBLE_EQ(log.value(3, offset[2]), 3.0);
+    EXPECT_TRUE(log.findState(2, "Source", "offset").empty());
+    EXPECT_EQ(log.statesOf(1, "ReplayTest"), (std::vector<std::string>{"doubled", "shifted"}));
+}
+
+// 测试回放组件的输出与记录一致，并能定位记录中被篡改的帧
+TEST(ReplayHarnessTest, ComparesHostedOutputsWithRecording) {
+    registerReplayTestComponent();
+    ReplayConfig config;
+    config.components.push_back(ComponentSpec{"ReplayTest", "", 500, false});
+    config.repeat = 2;
+
+    const std::string path = writeRecording(20, 7);
+    const RecordedLog log = RecordedLog::load(path);
+    std::filesystem::remove(path);
+    const ReplayResult result = ReplayHarness(config, log).run();
+
+    EXPECT_EQ(result.frames, 40u);
+    EXPECT_EQ(result.hosted_components, 1u);
+    ASSERT_EQ(result.comparisons.size(), 2u);
+    EXPECT_FALSE(result.passed());
+    for (const auto& comparison : result.comparisons) {
+        if (comparison.state.name == "doubled") {
+            EXPECT_EQ(comparison.samples, 20u);
+            EXPECT_EQ(comparison.mismatches, 1u);
+            EXPECT_EQ(comparison.first_mismatch_frame, 7u);
+            EXPECT_DOUBLE_EQ(comparison.max_abs_error, 1.0);
+        } else {
+            EXPECT_EQ(comparison.state.name, "shifted");
+            EXPECT_EQ(comparison.samples, 60u);
+            EXPECT_TRUE(comparison.passed());
+        }
+    }
+}
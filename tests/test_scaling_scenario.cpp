@@ -0,0 +1,93 @@
+/**
+ * @file test_scaling_scenario.cpp
+ * @brief 合成扩展性场景生成单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/scaling_scenario.hpp"
+#include "gnc/core/component_factory.hpp"
+#include "gnc/components/utility/config_manager.hpp"
+#include <set>
+#include <thread>
+
+using namespace gnc::core;
+
+// 测试生成的依赖图只指向编号更小的组件，遵守 fan_in/fan_out 限制，且同一种子结果相同
+TEST(ScalingScenarioTest, GeneratesAcyclicGraphWithinLimits) {
+    ScalingScenarioConfig config;
+    config.vehicles = 4;
+    config.components_per_vehicle = 30;
+    config.fan_in = 3;
+    config.fan_out = 4;
+    config.outputs_per_component = 2;
+    config.cross_vehicle_reads = 2;
+    config.seed = 42;
+
+    const ScalingScenario scenario(config);
+    const auto& components = scenario.layout().components;
+    ASSERT_EQ(components.size(), 30u);
+    EXPECT_TRUE(components[0].inputs.empty());
+
+    std::vector<size_t> consumers(components.size(), 0);
+    for (size_t k = 0; k < components.size(); ++k) {
+        std::set<std::pair<size_t, bool>> seen;
+        size_t local = 0;
+        for (const auto& input : components[k].inputs) {
+            EXPECT_LT(input.component, k);
+            EXPECT_LT(input.output, config.outputs_per_component);
+            EXPECT_TRUE(seen.insert({input.component, input.next_vehicle}).second);
+            if (!input.next_vehicle) {
+                ++local;
+                ++consumers[input.component];
+            }
+        }
+        EXPECT_EQ(local, std::min<size_t>(k, config.fan_in));
+    }
+    // 前几个组件的候选不足时可以超出 fan_out，之后应全部在上限以内
+    for (size_t c = 10; c < consumers.size(); ++c) {
+        EXPECT_LE(consumers[c], config.fan_out);
+    }
+
+    const ScalingScenario again(config);
+    for (size_t k = 0; k < components.size(); ++k) {
+        ASSERT_EQ(again.layout().components[k].inputs.size(), components[k].inputs.size());
+        for (size_t i = 0; i < components[k].inputs.size(); ++i) {
+            EXPECT_EQ(again.layout().components[k].inputs[i].component, components[k].inputs[i].component);
+        }
+    }
+
+    const auto core = scenario.coreConfig();
+    EXPECT_EQ(core["vehicle_templates"]["synthetic"]["components"].size(), 30u);
+    EXPECT_EQ(core["vehicles"][1]["id_range"][1].get<size_t>(), 4u);
+}
+
+// 测试 run() 结束后恢复原有的 core 配置并注销场景的合成组件类型，多个场景可在不同线程上调用
+TEST(ScalingScenarioTest, RunRestoresGlobalConfig) {
+    using gnc::components::utility::ConfigFileType;
+    using gnc::components::utility::ConfigManager;
+    auto& config_manager = ConfigManager::getInstance();
+    const nlohmann::json original = config_manager.getConfigValue(ConfigFileType::CORE, "core", nlohmann::json::object());
+    const nlohmann::json installed = {{"marker", "not a scaling scenario"}};
+    config_manager.setConfigValue(ConfigFileType::CORE, "core", installed);
+
+    ScalingScenarioConfig config;
+    config.vehicles = 2;
+    config.components_per_vehicle = 4;
+    config.frames = 5;
+    const ScalingScenario first(config);
+    config.seed = 2;
+    const ScalingScenario second(config);
+    EXPECT_NE(first.componentType(), second.componentType());
+
+    ScalingResult first_result, second_result;
+    std::thread other([&]() { second_result = second.run(); });
+    first_result = first.run();
+    other.join();
+
+    EXPECT_EQ(first_result.run.steps, 5u);
+    EXPECT_EQ(second_result.run.steps, 5u);
+    EXPECT_EQ(config_manager.getConfigValue(ConfigFileType::CORE, "core", nlohmann::json()), installed);
+    EXPECT_THROW(gnc::ComponentFactory::getInstance().createComponent(first.componentType(), 1, "Syn0"),
+                 gnc::ConfigurationError);
+    config_manager.setConfigValue(ConfigFileType::CORE, "core", original);
+}
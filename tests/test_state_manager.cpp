@@ -0,0 +1,568 @@
+/**
+ * @file test_state_manager.cpp
+ * @brief StateManager 调度相关单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/state_manager.hpp"
+#include "gnc/core/component_factory.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+using namespace gnc;
+using namespace gnc::states;
+
+namespace {
+
+// 计数组件：每次更新输出自增的计数
+class CounterComponent : public ComponentBase {
+public:
+    CounterComponent(VehicleId id, const std::string& name = "Counter")
+        : ComponentBase(id, name) {
+        declareOutput<int>("count", 0);
+    }
+
+    std::string getComponentType() const override { return "Counter"; }
+
+    int updates = 0;
+
+protected:
+    void updateImpl() override {
+        setState("count", ++updates);
+    }
+};
+
+// 自休眠组件：计数到阈值后让所属飞行器休眠
+class SelfSleepingComponent : public CounterComponent {
+public:
+    SelfSleepingComponent(VehicleId id, int sleep_after)
+        : CounterComponent(id, "Sleeper"), sleep_after_(sleep_after) {}
+
+protected:
+    void updateImpl() override {
+        CounterComponent::updateImpl();
+        if (updates >= sleep_after_) {
+            setVehicleActive(false);
+        }
+    }
+
+private:
+    int sleep_after_;
+};
+
+// 每次更新都在堆上分配的组件
+class AllocatingComponent : public CounterComponent {
+public:
+    explicit AllocatingComponent(VehicleId id) : CounterComponent(id, "Allocating") {}
+
+    std::vector<std::unique_ptr<int>> retained;
+
+protected:
+    void updateImpl() override {
+        retained.push_back(std::make_unique<int>(updates));
+        CounterComponent::updateImpl();
+    }
+};
+
+// 派生输出组件：doubled = 2 * count，记录求值次数
+class DerivedComponent : public ComponentBase {
+public:
+    explicit DerivedComponent(VehicleId id) : ComponentBase(id, "Derived") {
+        declareOutput<int>("count", 0);
+        declareDerivedOutput<int>("doubled", [this]() {
+            ++evaluations;
+            return 2 * updates;
+        });
+    }
+
+    std::string getComponentType() const override { return "Derived"; }
+
+    int updates = 0;
+    int evaluations = 0;
+
+protected:
+    void updateImpl() override {
+        setState("count", ++updates);
+    }
+};
+
+// 相互依赖的派生输出，用于循环检测
+class CyclicDerivedComponent : public ComponentBase {
+public:
+    explicit CyclicDerivedComponent(VehicleId id) : ComponentBase(id, "Cyclic") {
+        declareDerivedOutput<int>("a", [this]() { return getState<int>("b") + 1; });
+        declareDerivedOutput<int>("b", [this]() { return getState<int>("a") + 1; });
+    }
+
+    std::string getComponentType() const override { return "Cyclic"; }
+
+protected:
+    void updateImpl() override {}
+};
+
+// 纯函数组件：输出 = 上游计数 / 2（整除），启用输入未变化时跳过
+class HalvingComponent : public ComponentBase {
+public:
+    HalvingComponent(VehicleId id, const ComponentId& source, const std::string& name)
+        : ComponentBase(id, name), source_(source) {
+        declareInput<void>(source);
+        declareOutput<int>("half", 0);
+        setSkipIfInputsUnchanged(true);
+    }
+
+    std::string getComponentType() const override { return "Halving"; }
+
+    int updates = 0;
+
+protected:
+    void updateImpl() override {
+        ++updates;
+        int value = getState<int>(StateId{source_, source_.name == "Counter" ? "count" : "half"});
+        setState("half", value / 2);
+    }
+
+private:
+    ComponentId source_;
+};
+
+// 支持批量更新的组件：输出 = 上游计数 + 1（经初始化时绑定的句柄读取），记录批量调用
+class BatchedComponent : public ComponentBase {
+public:
+    explicit BatchedComponent(VehicleId id) : ComponentBase(id, "Batched") {
+        declareInput<void>(ComponentId{id, "Counter"});
+        declareOutput<int>("next", 0);
+    }
+
+    std::string getComponentType() const override { return "Batched"; }
+
+    void initialize() override {
+        count_ = getStateHandle<int>("Counter.count");
+    }
+
+    static void updateBatch(std::span<BatchedComponent*> batch) {
+        ++batch_calls;
+        largest_batch = std::max(largest_batch, batch.size());
+        for (auto* self : batch) {
+            self->updateImpl();
+        }
+    }
+
+    static inline int batch_calls = 0;
+    static inline size_t largest_batch = 0;
+
+protected:
+    void updateImpl() override {
+        setState("next", count_.get() + 1);
+    }
+
+private:
+    StateHandle<int> count_;
+};
+
+// 未声明依赖的组件：读取其他飞行器的计数
+class SnoopingComponent : public ComponentBase {
+public:
+    SnoopingComponent(VehicleId id, VehicleId target) : ComponentBase(id, "Snooping"), target_(target) {
+        declareOutput<int>("seen", 0);
+    }
+
+    std::string getComponentType() const override { return "Snooping"; }
+
+protected:
+    void updateImpl() override {
+        setState("seen", getState<int>({{target_, "Counter"}, "count"}));
+    }
+
+private:
+    VehicleId target_;
+};
+
+// 按上一帧读取其他组件输出的组件
+class PreviousFrameReader : public ComponentBase {
+public:
+    explicit PreviousFrameReader(VehicleId id) : ComponentBase(id, "Reader") {}
+
+    std::string getComponentType() const override { return "PreviousFrameReader"; }
+
+    template <typename T>
+    const T& snapshot(const StateId& id) {
+        return previousFrameState<T>(id);
+    }
+
+protected:
+    void updateImpl() override {}
+};
+
+// 独立初始化的组件：initialize() 中等待一段时间，记录是否看到依赖已初始化
+class SlowInitComponent : public CounterComponent {
+public:
+    SlowInitComponent(VehicleId id, const std::string& name, const ComponentId* dependency = nullptr)
+        : CounterComponent(id, name) {
+        if (dependency) {
+            declareInput<void>(*dependency);
+            dependency_ = *dependency;
+        }
+        setIndependentInitialization(true);
+    }
+
+    // 无依赖的组件在此会合：等到 INDEPENDENT 个都进入 initialize 才返回（顺序执行时超时），
+    // 并记录同时处于 initialize 中的最大组件数
+    void initialize() override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        dependency_initialized = !dependency_ || initialized_.count(*dependency_) > 0;
+        peak_concurrency = std::max(peak_concurrency, ++running_);
+        if (!dependency_) {
+            ++arrived_;
+            arrival_.notify_all();
+            arrival_.wait_for(lock, std::chrono::seconds(5), [] { return arrived_ >= INDEPENDENT; });
+        }
+        --running_;
+        initialized_.insert(getComponentId());
+    }
+
+    static constexpr int INDEPENDENT = 4;
+    static inline int peak_concurrency = 0;
+    bool dependency_initialized = false;
+
+private:
+    std::optional<ComponentId> dependency_;
+    static inline std::mutex mutex_;
+    static inline std::condition_variable arrival_;
+    static inline int arrived_ = 0;
+    static inline int running_ = 0;
+    static inline std::unordered_set<ComponentId, std::hash<ComponentId>> initialized_;
+};
+
+} // namespace
+
+// 测试休眠飞行器的组件被跳过，状态保持最后写入的值
+TEST(StateManagerTest, InactiveVehicleIsSkipped) {
+    StateManager manager;
+    auto* global = new CounterComponent(globalId);
+    auto* vehicle1 = new CounterComponent(1);
+    auto* vehicle2 = new CounterComponent(2);
+    manager.registerComponent(global);
+    manager.registerComponent(vehicle1);
+    manager.registerComponent(vehicle2);
+
+    manager.setVehicleActive(2, false);
+    manager.updateAll();
+    manager.updateAll();
+
+    EXPECT_EQ(global->updates, 2);
+    EXPECT_EQ(vehicle1->updates, 2);
+    EXPECT_EQ(vehicle2->updates, 0);
+    EXPECT_FALSE(manager.isVehicleActive(2));
+    EXPECT_EQ(manager.getSleepingVehicleCount(), 1u);
+
+    manager.setVehicleActive(2, true);
+    manager.updateAll();
+    EXPECT_EQ(vehicle2->updates, 1);
+    EXPECT_EQ(manager.getState<int>({{2, "Counter"}, "count"}), 1);
+}
+
+// 测试全局飞行器不能休眠
+TEST(StateManagerTest, GlobalVehicleCannotSleep) {
+    StateManager manager;
+    auto* global = new CounterComponent(globalId);
+    manager.registerComponent(global);
+
+    manager.setVehicleActive(globalId, false);
+    manager.updateAll();
+
+    EXPECT_TRUE(manager.isVehicleActive(globalId));
+    EXPECT_EQ(global->updates, 1);
+}
+
+// 测试活动飞行器数量随注册、休眠和唤醒维护，全局飞行器不计入
+TEST(StateManagerTest, ActiveVehicleCountTracksTransitions) {
+    StateManager manager;
+    manager.registerComponent(new CounterComponent(globalId));
+    manager.registerComponent(new CounterComponent(1));
+    manager.registerComponent(new CounterComponent(1, "Second"));
+    manager.registerComponent(new CounterComponent(2));
+    EXPECT_EQ(manager.getActiveVehicleCount(), 2u);
+
+    manager.setVehicleActive(2, false);
+    manager.setVehicleActive(2, false);
+    manager.setVehicleActive(globalId, false);
+    EXPECT_EQ(manager.getActiveVehicleCount(), 1u);
+
+    // 注册前已休眠的飞行器不计入
+    manager.setVehicleActive(3, false);
+    manager.registerComponent(new CounterComponent(3));
+    EXPECT_EQ(manager.getActiveVehicleCount(), 1u);
+
+    manager.setVehicleActive(1, false);
+    EXPECT_FALSE(manager.hasActiveVehicles());
+    manager.setVehicleActive(3, true);
+    manager.setVehicleActive(2, true);
+    EXPECT_EQ(manager.getActiveVehicleCount(), 2u);
+    EXPECT_TRUE(manager.hasActiveVehicles());
+}
+
+// 测试组件自行休眠后由唤醒条件恢复
+TEST(StateManagerTest, WakeConditionReactivatesVehicle) {
+    StateManager manager;
+    auto* global = new CounterComponent(globalId);
+    auto* sleeper = new SelfSleepingComponent(1, 2);
+    manager.registerComponent(global);
+    manager.registerComponent(sleeper);
+
+    manager.setWakeCondition(1, [global]() { return global->updates >= 5; });
+
+    for (int i = 0; i < 5; ++i) {
+        manager.updateAll();
+    }
+    // 第2帧后休眠，第3~5帧跳过
+    EXPECT_EQ(sleeper->updates, 2);
+    EXPECT_FALSE(manager.isVehicleActive(1));
+
+    // 第6帧开始时唤醒条件满足
+    manager.updateAll();
+    EXPECT_EQ(sleeper->updates, 3);
+}
+
+// 测试派生输出仅在读取时求值，且在一帧内缓存
+TEST(StateManagerTest, DerivedOutputIsLazyAndMemoized) {
+    StateManager manager;
+    auto* derived = new DerivedComponent(1);
+    manager.registerComponent(derived);
+    const StateId doubled_id{{1, "Derived"}, "doubled"};
+
+    manager.updateAll();
+    manager.updateAll();
+    EXPECT_EQ(derived->evaluations, 0) << "Unread derived output should never be computed";
+
+    EXPECT_EQ(manager.getState<int>(doubled_id), 4);
+    EXPECT_EQ(manager.getState<int>(doubled_id), 4);
+    EXPECT_EQ(derived->evaluations, 1);
+
+    // 观察者通过原始值读取同样触发求值
+    manager.updateAll();
+    EXPECT_EQ(std::any_cast<int>(manager.getRawStateValue(doubled_id)), 6);
+    EXPECT_EQ(derived->evaluations, 2);
+}
+
+// 测试派生输出为只读，且循环依赖会被检测
+TEST(StateManagerTest, DerivedOutputErrors) {
+    StateManager manager;
+    manager.registerComponent(new DerivedComponent(1));
+    manager.registerComponent(new CyclicDerivedComponent(1));
+    manager.updateAll();
+
+    EXPECT_THROW(manager.setState<int>({{1, "Derived"}, "doubled"}, 0), StateAccessError);
+    EXPECT_THROW(manager.getState<int>({{1, "Cyclic"}, "a"}), DependencyError);
+}
+
+// 测试状态版本只在值变化时递增，且输入未变化的组件及其下游被跳过
+TEST(StateManagerTest, SkipIfInputsUnchanged) {
+    StateManager manager;
+    auto* counter = new CounterComponent(1);
+    auto* first = new HalvingComponent(1, ComponentId{1, "Counter"}, "First");
+    auto* second = new HalvingComponent(1, ComponentId{1, "First"}, "Second");
+    manager.registerComponent(counter);
+    manager.registerComponent(first);
+    manager.registerComponent(second);
+
+    // 计数 1,2,3,4 -> half 0,1,1,2 -> half 0,0,0,1
+    for (int i = 0; i < 4; ++i) {
+        manager.updateAll();
+    }
+
+    EXPECT_EQ(first->updates, 4) << "Counter changes every frame";
+    EXPECT_EQ(second->updates, 3) << "First.half is unchanged in frame 3";
+    EXPECT_EQ(manager.getSkippedUpdateCount(), 1u);
+    EXPECT_EQ(manager.getStateVersion({{1, "First"}, "half"}), 2u);
+    EXPECT_EQ(manager.getState<int>({{1, "Second"}, "half"}), 1);
+}
+
+// 测试同类型的独立实例被合并为一次批量更新，休眠飞行器被排除在批次外
+TEST(StateManagerTest, SameTypeInstancesAreBatched) {
+    ComponentFactory::getInstance().registerBatchUpdater<BatchedComponent>();
+    StateManager manager;
+    for (VehicleId id = 1; id <= 3; ++id) {
+        manager.registerComponent(new CounterComponent(id));
+        manager.registerComponent(new BatchedComponent(id));
+    }
+
+    manager.updateAll();
+    EXPECT_EQ(manager.getBatchedStepCount(), 1u);
+    EXPECT_EQ(BatchedComponent::batch_calls, 1);
+    EXPECT_EQ(BatchedComponent::largest_batch, 3u);
+    for (VehicleId id = 1; id <= 3; ++id) {
+        EXPECT_EQ(manager.getState<int>({{id, "Batched"}, "next"}), 2);
+    }
+
+    manager.setVehicleActive(3, false);
+    manager.updateAll();
+    EXPECT_EQ(BatchedComponent::batch_calls, 2);
+    EXPECT_EQ(manager.getState<int>({{2, "Batched"}, "next"}), 3);
+    EXPECT_EQ(manager.getState<int>({{3, "Batched"}, "next"}), 2);
+}
+
+// 测试状态句柄跟踪存储值，且拒绝派生状态和类型不匹配
+TEST(StateManagerTest, StateHandleReadsSlotDirectly) {
+    StateManager manager;
+    manager.registerComponent(new CounterComponent(1));
+    manager.registerComponent(new DerivedComponent(1));
+    manager.updateAll();
+
+    auto handle = manager.getStateHandle<int>({{1, "Counter"}, "count"});
+    EXPECT_EQ(handle.get(), 1);
+    manager.updateAll();
+    EXPECT_EQ(handle.get(), 2);
+
+    EXPECT_THROW(manager.getStateHandle<double>({{1, "Counter"}, "count"}), StateAccessError);
+    EXPECT_THROW(manager.getStateHandle<int>({{1, "Derived"}, "doubled"}), StateAccessError);
+}
+
+// 测试帧预算：可卸载组件先推迟到帧末，截止时间已过时被跳过
+TEST(StateManagerTest, FrameBudgetDefersAndShedsSheddableComponents) {
+    StateManager manager;
+    auto* essential = new CounterComponent(1);
+    auto* logger = new CounterComponent(2);
+    manager.registerComponent(essential, 900);
+    manager.registerComponent(logger, 100, true);
+
+    auto now = StateManager::BudgetClock::now();
+    manager.setFrameBudget(now - std::chrono::seconds(1), now + std::chrono::hours(1));
+    manager.updateAll();
+    EXPECT_EQ(essential->updates, 1);
+    EXPECT_EQ(logger->updates, 1);
+    EXPECT_EQ(manager.getDeferredUpdateCount(), 1u);
+    EXPECT_EQ(manager.getShedUpdateCount(), 0u);
+
+    manager.setFrameBudget(now - std::chrono::seconds(1), now - std::chrono::seconds(1));
+    manager.updateAll();
+    EXPECT_EQ(essential->updates, 2);
+    EXPECT_EQ(logger->updates, 1);
+    EXPECT_EQ(manager.getShedUpdateCount(), 1u);
+    EXPECT_EQ(manager.getShedCounts().at(ComponentId{2, "Counter"}), 1u);
+
+    manager.clearFrameBudget();
+    manager.updateAll();
+    EXPECT_EQ(logger->updates, 2);
+}
+
+// 测试稳态分配检查：分配归属到正在更新的组件，fail_on_allocation 时抛出
+TEST(StateManagerTest, SteadyStateAllocationsAreAttributed) {
+    if (!AllocationTracker::enabled()) {
+        GTEST_SKIP() << "Built without GNC_TRACK_ALLOCATIONS";
+    }
+    StateManager manager;
+    manager.registerComponent(new CounterComponent(1));
+    manager.registerComponent(new AllocatingComponent(1));
+    manager.setAllocationCheck({.warmup_frames = 1, .sample_stacks = true, .fail_on_allocation = false});
+    for (int i = 0; i < 3; ++i) {
+        manager.updateAll();
+    }
+
+    auto report = manager.getAllocationReport();
+    auto it = std::find_if(report.begin(), report.end(),
+                           [](const auto& entry) { return entry.component == ComponentId{1, "Allocating"}; });
+    ASSERT_NE(it, report.end());
+    EXPECT_EQ(it->frames, 2u);
+    EXPECT_GE(it->allocations, 2u);
+    EXPECT_GT(manager.getSteadyStateAllocationCount(), 0u);
+
+    manager.setAllocationCheck({.warmup_frames = 1, .sample_stacks = false, .fail_on_allocation = true});
+    EXPECT_THROW(manager.updateAll(), AllocationError);
+}
+
+// 测试状态访问审计：读取按组件归属，未声明且无依赖路径的读取被标记
+TEST(StateManagerTest, AccessAuditFlagsUndeclaredReads) {
+    StateManager manager;
+    manager.registerComponent(new CounterComponent(1));
+    manager.registerComponent(new CounterComponent(2));
+    manager.registerComponent(new HalvingComponent(1, ComponentId{1, "Counter"}, "Half"));
+    manager.registerComponent(new SnoopingComponent(1, 2));
+    StateAccessAudit audit;
+    manager.setAccessAudit(&audit);
+    for (int i = 0; i < 4; ++i) {
+        manager.updateAll();
+    }
+    manager.getRawStateValue({{1, "Half"}, "half"});
+
+    auto edges = manager.analyzeAccessAudit();
+    auto find = [&edges](const ComponentId& consumer) {
+        return std::find_if(edges.begin(), edges.end(), [&](const auto& edge) { return edge.consumer() == consumer; });
+    };
+    auto declared = find({1, "Half"});
+    ASSERT_NE(declared, edges.end());
+    EXPECT_TRUE(declared->declared);
+    EXPECT_EQ(declared->access->frames, 4u);
+
+    auto snooping = find({1, "Snooping"});
+    ASSERT_NE(snooping, edges.end());
+    EXPECT_EQ(snooping->producer(), (ComponentId{2, "Counter"}));
+    EXPECT_TRUE(snooping->cross_vehicle);
+    EXPECT_FALSE(snooping->declared);
+    EXPECT_FALSE(snooping->ordered);
+    EXPECT_EQ(snooping->access->reads, 4u);
+
+    auto external = find({globalId, "[external]"});
+    ASSERT_NE(external, edges.end());
+    EXPECT_EQ(external->access->reads, 1u);
+}
+
+// 测试审计开启后绑定的句柄，其读取同样按组件归属计入审计
+TEST(StateManagerTest, AccessAuditCountsHandleReads) {
+    StateManager manager;
+    manager.registerComponent(new CounterComponent(1));
+    manager.registerComponent(new BatchedComponent(1));
+    StateAccessAudit audit;
+    manager.setAccessAudit(&audit);
+    for (int i = 0; i < 3; ++i) {
+        manager.updateAll();
+    }
+
+    auto edges = manager.analyzeAccessAudit();
+    auto batched = std::find_if(edges.begin(), edges.end(),
+                                [](const auto& edge) { return edge.consumer() == ComponentId{1, "Batched"}; });
+    ASSERT_NE(batched, edges.end());
+    EXPECT_EQ(batched->producer(), (ComponentId{1, "Counter"}));
+    EXPECT_EQ(batched->access->state.name, "count");
+    EXPECT_TRUE(batched->declared);
+    EXPECT_EQ(batched->access->reads, 3u);
+}
+
+// 测试类型不符或不存在的上一帧读取被拒绝且不登记快照，之后的帧照常复制已登记的快照
+TEST(StateManagerTest, PreviousFrameStateRejectsWrongType) {
+    StateManager manager;
+    manager.registerComponent(new CounterComponent(1));
+    auto* reader = new PreviousFrameReader(1);
+    manager.registerComponent(reader);
+
+    EXPECT_THROW(reader->snapshot<double>({{1, "Counter"}, "count"}), std::runtime_error);
+    EXPECT_THROW(reader->snapshot<int>({{1, "Counter"}, "missing"}), std::runtime_error);
+    const int& count = reader->snapshot<int>({{1, "Counter"}, "count"});
+
+    manager.updateAll();
+    manager.updateAll();
+    EXPECT_EQ(count, 1);
+}
+
+// 测试独立初始化的组件并行执行，且仍在依赖初始化完成后才开始
+TEST(StateManagerTest, IndependentComponentsInitializeInParallel) {
+    StateManager manager;
+    // 每个组件一个线程：等待依赖的任务占用一个工作线程，不能挤占会合的组件
+    manager.setInitializationThreads(SlowInitComponent::INDEPENDENT + 1);
+    const ComponentId first{1, "Slow0"};
+    std::vector<SlowInitComponent*> components;
+    for (int i = 0; i < SlowInitComponent::INDEPENDENT; ++i) {
+        components.push_back(new SlowInitComponent(1, "Slow" + std::to_string(i)));
+    }
+    auto* dependent = new SlowInitComponent(1, "Dependent", &first);
+    for (auto* component : components) {
+        manager.registerComponent(component);
+    }
+    manager.registerComponent(dependent);
+
+    manager.validateAndSortComponents();
+
+    EXPECT_TRUE(dependent->dependency_initialized);
+    // 4 个独立组件同时处于 initialize 中
+    EXPECT_EQ(SlowInitComponent::peak_concurrency, SlowInitComponent::INDEPENDENT);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file test_static_pipeline.cpp
+ * @brief 编译期静态流水线单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/core/static_pipeline.hpp"
+#include "gnc/core/state_manager.hpp"
+#include "gnc/components/dynamics/static_pipeline_dynamics.hpp"
+
+using namespace gnc;
+using namespace gnc::pipeline;
+using namespace gnc::states;
+using gnc::components::StaticPipelineDynamics;
+using gnc::components::utility::ConfigFileType;
+using gnc::components::utility::ConfigManager;
+
+namespace {
+
+struct SourceStage {
+    struct Outputs { int source = 0; };
+
+    template <typename State>
+    void step(State& state, const StepContext&) { state.source += 1; }
+};
+
+struct DoubleStage {
+    using Depends = gnc::pipeline::Depends<SourceStage>;
+    struct Outputs { int doubled = 0; };
+
+    template <typename State>
+    void step(State& state, const StepContext&) { state.doubled = 2 * state.source; }
+};
+
+struct SumStage {
+    using Depends = gnc::pipeline::Depends<DoubleStage, SourceStage>;
+    struct Outputs { int sum = 0; };
+
+    template <typename State>
+    void step(State& state, const StepContext&) { state.sum = state.source + state.doubled; }
+};
+
+// 阶段按与依赖相反的顺序声明
+using Pipeline = StaticPipeline<SumStage, DoubleStage, SourceStage>;
+
+// 固定步长 0.1 s 的时间源
+class FakeTiming : public ComponentBase {
+public:
+    FakeTiming() : ComponentBase(globalId, "TimingManager") {
+        declareOutput<double>("timing_delta_s", 0.1);
+        declareOutput<double>("timing_current_s", 0.0);
+    }
+
+    std::string getComponentType() const override { return "FakeTiming"; }
+
+protected:
+    void updateImpl() override {}
+};
+
+// 读取 RigidBodyDynamics6DoF 全部输出的下游组件
+class DynamicsConsumer : public ComponentBase {
+public:
+    explicit DynamicsConsumer(VehicleId id) : ComponentBase(id, "Consumer") {
+        declareInput<void>(ComponentId{id, "Dynamics"});
+    }
+
+    std::string getComponentType() const override { return "DynamicsConsumer"; }
+
+    Vector3d position = Vector3d::Zero();
+    Vector3d velocity = Vector3d::Zero();
+    Vector3d velocity_body = Vector3d::Zero();
+    Quaterniond attitude = Quaterniond::Identity();
+
+protected:
+    void updateImpl() override {
+        position = get<Vector3d>("Dynamics.position_truth_m");
+        velocity = get<Vector3d>("Dynamics.velocity_truth_mps");
+        attitude = get<Quaterniond>("Dynamics.attitude_truth_quat");
+        velocity_body = get<Vector3d>("Dynamics.velocity_body_mps");
+    }
+};
+
+} // namespace
+
+// 执行顺序在编译期确定
+static_assert(Pipeline::executionOrder[0] == 2);
+static_assert(Pipeline::executionOrder[1] == 1);
+static_assert(Pipeline::executionOrder[2] == 0);
+
+// 测试下游阶段在同一步内看到上游阶段的最新输出
+TEST(StaticPipelineTest, StagesRunInDependencyOrder) {
+    Pipeline pipeline;
+    pipeline.step({});
+    pipeline.step({});
+
+    EXPECT_EQ(pipeline.state().source, 2);
+    EXPECT_EQ(pipeline.state().doubled, 4);
+    EXPECT_EQ(pipeline.state().sum, 6);
+}
+
+// 测试用静态流水线替换动力学组件后，读取 RigidBodyDynamics6DoF 输出的组件仍能解析全部状态
+TEST(StaticPipelineTest, DynamicsComponentProvidesRigidBodyOutputs) {
+    ConfigManager::getInstance().setConfigValue(ConfigFileType::DYNAMICS, "dynamics.static_pipeline",
+                                                {{"initial_velocity", {60.0, 80.0, 0.0}}});
+    StateManager manager;
+    manager.registerComponent(new FakeTiming());
+    manager.registerComponent(new StaticPipelineDynamics(1));
+    auto* consumer = new DynamicsConsumer(1);
+    manager.registerComponent(consumer);
+    manager.validateAndSortComponents();
+
+    manager.updateAll();
+    manager.updateAll();
+
+    EXPECT_GT(consumer->position.norm(), 0.0);
+    EXPECT_GT(consumer->velocity.norm(), 0.0);
+    // 姿态与速度对齐，载体系速度沿 X 轴
+    EXPECT_NEAR(consumer->velocity_body.x(), consumer->velocity.norm(), 1e-9);
+    EXPECT_NEAR(consumer->velocity_body.y(), 0.0, 1e-9);
+    EXPECT_NEAR(consumer->velocity_body.z(), 0.0, 1e-9);
+    EXPECT_NEAR((consumer->attitude * Vector3d::UnitX()).dot(consumer->velocity.normalized()), 1.0, 1e-9);
+}
+
+// 测试二次阻力阶段：阻力与速度反向，大小为 0.5·ρ·|v|²·CdA，不含拉偏系数
+TEST(StaticPipelineTest, QuadraticDragOpposesVelocity) {
+    gnc::components::PointMassPipeline pipeline;
+    pipeline.state().velocity_truth_mps = Vector3d(60.0, 80.0, 0.0);
+    pipeline.step({});
+
+    const Vector3d& force = pipeline.state().aero_force_truth_N;
+    EXPECT_NEAR(force.norm(), 0.5 * 1.225 * 100.0 * 100.0 * 0.1, 1e-9);
+    EXPECT_NEAR(force.normalized().dot(Vector3d(0.6, 0.8, 0.0)), -1.0, 1e-12);
+}
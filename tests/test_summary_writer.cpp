@@ -0,0 +1,56 @@
+/**
+ * @file test_summary_writer.cpp
+ * @brief 在线统计写入器单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/components/utility/summary_writer.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+using namespace gnc::components::utility;
+using gnc::states::StateId;
+
+// 测试极值及其时刻、终值、RMS、超阈值时间，以及 NaN 样本被跳过
+TEST(SummaryWriterTest, ReducesColumnsOnline) {
+    const gnc::states::ComponentId component{1, "Plant"};
+    const std::vector<StateId> states = {{component, "Plant.x"}, {component, "Plant.y"}};
+
+    SummaryWriter writer;
+    writer.configure({{"thresholds", {{{"pattern", "Plant\\.x$"}, {"above", 0.5}}}}});
+    writer.initialize((std::filesystem::temp_directory_path() / "gnc_summary.json").string(), states, true,
+                      {{"run", "unit"}});
+
+    const double pi = std::acos(-1.0);
+    const size_t rows = 10000;
+    for (size_t row = 0; row <= rows; ++row) {
+        const double t = static_cast<double>(row) / rows;
+        const double y = row % 2 == 0 ? 2.0 : std::numeric_limits<double>::quiet_NaN();
+        writer.writeDataPoint(t, {std::sin(2.0 * pi * t), y});
+    }
+    writer.finalize();
+
+    std::ifstream file(writer.filePath());
+    ASSERT_TRUE(file.is_open());
+    const nlohmann::json summary = nlohmann::json::parse(file);
+    EXPECT_EQ(summary["rows"], rows + 1);
+    EXPECT_EQ(summary["metadata"]["run"], "unit");
+
+    const auto& x = summary["states"]["1.Plant.x"];
+    EXPECT_NEAR(x["max"].get<double>(), 1.0, 1e-9);
+    EXPECT_NEAR(x["time_of_max"].get<double>(), 0.25, 1e-9);
+    EXPECT_NEAR(x["min"].get<double>(), -1.0, 1e-9);
+    EXPECT_NEAR(x["time_of_min"].get<double>(), 0.75, 1e-9);
+    EXPECT_NEAR(x["final"].get<double>(), 0.0, 1e-9);
+    EXPECT_NEAR(x["rms"].get<double>(), std::sqrt(0.5), 1e-3);
+    // sin(2πt) > 0.5 在 t ∈ (1/12, 5/12)
+    EXPECT_NEAR(x["time_above"].get<double>(), 1.0 / 3.0, 1e-3);
+
+    const auto& y = summary["states"]["1.Plant.y"];
+    EXPECT_EQ(y["samples"], rows / 2 + 1);
+    EXPECT_DOUBLE_EQ(y["rms"].get<double>(), 2.0);
+    EXPECT_FALSE(y.contains("time_above"));
+
+    std::filesystem::remove(writer.filePath());
+}
@@ -0,0 +1,65 @@
+/**
+ * @file test_vehicle_layout.cpp
+ * @brief 飞行器模板与批量展开单元测试
+ */
+
+#include <gtest/gtest.h>
+#include "gnc/common/exceptions.hpp"
+#include "gnc/core/vehicle_layout.hpp"
+
+using namespace gnc::core;
+
+namespace {
+
+nlohmann::json swarmConfig() {
+    return nlohmann::json::parse(R"({
+        "vehicle_templates": {
+            "drone": {"components": ["Dynamics", {"type": "Guidance", "name": "Main", "priority": 600}]}
+        },
+        "vehicles": [
+            {"id": 0, "components": ["TimingManager"]},
+            {"template": "drone", "id_range": [1, 1000], "active": false, "wake_at_s": 2.0},
+            {"template": "drone", "id": 2000, "count": 3, "overrides": {"Main": {"priority": 700}},
+             "extra_components": ["Disturbance"]}
+        ]
+    })");
+}
+
+} // namespace
+
+// 测试模板批量展开共享同一份组件列表，覆盖项只作用于所在条目
+TEST(VehicleLayoutTest, TemplatesExpandToSharedComponentLists) {
+    const auto groups = parseVehicleLayout(swarmConfig());
+    ASSERT_EQ(groups.size(), 3u);
+
+    EXPECT_EQ(groups[1].first_id, 1u);
+    EXPECT_EQ(groups[1].count, 1000u);
+    EXPECT_FALSE(groups[1].active);
+    EXPECT_DOUBLE_EQ(groups[1].wake_at_s.value(), 2.0);
+    ASSERT_EQ(groups[1].components->size(), 2u);
+    EXPECT_EQ((*groups[1].components)[1].priority, 600);
+
+    EXPECT_EQ(groups[2].first_id, 2000u);
+    EXPECT_EQ(groups[2].count, 3u);
+    EXPECT_NE(groups[2].components, groups[1].components);
+    ASSERT_EQ(groups[2].components->size(), 3u);
+    EXPECT_EQ((*groups[2].components)[1].priority, 700);
+    EXPECT_EQ((*groups[2].components)[2].type, "Disturbance");
+
+    // 不带修改的再次引用直接复用模板的列表
+    auto config = swarmConfig();
+    config["vehicles"].push_back({{"template", "drone"}, {"id", 5000}});
+    const auto reused = parseVehicleLayout(config);
+    EXPECT_EQ(reused[3].components, reused[1].components);
+}
+
+// 测试重复的飞行器 ID 和未知模板在解析时报错
+TEST(VehicleLayoutTest, RejectsOverlappingIdsAndUnknownTemplates) {
+    auto overlapping = swarmConfig();
+    overlapping["vehicles"].push_back({{"template", "drone"}, {"id", 999}, {"count", 5}});
+    EXPECT_THROW(parseVehicleLayout(overlapping), gnc::ConfigurationError);
+
+    auto unknown = swarmConfig();
+    unknown["vehicles"].push_back({{"template", "missile"}, {"id", 9000}});
+    EXPECT_THROW(parseVehicleLayout(unknown), gnc::ConfigurationError);
+}
@@ -0,0 +1,214 @@
+// gnc_analyze.cpp
+// 批量后处理：并行读取多次运行的 DataLogger 日志，计算列表达式的逐次运行归约量和跨运行分位数带
+#include "gnc/components/utility/log_analysis.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: gnc_analyze RUN_OR_DIR... [options]\n"
+        "  RUN_OR_DIR              recorded logs (.gnclog, .h5 or .csv) or directories containing them\n"
+        "  --define NAME=EXPR      named expression usable in later expressions; may be repeated\n"
+        "  --reduce NAME=OP:EXPR   per-run scalar, OP one of min max mean rms std first final\n"
+        "                          time_of_min time_of_max; may be repeated\n"
+        "  --series EXPR           evaluate EXPR on the time grid of the first run\n"
+        "  --percentiles LIST      bands of --series across runs (default 0,5,50,95,100)\n"
+        "  --output FILE           per-run reductions as CSV (default: stdout)\n"
+        "  --series-output FILE    time and percentile bands as CSV (default: stdout)\n"
+        "  --pattern REGEX         file names picked up in directories (default \\.(gnclog|h5|csv)$)\n"
+        "  --threads N             worker threads, 0 = hardware concurrency (default 0)\n"
+        "  --chunk-rows N          rows per evaluation chunk (default 32768)\n"
+        "  --list                  list the columns of the first run\n"
+        "Expressions: + - * / ^, t, abs sqrt exp log sin cos tan asin acos atan atan2 hypot\n"
+        "min max norm deg rad; columns by flattened name, [..] for names with a vehicle prefix\n";
+}
+
+std::vector<double> parseList(const std::string& text) {
+    std::vector<double> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(std::stod(item));
+    }
+    return values;
+}
+
+/**
+ * @brief Open FILE for writing, or stdout for an empty name
+ */
+std::FILE* openOutput(const std::string& path) {
+    if (path.empty()) {
+        return stdout;
+    }
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        throw std::runtime_error("cannot write " + path);
+    }
+    return file;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    namespace fs = std::filesystem;
+    using namespace gnc::components::utility;
+
+    std::vector<std::string> inputs;
+    std::vector<std::pair<std::string, std::string>> definitions;
+    std::vector<ReductionSpec> reductions;
+    std::string series_expression;
+    std::vector<double> percentiles = {0.0, 5.0, 50.0, 95.0, 100.0};
+    std::string output_file;
+    std::string series_output_file;
+    std::string pattern = "\\.(gnclog|h5|csv)$";
+    AnalysisOptions options;
+    bool list = false;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else if (arg == "--define") {
+                const std::string value = next();
+                const auto equals = value.find('=');
+                if (equals == std::string::npos) {
+                    throw std::invalid_argument("--define expects NAME=EXPR");
+                }
+                definitions.emplace_back(value.substr(0, equals), value.substr(equals + 1));
+            } else if (arg == "--reduce") {
+                reductions.push_back(ReductionSpec::parse(next()));
+            } else if (arg == "--series") {
+                series_expression = next();
+            } else if (arg == "--percentiles") {
+                percentiles = parseList(next());
+            } else if (arg == "--output") {
+                output_file = next();
+            } else if (arg == "--series-output") {
+                series_output_file = next();
+            } else if (arg == "--pattern") {
+                pattern = next();
+            } else if (arg == "--threads") {
+                options.threads = std::stoul(next());
+            } else if (arg == "--chunk-rows") {
+                options.chunk_rows = std::stoul(next());
+            } else if (arg == "--list") {
+                list = true;
+            } else if (!arg.empty() && arg[0] == '-') {
+                throw std::invalid_argument("unknown option " + arg);
+            } else {
+                inputs.push_back(arg);
+            }
+        }
+        if (inputs.empty() || (!list && reductions.empty() && series_expression.empty())) {
+            throw std::invalid_argument("expected runs and at least one of --reduce, --series or --list");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "gnc_analyze: " << e.what() << "\n";
+        printUsage();
+        return 2;
+    }
+
+    int status = 0;
+    try {
+        const std::regex name_pattern(pattern);
+        std::vector<std::string> paths;
+        for (const auto& input : inputs) {
+            if (fs::is_directory(input)) {
+                std::vector<std::string> found;
+                for (const auto& entry : fs::directory_iterator(input)) {
+                    if (entry.is_regular_file() && std::regex_search(entry.path().filename().string(), name_pattern)) {
+                        found.push_back(entry.path().string());
+                    }
+                }
+                std::sort(found.begin(), found.end());
+                paths.insert(paths.end(), found.begin(), found.end());
+            } else {
+                paths.push_back(input);
+            }
+        }
+        if (paths.empty()) {
+            throw std::runtime_error("no runs found");
+        }
+
+        RunSet runs = RunSet::open(paths, options.threads);
+        for (const auto& [name, expression] : definitions) {
+            runs.define(name, expression);
+        }
+        std::fprintf(stderr, "opened %zu runs\n", runs.size());
+
+        if (list) {
+            for (const auto& name : runs.run(0).names) {
+                std::printf("%s\n", name.c_str());
+            }
+        }
+
+        if (!reductions.empty()) {
+            const Matrix values = runs.reduce(reductions, options);
+            const AnalysisStats stats = runs.lastStats();
+            std::FILE* out = openOutput(output_file);
+            std::fprintf(out, "run");
+            for (const auto& spec : reductions) {
+                std::fprintf(out, ",%s", spec.name.c_str());
+            }
+            std::fprintf(out, "\n");
+            for (size_t r = 0; r < values.rows; ++r) {
+                std::fprintf(out, "%s", runs.path(r).c_str());
+                for (size_t c = 0; c < values.cols; ++c) {
+                    std::fprintf(out, ",%.17g", values(r, c));
+                }
+                std::fprintf(out, "\n");
+            }
+            if (out != stdout) {
+                std::fclose(out);
+            }
+            std::fprintf(stderr, "reduced %llu rows in %.3f s (%.1f MB/s)\n", static_cast<unsigned long long>(stats.rows),
+                         stats.elapsed_s, stats.elapsed_s > 0.0 ? stats.bytes / stats.elapsed_s / 1e6 : 0.0);
+        }
+
+        if (!series_expression.empty()) {
+            const SeriesResult series = runs.series(series_expression, options);
+            const AnalysisStats stats = runs.lastStats();
+            const Matrix bands = percentileBands(series, percentiles, options.threads);
+            std::FILE* out = openOutput(series_output_file);
+            std::fprintf(out, "time");
+            for (double p : percentiles) {
+                std::fprintf(out, ",p%g", p);
+            }
+            std::fprintf(out, "\n");
+            for (size_t i = 0; i < series.times.size(); ++i) {
+                std::fprintf(out, "%.17g", series.times[i]);
+                for (size_t p = 0; p < bands.rows; ++p) {
+                    std::fprintf(out, ",%.17g", bands(p, i));
+                }
+                std::fprintf(out, "\n");
+            }
+            if (out != stdout) {
+                std::fclose(out);
+            }
+            std::fprintf(stderr, "series over %llu rows in %.3f s (%.1f MB/s)\n",
+                         static_cast<unsigned long long>(stats.rows), stats.elapsed_s,
+                         stats.elapsed_s > 0.0 ? stats.bytes / stats.elapsed_s / 1e6 : 0.0);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "gnc_analyze: " << e.what() << "\n";
+        status = 2;
+    }
+    std::fflush(stdout);
+    SimpleLogger::getInstance().shutdown();
+    return status;
+}
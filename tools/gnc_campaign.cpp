@@ -0,0 +1,194 @@
+// gnc_campaign.cpp
+// 批量运行统计汇总：收集各次运行的 summary 记录，在线合并为一份持续更新的批量统计文件
+#include "gnc/components/utility/campaign_stats.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: gnc_campaign --output FILE [options] SUMMARY_OR_DIR...\n"
+        "  SUMMARY_OR_DIR          run summary records (DataLogger format \"summary\") or\n"
+        "                          directories containing them\n"
+        "  --output FILE           campaign statistics file, rewritten after every batch of runs\n"
+        "  --watch                 keep polling the directories for new runs\n"
+        "  --expect N              with --watch, stop once N runs are aggregated\n"
+        "  --idle-timeout S        with --watch, stop after S seconds without a new run\n"
+        "  --interval S            poll interval in seconds (default 1)\n"
+        "  --pattern REGEX         file names picked up in directories (default \\.json$)\n"
+        "  --resume                start from the runs already in the output file\n"
+        "  --quantiles LIST        comma-separated, default 0.01,0.05,0.25,0.5,0.75,0.95,0.99\n"
+        "  --bins N                histogram bins (default 20)\n"
+        "  --compression X         t-digest compression (default 100)\n"
+        "  --no-sketches           do not store the sketches (smaller file, cannot be resumed)\n"
+        "Exit status: 0 success, 1 fewer runs than --expect, 2 error\n";
+}
+
+std::vector<double> parseList(const std::string& text) {
+    std::vector<double> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(std::stod(item));
+    }
+    return values;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    namespace fs = std::filesystem;
+    using gnc::components::utility::CampaignAggregator;
+    using gnc::components::utility::CampaignOptions;
+
+    CampaignOptions options;
+    std::vector<std::string> inputs;
+    std::string output_file;
+    std::string pattern = "\\.json$";
+    bool watch = false;
+    bool resume = false;
+    size_t expect = 0;
+    double idle_timeout = 0.0;
+    double interval = 1.0;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else if (arg == "--output") {
+                output_file = next();
+            } else if (arg == "--watch") {
+                watch = true;
+            } else if (arg == "--expect") {
+                expect = std::stoul(next());
+            } else if (arg == "--idle-timeout") {
+                idle_timeout = std::stod(next());
+            } else if (arg == "--interval") {
+                interval = std::stod(next());
+            } else if (arg == "--pattern") {
+                pattern = next();
+            } else if (arg == "--resume") {
+                resume = true;
+            } else if (arg == "--quantiles") {
+                options.quantiles = parseList(next());
+            } else if (arg == "--bins") {
+                options.histogram_bins = std::stoul(next());
+            } else if (arg == "--compression") {
+                options.compression = std::stod(next());
+            } else if (arg == "--no-sketches") {
+                options.include_sketches = false;
+            } else if (!arg.empty() && arg[0] == '-') {
+                throw std::invalid_argument("unknown option " + arg);
+            } else {
+                inputs.push_back(arg);
+            }
+        }
+        if (output_file.empty() || inputs.empty()) {
+            throw std::invalid_argument("expected --output and at least one input");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "gnc_campaign: " << e.what() << "\n";
+        printUsage();
+        return 2;
+    }
+
+    CampaignAggregator aggregator(options);
+    std::regex name_pattern;
+    try {
+        name_pattern = std::regex(pattern);
+        if (resume && fs::exists(output_file)) {
+            std::ifstream file(output_file);
+            aggregator.load(nlohmann::json::parse(file));
+            std::cout << "resumed " << aggregator.runs() << " runs from " << output_file << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "gnc_campaign: " << e.what() << "\n";
+        return 2;
+    }
+
+    // Files that are not run summaries (or cannot be parsed) are reported once and then ignored
+    std::set<std::string> ignored;
+    const fs::path output_path = fs::absolute(output_file).lexically_normal();
+    auto ingest = [&](const fs::path& path) {
+        const std::string source = path.lexically_normal().string();
+        if (aggregator.contains(source) || ignored.count(source) > 0 ||
+            fs::absolute(path).lexically_normal() == output_path) {
+            return false;
+        }
+        try {
+            std::ifstream file(path);
+            const nlohmann::json record = nlohmann::json::parse(file);
+            if (!CampaignAggregator::isRunSummary(record)) {
+                ignored.insert(source);
+                return false;
+            }
+            return aggregator.addRun(record, source);
+        } catch (const std::exception& e) {
+            std::cerr << "gnc_campaign: skipping " << source << ": " << e.what() << "\n";
+            ignored.insert(source);
+            return false;
+        }
+    };
+    auto scan = [&]() {
+        size_t added = 0;
+        for (const auto& input : inputs) {
+            std::error_code error;
+            if (fs::is_directory(input, error)) {
+                for (const auto& entry : fs::directory_iterator(input, error)) {
+                    if (entry.is_regular_file() && std::regex_search(entry.path().filename().string(), name_pattern)) {
+                        added += ingest(entry.path()) ? 1 : 0;
+                    }
+                }
+            } else if (fs::is_regular_file(input, error)) {
+                added += ingest(input) ? 1 : 0;
+            }
+        }
+        return added;
+    };
+
+    using Clock = std::chrono::steady_clock;
+    auto last_new_run = Clock::now();
+    bool written = false;
+    try {
+        while (true) {
+            const size_t added = scan();
+            if (added > 0 || !written) {
+                aggregator.write(output_file);
+                written = true;
+                if (added > 0) {
+                    last_new_run = Clock::now();
+                    std::cout << "aggregated " << aggregator.runs() << " runs (+" << added << ")" << std::endl;
+                }
+            }
+            if (!watch || (expect > 0 && aggregator.runs() >= expect)) {
+                break;
+            }
+            if (idle_timeout > 0.0 &&
+                std::chrono::duration<double>(Clock::now() - last_new_run).count() > idle_timeout) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::duration<double>(interval));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "gnc_campaign: " << e.what() << "\n";
+        return 2;
+    }
+
+    std::cout << aggregator.runs() << " runs -> " << output_file << "\n";
+    return expect > 0 && aggregator.runs() < expect ? 1 : 0;
+}
@@ -0,0 +1,153 @@
+// gnc_diff.cpp
+// 运行对比：按展平列名和时间对齐两份 DataLogger 日志，逐列按容差比较，用于 CI 回归门禁
+#include "gnc/components/utility/log_diff.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: gnc_diff BASELINE CANDIDATE [options]\n"
+        "  BASELINE, CANDIDATE     recorded logs (.gnclog, .h5 or .csv)\n"
+        "  --abs X                 default absolute tolerance (default 1e-9)\n"
+        "  --rel X                 default relative tolerance (default 0)\n"
+        "  --tol REGEX=ABS[:REL]   tolerance for columns matching REGEX; may be repeated,\n"
+        "                          the first match wins\n"
+        "  --include REGEX         only compare columns matching REGEX\n"
+        "  --time-tol X            row alignment tolerance on time (default 1e-9)\n"
+        "  --allow-missing         columns or rows present in only one log do not fail\n"
+        "  --threads N             scan threads, 0 = hardware concurrency (default 0)\n"
+        "  --config FILE           JSON options (DiffOptions fields); later flags override them\n"
+        "  --all                   list every compared column, not only diverging ones\n"
+        "  --output FILE           write the result as JSON\n"
+        "Exit status: 0 logs match, 1 logs differ, 2 error\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using gnc::components::utility::DiffOptions;
+    using gnc::components::utility::DiffResult;
+
+    DiffOptions options;
+    std::vector<std::string> logs;
+    std::string output_file;
+    bool list_all = false;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else if (arg == "--abs") {
+                options.abs_tolerance = std::stod(next());
+            } else if (arg == "--rel") {
+                options.rel_tolerance = std::stod(next());
+            } else if (arg == "--tol") {
+                const std::string value = next();
+                const auto equals = value.rfind('=');
+                if (equals == std::string::npos) {
+                    throw std::invalid_argument("--tol expects REGEX=ABS[:REL]");
+                }
+                const std::string limits = value.substr(equals + 1);
+                const auto colon = limits.find(':');
+                options.overrides.push_back({value.substr(0, equals), std::stod(limits.substr(0, colon)),
+                                             colon == std::string::npos ? options.rel_tolerance
+                                                                        : std::stod(limits.substr(colon + 1))});
+            } else if (arg == "--include") {
+                options.include = next();
+            } else if (arg == "--time-tol") {
+                options.time_tolerance = std::stod(next());
+            } else if (arg == "--allow-missing") {
+                options.allow_missing = true;
+            } else if (arg == "--threads") {
+                options.threads = std::stoul(next());
+            } else if (arg == "--config") {
+                const std::string path = next();
+                std::ifstream file(path);
+                if (!file) {
+                    throw std::invalid_argument("cannot open " + path);
+                }
+                options = DiffOptions::fromJson(nlohmann::json::parse(file));
+            } else if (arg == "--all") {
+                list_all = true;
+            } else if (arg == "--output") {
+                output_file = next();
+            } else if (!arg.empty() && arg[0] == '-') {
+                throw std::invalid_argument("unknown option " + arg);
+            } else {
+                logs.push_back(arg);
+            }
+        }
+        if (logs.size() != 2) {
+            throw std::invalid_argument("expected exactly two logs");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "gnc_diff: " << e.what() << "\n";
+        printUsage();
+        return 2;
+    }
+
+    DiffResult result;
+    try {
+        result = gnc::components::utility::diffLogs(logs[0], logs[1], options);
+    } catch (const std::exception& e) {
+        std::cerr << "gnc_diff: " << e.what() << "\n";
+        gnc::components::utility::SimpleLogger::getInstance().shutdown();
+        return 2;
+    }
+    gnc::components::utility::SimpleLogger::getInstance().shutdown();
+
+    std::printf("%-48s %10s %12s %12s %14s\n", "column", "mismatch", "max_abs_err", "abs_tol", "first_diverge");
+    for (const auto& column : result.columns) {
+        if (!list_all && !column.diverged()) {
+            continue;
+        }
+        if (column.diverged()) {
+            std::printf("%-48s %10llu %12.3e %12.3e %14.6f\n", column.name.c_str(),
+                        static_cast<unsigned long long>(column.mismatches), column.max_abs_error, column.abs_tolerance,
+                        column.first_divergence_time);
+        } else {
+            std::printf("%-48s %10d %12.3e %12.3e %14s\n", column.name.c_str(), 0, column.max_abs_error,
+                        column.abs_tolerance, "-");
+        }
+    }
+    for (const auto& name : result.only_in_a) {
+        std::printf("%-48s only in %s\n", name.c_str(), logs[0].c_str());
+    }
+    for (const auto& name : result.only_in_b) {
+        std::printf("%-48s only in %s\n", name.c_str(), logs[1].c_str());
+    }
+    if (result.rows_only_a > 0 || result.rows_only_b > 0) {
+        std::printf("unaligned rows: %llu only in baseline, %llu only in candidate\n",
+                    static_cast<unsigned long long>(result.rows_only_a),
+                    static_cast<unsigned long long>(result.rows_only_b));
+    }
+
+    const auto* first = result.firstDivergence();
+    const size_t diverged = static_cast<size_t>(std::count_if(result.columns.begin(), result.columns.end(),
+                                                              [](const auto& column) { return column.diverged(); }));
+    std::printf("%zu columns x %llu rows compared in %.3f s (%.1f MB/s), %zu diverged", result.columns.size(),
+                static_cast<unsigned long long>(result.compared_rows), result.elapsed_s,
+                result.elapsed_s > 0.0 ? result.bytes_scanned / result.elapsed_s / 1e6 : 0.0, diverged);
+    if (first) {
+        std::printf(", first at t = %.6f (%s)", first->first_divergence_time, first->name.c_str());
+    }
+    std::printf(": %s\n", result.passed() ? "PASS" : "FAIL");
+
+    if (!output_file.empty()) {
+        std::ofstream(output_file) << result.toJson().dump(2) << '\n';
+    }
+    return result.passed() ? 0 : 1;
+}
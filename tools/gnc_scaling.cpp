@@ -0,0 +1,145 @@
+// gnc_scaling.cpp
+// 合成场景扩展性测试：按参数网格生成场景，逐个运行并输出启动耗时、帧耗时和内存
+#include "gnc/core/scaling_scenario.hpp"
+#include "gnc/components/utility/simple_logger.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+    std::cout <<
+        "Usage: gnc_scaling [options]\n"
+        "  --vehicles LIST         comma-separated vehicle counts (default 10)\n"
+        "  --components LIST       comma-separated components per vehicle (default 10)\n"
+        "  --fan-in N              local inputs per component (default 2)\n"
+        "  --fan-out N             max local consumers per component, 0 = unlimited (default 0)\n"
+        "  --outputs N             outputs per component (default 1)\n"
+        "  --state-size N          doubles per output (default 3)\n"
+        "  --cross-reads N         inputs read from the next vehicle (default 0)\n"
+        "  --work N                arithmetic iterations per update (default 0)\n"
+        "  --frames N              frames to run per scenario (default 200)\n"
+        "  --seed N                graph generation seed (default 1)\n"
+        "  --logger                add a DataLogger recording every synthetic state\n"
+        "  --config FILE           JSON scenario defaults (ScalingScenarioConfig fields)\n"
+        "  --output FILE           append one JSON result per scenario (JSON lines)\n";
+}
+
+std::vector<size_t> parseList(const std::string& text) {
+    std::vector<size_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using gnc::core::ScalingScenario;
+    using gnc::core::ScalingScenarioConfig;
+
+    nlohmann::json defaults = nlohmann::json::object();
+    std::vector<size_t> vehicle_counts;
+    std::vector<size_t> component_counts;
+    std::string output_file;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else if (arg == "--vehicles") {
+                vehicle_counts = parseList(next());
+            } else if (arg == "--components") {
+                component_counts = parseList(next());
+            } else if (arg == "--fan-in") {
+                defaults["fan_in"] = std::stoul(next());
+            } else if (arg == "--fan-out") {
+                defaults["fan_out"] = std::stoul(next());
+            } else if (arg == "--outputs") {
+                defaults["outputs_per_component"] = std::stoul(next());
+            } else if (arg == "--state-size") {
+                defaults["state_size"] = std::stoul(next());
+            } else if (arg == "--cross-reads") {
+                defaults["cross_vehicle_reads"] = std::stoul(next());
+            } else if (arg == "--work") {
+                defaults["work_iterations"] = std::stoul(next());
+            } else if (arg == "--frames") {
+                defaults["frames"] = std::stoul(next());
+            } else if (arg == "--seed") {
+                defaults["seed"] = std::stoull(next());
+            } else if (arg == "--logger") {
+                defaults["data_logger"] = true;
+            } else if (arg == "--config") {
+                std::ifstream file(next());
+                nlohmann::json loaded = nlohmann::json::parse(file);
+                loaded.merge_patch(defaults);
+                defaults = std::move(loaded);
+            } else if (arg == "--output") {
+                output_file = next();
+            } else {
+                throw std::invalid_argument("unknown option " + arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "gnc_scaling: " << e.what() << "\n";
+        printUsage();
+        return 2;
+    }
+
+    const ScalingScenarioConfig base = ScalingScenarioConfig::fromJson(defaults);
+    if (vehicle_counts.empty()) {
+        vehicle_counts.push_back(base.vehicles);
+    }
+    if (component_counts.empty()) {
+        component_counts.push_back(base.components_per_vehicle);
+    }
+
+    std::ofstream output;
+    if (!output_file.empty()) {
+        output.open(output_file, std::ios::app);
+    }
+
+    std::printf("%9s %11s %9s %10s %11s %11s %11s %11s %12s\n", "vehicles", "components", "states", "startup_ms",
+                "frame_mean", "frame_p50", "frame_p99", "frames/s", "rss_delta_kb");
+    int status = 0;
+    for (size_t vehicles : vehicle_counts) {
+        for (size_t components : component_counts) {
+            ScalingScenarioConfig config = base;
+            config.vehicles = std::max<size_t>(vehicles, 1);
+            config.components_per_vehicle = std::max<size_t>(components, 1);
+            try {
+                const auto result = ScalingScenario(config).run();
+                std::printf("%9zu %11zu %9zu %10.1f %9.1fus %9.1fus %9.1fus %11.1f %12lld\n", config.vehicles,
+                            result.components, result.states, result.startup_s * 1e3, result.frame_mean_ns * 1e-3,
+                            result.frame_p50_ns * 1e-3, result.frame_p99_ns * 1e-3, result.run.stepsPerSecond(),
+                            static_cast<long long>(result.rss_after_run_kb - result.rss_before_kb));
+                std::fflush(stdout);
+                if (output.is_open()) {
+                    output << result.toJson().dump() << '\n';
+                }
+            } catch (const std::exception& e) {
+                LOG_ERROR("[Scaling] Scenario with {} vehicles x {} components failed: {}", config.vehicles,
+                          config.components_per_vehicle, e.what());
+                status = 1;
+            }
+        }
+    }
+
+    gnc::components::utility::SimpleLogger::getInstance().shutdown();
+    return status;
+}